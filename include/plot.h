@@ -197,6 +197,10 @@ int pl_fscale_r (plPlotter *plotter, double x, double y);
 int pl_fsetmatrix_r (plPlotter *plotter, double m0, double m1, double m2, double m3, double m4, double m5);
 int pl_ftranslate_r (plPlotter *plotter, double x, double y);
 
+/* 2 functions for retrieving the raster of a bitmap Plotter (GNU additions) */
+int pl_copyraster_r (plPlotter *plotter, unsigned char *buf, int stride);
+int pl_getraster_r (plPlotter *plotter, const unsigned char **pixels, int *width, int *height, int *stride, int *format);
+
 /* THE OLD (non-thread-safe) C API */
 
 /* 3 functions specific to the old C API.  (For construction/destruction
@@ -322,6 +326,10 @@ int pl_fscale (double x, double y);
 int pl_fsetmatrix (double m0, double m1, double m2, double m3, double m4, double m5);
 int pl_ftranslate (double x, double y);
 
+/* 2 functions for retrieving the raster of a bitmap Plotter (GNU additions) */
+int pl_copyraster (unsigned char *buf, int stride);
+int pl_getraster (const unsigned char **pixels, int *width, int *height, int *stride, int *format);
+
 
 /* UNDOCUMENTED FONT API CALLS */
 /* These are used by the graphics programs in the plotutils package (e.g.,
@@ -370,7 +378,7 @@ enum
 /* ONE-BYTE OPERATION CODES FOR GNU METAFILE FORMAT. These are now defined
    as enums rather than ints.  Cast them to ints if necessary.
 
-   There are 85 currently recognized op codes.  The first 10 date back to
+   There are 86 currently recognized op codes.  The first 10 date back to
    Unix plot(5) format. */
 
 enum
@@ -467,9 +475,16 @@ enum
 /* 3 op codes for floating point operations with no integer counterpart */
   O_FCONCAT		=	'\\',
   O_FMITERLIMIT		=	'i',
-  O_FSETMATRIX		=	'j'
+  O_FSETMATRIX		=	'j',
+
+/* 1 op code used only in the compact binary encoding, for a run of
+   fcont() operations */
+  O_FPOLYLINE		=	'v'
 };
 
+/* Pixel formats of the rasters returned by the getraster() method. */
+enum { PL_RASTER_RGB24 = 1 };	/* 3 bytes per pixel: red, green, blue */
+
 #endif /* not _PL_LIBPLOT_USEFUL_DEFS */
 
 /***********************************************************************/
@@ -485,6 +485,8 @@ typedef struct plOutbufStruct
   char *reset_point;		/* point below which contents are frozen */
   unsigned long contents;	/* size of contents */
   unsigned long reset_contents;	/* size of frozen contents if any */
+  bool spooled;			/* contents moved to data->page_spool? */
+  long spool_offset;		/* offset of contents in spool file, if so */
 
   /* page-specific information that some Plotters generate and use (this is
      starting to look like a Christmas tree...) */
@@ -504,6 +506,18 @@ typedef struct plOutbufStruct
   struct plOutbufStruct *next;
 } plOutbuf;
 
+/* A table of distinct strings, in order of insertion, with a hash index.
+   Used by SVG Plotters writing compact output, which share the style
+   attributes and marker definitions of all objects on a page. */
+typedef struct
+{
+  char **strings;		/* distinct strings, in order of insertion */
+  int num_strings;		/* number of strings in table */
+  int strings_len;		/* allocated length of `strings' */
+  int *hash;			/* hash index (entries are -1 if unused) */
+  int hash_len;			/* length of hash index (a power of 2) */
+} plStringTable;
+
 /* Each Plotter caches the color names that have previously been mapped to
    RGB triples via libplot's colorname database (see g_colorname.h).
    For the cache, a linked list is currently used. */
@@ -567,7 +581,7 @@ typedef struct plColorRecordStruct
    Plotter class (should be moved elsewhere if possible). */
 
 /* Number of recognized Plotter parameters (see g_params2.c). */
-#define NUM_PLOTTER_PARAMETERS 33
+#define NUM_PLOTTER_PARAMETERS 43
 
 /* Maximum number of pens, or logical pens, for an HP-GL/2 device.  Some
    such devices permit as many as 256, but all should permit at least 32.
@@ -693,6 +707,9 @@ typedef struct
   ostream *outstream;		/* C++-style output stream if any */
   ostream *errstream;		/* C++-style error stream if any */
 #endif /* not NOT_LIBPLOTTER */
+  bool compress_output;		/* gzip-compress output stream? */
+  int compression_level;	/* zlib compression level, if so */
+  void *compressor;		/* D: compressor state (see g_write.c) */
 
   /* device driver parameters (i.e., instance copies of class variables) */
   void * params[NUM_PLOTTER_PARAMETERS];
@@ -777,6 +794,17 @@ typedef struct
   plOutbuf *page;		/* D: output buffer for current page */
   plOutbuf *first_page;		/* D: first page (if a linked list is kept) */
 
+  /* spooling of completed pages (PAGES_ALL_AT_ONCE output model only) */
+  bool spool_pages;		/* move completed pages out of core? */
+  FILE *page_spool;		/* D: temporary file holding spooled pages */
+
+  /* raster of current page, or of most recently closed page (for
+     getraster()/copyraster(); used only by Plotters that render bitmaps) */
+  unsigned char *raster;	/* D: 24-bit RGB pixels, row by row */
+  int raster_width, raster_height; /* D: dimensions of raster */
+  int raster_size;		/* D: bytes allocated for raster */
+  bool raster_final;		/* D: raster holds the closed page? */
+
 } plPlotterData;
 
 /* The macro Q___ is used for declaring Plotter methods (as function
@@ -939,6 +967,7 @@ typedef struct plPlotterStruct	/* this tag is used only by libplot */
   int colorname (const char *name);
   int cont (int x, int y);
   int contrel (int dx, int dy);
+  int copyraster (unsigned char *buf, int stride);
   int ellarc (int xc, int yc, int x0, int y0, int x1, int y1);
   int ellarcrel (int dxc, int dyc, int dx0, int dy0, int dx1, int dy1);
   int ellipse (int x, int y, int rx, int ry, int angle);
@@ -991,6 +1020,7 @@ typedef struct plPlotterStruct	/* this tag is used only by libplot */
   int fspace2 (double x0, double y0, double x1, double y1, double x2, double y2);
   double ftextangle (double angle);
   int ftranslate (double x, double y);
+  int getraster (const unsigned char **pixels, int *width, int *height, int *stride, int *format);
   int havecap (const char *s);
   int joinmod (const char *s);
   int label (const char *s);
@@ -1155,6 +1185,14 @@ typedef struct plPlotterStruct	/* this tag is used only by libplot */
      value indicates whether flushing worked. */
   Q___(bool,flush_output) (S___(struct plPlotterStruct *_plotter));
 
+  /* Internal `update raster' method, called by the API methods
+     getraster() and copyraster().  A Plotter that renders its graphics
+     into a bitmap of its own should copy the bitmap to the `raster' member
+     of its plPlotterData, as 24-bit RGB; after closepl() the bitmap of the
+     closed page should still be available.  The generic version does
+     nothing, and returns false. */
+  Q___(bool,update_raster) (S___(struct plPlotterStruct *_plotter));
+
   /* error handlers */
   Q___(void,warning) (R___(struct plPlotterStruct *_plotter) const char *msg);
   Q___(void,error) (R___(struct plPlotterStruct *_plotter) const char *msg);
@@ -1191,9 +1229,14 @@ typedef struct plPlotterStruct	/* this tag is used only by libplot */
   int b_xn, b_yn;		/* bitmap dimensions */
   void * b_painted_set;	/* D: libxmi's canvas (a (miPaintedSet *)) */
   void * b_canvas;		/* D: libxmi's canvas (a (miCanvas *)) */
+  int b_num_colors;		/* D: no. of distinct colors painted on canvas */
+  unsigned long * b_colors;	/* D: those colors (0xRRGGBB), if <= 256 */
   /* data members specific to Metafile Plotters */
   /* 0. parameters */
   bool meta_portable_output;	/* portable, not binary output format? */
+  bool meta_compact_output;	/* compact binary output format? */
+  bool meta_optimize;		/* merge paths, drop invisible ones? */
+  bool meta_page_index;		/* append an index of page offsets? */
   /* 1. dynamic attributes, general */
   plPoint meta_pos;		/* graphics cursor position */
   bool meta_position_is_unknown; /* position is unknown? */
@@ -1224,6 +1267,22 @@ typedef struct plPlotterStruct	/* this tag is used only by libplot */
   plColor meta_fgcolor;		/* foreground color, i.e., pen color */
   plColor meta_fillcolor_base;	/* fill color */
   plColor meta_bgcolor;		/* background color for graphics display */
+  /* 5. page index (see META_PAGE_INDEX parameter) */
+  long meta_offset;		/* number of bytes emitted so far */
+  long *meta_page_offsets;	/* offset of each page's OPENPL */
+  int meta_num_pages;		/* number of pages begun */
+  int meta_page_offsets_len;	/* length of offsets array */
+  /* 6. compact binary encoding (see META_COMPACT parameter) */
+  int meta_coordinates_left;	/* coordinate args of op code not yet emitted */
+  bool meta_coordinate_is_y;	/* next coordinate arg is a y coordinate? */
+  unsigned int meta_prev_x, meta_prev_y; /* previous coordinates, encoded */
+  /* 7. path merging (see META_OPTIMIZE parameter) */
+  plPath *meta_pending_path;	/* polyline painted but not yet emitted */
+  bool meta_path_is_pending;	/* pending path is non-empty? */
+  plPoint meta_pending_pos;	/* cursor position before pending path */
+  /* 8. output buffer */
+  unsigned char *meta_buffer;	/* bytes not yet passed to output stream */
+  int meta_buffer_len;		/* number of bytes in buffer */
   /* data members specific to Tektronix Plotters */
   int tek_display_type;		/* which sort of Tektronix? (one of TEK_DPY_*) */
   int tek_mode;			/* D: one of TEK_MODE_* */
@@ -1360,6 +1419,12 @@ typedef struct plPlotterStruct	/* this tag is used only by libplot */
   bool s_matrix_is_bogus;	/* D: matrix has been set, but is bogus? */
   plColor s_bgcolor;		/* D: background color (RGB) */
   bool s_bgcolor_suppressed;	/* D: background color suppressed? */
+  bool s_compact;		/* compact output (relative paths, CSS, etc.)? */
+  int s_precision;		/* significant digits, in compact output */
+  plOutbuf *s_scratch;		/* scratch buffer, used in compact output */
+  plStringTable *s_styles;	/* D: distinct styles (CSS classes) on page */
+  plStringTable *s_markers;	/* D: distinct marker symbols on page */
+  bool s_in_marker_def;		/* D: drawing a marker symbol definition? */
 /* data members specific to PNM Plotters (derived from Bitmap Plotters) */
   bool n_portable_output;	/* portable, not binary output format? */
 #ifdef INCLUDE_PNG_SUPPORT
@@ -1367,6 +1432,9 @@ typedef struct plPlotterStruct	/* this tag is used only by libplot */
   bool z_interlace;		/* interlaced PNG? */
   bool z_transparent;		/* transparent PNG? */
   plColor z_transparent_color;	/* if so, transparent color (24-bit RGB) */
+  int z_compression_level;	/* zlib compression level (-1 = default) */
+  int z_compression_strategy;	/* zlib compression strategy (-1 = default) */
+  int z_filters;		/* mask of PNG row filters (-1 = default) */
 #endif /* INCLUDE_PNG_SUPPORT */
 /* data members specific to GIF Plotters */
   int i_xn, i_yn;		/* bitmap dimensions */
@@ -1496,6 +1564,7 @@ class MetaPlotter : public Plotter
   bool begin_page (void);
   bool end_page (void);
   bool erase_page (void);
+  bool flush_output (void);
   bool paint_marker (int type, double size);
   bool paint_paths (void);
   bool path_is_flushable (void);
@@ -1509,13 +1578,22 @@ class MetaPlotter : public Plotter
   void _m_emit_integer (int x);
   void _m_emit_float (double x);  
   void _m_emit_op_code (int c);  
+  void _m_emit_page_index (void);
+  void _m_emit_pending_path (void);
   void _m_emit_string (const char *s);  
   void _m_emit_terminator (void);
+  void _m_flush_buffer (void);
+  void _m_hold_path (const plPath *path);
   void _m_paint_path_internal (const plPath *path);
   void _m_set_attributes (unsigned int mask);
+  void _m_write_bytes (int n, const unsigned char *c);
+  void _m_write_string (const char *s);
   /* MetaPlotter-specific data members */
   /* 0. parameters */
   bool meta_portable_output;	/* portable, not binary output format? */
+  bool meta_compact_output;	/* compact binary output format? */
+  bool meta_optimize;		/* merge paths, drop invisible ones? */
+  bool meta_page_index;		/* append an index of page offsets? */
   /* 1. dynamic attributes, general */
   plPoint meta_pos;		/* graphics cursor position */
   bool meta_position_is_unknown; /* position is unknown? */
@@ -1546,6 +1624,22 @@ class MetaPlotter : public Plotter
   plColor meta_fgcolor;		/* foreground color, i.e., pen color */
   plColor meta_fillcolor_base;	/* fill color */
   plColor meta_bgcolor;		/* background color for graphics display */
+  /* 5. page index (see META_PAGE_INDEX parameter) */
+  long meta_offset;		/* number of bytes emitted so far */
+  long *meta_page_offsets;	/* offset of each page's OPENPL */
+  int meta_num_pages;		/* number of pages begun */
+  int meta_page_offsets_len;	/* length of offsets array */
+  /* 6. compact binary encoding (see META_COMPACT parameter) */
+  int meta_coordinates_left;	/* coordinate args of op code not yet emitted */
+  bool meta_coordinate_is_y;	/* next coordinate arg is a y coordinate? */
+  unsigned int meta_prev_x, meta_prev_y; /* previous coordinates, encoded */
+  /* 7. path merging (see META_OPTIMIZE parameter) */
+  plPath *meta_pending_path;	/* polyline painted but not yet emitted */
+  bool meta_path_is_pending;	/* pending path is non-empty? */
+  plPoint meta_pending_pos;	/* cursor position before pending path */
+  /* 8. output buffer */
+  unsigned char *meta_buffer;	/* bytes not yet passed to output stream */
+  int meta_buffer_len;		/* number of bytes in buffer */
 };
 
 /* The BitmapPlotter class, from which PNMPlotter and PNGPlotter are derived */
@@ -1580,6 +1674,7 @@ class BitmapPlotter : public Plotter
   void terminate (void);
   void paint_path (void);
   bool paint_paths (void);
+  bool update_raster (void);
   /* internal functions that are overridden in derived classes (crocks) */
   virtual int _maybe_output_image (void);
   /* BitmapPlotter-specific internal functions */
@@ -1588,11 +1683,14 @@ class BitmapPlotter : public Plotter
   void _b_draw_elliptic_arc_2 (plPoint p0, plPoint p1, plPoint pc);
   void _b_draw_elliptic_arc_internal (int xorigin, int yorigin, unsigned int squaresize_x, unsigned int squaresize_y, int startangle, int anglerange);
   void _b_new_image (void);
+  void _b_note_color (int red, int green, int blue, int xmin, int ymin, int xmax, int ymax);
   /* BitmapPlotter-specific data members */
   void * b_arc_cache_data;	/* pointer to cache (used by miPolyArc_r) */
   int b_xn, b_yn;		/* bitmap dimensions */
   void * b_painted_set;	/* D: libxmi's canvas (a (miPaintedSet *)) */
   void * b_canvas;		/* D: libxmi's canvas (a (miCanvas *)) */
+  int b_num_colors;		/* D: no. of distinct colors painted on canvas */
+  unsigned long * b_colors;	/* D: those colors (0xRRGGBB), if <= 256 */
 };
 
 /* The TekPlotter class, which produces Tektronix output */
@@ -2087,6 +2185,7 @@ class SVGPlotter : public Plotter
   bool begin_page (void);
   bool erase_page (void);
   bool end_page (void);
+  bool paint_marker (int type, double size);
   void paint_point (void);
   void initialize (void);
   void terminate (void);
@@ -2095,12 +2194,19 @@ class SVGPlotter : public Plotter
   double paint_text_string (const unsigned char *s, int h_just, int v_just);
   /* SVGPlotter-specific internal functions */
   void _s_set_matrix (const double m_local[6]);
+  void _s_write_style_class (const char *attributes);
   /* SVGPlotter-specific data members */
   double s_matrix[6];		/* D: default transformation matrix for page */
   bool s_matrix_is_unknown;	/* D: matrix has not yet been set? */
   bool s_matrix_is_bogus;	/* D: matrix has been set, but is bogus? */
   plColor s_bgcolor;		/* D: background color (RGB) */
   bool s_bgcolor_suppressed;	/* D: background color suppressed? */
+  bool s_compact;		/* compact output (relative paths, CSS, etc.)? */
+  int s_precision;		/* significant digits, in compact output */
+  plOutbuf *s_scratch;		/* scratch buffer, used in compact output */
+  plStringTable *s_styles;	/* D: distinct styles (CSS classes) on page */
+  plStringTable *s_markers;	/* D: distinct marker symbols on page */
+  bool s_in_marker_def;		/* D: drawing a marker symbol definition? */
 };
 
 /* The PNMPlotter class, which produces PBM/PGM/PPM output; derived from
@@ -2175,6 +2281,9 @@ class PNGPlotter : public BitmapPlotter
   bool z_interlace;		/* interlaced PNG? */
   bool z_transparent;		/* transparent PNG? */
   plColor z_transparent_color;	/* if so, transparent color (24-bit RGB) */
+  int z_compression_level;	/* zlib compression level (-1 = default) */
+  int z_compression_strategy;	/* zlib compression strategy (-1 = default) */
+  int z_filters;		/* mask of PNG row filters (-1 = default) */
 };
 #endif /* INCLUDE_PNG_SUPPORT */
 
@@ -2210,6 +2319,7 @@ class GIFPlotter : public Plotter
   void terminate (void);
   void paint_path (void);
   bool paint_paths (void);
+  bool update_raster (void);
   /* GIFPlotter-specific internal functions */
   unsigned char _i_new_color_index (int red, int green, int blue);
   int _i_scan_pixel (void);
@@ -2404,7 +2514,7 @@ enum
 /* ONE-BYTE OPERATION CODES FOR GNU METAFILE FORMAT. These are now defined
    as enums rather than ints.  Cast them to ints if necessary.
 
-   There are 85 currently recognized op codes.  The first 10 date back to
+   There are 86 currently recognized op codes.  The first 10 date back to
    Unix plot(5) format. */
 
 enum
@@ -2501,9 +2611,16 @@ enum
 /* 3 op codes for floating point operations with no integer counterpart */
   O_FCONCAT		=	'\\',
   O_FMITERLIMIT		=	'i',
-  O_FSETMATRIX		=	'j'
+  O_FSETMATRIX		=	'j',
+
+/* 1 op code used only in the compact binary encoding, for a run of
+   fcont() operations */
+  O_FPOLYLINE		=	'v'
 };
 
+/* Pixel formats of the rasters returned by the getraster() method. */
+enum { PL_RASTER_RGB24 = 1 };	/* 3 bytes per pixel: red, green, blue */
+
 #endif /* not _PL_LIBPLOT_USEFUL_DEFS */
 
 /***********************************************************************/
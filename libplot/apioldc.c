@@ -393,6 +393,14 @@ pl_contrel (int x, int y)
   return _API_contrel (_old_api_plotter, x, y);
 }
 
+int
+pl_copyraster (unsigned char *buf, int stride)
+{
+  if (_old_api_plotters_len == 0)
+    _create_and_select_default_plotter ();
+  return _API_copyraster (_old_api_plotter, buf, stride);
+}
+
 int
 pl_ellarc (int xc, int yc, int x0, int y0, int x1, int y1)
 {
@@ -809,6 +817,14 @@ pl_ftranslate (double x, double y)
   return _API_ftranslate (_old_api_plotter, x, y);
 }
 
+int
+pl_getraster (const unsigned char **pixels, int *width, int *height, int *stride, int *format)
+{
+  if (_old_api_plotters_len == 0)
+    _create_and_select_default_plotter ();
+  return _API_getraster (_old_api_plotter, pixels, width, height, stride, format);
+}
+
 int
 pl_havecap (const char *s)
 {
@@ -30,8 +30,9 @@ _pl_b_end_page (S___(Plotter *_plotter))
      classes. */
   retval = _maybe_output_image (S___(_plotter));
 
-  /* tear down */
-  _pl_b_delete_image (S___(_plotter));
+  /* The canvas isn't torn down until the next page is begun, or the
+     Plotter is deleted, so that getraster() and copyraster() can still
+     retrieve the page (see g_raster.c). */
 
   return (retval < 0 ? false : true);
 }
@@ -45,6 +46,35 @@ _pl_b_delete_image (S___(Plotter *_plotter))
   _plotter->b_canvas = (void *)NULL;
   miDeletePaintedSet ((miPaintedSet *)_plotter->b_painted_set);
   _plotter->b_painted_set = (void *)NULL;
+  free (_plotter->b_colors);
+  _plotter->b_colors = (unsigned long *)NULL;
+  _plotter->b_num_colors = 0;
+}
+
+/* This is the BitmapPlotter-specific version of the internal
+   update_raster() method, which copies the canvas to the Plotter's raster
+   buffer as 24-bit RGB (see g_raster.c). */
+bool
+_pl_b_update_raster (S___(Plotter *_plotter))
+{
+  miPixel **pixmap;
+  unsigned char *ptr;
+  int i, j;
+
+  if (_plotter->b_canvas == (void *)NULL)
+    return false;
+
+  pixmap = ((miCanvas *)(_plotter->b_canvas))->drawable->pixmap;
+  ptr = _alloc_raster (_plotter->data, _plotter->b_xn, _plotter->b_yn);
+  for (j = 0; j < _plotter->b_yn; j++)
+    for (i = 0; i < _plotter->b_xn; i++)
+      {
+	*ptr++ = pixmap[j][i].u.rgb[0];
+	*ptr++ = pixmap[j][i].u.rgb[1];
+	*ptr++ = pixmap[j][i].u.rgb[2];
+      }
+
+  return true;
 }
 
 /* This is the BitmapPlotter-specific version of the _maybe_output_image()
@@ -50,6 +50,8 @@ const Plotter _pl_b_default_plotter =
   _pl_g_retrieve_font,
   /* `flush output' method, called only if Plotter handles its own output */
   _pl_g_flush_output,
+  /* `update raster' method, called only if Plotter renders a bitmap */
+  _pl_b_update_raster,
   /* error handlers */
   _pl_g_warning,
   _pl_g_error,
@@ -80,6 +82,11 @@ _pl_b_initialize (S___(Plotter *_plotter))
   /* output model */
   _plotter->data->output_model = PL_OUTPUT_NONE;
 
+  /* output is written directly to the output stream, not via
+     _write_string() etc., so it can't be compressed (see g_write.c) */
+  _plotter->data->compress_output = false;
+  _end_compression (_plotter->data);
+
   /* user-queryable capabilities: 0/1/2 = no/yes/maybe */
   _plotter->data->have_wide_lines = 1;
   _plotter->data->have_dash_array = 1;
@@ -135,6 +142,8 @@ _pl_b_initialize (S___(Plotter *_plotter))
   _plotter->b_yn = _plotter->data->jmin + 1;
   _plotter->b_painted_set = (void *)NULL;
   _plotter->b_canvas = (void *)NULL;
+  _plotter->b_num_colors = 0;
+  _plotter->b_colors = (unsigned long *)NULL;
 
   /* initialize storage used by libxmi's reentrant miDrawArcs_r() function
      for cacheing rasterized ellipses */
@@ -195,6 +204,14 @@ parse_bitmap_size (const char *bitmap_size_s, int *width, int *height)
 void
 _pl_b_terminate (S___(Plotter *_plotter))
 {
+  /* if luser left the Plotter open, close it */
+  if (_plotter->data->open)
+    _API_closepl (S___(_plotter));
+
+  /* tear down the most recent page's image, which closepl() keeps */
+  if (_plotter->b_canvas)
+    _pl_b_delete_image (S___(_plotter));
+
   /* free storage used by libxmi's reentrant miDrawArcs_r() function */
   miDeleteEllipseCache ((miEllipseCache *)_plotter->b_arc_cache_data);
 
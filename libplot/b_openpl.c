@@ -23,6 +23,10 @@
 bool
 _pl_b_begin_page (S___(Plotter *_plotter))
 {
+  /* tear down the previous page's image, if it was kept (see b_closepl.c) */
+  if (_plotter->b_canvas)
+    _pl_b_delete_image (S___(_plotter));
+
   /* create new pixmap of specified size (all pixels of background color) */
   _pl_b_new_image (S___(_plotter));
 
@@ -49,4 +53,48 @@ _pl_b_new_image (S___(Plotter *_plotter))
   /* create libxmi miPaintedSet and miCanvas structs */
   _plotter->b_painted_set = (void *)miNewPaintedSet ();
   _plotter->b_canvas = (void *)miNewCanvas ((unsigned int)_plotter->b_xn, (unsigned int)_plotter->b_yn, pixel);
+
+  /* begin keeping track of the colors on the canvas */
+  _plotter->b_colors = (unsigned long *)_pl_xmalloc (PL_MAX_BITMAP_COLORS * sizeof(unsigned long));
+  _plotter->b_num_colors = 0;
+  _pl_b_note_color (R___(_plotter) red, green, blue,
+		    0, 0, _plotter->b_xn - 1, _plotter->b_yn - 1);
+}
+
+/* internal function: record a 24-bit color that is about to be painted on
+   the canvas, within a specified bounding box (in integer device
+   coordinates).  Up to PL_MAX_BITMAP_COLORS distinct colors are recorded;
+   after that, b_num_colors is set to one more than the maximum, and no
+   further colors are recorded.  Since libxmi paints each pixel in a
+   single color taken from its graphics context (no antialiasing or
+   blending is done), the recorded colors include every color that
+   appears in the image.  Colors of objects that lie wholly off the canvas
+   aren't recorded. */
+void
+_pl_b_note_color (R___(Plotter *_plotter) int red, int green, int blue, int xmin, int ymin, int xmax, int ymax)
+{
+  unsigned long color;
+  int pad, i;
+
+  if (_plotter->b_num_colors > PL_MAX_BITMAP_COLORS)
+    return;			/* too many colors; no longer recording */
+
+  /* allow for line width, and mitered line joins */
+  pad = 2 + IROUND(0.5 * _plotter->drawstate->miter_limit
+		   * _plotter->drawstate->quantized_device_line_width);
+  if (xmax + pad < 0 || xmin - pad >= _plotter->b_xn
+      || ymax + pad < 0 || ymin - pad >= _plotter->b_yn)
+    return;			/* object won't appear on canvas */
+
+  color = ((unsigned long)red << 16) | ((unsigned long)green << 8) 
+    | (unsigned long)blue;
+
+  /* search most recently recorded colors first */
+  for (i = _plotter->b_num_colors - 1; i >= 0; i--)
+    if (_plotter->b_colors[i] == color)
+      return;
+
+  if (_plotter->b_num_colors < PL_MAX_BITMAP_COLORS)
+    _plotter->b_colors[_plotter->b_num_colors] = color;
+  _plotter->b_num_colors++;
 }
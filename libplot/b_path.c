@@ -47,6 +47,7 @@ _pl_b_paint_path (S___(Plotter *_plotter))
     case (int)PATH_SEGMENT_LIST:
       {
 	int i, polyline_len;
+	int xmin, ymin, xmax, ymax;
 	bool identical_user_coordinates = true;
 	double xu_last, yu_last;
 	miGC *pGC;
@@ -126,6 +127,17 @@ _pl_b_paint_path (S___(Plotter *_plotter))
 	    yu_last = yu;
 	  }
 	
+	/* determine bounding box of polyline, in device coordinates */
+	xmin = xmax = miPoints[0].x;
+	ymin = ymax = miPoints[0].y;
+	for (i = 1; i < polyline_len; i++)
+	  {
+	    xmin = IMIN(xmin, miPoints[i].x);
+	    xmax = IMAX(xmax, miPoints[i].x);
+	    ymin = IMIN(ymin, miPoints[i].y);
+	    ymax = IMAX(ymax, miPoints[i].y);
+	  }
+
 	/* determine background pixel color */
 	bgPixel.type = MI_PIXEL_RGB_TYPE;
 	bgPixel.u.rgb[0] = _plotter->drawstate->bgcolor.red & 0xff;
@@ -158,6 +170,8 @@ _pl_b_paint_path (S___(Plotter *_plotter))
 	    pixels[0] = bgPixel;
 	    pixels[1] = fgPixel;
 	    miSetGCPixels (pGC, 2, pixels);
+	    _pl_b_note_color (R___(_plotter) red, green, blue,
+			      xmin, ymin, xmax, ymax);
 	    
 	    /* do the filling */
 
@@ -189,6 +203,8 @@ _pl_b_paint_path (S___(Plotter *_plotter))
 	    pixels[0] = bgPixel;
 	    pixels[1] = fgPixel;
 	    miSetGCPixels (pGC, 2, pixels);
+	    _pl_b_note_color (R___(_plotter) red, green, blue,
+			      xmin, ymin, xmax, ymax);
 	    
 	    if (polyline_len == 1)
 	      /* Special case: all user-space points in the polyline were
@@ -545,6 +561,8 @@ _pl_b_draw_elliptic_arc_internal (R___(Plotter *_plotter) int xorigin, int yorig
       pixels[0] = bgPixel;
       pixels[1] = fgPixel;
       miSetGCPixels (pGC, 2, pixels);
+      _pl_b_note_color (R___(_plotter) red, green, blue,
+			arc.x, arc.y, arc.x + (int)arc.width, arc.y + (int)arc.height);
       
       /* fill the arc */
       if (squaresize_x <= 1 || squaresize_y <= 1)
@@ -580,6 +598,8 @@ _pl_b_draw_elliptic_arc_internal (R___(Plotter *_plotter) int xorigin, int yorig
       pixels[0] = bgPixel;
       pixels[1] = fgPixel;
       miSetGCPixels (pGC, 2, pixels);
+      _pl_b_note_color (R___(_plotter) red, green, blue,
+			arc.x, arc.y, arc.x + (int)arc.width, arc.y + (int)arc.height);
       
       if (squaresize_x <= 1 || squaresize_y <= 1)
 	/* Won't call miDrawArcs in the usual way, because it performs
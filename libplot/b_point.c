@@ -66,6 +66,7 @@ _pl_b_paint_point (S___(Plotter *_plotter))
       /* construct an miGC (graphics context for the libxmi module); copy
 	 attributes from the Plotter's GC to it */
       pGC = miNewGC (2, pixels);
+      _pl_b_note_color (R___(_plotter) red, green, blue, ixx, iyy, ixx, iyy);
       _set_common_mi_attributes (_plotter->drawstate, (void *)pGC);
       
       point.x = ixx;
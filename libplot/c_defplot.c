@@ -78,6 +78,8 @@ const Plotter _pl_c_default_plotter =
   _pl_g_retrieve_font,
   /* `flush output' method, called only if Plotter handles its own output */
   _pl_g_flush_output,
+  /* `update raster' method, called only if Plotter renders a bitmap */
+  _pl_g_update_raster,
   /* error handlers */
   _pl_g_warning,
   _pl_g_error,
@@ -1567,9 +1569,9 @@ _pl_c_terminate (S___(Plotter *_plotter))
 	  _delete_outbuf (current_page_header);
 
 	  /* WRITE THE PICTURE */
-	  _write_bytes (_plotter->data, 
-				 (int)(current_page->contents),
-				 (unsigned char *)current_page->base);
+	  if (_write_outbuf (_plotter->data, current_page) == false)
+	    _plotter->error (R___(_plotter)
+			     "a page could not be read back from the spool file");
 
 	  /* prepare a page trailer */
 
@@ -505,6 +505,16 @@ enum { DISP_DEVICE_COORS_REAL, DISP_DEVICE_COORS_INTEGER_LIBXMI, DISP_DEVICE_COO
 /* DEFINITIONS & EXTERNALS SPECIFIC TO INDIVIDUAL DEVICE DRIVERS */
 /************************************************************************/
 
+/************************************************************************/
+/* Bitmap device driver (also PNM, PNG) */
+/************************************************************************/
+
+/* Maximum number of distinct colors that a BitmapPlotter keeps track of,
+   as it paints its canvas.  If no more than this many are painted, a
+   derived class (e.g. a PNGPlotter) can write an indexed-color image
+   without rescanning the canvas. */
+#define PL_MAX_BITMAP_COLORS 256
+
 /************************************************************************/
 /* Metafile device driver */
 /************************************************************************/
@@ -1178,11 +1188,24 @@ extern void * _get_default_plot_param (const char *parameter);
 extern void _write_byte (const plPlotterData *data, unsigned char c);
 extern void _write_bytes (const plPlotterData *data, int n, const unsigned char *c);
 extern void _write_string (const plPlotterData *data, const char *s);
+extern bool _begin_compression (plPlotterData *data, int level);
+extern void _flush_compression (const plPlotterData *data);
+extern void _end_compression (plPlotterData *data);
+/* storage for the raster of a bitmap Plotter (see g_raster.c) */
+extern unsigned char * _alloc_raster (plPlotterData *data, int width, int height);
 /* other plPlotterData methods */
 extern bool _compute_ndc_to_device_map (plPlotterData *data);
 extern void _set_page_type (plPlotterData *data);
 extern void * _get_plot_param (const plPlotterData *data, const char *parameter); 
 
+/* plStringTable methods (see s_style.c) */
+extern plStringTable * _new_string_table (void);
+extern int _string_table_intern (plStringTable *table, const char *s, bool *is_new);
+extern void _delete_string_table (plStringTable *table);
+
+/* SVG-specific number formatting (see s_style.c) */
+extern int _svg_format_number (char *buf, double x, int precision, bool compact);
+
 /* plPath methods (see g_subpaths.c) */
 extern plPath * _flatten_path (const plPath *path);
 extern plPath * _new_plPath (void);
@@ -1219,9 +1242,11 @@ extern void _bbox_of_outbufs (plOutbuf *bufp, double *xmin, double *xmax, double
 extern void _delete_outbuf (plOutbuf *outbuf);
 extern void _freeze_outbuf (plOutbuf *outbuf);
 extern void _reset_outbuf (plOutbuf *outbuf);
+extern bool _spool_outbuf (plPlotterData *data, plOutbuf *outbuf);
 extern void _update_bbox (plOutbuf *bufp, double x, double y);
 extern void _update_buffer (plOutbuf *outbuf);
 extern void _update_buffer_by_added_bytes (plOutbuf *outbuf, int additional);
+extern bool _write_outbuf (const plPlotterData *data, const plOutbuf *outbuf);
 
 /* functions that update a device-frame bounding box for a page, as stored
    in a plOutbuf */
@@ -1415,6 +1440,7 @@ extern void _maybe_handle_x_events (Plotter *_plotter);
 #define _API_colorname pl_colorname_r
 #define _API_cont pl_cont_r
 #define _API_contrel pl_contrel_r
+#define _API_copyraster pl_copyraster_r
 #define _API_ellarc pl_ellarc_r
 #define _API_ellarcrel pl_ellarcrel_r
 #define _API_ellipse pl_ellipse_r
@@ -1467,6 +1493,7 @@ extern void _maybe_handle_x_events (Plotter *_plotter);
 #define _API_fspace2 pl_fspace2_r
 #define _API_ftextangle pl_ftextangle_r
 #define _API_ftranslate pl_ftranslate_r
+#define _API_getraster pl_getraster_r
 #define _API_havecap pl_havecap_r
 #define _API_joinmod pl_joinmod_r
 #define _API_label pl_label_r
@@ -1519,6 +1546,7 @@ extern int _API_color (Plotter *_plotter, int red, int green, int blue);
 extern int _API_colorname (Plotter *_plotter, const char *name);
 extern int _API_cont (Plotter *_plotter, int x, int y);
 extern int _API_contrel (Plotter *_plotter, int x, int y);
+extern int _API_copyraster (Plotter *_plotter, unsigned char *buf, int stride);
 extern int _API_ellarc (Plotter *_plotter, int xc, int yc, int x0, int y0, int x1, int y1);
 extern int _API_ellarcrel (Plotter *_plotter, int dxc, int dyc, int dx0, int dy0, int dx1, int dy1);
 extern int _API_ellipse (Plotter *_plotter, int x, int y, int rx, int ry, int angle);
@@ -1567,6 +1595,7 @@ extern int _API_fsetmatrix (Plotter *_plotter, double m0, double m1, double m2,
 extern int _API_fspace (Plotter *_plotter, double x0, double y0, double x1, double y1);
 extern int _API_fspace2 (Plotter *_plotter, double x0, double y0, double x1, double y1, double x2, double y2);
 extern int _API_ftranslate (Plotter *_plotter, double x, double y);
+extern int _API_getraster (Plotter *_plotter, const unsigned char **pixels, int *width, int *height, int *stride, int *format);
 extern int _API_havecap (Plotter *_plotter, const char *s);
 extern int _API_joinmod (Plotter *_plotter, const char *s);
 extern int _API_label (Plotter *_plotter, const char *s);
@@ -1597,6 +1626,7 @@ extern bool _pl_g_begin_page (Plotter *_plotter);
 extern bool _pl_g_end_page (Plotter *_plotter);
 extern bool _pl_g_erase_page (Plotter *_plotter);
 extern bool _pl_g_flush_output (Plotter *_plotter);
+extern bool _pl_g_update_raster (Plotter *_plotter);
 extern bool _pl_g_paint_marker (Plotter *_plotter, int type, double size);
 extern bool _pl_g_paint_paths (Plotter *_plotter);
 extern bool _pl_g_path_is_flushable (Plotter *_plotter);
@@ -1664,6 +1694,7 @@ ___END_DECLS
 #define _API_colorname Plotter::colorname
 #define _API_cont Plotter::cont
 #define _API_contrel Plotter::contrel
+#define _API_copyraster Plotter::copyraster
 #define _API_ellarc Plotter::ellarc
 #define _API_ellarcrel Plotter::ellarcrel
 #define _API_ellipse Plotter::ellipse
@@ -1716,6 +1747,7 @@ ___END_DECLS
 #define _API_fspace2 Plotter::fspace2
 #define _API_ftextangle Plotter::ftextangle
 #define _API_ftranslate Plotter::ftranslate
+#define _API_getraster Plotter::getraster
 #define _API_havecap Plotter::havecap
 #define _API_joinmod Plotter::joinmod
 #define _API_label Plotter::label
@@ -1751,6 +1783,7 @@ ___END_DECLS
 #define _pl_g_paint_text_string Plotter::paint_text_string
 #define _pl_g_get_text_width Plotter::get_text_width
 #define _pl_g_flush_output Plotter::flush_output
+#define _pl_g_update_raster Plotter::update_raster
 #define _pl_g_initialize Plotter::initialize
 #define _pl_g_path_is_flushable Plotter::path_is_flushable
 #define _pl_g_maybe_prepaint_segments Plotter::maybe_prepaint_segments
@@ -1797,6 +1830,7 @@ ___BEGIN_DECLS
 extern bool _pl_m_begin_page (Plotter *_plotter);
 extern bool _pl_m_end_page (Plotter *_plotter);
 extern bool _pl_m_erase_page (Plotter *_plotter);
+extern bool _pl_m_flush_output (Plotter *_plotter);
 extern bool _pl_m_paint_marker (Plotter *_plotter, int type, double size);
 extern bool _pl_m_paint_paths (Plotter *_plotter);
 extern bool _pl_m_path_is_flushable (Plotter *_plotter);
@@ -1810,16 +1844,23 @@ extern void _pl_m_terminate (Plotter *_plotter);
 extern void _pl_m_emit_integer (Plotter *_plotter, int x);
 extern void _pl_m_emit_float (Plotter *_plotter, double x);
 extern void _pl_m_emit_op_code (Plotter *_plotter, int c);
+extern void _pl_m_emit_page_index (Plotter *_plotter);
+extern void _pl_m_emit_pending_path (Plotter *_plotter);
 extern void _pl_m_emit_string (Plotter *_plotter, const char *s);
 extern void _pl_m_emit_terminator (Plotter *_plotter);
+extern void _pl_m_flush_buffer (Plotter *_plotter);
+extern void _pl_m_hold_path (Plotter *_plotter, const plPath *path);
 extern void _pl_m_paint_path_internal (Plotter *_plotter, const plPath *path);
 extern void _pl_m_set_attributes (Plotter *_plotter, unsigned int mask);
+extern void _pl_m_write_bytes (Plotter *_plotter, int n, const unsigned char *c);
+extern void _pl_m_write_string (Plotter *_plotter, const char *s);
 ___END_DECLS
 #else  /* LIBPLOTTER */
 /* MetaPlotter protected methods, for libplotter */
 #define _pl_m_begin_page MetaPlotter::begin_page
 #define _pl_m_end_page MetaPlotter::end_page
 #define _pl_m_erase_page MetaPlotter::erase_page
+#define _pl_m_flush_output MetaPlotter::flush_output
 #define _pl_m_paint_text_string_with_escapes MetaPlotter::paint_text_string_with_escapes
 #define _pl_m_initialize MetaPlotter::initialize
 #define _pl_m_path_is_flushable MetaPlotter::path_is_flushable
@@ -1833,10 +1874,16 @@ ___END_DECLS
 #define _pl_m_emit_integer MetaPlotter::_m_emit_integer
 #define _pl_m_emit_float MetaPlotter::_m_emit_float
 #define _pl_m_emit_op_code MetaPlotter::_m_emit_op_code
+#define _pl_m_emit_page_index MetaPlotter::_m_emit_page_index
+#define _pl_m_emit_pending_path MetaPlotter::_m_emit_pending_path
 #define _pl_m_emit_string MetaPlotter::_m_emit_string
 #define _pl_m_emit_terminator MetaPlotter::_m_emit_terminator
+#define _pl_m_flush_buffer MetaPlotter::_m_flush_buffer
+#define _pl_m_hold_path MetaPlotter::_m_hold_path
 #define _pl_m_paint_path_internal MetaPlotter::_m_paint_path_internal
 #define _pl_m_set_attributes MetaPlotter::_m_set_attributes
+#define _pl_m_write_bytes MetaPlotter::_m_write_bytes
+#define _pl_m_write_string MetaPlotter::_m_write_string
 #endif /* LIBPLOTTER */
 
 #ifndef LIBPLOTTER
@@ -1846,6 +1893,7 @@ extern bool _pl_b_begin_page (Plotter *_plotter);
 extern bool _pl_b_end_page (Plotter *_plotter);
 extern bool _pl_b_erase_page (Plotter *_plotter);
 extern bool _pl_b_paint_paths (Plotter *_plotter);
+extern bool _pl_b_update_raster (Plotter *_plotter);
 extern void _pl_b_initialize (Plotter *_plotter);
 extern void _pl_b_paint_path (Plotter *_plotter);
 extern void _pl_b_paint_point (Plotter *_plotter);
@@ -1858,6 +1906,7 @@ extern void _pl_b_draw_elliptic_arc (Plotter *_plotter, plPoint p0, plPoint p1,
 extern void _pl_b_draw_elliptic_arc_2 (Plotter *_plotter, plPoint p0, plPoint p1, plPoint pc);
 extern void _pl_b_draw_elliptic_arc_internal (Plotter *_plotter, int xorigin, int yorigin, unsigned int squaresize_x, unsigned int squaresize_y, int startangle, int anglerange);
 extern void _pl_b_new_image (Plotter *_plotter);
+extern void _pl_b_note_color (Plotter *_plotter, int red, int green, int blue, int xmin, int ymin, int xmax, int ymax);
 ___END_DECLS
 #else  /* LIBPLOTTER */
 /* BitmapPlotter protected methods, for libplotter */
@@ -1867,6 +1916,7 @@ ___END_DECLS
 #define _pl_b_initialize BitmapPlotter::initialize
 #define _pl_b_paint_path BitmapPlotter::paint_path
 #define _pl_b_paint_paths BitmapPlotter::paint_paths
+#define _pl_b_update_raster BitmapPlotter::update_raster
 #define _pl_b_paint_point BitmapPlotter::paint_point
 #define _pl_b_terminate BitmapPlotter::terminate
 /* BitmapPlotter internal functions (overriden in subclasses) */
@@ -1877,6 +1927,7 @@ ___END_DECLS
 #define _pl_b_draw_elliptic_arc_2 BitmapPlotter::_b_draw_elliptic_arc_2
 #define _pl_b_draw_elliptic_arc_internal BitmapPlotter::_b_draw_elliptic_arc_internal
 #define _pl_b_new_image BitmapPlotter::_b_new_image 
+#define _pl_b_note_color BitmapPlotter::_b_note_color
 #endif /* LIBPLOTTER */
 
 #ifndef LIBPLOTTER
@@ -2197,10 +2248,12 @@ extern bool _pl_s_paint_paths (Plotter *_plotter);
 extern double _pl_s_paint_text_string (Plotter *_plotter, const unsigned char *s, int h_just, int v_just);
 extern void _pl_s_initialize (Plotter *_plotter);
 extern void _pl_s_paint_path (Plotter *_plotter);
+extern bool _pl_s_paint_marker (Plotter *_plotter, int type, double size);
 extern void _pl_s_paint_point (Plotter *_plotter);
 extern void _pl_s_terminate (Plotter *_plotter);
 /* PSPlotter internal functions, for libplot */
 extern void _pl_s_set_matrix (Plotter *_plotter, const double m_local[6]);
+extern void _pl_s_write_style_class (Plotter *_plotter, const char *attributes);
 ___END_DECLS
 #else  /* LIBPLOTTER */
 /* SVGPlotter protected methods, for libplotter */
@@ -2209,12 +2262,14 @@ ___END_DECLS
 #define _pl_s_erase_page SVGPlotter::erase_page
 #define _pl_s_paint_text_string SVGPlotter::paint_text_string
 #define _pl_s_initialize SVGPlotter::initialize
+#define _pl_s_paint_marker SVGPlotter::paint_marker
 #define _pl_s_paint_path SVGPlotter::paint_path
 #define _pl_s_paint_paths SVGPlotter::paint_paths
 #define _pl_s_paint_point SVGPlotter::paint_point
 #define _pl_s_terminate SVGPlotter::terminate
 /* SVGPlotter internal functions, for libplotter */
 #define _pl_s_set_matrix SVGPlotter::_s_set_matrix
+#define _pl_s_write_style_class SVGPlotter::_s_write_style_class
 #endif /* LIBPLOTTER */
 
 #ifndef LIBPLOTTER
@@ -2268,6 +2323,7 @@ extern bool _pl_i_begin_page (Plotter *_plotter);
 extern bool _pl_i_end_page (Plotter *_plotter);
 extern bool _pl_i_erase_page (Plotter *_plotter);
 extern bool _pl_i_paint_paths (Plotter *_plotter);
+extern bool _pl_i_update_raster (Plotter *_plotter);
 extern void _pl_i_initialize (Plotter *_plotter);
 extern void _pl_i_paint_path (Plotter *_plotter);
 extern void _pl_i_paint_point (Plotter *_plotter);
@@ -2297,6 +2353,7 @@ ___END_DECLS
 #define _pl_i_initialize GIFPlotter::initialize
 #define _pl_i_paint_path GIFPlotter::paint_path
 #define _pl_i_paint_paths GIFPlotter::paint_paths
+#define _pl_i_update_raster GIFPlotter::update_raster
 #define _pl_i_paint_point GIFPlotter::paint_point
 #define _pl_i_terminate GIFPlotter::terminate
 /* GIFPlotter internal functions, for libplotter */
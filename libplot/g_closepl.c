@@ -117,7 +117,9 @@ _API_closepl (S___(Plotter *_plotter))
       /* Plotter will do its own output, in its terminate() routine.  
 	 It will do so by writing out the contents of all its cached pages
 	 (a new one gets added to the list each time openpl() is invoked).
-	 So do nothing. */
+	 So do nothing, except move the page out of core if requested. */
+      if (_plotter->data->spool_pages)
+	_spool_outbuf (_plotter->data, _plotter->data->page);
       break;
 
     case (int)PL_OUTPUT_VIA_CUSTOM_ROUTINES:
@@ -92,6 +92,8 @@ const Plotter _pl_g_default_plotter =
   _pl_g_retrieve_font,
   /* `flush output' method, called only if Plotter handles its own output */
   _pl_g_flush_output,
+  /* `update raster' method, called only if Plotter renders a bitmap */
+  _pl_g_update_raster,
   /* error handlers */
   _pl_g_warning,
   _pl_g_error
@@ -171,6 +173,16 @@ _pl_g_initialize (S___(Plotter *_plotter))
   /* I/O, will not differ in derived classes */
   _plotter->data->page = (plOutbuf *)NULL;
   _plotter->data->first_page = (plOutbuf *)NULL;  
+  _plotter->data->spool_pages = false;
+  _plotter->data->page_spool = (FILE *)NULL;
+  _plotter->data->compress_output = false;
+  _plotter->data->compression_level = -1; /* i.e. Z_DEFAULT_COMPRESSION */
+  _plotter->data->compressor = NULL;
+  _plotter->data->raster = (unsigned char *)NULL;
+  _plotter->data->raster_width = 0;
+  _plotter->data->raster_height = 0;
+  _plotter->data->raster_size = 0;
+  _plotter->data->raster_final = false;
 
   /* basic data members, will not differ in derived classes */
   _plotter->data->open = false;
@@ -276,6 +288,39 @@ _pl_g_initialize (S___(Plotter *_plotter))
     _plotter->data->max_unfilled_path_length = local_length;
   }
       
+  /* move completed pages to a temporary file, rather than caching them
+     in core (relevant only to Plotters that emit all pages at once) */
+  {
+    const char *spool_s;
+
+    spool_s = (const char *)_get_plot_param (_plotter->data, 
+					     "SPOOL_PAGES");
+    if (strcasecmp (spool_s, "yes") == 0)
+      _plotter->data->spool_pages = true;
+    else
+      _plotter->data->spool_pages = false; /* default value */
+  }
+
+  /* compress output stream? ("gzip" or "gzip:N", N = level 0..9) */
+  {
+    const char *compression_s;
+    int level;
+
+    compression_s = (const char *)_get_plot_param (_plotter->data, 
+						   "OUTPUT_COMPRESSION");
+    if (strcasecmp (compression_s, "gzip") == 0)
+      _plotter->data->compress_output = true;
+    else if (strncasecmp (compression_s, "gzip:", 5) == 0
+	     && sscanf (compression_s + 5, "%d", &level) == 1
+	     && level >= 0 && level <= 9)
+      {
+	_plotter->data->compress_output = true;
+	_plotter->data->compression_level = level;
+      }
+    else
+      _plotter->data->compress_output = false; /* default value */
+  }
+
   /* Ensure widths of labels rendered in the Stick fonts are correctly
      computed.  This is a kludge (in pre-HP-GL/2, Stick fonts were kerned;
      see g_alabel.c.)  */
@@ -309,6 +354,25 @@ _pl_g_initialize (S___(Plotter *_plotter))
       setmode (fileno (stdout), O_BINARY);
     }
 #endif
+
+  /* start compressing output stream, if requested; Plotters that write
+     directly to it, rather than via _write_string() etc., will cancel
+     this */
+  if (_plotter->data->compress_output
+      && (_plotter->data->outfp
+#ifdef LIBPLOTTER
+	  || _plotter->data->outstream
+#endif
+	  ))
+    {
+      if (_begin_compression (_plotter->data, 
+			      _plotter->data->compression_level) == false)
+	{
+	  _plotter->warning (R___(_plotter) 
+			     "output compression is not supported, so output will be uncompressed");
+	  _plotter->data->compress_output = false;
+	}
+    }
 }
 
 /* The private `terminate' method, which is invoked when a Plotter is
@@ -330,6 +394,20 @@ _pl_g_terminate (S___(Plotter *_plotter))
   /* free color name cache */
   _delete_color_name_cache (_plotter->data->color_name_cache);
 
+  /* finish compressing output stream, if doing so */
+  _end_compression (_plotter->data);
+
+  /* close (and thereby remove) spool file for cached pages, if any */
+  if (_plotter->data->page_spool)
+    {
+      fclose (_plotter->data->page_spool);
+      _plotter->data->page_spool = (FILE *)NULL;
+    }
+
+  /* free raster of most recent page, if any */
+  free (_plotter->data->raster);
+  _plotter->data->raster = (unsigned char *)NULL;
+
   /* remove Plotter from sparse Plotter array */
 
 #ifdef PTHREAD_SUPPORT
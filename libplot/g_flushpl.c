@@ -65,6 +65,7 @@ _API_flushpl (S___(Plotter *_plotter))
 	 really distinguish here between Plotters that write graphics in
 	 real time, and those that wait until the end of a page, or of all
 	 pages, before writing graphics.  */
+      _flush_compression (_plotter->data);
       if (_plotter->data->outfp)
 	{
 	  if (fflush(_plotter->data->outfp) < 0
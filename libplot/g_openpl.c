@@ -89,6 +89,9 @@ _API_openpl (S___(Plotter *_plotter))
   _plotter->data->opened = true;
   _plotter->data->page_number++;
 
+  /* any raster taken of the previous page is out of date */
+  _plotter->data->raster_final = false;
+
   /* keep track of these; some lusers don't invoke ffontsize() or
      flinewidth(), so we need to choose a reasonable font size and/or line
      width for them */
@@ -36,7 +36,14 @@
    remove all graphics from the plOutbuf.  There is provision for keeping a
    section of initialization code in the plOutbuf, untouched.  This is
    arranged by a previous call to _FREEZE_OUTBUF.  Anything in the plOutbuf
-   at that time will be untouched by a later call to _RESET_OUTBUF. */
+   at that time will be untouched by a later call to _RESET_OUTBUF.
+
+   Plotters that cache every page until they are deleted (PS and CGM
+   Plotters) may, if the SPOOL_PAGES parameter is "yes", move the contents
+   of each completed page to a temporary spool file by calling
+   _SPOOL_OUTBUF.  Only the per-page metadata (bounding box, fonts used,
+   etc.) then stays in core.  _WRITE_OUTBUF writes out the contents of a
+   plOutbuf, whether or not it has been spooled. */
 
 #include "sys-defines.h"
 #include "extern.h"
@@ -53,6 +60,10 @@
    reallocating due to exhaustion of storage. */
 #define NEW_OUTBUF_LEN(old_outbuf_len) ((old_outbuf_len) < 10000000 ? 2 * (old_outbuf_len) : (old_outbuf_len) + 10000000)
 
+/* Size of the chunks in which spooled page contents are copied back from
+   the spool file to the output stream. */
+#define SPOOL_CHUNK_LEN 65536
+
 plOutbuf *
 _new_outbuf (void)
 {
@@ -66,6 +77,8 @@ _new_outbuf (void)
   bufp->next = NULL;
   bufp->reset_point = bufp->base;
   bufp->reset_contents = (unsigned long)0L;
+  bufp->spooled = false;
+  bufp->spool_offset = 0L;
   _reset_outbuf (bufp);
 
   return bufp;
@@ -181,6 +194,109 @@ _update_buffer_by_added_bytes (plOutbuf *bufp, int additional)
     }      
 }
 
+/* Move the contents of a completed page to the Plotter's spool file,
+   creating the spool file if necessary, and shrink the in-core buffer to a
+   minimum.  The plOutbuf's `contents' field continues to record the
+   number of bytes on the page; all other page-specific information is
+   untouched.  Nothing may be written to a plOutbuf after it is spooled.
+   Returns false if the page could not be spooled, in which case it stays
+   in core. */
+
+bool
+_spool_outbuf (plPlotterData *data, plOutbuf *bufp)
+{
+  long offset;
+
+  if (bufp == (plOutbuf *)NULL || bufp->spooled)
+    return true;
+
+  if (data->page_spool == (FILE *)NULL)
+    {
+      data->page_spool = tmpfile ();
+      if (data->page_spool == (FILE *)NULL)
+	return false;
+    }
+
+  if (fseek (data->page_spool, 0L, SEEK_END) < 0)
+    return false;
+  offset = ftell (data->page_spool);
+  if (offset < 0L)
+    return false;
+  if (bufp->contents > 0
+      && fwrite (bufp->base, sizeof(char), bufp->contents, data->page_spool)
+      != bufp->contents)
+    return false;
+
+  /* page is safely in the spool file, so free most of its storage */
+  free (bufp->base);
+  bufp->base = (char *)_pl_xmalloc (sizeof(char));
+  bufp->base[0] = '\0';
+  bufp->len = 1;
+  bufp->point = bufp->base;
+  bufp->reset_point = bufp->base;
+  bufp->reset_contents = (unsigned long)0L;
+  bufp->spooled = true;
+  bufp->spool_offset = offset;
+
+  return true;
+}
+
+/* Write the contents of a plOutbuf to a Plotter's output stream.  If the
+   plOutbuf has been spooled, its contents are copied from the spool file,
+   a chunk at a time.  Returns false if they could not all be read back
+   from the spool file, in which case the page is incomplete. */
+
+bool
+_write_outbuf (const plPlotterData *data, const plOutbuf *bufp)
+{
+  unsigned long remaining;
+
+  if (bufp == (const plOutbuf *)NULL || bufp->contents == 0)
+    return true;
+
+  if (bufp->spooled == false)
+    {
+      const char *p = bufp->base;
+
+      remaining = bufp->contents;
+      while (remaining > 0)
+	{
+	  int n = (remaining > SPOOL_CHUNK_LEN 
+		   ? SPOOL_CHUNK_LEN : (int)remaining);
+
+	  _write_bytes (data, n, (const unsigned char *)p);
+	  p += n;
+	  remaining -= n;
+	}
+      return true;
+    }
+
+  if (data->page_spool == (FILE *)NULL
+      || fseek (data->page_spool, bufp->spool_offset, SEEK_SET) < 0)
+    return false;
+
+  {
+    unsigned char *chunk;
+
+    chunk = (unsigned char *)_pl_xmalloc (SPOOL_CHUNK_LEN * sizeof(unsigned char));
+    remaining = bufp->contents;
+    while (remaining > 0)
+      {
+	size_t n = (remaining > SPOOL_CHUNK_LEN 
+		    ? SPOOL_CHUNK_LEN : (size_t)remaining);
+
+	n = fread (chunk, sizeof(unsigned char), n, data->page_spool);
+	if (n == 0)		/* read error, or spool file truncated */
+	  break;
+	_write_bytes (data, (int)n, chunk);
+	remaining -= n;
+      }
+    free (chunk);
+  }
+
+  return (remaining == 0 ? true : false);
+}
+
 /* update bounding box information for a plOutbuf, to take account of a
    point being plotted on the associated page */
 void 
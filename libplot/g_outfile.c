@@ -43,12 +43,19 @@ _API_outfile(R___(Plotter *_plotter) FILE *outfile)
       return (FILE *)NULL;
     }
 
+  /* finish any compressed stream on the old output stream, and start a
+     new one on the new stream */
+  _end_compression (_plotter->data);
+
   oldoutfile = _plotter->data->outfp;
   _plotter->data->outfp = outfile;
 #ifdef LIBPLOTTER
   _plotter->data->outstream = NULL;
 #endif
 
+  if (_plotter->data->compress_output && outfile)
+    _begin_compression (_plotter->data, _plotter->data->compression_level);
+
   _plotter->data->page_number = 0;	/* reset */
 
   return oldoutfile;
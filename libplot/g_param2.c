@@ -53,12 +53,22 @@ const struct plParamRecord _known_params[NUM_PLOTTER_PARAMETERS] =
   {"HPGL_VERSION", (char *)"2", true},	/* hpgl */
   {"INTERLACE", (char *)"no", true}, /* gif */
   {"MAX_LINE_LENGTH", (char *)PL_MAX_UNFILLED_PATH_LENGTH_STRING, true}, /* all but tek and meta */
+  {"META_COMPACT", (char *)"no", true}, /* meta */
+  {"META_OPTIMIZE", (char *)"no", true}, /* meta */
+  {"META_PAGE_INDEX", (char *)"no", true}, /* meta */
   {"META_PORTABLE", (char *)"no", true}, /* meta */
+  {"OUTPUT_COMPRESSION", (char *)"none", true}, /* all but X, pnm, gif, png */
   {"PAGESIZE", (char *)"letter", true}, /* hpgl, pcl, fig, cgm, ps, ai */
   {"PCL_ASSIGN_COLORS", (char *)"no", true}, /* pcl */
   {"PCL_BEZIERS", (char *)"yes", true},	/* pcl */
+  {"PNG_COMPRESSION_LEVEL", (char *)"default", true}, /* png */
+  {"PNG_COMPRESSION_STRATEGY", (char *)"default", true}, /* png */
+  {"PNG_FILTER", (char *)"default", true}, /* png */
   {"PNM_PORTABLE", (char *)"no", true}, /* pnm */
   {"ROTATION", (char *)"no", true}, /* tek, hpgl, pcl, fig, ps, ai, X, XDrawable */
+  {"SPOOL_PAGES", (char *)"no", true}, /* cgm, ps */
+  {"SVG_COMPACT", (char *)"no", true}, /* svg */
+  {"SVG_PRECISION", (char *)"5", true}, /* svg */
   {"TERM", (char *)"tek", true}, /* tek only! */
   {"TRANSPARENT_COLOR", (char *)"none", true}, /* gif */
   {"USE_DOUBLE_BUFFERING", (char *)"no", true}, /* X, XDrawable */
@@ -0,0 +1,145 @@
+/* This file is part of the GNU plotutils package.  Copyright (C) 1995,
+   1996, 1997, 1998, 1999, 2000, 2005, 2008, Free Software Foundation, Inc.
+
+   The GNU plotutils package is free software.  You may redistribute it
+   and/or modify it under the terms of the GNU General Public License as
+   published by the Free Software foundation; either version 2, or (at your
+   option) any later version.
+
+   The GNU plotutils package is distributed in the hope that it will be
+   useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with the GNU plotutils package; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin St., Fifth Floor,
+   Boston, MA 02110-1301, USA. */
+
+/* This file contains the getraster and copyraster methods, which are GNU
+   extensions to libplot.  They give an application direct access to the
+   page of graphics rendered by a Plotter that draws into a bitmap of its
+   own (a Bitmap, PNM, PNG, or GIF Plotter), so that it needn't decode the
+   Plotter's output.
+
+   While a page is open, the raster is copied from the Plotter's canvas
+   each time one of these methods is invoked (after the path under
+   construction, if any, is ended).  When a page is closed, the Plotter
+   keeps its canvas until it is reopened or deleted, and the raster is
+   copied from it once, the first time it's asked for.  So a Plotter whose
+   raster is never asked for does no copying.  The raster is always
+   returned in PL_RASTER_RGB24 format: 3 bytes (red, green, blue) per
+   pixel. */
+
+#include "sys-defines.h"
+#include "extern.h"
+
+/* Return a read-only pointer to the raster, and its dimensions, row
+   stride (in bytes), and pixel format.  Any of the pointer arguments may
+   be NULL.  The pixels are a snapshot: they aren't affected by later
+   drawing until getraster() or copyraster() is invoked again.  The
+   pointer remains valid until the Plotter is deleted.  The return value
+   is -1 if the Plotter doesn't render a bitmap, or has not yet been
+   opened. */
+int
+_API_getraster (R___(Plotter *_plotter) const unsigned char **pixels, int *width, int *height, int *stride, int *format)
+{
+  if (_plotter->data->open)
+    {
+      /* flush path under construction, if any, so it'll be in the raster */
+      _API_endpath (S___(_plotter));
+      _plotter->update_raster (S___(_plotter));
+    }
+  else if (_plotter->data->raster_final == false)
+    /* copy the closed page, whose canvas the Plotter has kept */
+    _plotter->data->raster_final = 
+      _plotter->update_raster (S___(_plotter));
+
+  if (_plotter->data->raster == (unsigned char *)NULL)
+    return -1;
+
+  if (pixels)
+    *pixels = _plotter->data->raster;
+  if (width)
+    *width = _plotter->data->raster_width;
+  if (height)
+    *height = _plotter->data->raster_height;
+  if (stride)
+    *stride = 3 * _plotter->data->raster_width;
+  if (format)
+    *format = (int)PL_RASTER_RGB24;
+
+  return 0;
+}
+
+/* Copy the raster into a caller-supplied buffer, with a specified row
+   stride (in bytes).  A stride of zero means the rows should be packed
+   together.  The buffer must be at least stride*height bytes long; the
+   width and height may be obtained by invoking getraster().  The return
+   value is -1 if there is no raster, or the stride is too small. */
+int
+_API_copyraster (R___(Plotter *_plotter) unsigned char *buf, int stride)
+{
+  int row_length, j;
+  const unsigned char *src;
+
+  if (_plotter->data->open)
+    {
+      /* flush path under construction, if any, so it'll be in the raster */
+      _API_endpath (S___(_plotter));
+      _plotter->update_raster (S___(_plotter));
+    }
+  else if (_plotter->data->raster_final == false)
+    /* copy the closed page, whose canvas the Plotter has kept */
+    _plotter->data->raster_final = 
+      _plotter->update_raster (S___(_plotter));
+
+  if (_plotter->data->raster == (unsigned char *)NULL 
+      || buf == (unsigned char *)NULL)
+    return -1;
+
+  row_length = 3 * _plotter->data->raster_width;
+  if (stride == 0)
+    stride = row_length;
+  else if (stride < row_length)
+    return -1;
+
+  if (stride == row_length)
+    memcpy (buf, _plotter->data->raster, 
+	    (size_t)row_length * (size_t)_plotter->data->raster_height);
+  else
+    for (j = 0, src = _plotter->data->raster; 
+	 j < _plotter->data->raster_height; 
+	 j++, src += row_length, buf += stride)
+      memcpy (buf, src, (size_t)row_length);
+
+  return 0;
+}
+
+/* The generic version of the internal `update raster' method, which is
+   invoked by the above.  It does nothing, since a generic Plotter doesn't
+   render a bitmap; it's overridden by Bitmap and GIF Plotters. */
+bool
+_pl_g_update_raster (S___(Plotter *_plotter))
+{
+  return false;
+}
+
+/* Ensure that a plPlotterData's raster buffer can hold a raster of the
+   specified size, and return it.  The buffer is reused if possible. */
+unsigned char *
+_alloc_raster (plPlotterData *data, int width, int height)
+{
+  int size = 3 * width * height;
+
+  if (data->raster == (unsigned char *)NULL || data->raster_size < size)
+    {
+      free (data->raster);
+      data->raster = (unsigned char *)_pl_xmalloc ((size_t)size);
+      data->raster_size = size;
+    }
+  data->raster_width = width;
+  data->raster_height = height;
+
+  return data->raster;
+}
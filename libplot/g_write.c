@@ -17,14 +17,54 @@
    Boston, MA 02110-1301, USA. */
 
 /* These are the lowest-level output routines in libplot/libplotter.
-   Plotters that write to output streams use these. */
+   Plotters that write to output streams use these.
+
+   If the OUTPUT_COMPRESSION parameter is "gzip" (or "gzip:N", N being a
+   compression level 0..9), whatever is written by these routines is
+   compressed in gzip format before it reaches the output stream.  That
+   requires zlib, which is available if libpng is.  A compressor is
+   started by _pl_g_initialize(), and finished (i.e., the gzip trailer is
+   written) by _pl_g_terminate(). */
 
 #include "sys-defines.h"
 #include "extern.h"
 
+#ifdef INCLUDE_PNG_SUPPORT
+#include <zlib.h>		/* libpng requires zlib, so it's available */
+
+/* length of the compressor's input and output buffers */
+#define COMPRESSION_CHUNK_LEN 16384
+
+typedef struct
+{
+  z_stream z;			/* zlib state */
+  bool started;			/* any bytes received yet? */
+  int in_len;			/* number of bytes in input buffer */
+  unsigned char in[COMPRESSION_CHUNK_LEN];
+  unsigned char out[COMPRESSION_CHUNK_LEN];
+} plCompressor;
+
+/* forward references */
+static void compress_bytes (const plPlotterData *data, int n, const unsigned char *c);
+static void run_compressor (const plPlotterData *data, int flush);
+static void write_raw_bytes (const plPlotterData *data, int n, const unsigned char *c);
+#endif /* INCLUDE_PNG_SUPPORT */
+
 void
 _write_byte (const plPlotterData *data, unsigned char c)
 {
+#ifdef INCLUDE_PNG_SUPPORT
+  if (data->compressor)
+    {
+      plCompressor *compressor = (plCompressor *)data->compressor;
+
+      if (compressor->in_len == COMPRESSION_CHUNK_LEN)
+	run_compressor (data, Z_NO_FLUSH);
+      compressor->in[compressor->in_len++] = c;
+      compressor->started = true;
+      return;
+    }
+#endif
   if (data->outfp)
     putc ((int)c, data->outfp);
 #ifdef LIBPLOTTER
@@ -36,13 +76,15 @@ _write_byte (const plPlotterData *data, unsigned char c)
 void
 _write_bytes (const plPlotterData *data, int n, const unsigned char *c)
 {
-  int i;
-
-  if (data->outfp)
+#ifdef INCLUDE_PNG_SUPPORT
+  if (data->compressor)
     {
-      for (i = 0; i < n; i++)
-	putc ((int)(c[i]), data->outfp);
+      compress_bytes (data, n, c);
+      return;
     }
+#endif
+  if (data->outfp)
+    fwrite ((const void *)c, sizeof(unsigned char), (size_t)n, data->outfp);
 #ifdef LIBPLOTTER
   else if (data->outstream)
     data->outstream->write((const char *)c, n);
@@ -52,6 +94,13 @@ _write_bytes (const plPlotterData *data, int n, const unsigned char *c)
 void
 _write_string (const plPlotterData *data, const char *s)
 {
+#ifdef INCLUDE_PNG_SUPPORT
+  if (data->compressor)
+    {
+      compress_bytes (data, (int)strlen (s), (const unsigned char *)s);
+      return;
+    }
+#endif
   if (data->outfp)
     fputs (s, data->outfp);
 #ifdef LIBPLOTTER
@@ -59,3 +108,130 @@ _write_string (const plPlotterData *data, const char *s)
     (*(data->outstream)) << s;
 #endif
 }
+
+/* Start compressing output, at the specified zlib compression level
+   (Z_DEFAULT_COMPRESSION, i.e. -1, or 0..9).  Return value indicates
+   whether compression is supported. */
+
+bool
+_begin_compression (plPlotterData *data, int level)
+{
+#ifdef INCLUDE_PNG_SUPPORT
+  plCompressor *compressor;
+
+  if (data->compressor)		/* already compressing */
+    return true;
+
+  compressor = (plCompressor *)_pl_xmalloc (sizeof(plCompressor));
+  compressor->z.zalloc = Z_NULL;
+  compressor->z.zfree = Z_NULL;
+  compressor->z.opaque = Z_NULL;
+  /* 16 + 15 = gzip wrapper, with largest window */
+  if (deflateInit2 (&compressor->z, level, Z_DEFLATED, 16 + 15, 8, 
+		    Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+      free (compressor);
+      return false;
+    }
+  compressor->started = false;
+  compressor->in_len = 0;
+  data->compressor = (void *)compressor;
+  return true;
+#else
+  return false;
+#endif
+}
+
+/* Push everything written so far through the compressor to the output
+   stream, so that it can be decompressed (invoked by flushpl()). */
+
+void
+_flush_compression (const plPlotterData *data)
+{
+#ifdef INCLUDE_PNG_SUPPORT
+  if (data->compressor && ((plCompressor *)data->compressor)->started)
+    run_compressor (data, Z_SYNC_FLUSH);
+#endif
+}
+
+/* Stop compressing output.  Unless nothing was written (in which case
+   nothing is output), the remaining compressed data and the gzip trailer
+   are written to the output stream. */
+
+void
+_end_compression (plPlotterData *data)
+{
+#ifdef INCLUDE_PNG_SUPPORT
+  plCompressor *compressor = (plCompressor *)data->compressor;
+
+  if (compressor == NULL)
+    return;
+
+  if (compressor->started)
+    run_compressor (data, Z_FINISH);
+  deflateEnd (&compressor->z);
+  free (compressor);
+  data->compressor = NULL;
+#endif
+}
+
+#ifdef INCLUDE_PNG_SUPPORT
+/* write bytes to the output stream, bypassing any compressor */
+static void
+write_raw_bytes (const plPlotterData *data, int n, const unsigned char *c)
+{
+  if (data->outfp)
+    fwrite ((const void *)c, sizeof(unsigned char), (size_t)n, data->outfp);
+#ifdef LIBPLOTTER
+  else if (data->outstream)
+    data->outstream->write((const char *)c, n);
+#endif
+}
+
+static void
+compress_bytes (const plPlotterData *data, int n, const unsigned char *c)
+{
+  plCompressor *compressor = (plCompressor *)data->compressor;
+
+  if (n > 0)
+    compressor->started = true;
+  while (n > 0)
+    {
+      int len;
+
+      if (compressor->in_len == COMPRESSION_CHUNK_LEN)
+	run_compressor (data, Z_NO_FLUSH);
+      len = COMPRESSION_CHUNK_LEN - compressor->in_len;
+      if (len > n)
+	len = n;
+      memcpy (compressor->in + compressor->in_len, c, (size_t)len);
+      compressor->in_len += len;
+      c += len;
+      n -= len;
+    }
+}
+
+/* Compress the contents of the input buffer, and write whatever output
+   zlib produces to the output stream. */
+
+static void
+run_compressor (const plPlotterData *data, int flush)
+{
+  plCompressor *compressor = (plCompressor *)data->compressor;
+  int status;
+
+  compressor->z.next_in = compressor->in;
+  compressor->z.avail_in = (unsigned int)compressor->in_len;
+  do
+    {
+      compressor->z.next_out = compressor->out;
+      compressor->z.avail_out = COMPRESSION_CHUNK_LEN;
+      status = deflate (&compressor->z, flush);
+      write_raw_bytes (data, 
+			COMPRESSION_CHUNK_LEN - (int)compressor->z.avail_out,
+			compressor->out);
+    }
+  while (compressor->z.avail_out == 0 && status != Z_STREAM_END);
+  compressor->in_len = 0;
+}
+#endif /* INCLUDE_PNG_SUPPORT */
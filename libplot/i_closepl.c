@@ -55,8 +55,38 @@ _pl_i_end_page (S___(Plotter *_plotter))
 	}
     }
   
-  /* delete image: deallocate frame's canvas, reset frame's color table */
-  _pl_i_delete_image (S___(_plotter));
+  /* The image (the frame's canvas and color table) isn't deleted until
+     the next page is begun, or the Plotter is deleted, so that getraster()
+     and copyraster() can still retrieve the page (see g_raster.c). */
+
+  return true;
+}
+
+/* This is the GIFPlotter-specific version of the internal update_raster()
+   method, which copies the canvas to the Plotter's raster buffer as 24-bit
+   RGB, by looking up each pixel's color index in the frame's color table
+   (see g_raster.c). */
+bool
+_pl_i_update_raster (S___(Plotter *_plotter))
+{
+  miPixel **pixmap;
+  unsigned char *ptr;
+  int i, j;
+
+  if (_plotter->i_canvas == (void *)NULL)
+    return false;
+
+  pixmap = ((miCanvas *)(_plotter->i_canvas))->drawable->pixmap;
+  ptr = _alloc_raster (_plotter->data, _plotter->i_xn, _plotter->i_yn);
+  for (j = 0; j < _plotter->i_yn; j++)
+    for (i = 0; i < _plotter->i_xn; i++)
+      {
+	const plColor *color = &_plotter->i_colormap[pixmap[j][i].u.index];
+
+	*ptr++ = (unsigned char)color->red;
+	*ptr++ = (unsigned char)color->green;
+	*ptr++ = (unsigned char)color->blue;
+      }
 
   return true;
 }
@@ -429,10 +459,13 @@ _pl_i_delete_image (S___(Plotter *_plotter))
   /* reset colormap */
   _plotter->i_num_color_indices = 0;
 
-  /* flag color indices in drawing state as bogus */
-  _plotter->drawstate->i_pen_color_status = false;
-  _plotter->drawstate->i_fill_color_status = false;
-  _plotter->drawstate->i_bg_color_status = false;
+  /* flag color indices in drawing state (if any) as bogus */
+  if (_plotter->drawstate)
+    {
+      _plotter->drawstate->i_pen_color_status = false;
+      _plotter->drawstate->i_fill_color_status = false;
+      _plotter->drawstate->i_bg_color_status = false;
+    }
 }
 
 /* compare two partially filled size-256 colormaps for equality */
@@ -50,6 +50,8 @@ const Plotter _pl_i_default_plotter =
   _pl_g_retrieve_font,
   /* `flush output' method, called only if Plotter handles its own output */
   _pl_g_flush_output,
+  /* `update raster' method, called only if Plotter renders a bitmap */
+  _pl_i_update_raster,
   /* error handlers */
   _pl_g_warning,
   _pl_g_error,
@@ -80,6 +82,11 @@ _pl_i_initialize (S___(Plotter *_plotter))
   /* output model */
   _plotter->data->output_model = PL_OUTPUT_VIA_CUSTOM_ROUTINES;
 
+  /* output is written directly to the output stream, not via
+     _write_string() etc., so it can't be compressed (see g_write.c) */
+  _plotter->data->compress_output = false;
+  _end_compression (_plotter->data);
+
   /* user-queryable capabilities: 0/1/2 = no/yes/maybe */
   _plotter->data->have_wide_lines = 1;
   _plotter->data->have_dash_array = 1;
@@ -272,6 +279,14 @@ parse_bitmap_size (const char *bitmap_size_s, int *width, int *height)
 void
 _pl_i_terminate (S___(Plotter *_plotter))
 {
+  /* if luser left the Plotter open, close it */
+  if (_plotter->data->open)
+    _API_closepl (S___(_plotter));
+
+  /* delete the most recent page's image, which closepl() keeps */
+  if (_plotter->i_canvas)
+    _pl_i_delete_image (S___(_plotter));
+
   /* free storage used by libxmi's reentrant miDrawArcs_r() function */
   miDeleteEllipseCache ((miEllipseCache *)_plotter->i_arc_cache_data);
 
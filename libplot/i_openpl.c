@@ -27,6 +27,11 @@ _pl_i_begin_page (S___(Plotter *_plotter))
      members of the GIFPlotter.  The data members, and the values that are
      set, are the same as are used in initializing the GIFPlotter (see
      i_defplot.c). */
+
+  /* first delete the previous page's image, if it was kept (see
+     i_closepl.c) */
+  if (_plotter->i_canvas)
+    _pl_i_delete_image (S___(_plotter));
      
   _plotter->i_painted_set = (void *)NULL;
   _plotter->i_canvas = (void *)NULL;
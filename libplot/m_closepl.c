@@ -24,6 +24,7 @@ _pl_m_end_page (S___(Plotter *_plotter))
 {
   _pl_m_emit_op_code (R___(_plotter) O_CLOSEPL);
   _pl_m_emit_terminator (S___(_plotter));
+  _pl_m_flush_buffer (S___(_plotter));
 
   /* clean up device-specific Plotter members that are heap-allocated */
   if (_plotter->meta_font_name != (const char *)NULL)
@@ -45,7 +45,9 @@ const Plotter _pl_m_default_plotter =
   /* internal `retrieve font' method */
   _pl_g_retrieve_font,
   /* `flush output' method, called only if Plotter handles its own output */
-  _pl_g_flush_output,
+  _pl_m_flush_output,
+  /* `update raster' method, called only if Plotter renders a bitmap */
+  _pl_g_update_raster,
   /* internal `error handler' methods */
   _pl_g_warning,
   _pl_g_error,
@@ -131,6 +133,9 @@ _pl_m_initialize (S___(Plotter *_plotter))
   /* initialize data members specific to this derived class */
   /* parameters */
   _plotter->meta_portable_output = false;
+  _plotter->meta_compact_output = false;
+  _plotter->meta_optimize = false;
+  _plotter->meta_page_index = false;
   /* dynamic variables */
   _plotter->meta_pos.x = 0.0;
   _plotter->meta_pos.y = 0.0;
@@ -169,6 +174,20 @@ _pl_m_initialize (S___(Plotter *_plotter))
   _plotter->meta_bgcolor.red = 65535;
   _plotter->meta_bgcolor.green = 65535;
   _plotter->meta_bgcolor.blue = 65535;
+  _plotter->meta_offset = 0;
+  _plotter->meta_page_offsets = (long *)NULL;
+  _plotter->meta_num_pages = 0;
+  _plotter->meta_page_offsets_len = 0;
+  _plotter->meta_coordinates_left = 0;
+  _plotter->meta_coordinate_is_y = false;
+  _plotter->meta_prev_x = 0;
+  _plotter->meta_prev_y = 0;
+  _plotter->meta_pending_path = (plPath *)NULL;
+  _plotter->meta_path_is_pending = false;
+  _plotter->meta_pending_pos.x = 0.0;
+  _plotter->meta_pending_pos.y = 0.0;
+  _plotter->meta_buffer = (unsigned char *)NULL;
+  _plotter->meta_buffer_len = 0;
   
   /* initialize certain data members from device driver parameters */
       
@@ -183,6 +202,43 @@ _pl_m_initialize (S___(Plotter *_plotter))
     else
       _plotter->meta_portable_output = false; /* default value */
   }
+
+  /* if binary, determine whether compact binary encoding is wanted */
+  {
+    const char *compact_s;
+    
+    compact_s = (const char *)_get_plot_param (_plotter->data, 
+					       "META_COMPACT");
+    if (strcasecmp (compact_s, "yes") == 0 
+	&& _plotter->meta_portable_output == false)
+      _plotter->meta_compact_output = true;
+    else
+      _plotter->meta_compact_output = false; /* default value */
+  }
+
+  /* determine whether paths should be merged where possible */
+  {
+    const char *optimize_s;
+    
+    optimize_s = (const char *)_get_plot_param (_plotter->data, 
+						"META_OPTIMIZE");
+    if (strcasecmp (optimize_s, "yes") == 0)
+      _plotter->meta_optimize = true;
+    else
+      _plotter->meta_optimize = false; /* default value */
+  }
+
+  /* determine whether an index of page offsets should be appended */
+  {
+    const char *page_index_s;
+    
+    page_index_s = (const char *)_get_plot_param (_plotter->data, 
+						  "META_PAGE_INDEX");
+    if (strcasecmp (page_index_s, "yes") == 0)
+      _plotter->meta_page_index = true;
+    else
+      _plotter->meta_page_index = false; /* default value */
+  }
 }
 
 /* The private `terminate' method, which is invoked when a Plotter is
@@ -193,6 +249,17 @@ _pl_m_initialize (S___(Plotter *_plotter))
 void
 _pl_m_terminate (S___(Plotter *_plotter))
 {
+  /* append index of page offsets, if requested; this must precede
+     superclass termination, which finishes compressing the output */
+  if (_plotter->meta_page_index && _plotter->meta_num_pages > 0)
+    _pl_m_emit_page_index (S___(_plotter));
+  _pl_m_flush_buffer (S___(_plotter));
+  if (_plotter->meta_buffer)
+    free (_plotter->meta_buffer);
+  if (_plotter->meta_page_offsets)
+    free (_plotter->meta_page_offsets);
+  _delete_plPath (_plotter->meta_pending_path);
+
 #ifndef LIBPLOTTER
   /* in libplot, manually invoke superclass termination method */
   _pl_g_terminate (S___(_plotter));
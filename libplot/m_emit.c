@@ -39,78 +39,148 @@
    Our representation for floating-point numbers in binary metafiles is
    simply the machine representation for single-precision floating point.
    plot(5) format did not support floating point arguments, so there are no
-   concerns over backward compatibility. */
+   concerns over backward compatibility.
+
+   The compact binary metafile format (type 3, selected by the
+   META_COMPACT parameter) is machine-independent, and typically much
+   smaller.  Integers are written as variable-length `zigzag' integers:
+   0, -1, 1, -2, ... are mapped to 0, 1, 2, 3, ..., which are written
+   seven bits per byte, least significant first, with the high bit of each
+   byte but the last set.  A coordinate, i.e. an x or y argument of an op
+   code that specifies points (e.g. fcont), is first rounded to single
+   precision.  Its bit pattern is mapped to an integer key, in a way that
+   preserves order, and the difference between the key and the key of the
+   previous x or y coordinate is written as a zigzag integer.  Nearby
+   points therefore take only a few bytes.  Other floating point numbers
+   are written in IEEE single precision format, least significant byte
+   first.  A run of fcont operations is written as a single FPOLYLINE
+   operation: a count, followed by the points.  The format loses no
+   information relative to the binary format. */
 
 #include "sys-defines.h"
 #include "extern.h"
 
+/* All output is assembled in a buffer of this length, which is passed
+   to the low-level routines in g_write.c (so that it can be compressed;
+   see the OUTPUT_COMPRESSION parameter) by _pl_m_flush_buffer(): at the
+   end of each page, when flushpl() is invoked, and when the buffer
+   fills.  The number of bytes emitted is kept track of, for the page
+   index (see _pl_m_emit_page_index() below). */
+#define META_BUFFER_LEN 65536
+
+/* forward references */
+static int _encode_zigzag (unsigned char *buf, unsigned int u);
+static int _format_float (char *buf, double x);
+static int _format_integer (char *buf, int x);
+static int _num_coordinates (int op_code);
+static unsigned int _float_to_key (float f);
+
 /* emit one unsigned character, passed as an int */
 void
 _pl_m_emit_op_code (R___(Plotter *_plotter) int c)
 {
-  if (_plotter->data->outfp)
-    putc (c, _plotter->data->outfp);
-#ifdef LIBPLOTTER
-  else if (_plotter->data->outstream)
-    _plotter->data->outstream->put ((unsigned char)c);
-#endif
+  unsigned char byte;
+
+  /* a path that is being held back for merging (see m_path.c) must
+     precede anything else that is emitted */
+  if (_plotter->meta_path_is_pending)
+    _pl_m_emit_pending_path (S___(_plotter));
+
+  byte = (unsigned char)c;
+  _pl_m_write_bytes (R___(_plotter) 1, &byte);
+
+  /* in the compact encoding, prepare to emit coordinates (if any) */
+  if (_plotter->meta_compact_output)
+    {
+      _plotter->meta_coordinates_left = _num_coordinates (c);
+      _plotter->meta_coordinate_is_y = false;
+    }
 }
 
 void
 _pl_m_emit_integer (R___(Plotter *_plotter) int x)
 {
-  if (_plotter->data->outfp)
+  if (_plotter->meta_portable_output)
     {
-      if (_plotter->meta_portable_output)
-	fprintf (_plotter->data->outfp, " %d", x);
-      else
-	fwrite ((void *) &x, sizeof(int), 1, _plotter->data->outfp);
+      char buf[32];
+      int len;
+
+      len = _format_integer (buf, x); /* i.e. sprintf (buf, " %d", x) */
+      _pl_m_write_bytes (R___(_plotter) len, (const unsigned char *)buf);
     }
-#ifdef LIBPLOTTER
-  else if (_plotter->data->outstream)
+  else if (_plotter->meta_compact_output)
     {
-      if (_plotter->meta_portable_output)
-	(*(_plotter->data->outstream)) << ' ' << x;
-      else
-	_plotter->data->outstream->write((char *)&x, sizeof(int));
+      unsigned char buf[5];
+      int len;
+
+      len = _encode_zigzag (buf, (unsigned int)x);
+      _pl_m_write_bytes (R___(_plotter) len, buf);
     }
-#endif
+  else
+    _pl_m_write_bytes (R___(_plotter) 
+		       (int)sizeof(int), (const unsigned char *)&x);
 }
 
 void
 _pl_m_emit_float (R___(Plotter *_plotter) double x)
 {
-  if (_plotter->data->outfp)
+  if (_plotter->meta_portable_output)
     {
-      if (_plotter->meta_portable_output)
+      char buf[64];
+      int len;
+
+      /* treat equality with zero specially, since some printf's print
+	 negative zero differently from positive zero, and that may
+	 prevent regression tests from working properly */
+      if (x == 0.0)
 	{
-	  /* treat equality with zero specially, since some printf's print
-	     negative zero differently from positive zero, and that may
-	     prevent regression tests from working properly */
-	  fprintf (_plotter->data->outfp, x == 0.0 ? " 0" : " %g", x);
+	  strcpy (buf, " 0");
+	  len = 2;
 	}
       else
-	{
-	  float f;
-	  
-	  f = FROUND(x);
-	  fwrite ((void *) &f, sizeof(float), 1, _plotter->data->outfp);
-	}
+	len = _format_float (buf, x); /* i.e. sprintf (buf, " %g", x) */
+      _pl_m_write_bytes (R___(_plotter) len, (const unsigned char *)buf);
     }
-#ifdef LIBPLOTTER
-  else if (_plotter->data->outstream)
+  else if (_plotter->meta_compact_output)
     {
-      if (_plotter->meta_portable_output)
-	(*(_plotter->data->outstream)) << ' ' << x;
+      unsigned char buf[5];
+      unsigned int key, *prev;
+      int len;
+      float f;
+
+      f = FROUND(x);
+      key = _float_to_key (f);
+      if (_plotter->meta_coordinates_left > 0)
+	/* a coordinate; emit difference from previous x or y */
+	{
+	  prev = (_plotter->meta_coordinate_is_y 
+		  ? &_plotter->meta_prev_y : &_plotter->meta_prev_x);
+	  len = _encode_zigzag (buf, (key - *prev) & 0xffffffffU);
+	  *prev = key;
+	  _plotter->meta_coordinate_is_y = !_plotter->meta_coordinate_is_y;
+	  _plotter->meta_coordinates_left--;
+	}
       else
+	/* emit IEEE bit pattern, least significant byte first */
 	{
-	  float f;
+	  unsigned int bits;
+	  int i;
 	  
-	  f = FROUND(x);
-	  _plotter->data->outstream->write((char *)&f, sizeof(float));
+	  memcpy (&bits, &f, sizeof(float));
+	  for (i = 0; i < 4; i++)
+	    buf[i] = (unsigned char)((bits >> (8 * i)) & 0xff);
+	  len = 4;
 	}
+      _pl_m_write_bytes (R___(_plotter) len, buf);
+    }
+  else
+    {
+      float f;
+	  
+      f = FROUND(x);
+      _pl_m_write_bytes (R___(_plotter) 
+			 (int)sizeof(float), (const unsigned char *)&f);
     }
-#endif
 }
 
 void
@@ -145,20 +215,9 @@ _pl_m_emit_string (R___(Plotter *_plotter) const char *s)
   /* emit string, with appended newline if output format is binary (old
      plot(3) convention, which makes sense only if there can be at most one
      string among the command arguments, and it's positioned last) */
-  if (_plotter->data->outfp)
-    {
-      fputs (u, _plotter->data->outfp);
-      if (_plotter->meta_portable_output == false)
-	putc ('\n', _plotter->data->outfp); 
-    }
-#ifdef LIBPLOTTER
-  else if (_plotter->data->outstream)
-    {
-      (*(_plotter->data->outstream)) << u;
-      if (_plotter->meta_portable_output == false)
-	(*(_plotter->data->outstream)) << '\n';
-    }
-#endif
+  _pl_m_write_string (R___(_plotter) u);
+  if (_plotter->meta_portable_output == false)
+    _pl_m_write_string (R___(_plotter) "\n");
 
   if (has_newline)
     free (t);
@@ -171,12 +230,285 @@ void
 _pl_m_emit_terminator (S___(Plotter *_plotter))
 {
   if (_plotter->meta_portable_output)
+    _pl_m_write_string (R___(_plotter) "\n");
+}
+
+/* Emit an index of the pages in the metafile, at its end (invoked when the
+   Plotter is deleted, if the META_PAGE_INDEX parameter is "yes").  The
+   index is a sequence of comment lines, which are the same in binary and
+   portable format, and which readers that don't understand them will
+   ignore:
+
+     #PAGE 1 <offset of page 1>
+     ...
+     #PAGE <n> <offset of page n>
+     #PAGE_INDEX <n> <offset of first #PAGE line>
+
+   Offsets are in bytes from the beginning of the (uncompressed) metafile,
+   and a page's offset is that of its OPENPL instruction.  So a reader can
+   locate any page by reading the short final line first. */
+void
+_pl_m_emit_page_index (S___(Plotter *_plotter))
+{
+  char buf[64];
+  long index_offset = _plotter->meta_offset;
+  int i;
+
+  for (i = 0; i < _plotter->meta_num_pages; i++)
+    {
+      sprintf (buf, "%cPAGE %d %ld\n", 
+	       (int)O_COMMENT, i + 1, _plotter->meta_page_offsets[i]);
+      _pl_m_write_string (R___(_plotter) buf);
+    }
+  sprintf (buf, "%cPAGE_INDEX %d %ld\n", 
+	   (int)O_COMMENT, _plotter->meta_num_pages, index_offset);
+  _pl_m_write_string (R___(_plotter) buf);
+}
+
+/* Append bytes to the output buffer, first flushing it if there's no
+   room. */
+void
+_pl_m_write_bytes (R___(Plotter *_plotter) int n, const unsigned char *c)
+{
+  if (_plotter->meta_buffer == (unsigned char *)NULL)
+    _plotter->meta_buffer = (unsigned char *)_pl_xmalloc (META_BUFFER_LEN);
+  if (_plotter->meta_buffer_len + n > META_BUFFER_LEN)
     {
-      if (_plotter->data->outfp)
-	putc ('\n', _plotter->data->outfp);
+      _pl_m_flush_buffer (S___(_plotter));
+      if (n > META_BUFFER_LEN)
+	/* too long to buffer (can only be a long string), so write it */
+	{
+	  _write_bytes (_plotter->data, n, c);
+	  _plotter->meta_offset += (long)n;
+	  return;
+	}
+    }
+  memcpy (_plotter->meta_buffer + _plotter->meta_buffer_len, c, (size_t)n);
+  _plotter->meta_buffer_len += n;
+  _plotter->meta_offset += (long)n;
+}
+
+void
+_pl_m_write_string (R___(Plotter *_plotter) const char *s)
+{
+  _pl_m_write_bytes (R___(_plotter) 
+		     (int)strlen (s), (const unsigned char *)s);
+}
+
+/* Pass the contents of the output buffer to the output stream. */
+void
+_pl_m_flush_buffer (S___(Plotter *_plotter))
+{
+  if (_plotter->meta_buffer_len > 0)
+    {
+      _write_bytes (_plotter->data, 
+		    _plotter->meta_buffer_len, _plotter->meta_buffer);
+      _plotter->meta_buffer_len = 0;
+    }
+}
+
+/* The MetaPlotter-specific `flush output' method, which is invoked by
+   flushpl() and closepl().  It flushes the output buffer, and then the
+   stream.  It doesn't flush the compressor (if any), since that would
+   alter the compressed output. */
+bool
+_pl_m_flush_output (S___(Plotter *_plotter))
+{
+  bool retval = true;
+
+  _pl_m_flush_buffer (S___(_plotter));
+  if (_plotter->data->outfp)
+    {
+      if (fflush (_plotter->data->outfp) < 0)
+	retval = false;
+    }
 #ifdef LIBPLOTTER
-      else if (_plotter->data->outstream)
-	(*(_plotter->data->outstream)) << '\n';
+  else if (_plotter->data->outstream)
+    {
+      _plotter->data->outstream->flush ();
+      if (!(*(_plotter->data->outstream)))
+	retval = false;
+    }
 #endif
+
+  return retval;
+}
+
+/* Format an integer as sprintf (buf, " %d", x) would.  Return value is
+   the number of characters written, not counting the terminating null. */
+static int
+_format_integer (char *buf, int x)
+{
+  char digits[16];
+  unsigned int u;
+  int len = 0, num_digits = 0;
+
+  buf[len++] = ' ';
+  if (x < 0)
+    {
+      buf[len++] = '-';
+      u = 0U - (unsigned int)x;
+    }
+  else
+    u = (unsigned int)x;
+  do
+    {
+      digits[num_digits++] = (char)('0' + u % 10);
+      u /= 10;
+    }
+  while (u > 0);
+  while (num_digits > 0)
+    buf[len++] = digits[--num_digits];
+  buf[len] = '\0';
+
+  return len;
+}
+
+/* Format a nonzero number as sprintf (buf, " %g", x) would.  Return value
+   is the number of characters written, not counting the terminating null.
+
+   Numbers of magnitude between 1e-4 and 1e6, which %g prints with six
+   significant digits and without an exponent, are formatted here.  The
+   digits are obtained by scaling by a power of ten, which is exactly
+   representable, so there's only one rounding error.  If that could
+   affect the result, i.e., if the scaled number is very nearly halfway
+   between two integers, sprintf() is invoked instead.  So it is for
+   numbers outside that range, and in the rare case that rounding yields
+   seven digits. */
+static int
+_format_float (char *buf, double x)
+{
+  static const double powers_of_ten[10] =
+  { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+  char digits[6];
+  double ax, scaled, whole, frac;
+  long n;
+  int exponent, i, num_digits, len = 0;
+
+  ax = (x < 0.0 ? -x : x);
+  if (!(ax >= 1e-4 && ax < 1e6)) /* also catches NaN */
+    return sprintf (buf, " %g", x);
+
+  /* decimal exponent of leading digit (possibly off by one, for numbers
+     very close to powers of ten; if so, the check below will fail) */
+  for (exponent = 5; exponent > -4; exponent--)
+    if (ax * powers_of_ten[5 - exponent] >= 1e5)
+      break;
+  scaled = ax * powers_of_ten[5 - exponent];
+  whole = floor (scaled);
+  frac = scaled - whole;
+  if (frac > 0.5 - 1e-9 && frac < 0.5 + 1e-9)
+    return sprintf (buf, " %g", x);
+  n = (long)whole + (frac > 0.5 ? 1 : 0);
+  if (n < 100000L || n > 999999L)
+    return sprintf (buf, " %g", x);
+
+  for (i = 5; i >= 0; i--)
+    {
+      digits[i] = (char)('0' + n % 10);
+      n /= 10;
+    }
+  /* drop trailing zeroes (at least one digit precedes the decimal point,
+     if exponent is nonnegative) */
+  for (num_digits = 6; num_digits > 1 && num_digits > exponent + 1; 
+       num_digits--)
+    if (digits[num_digits - 1] != '0')
+      break;
+
+  buf[len++] = ' ';
+  if (x < 0.0)
+    buf[len++] = '-';
+  if (exponent >= 0)
+    {
+      for (i = 0; i <= exponent; i++)
+	buf[len++] = digits[i];
+      if (num_digits > exponent + 1)
+	{
+	  buf[len++] = '.';
+	  for (i = exponent + 1; i < num_digits; i++)
+	    buf[len++] = digits[i];
+	}
+    }
+  else
+    {
+      buf[len++] = '0';
+      buf[len++] = '.';
+      for (i = -1; i > exponent; i--)
+	buf[len++] = '0';
+      for (i = 0; i < num_digits; i++)
+	buf[len++] = digits[i];
+    }
+  buf[len] = '\0';
+
+  return len;
+}
+
+/* Write an integer, interpreted as a 32-bit two's complement integer, to a
+   buffer as a zigzag integer (see above).  Return value is the number of
+   bytes written (at most 5). */
+static int
+_encode_zigzag (unsigned char *buf, unsigned int u)
+{
+  unsigned int z;
+  int len = 0;
+
+  u &= 0xffffffffU;
+  z = ((u << 1) ^ ((u & 0x80000000U) ? 0xffffffffU : 0)) & 0xffffffffU;
+  while (z >= 0x80)
+    {
+      buf[len++] = (unsigned char)((z & 0x7f) | 0x80);
+      z >>= 7;
+    }
+  buf[len++] = (unsigned char)z;
+
+  return len;
+}
+
+/* Map the bit pattern of a single precision number to a 32-bit key, so
+   that the order of keys, interpreted as two's complement integers, is
+   the order of the numbers.  Negative numbers, including -0.0, are mapped
+   to negative keys. */
+static unsigned int
+_float_to_key (float f)
+{
+  unsigned int bits;
+
+  memcpy (&bits, &f, sizeof(float));
+  if (bits & 0x80000000U)
+    return (~(bits & 0x7fffffffU)) & 0xffffffffU; /* -1 - magnitude */
+  else
+    return bits;
+}
+
+/* Return the number of leading floating point arguments of an op code
+   that are coordinates, i.e. alternating x and y coordinates of points,
+   in the compact encoding.  (An FPOLYLINE op code has any number.) */
+static int
+_num_coordinates (int op_code)
+{
+  switch (op_code)
+    {
+    case (int)O_FCIRCLE:
+    case (int)O_FCONT:
+    case (int)O_FELLIPSE:
+    case (int)O_FMARKER:
+    case (int)O_FMOVE:
+    case (int)O_FPOINT:
+      return 2;
+    case (int)O_FBOX:
+    case (int)O_FLINE:
+    case (int)O_FSPACE:
+      return 4;
+    case (int)O_FARC:
+    case (int)O_FBEZIER2:
+    case (int)O_FELLARC:
+    case (int)O_FSPACE2:
+      return 6;
+    case (int)O_FBEZIER3:
+      return 8;
+    case (int)O_FPOLYLINE:
+      return INT_MAX;
+    default:
+      return 0;
     }
 }
@@ -25,15 +25,42 @@ _pl_m_begin_page (S___(Plotter *_plotter))
   if (_plotter->data->page_number == 1)
     /* emit metafile header, i.e. magic string */
     {
-      _write_string (_plotter->data, PL_PLOT_MAGIC);
+      _pl_m_write_string (R___(_plotter) PL_PLOT_MAGIC);
 
-      /* format type 1 = GNU binary, type 2 = GNU portable */
+      /* format type 1 = GNU binary, type 2 = GNU portable, type 3 = GNU
+	 compact binary */
       if (_plotter->meta_portable_output)
-	_write_string (_plotter->data, " 2\n");
+	_pl_m_write_string (R___(_plotter) " 2\n");
+      else if (_plotter->meta_compact_output)
+	_pl_m_write_string (R___(_plotter) " 3\n");
       else
-	_write_string (_plotter->data, " 1\n");
+	_pl_m_write_string (R___(_plotter) " 1\n");
     }
   
+  /* record offset of page, for the page index (if any) */
+  if (_plotter->meta_page_index)
+    {
+      if (_plotter->meta_num_pages == _plotter->meta_page_offsets_len)
+	{
+	  if (_plotter->meta_page_offsets_len == 0)
+	    {
+	      _plotter->meta_page_offsets_len = 16;
+	      _plotter->meta_page_offsets = 
+		(long *)_pl_xmalloc (16 * sizeof(long));
+	    }
+	  else
+	    {
+	      _plotter->meta_page_offsets_len *= 2;
+	      _plotter->meta_page_offsets = 
+		(long *)_pl_xrealloc (_plotter->meta_page_offsets, 
+				      _plotter->meta_page_offsets_len
+				      * sizeof(long));
+	    }
+	}
+      _plotter->meta_page_offsets[_plotter->meta_num_pages++] 
+	= _plotter->meta_offset;
+    }
+
   _pl_m_emit_op_code (R___(_plotter) O_OPENPL);
   _pl_m_emit_terminator (S___(_plotter));
 
@@ -75,6 +102,10 @@ _pl_m_begin_page (S___(Plotter *_plotter))
   _plotter->meta_bgcolor.red = 65535;
   _plotter->meta_bgcolor.green = 65535;
   _plotter->meta_bgcolor.blue = 65535;
+  /* in the compact binary encoding, the first coordinates on each page
+     are relative to (0,0), so that the page can be decoded by itself */
+  _plotter->meta_prev_x = 0;
+  _plotter->meta_prev_y = 0;
 
   return true;
 }
@@ -22,12 +22,21 @@
 #include "sys-defines.h"
 #include "extern.h"
 
+/* forward references */
+static bool _path_is_mergeable (const plDrawState *drawstate);
+
 void
 _pl_m_paint_path (S___(Plotter *_plotter))
 {
   const plPath *path;
   bool explicit_endpath, sync_miter_limit = false;
 
+  if (_plotter->meta_optimize
+      && _plotter->drawstate->pen_type == 0
+      && _plotter->drawstate->fill_type == 0)
+    /* path is invisible, so omit it */
+    return;
+
   /* sync basic path attributes */
   _pl_m_set_attributes (R___(_plotter) 
 		     PL_ATTR_TRANSFORMATION_MATRIX 
@@ -47,6 +56,13 @@ _pl_m_paint_path (S___(Plotter *_plotter))
   if (sync_miter_limit)
     _pl_m_set_attributes (R___(_plotter) PL_ATTR_MITER_LIMIT);
 
+  if (_plotter->meta_optimize && _path_is_mergeable (_plotter->drawstate))
+    /* don't emit the path yet, since the next path may continue it */
+    {
+      _pl_m_hold_path (R___(_plotter) path);
+      return;
+    }
+
   if (path->type == PATH_SEGMENT_LIST)
     explicit_endpath = true;
   else
@@ -74,6 +90,12 @@ _pl_m_paint_paths (S___(Plotter *_plotter))
   if (_plotter->drawstate->num_paths == 0)
     return true;
 
+  if (_plotter->meta_optimize
+      && _plotter->drawstate->pen_type == 0
+      && _plotter->drawstate->fill_type == 0)
+    /* compound path is invisible, so omit it */
+    return true;
+
   /* sync basic path attributes */
   _pl_m_set_attributes (R___(_plotter) 
 		     PL_ATTR_TRANSFORMATION_MATRIX 
@@ -185,6 +207,30 @@ _pl_m_paint_path_internal (R___(Plotter *_plotter) const plPath *path)
 	    switch ((int)segment.type)
 	      {
 	      case (int)S_LINE:
+		if (_plotter->meta_compact_output)
+		  /* emit a run of line segments as a single polyline */
+		  {
+		    int j, run;
+
+		    for (run = 1; i + run < path->num_segments; run++)
+		      if (path->segments[i + run].type != S_LINE)
+			break;
+		    if (run > 1)
+		      {
+			_pl_m_emit_op_code (R___(_plotter) O_FPOLYLINE);
+			_pl_m_emit_integer (R___(_plotter) run);
+			for (j = i; j < i + run; j++)
+			  {
+			    _pl_m_emit_float (R___(_plotter) path->segments[j].p.x);
+			    _pl_m_emit_float (R___(_plotter) path->segments[j].p.y);
+			  }
+			_pl_m_emit_terminator (S___(_plotter));
+			i += run - 1;
+			segment = path->segments[i];
+			_plotter->meta_pos = segment.p;
+			break;
+		      }
+		  }
 		_pl_m_emit_op_code (R___(_plotter) O_FCONT);
 		_pl_m_emit_float (R___(_plotter) segment.p.x);
 		_pl_m_emit_float (R___(_plotter) segment.p.y);
@@ -294,6 +340,108 @@ _pl_m_paint_path_internal (R___(Plotter *_plotter) const plPath *path)
     }
 }
 
+/* Path merging, done if the META_OPTIMIZE parameter is "yes".  Programs
+   such as `graph' often draw a polyline as a sequence of separate paths,
+   each beginning where the last one ended; e.g., because a long polyline
+   is broken into pieces of length PL_MAX_UNFILLED_PATH_LENGTH.  So rather
+   than emitting an unfilled polyline at once, we hold it back, and if the
+   next path is a polyline that has the same attributes and begins at the
+   end of the pending one, we append it.  The only effect on the rendered
+   graphics is that a line join, rather than two line caps, will be drawn
+   at each juncture point.  Since anything else that is emitted may
+   change the attributes, _pl_m_emit_op_code() emits the pending path
+   first. */
+
+/* Is the path in the drawing state an unfilled, solid, open polyline,
+   i.e., something that can be merged with its neighbors? */
+static bool
+_path_is_mergeable (const plDrawState *drawstate)
+{
+  const plPath *path = drawstate->path;
+  plPoint p0, p1;
+  int i;
+
+  if (path->type != PATH_SEGMENT_LIST || path->num_segments < 2
+      || drawstate->pen_type == 0 || drawstate->fill_type != 0
+      || drawstate->points_are_connected == false
+      || drawstate->line_type != PL_L_SOLID 
+      || drawstate->dash_array_in_effect)
+    return false;
+
+  for (i = 1; i < path->num_segments; i++)
+    if (path->segments[i].type != S_LINE)
+      return false;
+
+  /* a closed polyline has no caps, and so can't be merged */
+  p0 = path->segments[0].p;
+  p1 = path->segments[path->num_segments - 1].p;
+  if (p0.x == p1.x && p0.y == p1.y)
+    return false;
+
+  return true;
+}
+
+/* Hold back a mergeable path, appending it to the pending path if
+   possible.  Before this is invoked, the attributes of the path will
+   have been synced; so if the pending path is still present, nothing has
+   been emitted since it was painted, and the attributes are unchanged. */
+void
+_pl_m_hold_path (R___(Plotter *_plotter) const plPath *path)
+{
+  plPath *pending = _plotter->meta_pending_path;
+  plPoint p0, p1;
+  int i;
+
+  p0 = path->segments[0].p;
+  p1 = path->segments[path->num_segments - 1].p;
+
+  if (_plotter->meta_path_is_pending
+      && pending->segments[pending->num_segments - 1].p.x == p0.x
+      && pending->segments[pending->num_segments - 1].p.y == p0.y
+      /* merging mustn't yield a closed polyline */
+      && (pending->segments[0].p.x != p1.x
+	  || pending->segments[0].p.y != p1.y))
+    {
+      for (i = 1; i < path->num_segments; i++)
+	_add_line (pending, path->segments[i].p);
+      _plotter->meta_pos = p1;
+      return;
+    }
+
+  /* can't merge, so emit pending path if any, and replace it */
+  _pl_m_emit_pending_path (S___(_plotter));
+  if (pending == (plPath *)NULL)
+    {
+      pending = _new_plPath ();
+      _plotter->meta_pending_path = pending;
+    }
+  else
+    _reset_plPath (pending);
+  _add_moveto (pending, p0);
+  for (i = 1; i < path->num_segments; i++)
+    _add_line (pending, path->segments[i].p);
+
+  /* position will be at end of pending path, by the time anything else is
+     emitted */
+  _plotter->meta_pending_pos = _plotter->meta_pos;
+  _plotter->meta_pos = p1;
+  _plotter->meta_path_is_pending = true;
+}
+
+void
+_pl_m_emit_pending_path (S___(Plotter *_plotter))
+{
+  if (_plotter->meta_path_is_pending == false)
+    return;
+
+  /* clear flag first, since we'll invoke _pl_m_emit_op_code() */
+  _plotter->meta_path_is_pending = false;
+  _plotter->meta_pos = _plotter->meta_pending_pos;
+  _pl_m_paint_path_internal (R___(_plotter) _plotter->meta_pending_path);
+  _pl_m_emit_op_code (R___(_plotter) O_ENDPATH);
+  _pl_m_emit_terminator (S___(_plotter));
+}
+
 bool
 _pl_m_path_is_flushable (S___(Plotter *_plotter))
 {
@@ -47,6 +47,8 @@ const Plotter _pl_n_default_plotter =
   _pl_g_retrieve_font,
   /* `flush output' method, called only if Plotter handles its own output */
   _pl_g_flush_output,
+  /* `update raster' method, called only if Plotter renders a bitmap */
+  _pl_b_update_raster,
   /* error handlers */
   _pl_g_warning,
   _pl_g_error,
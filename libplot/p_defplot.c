@@ -76,6 +76,8 @@ const Plotter _pl_p_default_plotter =
   _pl_g_retrieve_font,
   /* `flush output' method, called only if Plotter handles its own output */
   _pl_g_flush_output,
+  /* `update raster' method, called only if Plotter renders a bitmap */
+  _pl_g_update_raster,
   /* error handlers */
   _pl_g_warning,
   _pl_g_error,
@@ -726,8 +728,9 @@ showpage\n\n");
 
 	      /* WRITE PS CODE FOR THIS PAGE, including header, trailer */
 	      _write_string (_plotter->data, page_header->base); 
-	      if (current_page->len > 0)
-		_write_string (_plotter->data, current_page->base);
+	      if (_write_outbuf (_plotter->data, current_page) == false)
+		_plotter->error (R___(_plotter)
+				 "a page could not be read back from the spool file");
 	      _write_string (_plotter->data, page_trailer->base);
 
 	      /* free header, trailer plOutbufs */
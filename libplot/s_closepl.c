@@ -21,6 +21,7 @@
 
 /* forward references */
 static void write_svg_transform (plOutbuf *outbuf, const double m[6]);
+static void write_svg_style_sheet (plOutbuf *outbuf, const plStringTable *styles);
 
 bool
 _pl_s_end_page (S___(Plotter *_plotter))
@@ -76,6 +77,12 @@ _pl_s_end_page (S___(Plotter *_plotter))
 	   PL_LIBPLOT_VER_STRING);
   _update_buffer (svg_header);
 
+  /* in compact output, the distinct styles used on the page are CSS
+     classes, which go in a style sheet */
+  if (_plotter->s_compact && _plotter->s_styles
+      && _plotter->s_styles->num_strings > 0)
+    write_svg_style_sheet (svg_header, _plotter->s_styles);
+
   if (_plotter->s_bgcolor_suppressed == false)
   /* place a background rectangle behind, covering entire viewport */
     {
@@ -456,3 +463,40 @@ write_svg_transform (plOutbuf *outbuf, const double m[6])
   sprintf (outbuf->point, "\" ");
   _update_buffer (outbuf);
 }
+
+/* Write a <style> element that defines the CSS classes s0, s1, ...,
+   one per string in the table.  A declaration block may be longer than
+   the free space in the plOutbuf, so it is copied in pieces. */
+
+static void
+write_svg_style_sheet (plOutbuf *outbuf, const plStringTable *styles)
+{
+  int i;
+  
+  sprintf (outbuf->point, "<style type=\"text/css\"><![CDATA[\n");
+  _update_buffer (outbuf);
+  for (i = 0; i < styles->num_strings; i++)
+    {
+      const char *s = styles->strings[i];
+      size_t len = strlen (s);
+
+      sprintf (outbuf->point, ".s%d{", i);
+      _update_buffer (outbuf);
+      while (len > 0)
+	{
+	  size_t n = outbuf->len - outbuf->contents - 1;
+
+	  if (n > len)
+	    n = len;
+	  memcpy (outbuf->point, s, n);
+	  outbuf->point[n] = '\0';
+	  _update_buffer (outbuf);
+	  s += n;
+	  len -= n;
+	}
+      sprintf (outbuf->point, "}\n");
+      _update_buffer (outbuf);
+    }
+  sprintf (outbuf->point, "]]></style>\n");
+  _update_buffer (outbuf);
+}
@@ -39,7 +39,7 @@ const Plotter _pl_s_default_plotter =
   /* internal path-painting methods (endpath() is a wrapper for the first) */
   _pl_s_paint_path, _pl_s_paint_paths, _pl_g_path_is_flushable, _pl_g_maybe_prepaint_segments,
   /* internal methods for drawing of markers and points */
-  _pl_g_paint_marker, _pl_s_paint_point,
+  _pl_s_paint_marker, _pl_s_paint_point,
   /* internal methods that plot strings in Hershey, non-Hershey fonts */
   _pl_g_paint_text_string_with_escapes, _pl_s_paint_text_string,
   _pl_g_get_text_width,
@@ -47,6 +47,8 @@ const Plotter _pl_s_default_plotter =
   _pl_g_retrieve_font,
   /* `flush output' method, called only if Plotter handles its own output */
   _pl_g_flush_output,
+  /* `update raster' method, called only if Plotter renders a bitmap */
+  _pl_g_update_raster,
   /* error handlers */
   _pl_g_warning,
   _pl_g_error,
@@ -144,6 +146,45 @@ _pl_s_initialize (S___(Plotter *_plotter))
   _plotter->s_bgcolor.green = -1;
   _plotter->s_bgcolor.blue = -1;
   _plotter->s_bgcolor_suppressed = false;
+  _plotter->s_compact = false;
+  _plotter->s_precision = 5;
+  _plotter->s_scratch = (plOutbuf *)NULL;
+  _plotter->s_styles = (plStringTable *)NULL; /* created in s_begin_page */
+  _plotter->s_markers = (plStringTable *)NULL;
+  _plotter->s_in_marker_def = false;
+
+  /* initialize certain data members from device driver parameters */
+
+  /* write compact SVG? */
+  {
+    const char *compact_s;
+
+    compact_s = (const char *)_get_plot_param (_plotter->data, 
+					       "SVG_COMPACT");
+    if (strcasecmp (compact_s, "yes") == 0)
+      {
+	_plotter->s_compact = true;
+	_plotter->s_scratch = _new_outbuf ();
+      }
+    else
+      _plotter->s_compact = false; /* default value */
+  }
+
+  /* number of significant digits in compact SVG */
+  {
+    const char *precision_s;
+    int precision;
+
+    precision_s = (const char *)_get_plot_param (_plotter->data, 
+						 "SVG_PRECISION");
+    if (sscanf (precision_s, "%d", &precision) <= 0
+	|| precision < 1 || precision > 17)
+      {
+	precision_s = (const char *)_get_default_plot_param ("SVG_PRECISION");
+	sscanf (precision_s, "%d", &precision);
+      }
+    _plotter->s_precision = precision;
+  }
 
   /* Note: xmin,xmax,ymin,ymax determine the range of device coordinates
      over which the viewport will extend (and hence the transformation from
@@ -191,6 +232,18 @@ _pl_s_initialize (S___(Plotter *_plotter))
 void
 _pl_s_terminate (S___(Plotter *_plotter))
 {
+#ifndef LIBPLOTTER
+  /* in libplot, manually invoke superclass termination method */
+  _pl_g_terminate (S___(_plotter));
+#endif
+
+  /* free storage used in writing compact SVG, if any */
+  _delete_outbuf (_plotter->s_scratch);
+  _plotter->s_scratch = (plOutbuf *)NULL;
+  _delete_string_table (_plotter->s_styles);
+  _plotter->s_styles = (plStringTable *)NULL;
+  _delete_string_table (_plotter->s_markers);
+  _plotter->s_markers = (plStringTable *)NULL;
 }
 
 #ifdef LIBPLOTTER
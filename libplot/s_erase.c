@@ -41,6 +41,13 @@ _pl_s_erase_page (S___(Plotter *_plotter))
   _plotter->s_matrix[5] = 0.0;
   _plotter->s_matrix_is_unknown = true;
   _plotter->s_matrix_is_bogus = false;
+  if (_plotter->s_compact)
+    {
+      _delete_string_table (_plotter->s_styles);
+      _plotter->s_styles = _new_string_table ();
+      _delete_string_table (_plotter->s_markers);
+      _plotter->s_markers = _new_string_table ();
+    }
 
   /* update our knowledge of what SVG's background color should be (we'll
      use it when we write the SVG page header) */
@@ -0,0 +1,98 @@
+/* This file is part of the GNU plotutils package.  Copyright (C) 1995,
+   1996, 1997, 1998, 1999, 2000, 2005, 2008, Free Software Foundation, Inc.
+
+   The GNU plotutils package is free software.  You may redistribute it
+   and/or modify it under the terms of the GNU General Public License as
+   published by the Free Software foundation; either version 2, or (at your
+   option) any later version.
+
+   The GNU plotutils package is distributed in the hope that it will be
+   useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with the GNU plotutils package; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin St., Fifth Floor,
+   Boston, MA 02110-1301, USA. */
+
+/* The paint_marker method, which is an internal function that is called
+   when the marker() method is invoked.  It plots an object: a marker of a
+   specified type, at a specified size, at the current location.
+
+   If this returns `false', marker() will construct the marker from other
+   libplot primitives, in a generic way. */
+
+/* This implementation is for SVG Plotters.  In compact output (see
+   s_style.c), each distinct marker symbol on a page is drawn only once,
+   centered on the origin, as an SVG group inside a <defs> element that
+   precedes its first use.  Each marker is then written as a <use> element
+   that refers to the group.  The marker symbol itself is drawn by the
+   generic code in g_mark.c. */
+
+#include "sys-defines.h"
+#include "extern.h"
+
+bool
+_pl_s_paint_marker (R___(Plotter *_plotter) int type, double size)
+{
+  char key[128], xbuf[32], ybuf[32];
+  plPoint pos;
+  bool is_new;
+  int i, index;
+
+  if (_plotter->s_compact == false || _plotter->s_in_marker_def)
+    return false;
+
+  /* only marker symbols (not characters in the current font) are shared */
+  if (type <= 0 || type > 31)
+    return false;
+
+  /* the marker's definition is drawn in the page's default coordinate
+     frame, so the current user->NDC map must agree with it */
+  if (_plotter->s_matrix_is_unknown)
+    {
+      const double *m = _plotter->drawstate->transform.m_user_to_ndc;
+
+      if (m[0] * m[3] - m[1] * m[2] == 0.0)
+	/* singular, so will be bogus */
+	return false;
+    }
+  else
+    {
+      if (_plotter->s_matrix_is_bogus)
+	return false;
+      for (i = 0; i < 6; i++)
+	if (_plotter->drawstate->transform.m_user_to_ndc[i] 
+	    != _plotter->s_matrix[i])
+	  return false;
+    }
+
+  sprintf (key, "%d %.17g %d %d %d", type, size,
+	   _plotter->drawstate->fgcolor.red, 
+	   _plotter->drawstate->fgcolor.green,
+	   _plotter->drawstate->fgcolor.blue);
+  index = _string_table_intern (_plotter->s_markers, key, &is_new);
+
+  pos = _plotter->drawstate->pos;
+  if (is_new)
+    /* define the marker symbol, by drawing it at the origin */
+    {
+      sprintf (_plotter->data->page->point, "<defs><g id=\"m%d\">\n", index);
+      _update_buffer (_plotter->data->page);
+      _plotter->s_in_marker_def = true;
+      _API_fmarker (R___(_plotter) 0.0, 0.0, type, size);
+      _plotter->s_in_marker_def = false;
+      sprintf (_plotter->data->page->point, "</g></defs>\n");
+      _update_buffer (_plotter->data->page);
+      _plotter->drawstate->pos = pos;
+    }
+
+  _svg_format_number (xbuf, pos.x, _plotter->s_precision, true);
+  _svg_format_number (ybuf, pos.y, _plotter->s_precision, true);
+  sprintf (_plotter->data->page->point, 
+	   "<use xlink:href=\"#m%d\" x=\"%s\" y=\"%s\"/>\n", index, xbuf, ybuf);
+  _update_buffer (_plotter->data->page);
+
+  return true;
+}
@@ -37,5 +37,15 @@ _pl_s_begin_page (S___(Plotter *_plotter))
   _plotter->s_bgcolor = _plotter->drawstate->bgcolor;
   _plotter->s_bgcolor_suppressed = _plotter->drawstate->bgcolor_suppressed;
 
+  /* in compact output, keep track of the distinct styles and marker
+     symbols on the page (they're written out by s_end_page) */
+  if (_plotter->s_compact)
+    {
+      _delete_string_table (_plotter->s_styles);
+      _plotter->s_styles = _new_string_table ();
+      _delete_string_table (_plotter->s_markers);
+      _plotter->s_markers = _new_string_table ();
+    }
+
   return true;
 }
@@ -22,7 +22,12 @@
 
 /* This version of paint_path() is for SVGPlotters.  It renders a libplot
    path in terms of SVG shapes:
-   path/rect/circle/ellipse/line/polyline/polygon. */
+   path/rect/circle/ellipse/line/polyline/polygon.
+
+   In compact output (see s_style.c), every segment-list path is written
+   as an SVG path, and each path data command is written in absolute or
+   relative form, whichever is shorter.  Redundant command letters and
+   separators are omitted. */
 
 #include "sys-defines.h"
 #include "extern.h"
@@ -44,13 +49,59 @@ static const char * const svg_fill_style[PL_NUM_FILL_RULES] =
 
 static const double identity_matrix[6] = { 1.0, 0.0, 0.0, 1.0, 0.0, 0.0 };
 
+/* state of the writer of compact SVG path data */
+typedef struct
+{
+  plOutbuf *page;
+  int precision;		/* number of significant digits */
+  char implied_command;		/* command implied if letter is omitted */
+  plPoint pos;			/* current point, as it will be parsed */
+  plPoint start;		/* start of current subpath, ditto */
+} svg_path_writer;
+
+/* kinds of argument of an SVG path data command */
+#define SVG_ARG_X 0		/* x coordinate, may be relative */
+#define SVG_ARG_Y 1		/* y coordinate, may be relative */
+#define SVG_ARG_LENGTH 2	/* radius or angle, never relative */
+#define SVG_ARG_FLAG 3		/* 0 or 1 */
+
+#define SVG_MAX_ARGS 7
+
 /* forward references */
 static void write_svg_path_data (plOutbuf *page, const plPath *path);
 static void write_svg_path_style (plOutbuf *page, const plDrawState *drawstate, bool need_cap, bool need_join);
+static void write_svg_number_attribute (plOutbuf *page, const char *name, double x, int precision, bool compact);
+static void svg_ellarc_parameters (plPoint p0, plPoint p1, plPoint pc, double *rx, double *ry, double *theta, bool *clockwise);
+static void begin_svg_path_data (svg_path_writer *writer, plOutbuf *page, int precision);
+static void write_svg_path_data_compact (svg_path_writer *writer, const plPath *path);
+static void write_svg_path_command (svg_path_writer *writer, char command, int num_args, const double *args, const int *kinds);
+static void format_svg_path_args (const svg_path_writer *writer, int num_args, const double *args, const int *kinds, char *abs_buf, int *abs_len, plPoint *abs_end, char *rel_buf, int *rel_len, plPoint *rel_end);
+static int format_svg_relative_number (char *buf, const char *abs_number, double origin, int precision);
+
+/* Write the style attributes of the current SVG object.  In compact
+   output, they're replaced by a reference to a CSS class. */
+#define WRITE_SVG_PATH_STYLE(need_cap, need_join) \
+do { \
+  if (_plotter->s_compact) \
+    { \
+      _reset_outbuf (_plotter->s_scratch); \
+      write_svg_path_style (_plotter->s_scratch, _plotter->drawstate, \
+			    (need_cap), (need_join)); \
+      _pl_s_write_style_class (R___(_plotter) _plotter->s_scratch->base); \
+    } \
+  else \
+    write_svg_path_style (_plotter->data->page, _plotter->drawstate, \
+			  (need_cap), (need_join)); \
+} while (0)
 
 void
 _pl_s_paint_path (S___(Plotter *_plotter))
 {
+  int precision;
+
+  /* non-compact output always uses 5 significant digits */
+  precision = _plotter->s_compact ? _plotter->s_precision : 5;
+
   switch ((int)_plotter->drawstate->path->type)
     {
     case (int)PATH_SEGMENT_LIST:
@@ -86,6 +137,10 @@ _pl_s_paint_path (S___(Plotter *_plotter))
 		break;
 	      }
 	  }
+
+	/* in compact output, relative path data beats a list of points */
+	if (_plotter->s_compact)
+	  lines_only = false;
 	
 	if (lines_only && _plotter->drawstate->path->num_segments == 2)
 	  /* SVG line */
@@ -103,8 +158,7 @@ _pl_s_paint_path (S___(Plotter *_plotter))
 		     _plotter->drawstate->path->segments[1].p.y);
 	    _update_buffer (_plotter->data->page);
 
-	    write_svg_path_style (_plotter->data->page, _plotter->drawstate, 
-				   true, false);
+	    WRITE_SVG_PATH_STYLE (true, false);
 
 	    sprintf (_plotter->data->page->point, "/>\n");
 	    _update_buffer (_plotter->data->page);
@@ -135,8 +189,7 @@ _pl_s_paint_path (S___(Plotter *_plotter))
 		     "\" ");
 	    _update_buffer (_plotter->data->page);
 
-	    write_svg_path_style (_plotter->data->page, _plotter->drawstate,
-				   true, true);
+	    WRITE_SVG_PATH_STYLE (true, true);
 
 	    sprintf (_plotter->data->page->point,
 		     "/>\n");
@@ -168,8 +221,7 @@ _pl_s_paint_path (S___(Plotter *_plotter))
 		     "\" ");
 	    _update_buffer (_plotter->data->page);
 
-	    write_svg_path_style (_plotter->data->page, _plotter->drawstate,
-				   false, true);
+	    WRITE_SVG_PATH_STYLE (false, true);
 
 	    sprintf (_plotter->data->page->point,
 		     "/>\n");
@@ -189,15 +241,24 @@ _pl_s_paint_path (S___(Plotter *_plotter))
 	    _update_buffer (_plotter->data->page);
 	    
 	    /* write SVG path data string */
-	    write_svg_path_data (_plotter->data->page, 
-				  _plotter->drawstate->path);
+	    if (_plotter->s_compact)
+	      {
+		svg_path_writer writer;
+
+		begin_svg_path_data (&writer, _plotter->data->page, 
+				     _plotter->s_precision);
+		write_svg_path_data_compact (&writer, 
+					     _plotter->drawstate->path);
+	      }
+	    else
+	      write_svg_path_data (_plotter->data->page, 
+				   _plotter->drawstate->path);
 
 	    sprintf (_plotter->data->page->point,
 		     "\" ");
 	    _update_buffer (_plotter->data->page);
 
-	    write_svg_path_style (_plotter->data->page, _plotter->drawstate,
-				   true, true);
+	    WRITE_SVG_PATH_STYLE (true, true);
 
 	    sprintf (_plotter->data->page->point,
 		     "/>\n");
@@ -223,13 +284,16 @@ _pl_s_paint_path (S___(Plotter *_plotter))
 
 	_pl_s_set_matrix (R___(_plotter) identity_matrix); 
 
-	sprintf (_plotter->data->page->point,
-		 "x=\"%.5g\" y=\"%.5g\" width=\"%.5g\" height=\"%.5g\" ",
-		 xmin, ymin, xmax - xmin, ymax - ymin);
-	_update_buffer (_plotter->data->page);
+	write_svg_number_attribute (_plotter->data->page, "x", xmin, 
+				    precision, _plotter->s_compact);
+	write_svg_number_attribute (_plotter->data->page, "y", ymin, 
+				    precision, _plotter->s_compact);
+	write_svg_number_attribute (_plotter->data->page, "width", xmax - xmin,
+				    precision, _plotter->s_compact);
+	write_svg_number_attribute (_plotter->data->page, "height", ymax - ymin,
+				    precision, _plotter->s_compact);
 
-	write_svg_path_style (_plotter->data->page, _plotter->drawstate, 
-			       false, true);
+	WRITE_SVG_PATH_STYLE (false, true);
 	sprintf (_plotter->data->page->point,
 		 "/>\n");
 	_update_buffer (_plotter->data->page);
@@ -247,13 +311,14 @@ _pl_s_paint_path (S___(Plotter *_plotter))
 	_pl_s_set_matrix (R___(_plotter) identity_matrix); 
 
 	pc = _plotter->drawstate->path->pc;
-	sprintf (_plotter->data->page->point,
-		 "cx=\"%.5g\" cy=\"%.5g\" r=\"%.5g\" ",
-		 pc.x, pc.y, radius);
-	_update_buffer (_plotter->data->page);
+	write_svg_number_attribute (_plotter->data->page, "cx", pc.x, 
+				    precision, _plotter->s_compact);
+	write_svg_number_attribute (_plotter->data->page, "cy", pc.y, 
+				    precision, _plotter->s_compact);
+	write_svg_number_attribute (_plotter->data->page, "r", radius, 
+				    precision, _plotter->s_compact);
 
-	write_svg_path_style (_plotter->data->page, _plotter->drawstate, 
-			       false, false);
+	WRITE_SVG_PATH_STYLE (false, false);
 
 	sprintf (_plotter->data->page->point,
 		 "/>\n");
@@ -281,12 +346,12 @@ _pl_s_paint_path (S___(Plotter *_plotter))
 	local_matrix[5] = pc.y;
 	_pl_s_set_matrix (R___(_plotter) local_matrix);
 
-	sprintf (_plotter->data->page->point, "rx=\"%.5g\" ry=\"%.5g\" ",
-		 rx, ry);
-	_update_buffer (_plotter->data->page);
+	write_svg_number_attribute (_plotter->data->page, "rx", rx, 
+				    precision, _plotter->s_compact);
+	write_svg_number_attribute (_plotter->data->page, "ry", ry, 
+				    precision, _plotter->s_compact);
 
-	write_svg_path_style (_plotter->data->page, _plotter->drawstate, 
-			       false, false);
+	WRITE_SVG_PATH_STYLE (false, false);
 
 	sprintf (_plotter->data->page->point, "/>\n");
 	_update_buffer (_plotter->data->page);
@@ -301,6 +366,7 @@ _pl_s_paint_path (S___(Plotter *_plotter))
 bool
 _pl_s_paint_paths (S___(Plotter *_plotter))
 {
+  svg_path_writer writer;
   int i;
 
   sprintf (_plotter->data->page->point,
@@ -313,10 +379,20 @@ _pl_s_paint_paths (S___(Plotter *_plotter))
 	   "d=\"");
   _update_buffer (_plotter->data->page);
   
+  if (_plotter->s_compact)
+    begin_svg_path_data (&writer, _plotter->data->page, 
+			 _plotter->s_precision);
+
   for (i = 0; i < _plotter->drawstate->num_paths; i++)
     {
       plPath *path = _plotter->drawstate->paths[i];
 
+      if (_plotter->s_compact)
+	{
+	  write_svg_path_data_compact (&writer, path);
+	  continue;
+	}
+
       switch ((int)path->type)
 	{
 	case (int)PATH_SEGMENT_LIST:
@@ -445,8 +521,7 @@ A%.5g,%.5g,%.5g,%d,%d,%.5g,%.5g Z ",
 	   "\" ");
   _update_buffer (_plotter->data->page);
 
-  write_svg_path_style (_plotter->data->page, _plotter->drawstate, 
-			 true, true);
+  WRITE_SVG_PATH_STYLE (true, true);
 
   sprintf (_plotter->data->page->point,
 	   "/>\n");
@@ -533,51 +608,14 @@ write_svg_path_data (plOutbuf *page, const plPath *path)
 	  
 	case (int)S_ELLARC:
 	  {
-	    double cross, mixing_angle, rx, ry, theta;
-	    plVector u, v, semi_axis_1, semi_axis_2;
+	    double rx, ry, theta;
 	    bool clockwise;
 
-	    /* conjugate radial vectors for the quarter-ellipse */
-	    u.x = oldpoint.x - pc.x;
-	    u.y = oldpoint.y - pc.y;
-	    v.x = p.x - pc.x;
-	    v.y = p.y - pc.y;
-	    cross = u.x * v.y - v.x * u.y;
-	    clockwise = cross < 0.0 ? true : false;
-
-	    /* angle by which they should be mixed, to yield vectors along
-	       the major and minor axes */
-	    mixing_angle = 0.5 * _xatan2 (2.0 * (u.x * v.x + u.y * v.y),
-					  u.x * u.x + u.y * u.y 
-					  - v.x * v.x + v.y * v.y);
-  
-	    /* semi-axis vectors */
-	    semi_axis_1.x = u.x * cos(mixing_angle) + v.x * sin(mixing_angle);
-	    semi_axis_1.y = u.y * cos(mixing_angle) + v.y * sin(mixing_angle);
-	    semi_axis_2.x = (u.x * cos(mixing_angle + M_PI_2) 
-			     + v.x * sin(mixing_angle + M_PI_2));
-	    semi_axis_2.y = (u.y * cos(mixing_angle + M_PI_2) 
-			     + v.y * sin(mixing_angle + M_PI_2));
-	    
-	    /* semi-axis lengths */
-	    rx = sqrt (semi_axis_1.x * semi_axis_1.x
-		       + semi_axis_1.y * semi_axis_1.y);
-	    ry = sqrt (semi_axis_2.x * semi_axis_2.x
-		       + semi_axis_2.y * semi_axis_2.y);
-	    
-	    /* angle of inclination of first semi-axis */
-	    theta = _xatan2 (semi_axis_1.y, semi_axis_1.x);
-
-  /* compensate for possible roundoff error: treat a very small inclination
-     angle of the 1st semi-axis, relative to the x-axis, as zero */
-#define VERY_SMALL_ANGLE 1e-10
-  
-	    if (theta < VERY_SMALL_ANGLE && theta > -(VERY_SMALL_ANGLE))
-	      theta = 0.0;
-
+	    svg_ellarc_parameters (oldpoint, p, pc, &rx, &ry, &theta, 
+				   &clockwise);
 	    sprintf (page->point, "A%.5g,%.5g,%.5g,%d,%d,%.5g,%.5g ",
 		     rx, ry, 
-		     theta * 180.0 / M_PI, /* rotation of x-axis of ellipse */
+		     theta,	/* rotation of x-axis of ellipse */
 		     0, /* large-arc-flag, 0/1 = small/large */
 		     clockwise ? 0 : 1,	/* sweep-flag, 0/1 = clock/c'clock */
 		     p.x, p.y);
@@ -759,3 +797,528 @@ write_svg_path_style (plOutbuf *page, const plDrawState *drawstate, bool need_ca
 	}
     }
 }
+
+/* Write an attribute whose value is a number, such as a coordinate or a
+   length. */
+
+static void
+write_svg_number_attribute (plOutbuf *page, const char *name, double x, int precision, bool compact)
+{
+  char buf[32];
+
+  _svg_format_number (buf, x, precision, compact);
+  sprintf (page->point, "%s=\"%s\" ", name, buf);
+  _update_buffer (page);
+}
+
+/* Compute the parameters of an SVG elliptic arc command that draws a
+   quarter-ellipse, from p0 to p1, with center pc.  The inclination of the
+   first semi-axis, theta, is returned in degrees. */
+
+static void
+svg_ellarc_parameters (plPoint p0, plPoint p1, plPoint pc, double *rx, double *ry, double *theta, bool *clockwise)
+{
+  double cross, mixing_angle, angle;
+  plVector u, v, semi_axis_1, semi_axis_2;
+
+  /* conjugate radial vectors for the quarter-ellipse */
+  u.x = p0.x - pc.x;
+  u.y = p0.y - pc.y;
+  v.x = p1.x - pc.x;
+  v.y = p1.y - pc.y;
+  cross = u.x * v.y - v.x * u.y;
+  *clockwise = cross < 0.0 ? true : false;
+
+  /* angle by which they should be mixed, to yield vectors along the major
+     and minor axes */
+  mixing_angle = 0.5 * _xatan2 (2.0 * (u.x * v.x + u.y * v.y),
+				u.x * u.x + u.y * u.y 
+				- v.x * v.x + v.y * v.y);
+  
+  /* semi-axis vectors */
+  semi_axis_1.x = u.x * cos(mixing_angle) + v.x * sin(mixing_angle);
+  semi_axis_1.y = u.y * cos(mixing_angle) + v.y * sin(mixing_angle);
+  semi_axis_2.x = (u.x * cos(mixing_angle + M_PI_2) 
+		   + v.x * sin(mixing_angle + M_PI_2));
+  semi_axis_2.y = (u.y * cos(mixing_angle + M_PI_2) 
+		   + v.y * sin(mixing_angle + M_PI_2));
+	    
+  /* semi-axis lengths */
+  *rx = sqrt (semi_axis_1.x * semi_axis_1.x
+	      + semi_axis_1.y * semi_axis_1.y);
+  *ry = sqrt (semi_axis_2.x * semi_axis_2.x
+	      + semi_axis_2.y * semi_axis_2.y);
+	    
+  /* angle of inclination of first semi-axis */
+  angle = _xatan2 (semi_axis_1.y, semi_axis_1.x);
+
+  /* compensate for possible roundoff error: treat a very small inclination
+     angle of the 1st semi-axis, relative to the x-axis, as zero */
+#define VERY_SMALL_ANGLE 1e-10
+  
+  if (angle < VERY_SMALL_ANGLE && angle > -(VERY_SMALL_ANGLE))
+    angle = 0.0;
+
+  *theta = angle * 180.0 / M_PI;
+}
+
+/* Prepare to write a compact SVG path data string, which may contain any
+   number of simple paths. */
+
+static void
+begin_svg_path_data (svg_path_writer *writer, plOutbuf *page, int precision)
+{
+  writer->page = page;
+  writer->precision = precision;
+  writer->implied_command = '\0'; /* none yet */
+  writer->pos.x = 0.0;
+  writer->pos.y = 0.0;
+  writer->start = writer->pos;
+}
+
+/* Write compact SVG path data for a single simple path, which may be a
+   segment list or a closed primitive (box/circle/ellipse).  The commands
+   are the same as those written by write_svg_path_data() and
+   _pl_s_paint_paths() in non-compact output. */
+
+static void
+write_svg_path_data_compact (svg_path_writer *writer, const plPath *path)
+{
+  static const int kinds_xy[6] = 
+  { SVG_ARG_X, SVG_ARG_Y, SVG_ARG_X, SVG_ARG_Y, SVG_ARG_X, SVG_ARG_Y };
+  static const int kinds_x[1] = { SVG_ARG_X };
+  static const int kinds_y[1] = { SVG_ARG_Y };
+  static const int kinds_arc[7] = 
+  { SVG_ARG_LENGTH, SVG_ARG_LENGTH, SVG_ARG_LENGTH, 
+    SVG_ARG_FLAG, SVG_ARG_FLAG, SVG_ARG_X, SVG_ARG_Y };
+  double args[SVG_MAX_ARGS];
+  bool closed = false;
+
+  switch ((int)path->type)
+    {
+    case (int)PATH_SEGMENT_LIST:
+      {
+	plPoint p, pc, pd, oldpoint;
+	int i;
+
+	if ((path->num_segments >= 3)	/* check for closure */
+	    && (path->segments[path->num_segments - 1].p.x == path->segments[0].p.x)
+	    && (path->segments[path->num_segments - 1].p.y == path->segments[0].p.y))
+	  closed = true;
+
+	p = path->segments[0].p; /* initial seg should be a moveto */
+	args[0] = p.x;
+	args[1] = p.y;
+	write_svg_path_command (writer, 'M', 2, args, kinds_xy);
+
+	oldpoint = p;
+	for (i = 1; i < path->num_segments; i++)
+	  {
+	    plPathSegmentType type;
+
+	    type = path->segments[i].type;
+	    p = path->segments[i].p;
+	    pc = path->segments[i].pc;
+	    pd = path->segments[i].pd;
+
+	    if (closed
+		&& i == path->num_segments - 1
+		&& type == S_LINE)
+	      continue;	/* i.e. don't end with line-as-closepath */
+      
+	    switch ((int)type)
+	      {
+	      case (int)S_LINE:
+		if (p.y == oldpoint.y)
+		  {
+		    args[0] = p.x;
+		    write_svg_path_command (writer, 'H', 1, args, kinds_x);
+		  }
+		else if (p.x == oldpoint.x)
+		  {
+		    args[0] = p.y;
+		    write_svg_path_command (writer, 'V', 1, args, kinds_y);
+		  }
+		else
+		  {
+		    args[0] = p.x;
+		    args[1] = p.y;
+		    write_svg_path_command (writer, 'L', 2, args, kinds_xy);
+		  }
+		break;
+
+	      case (int)S_ARC:
+		{
+		  double angle;
+
+		  /* compute angle in radians, range -pi..pi */
+		  angle = _angle_of_arc (oldpoint, p, pc);
+		  args[0] = sqrt ((p.x - pc.x)*(p.x - pc.x)
+				  + (p.y - pc.y)*(p.y - pc.y));
+		  args[1] = args[0];
+		  args[2] = 0.0;
+		  args[3] = 0.0;
+		  args[4] = (angle >= 0.0 ? 1.0 : 0.0);
+		  args[5] = p.x;
+		  args[6] = p.y;
+		  write_svg_path_command (writer, 'A', 7, args, kinds_arc);
+		}
+		break;
+
+	      case (int)S_ELLARC:
+		{
+		  bool clockwise;
+
+		  svg_ellarc_parameters (oldpoint, p, pc, 
+					 &args[0], &args[1], &args[2], 
+					 &clockwise);
+		  args[3] = 0.0;
+		  args[4] = (clockwise ? 0.0 : 1.0);
+		  args[5] = p.x;
+		  args[6] = p.y;
+		  write_svg_path_command (writer, 'A', 7, args, kinds_arc);
+		}
+		break;
+
+	      case (int)S_QUAD:
+		args[0] = pc.x;
+		args[1] = pc.y;
+		args[2] = p.x;
+		args[3] = p.y;
+		write_svg_path_command (writer, 'Q', 4, args, kinds_xy);
+		break;
+	  
+	      case (int)S_CUBIC:
+		args[0] = pc.x;
+		args[1] = pc.y;
+		args[2] = pd.x;
+		args[3] = pd.y;
+		args[4] = p.x;
+		args[5] = p.y;
+		write_svg_path_command (writer, 'C', 6, args, kinds_xy);
+		break;
+	  
+	      default:	/* shouldn't happen */
+		break;
+	      }
+	    oldpoint = p;
+	  }
+      }
+      break;
+
+    case (int)PATH_CIRCLE:
+    case (int)PATH_ELLIPSE:
+      /* draw as four quarter-ellipses */
+      {
+	plPoint pc;
+	plVector v1, v2;
+	double sweep;
+	int i;
+
+	pc = path->pc;
+	if (path->type == PATH_CIRCLE)
+	  {
+	    v1.x = path->radius;
+	    v1.y = 0.0;
+	    v2.x = 0.0;
+	    v2.y = path->radius;
+	    args[0] = path->radius;
+	    args[1] = path->radius;
+	  }
+	else
+	  {
+	    double angle = path->angle;
+
+	    v1.x = path->rx * cos (M_PI * angle / 180.0);
+	    v1.y = path->rx * sin (M_PI * angle / 180.0);
+	    v2.x = -path->ry * sin (M_PI * angle / 180.0);
+	    v2.y = path->ry * cos (M_PI * angle / 180.0);
+	    args[0] = path->rx;
+	    args[1] = path->ry;
+	  }
+	if (path->clockwise)
+	  {
+	    v2.x = -v2.x;
+	    v2.y = -v2.y;
+	    sweep = 0.0;
+	  }
+	else
+	  sweep = 1.0;
+
+	args[5] = pc.x + v1.x;
+	args[6] = pc.y + v1.y;
+	write_svg_path_command (writer, 'M', 2, args + 5, kinds_xy);
+	args[2] = 0.0;
+	args[3] = 0.0;
+	args[4] = sweep;
+	for (i = 0; i < 4; i++)
+	  {
+	    plVector v;
+
+	    /* successive ends of quarter-ellipses: v2, -v1, -v2, v1 */
+	    v = (i % 2 == 0 ? v2 : v1);
+	    if (i == 1 || i == 2)
+	      {
+		v.x = -v.x;
+		v.y = -v.y;
+	      }
+	    args[5] = pc.x + v.x;
+	    args[6] = pc.y + v.y;
+	    write_svg_path_command (writer, 'A', 7, args, kinds_arc);
+	  }
+	closed = true;
+      }
+      break;
+
+    case (int)PATH_BOX:
+      {
+	plPoint p0, p1;
+	bool x_move_is_first;
+	    
+	p0 = path->p0;
+	p1 = path->p1;
+
+	/* if counterclockwise, would first pen motion be in x direction? */
+	x_move_is_first = ((p1.x >= p0.x && p1.y >= p0.y)
+			   || (p1.x < p0.x && p1.y < p0.y) ? true : false);
+	if (path->clockwise)
+	  /* take complement */
+	  x_move_is_first = (x_move_is_first == true ? false : true);
+
+	args[0] = p0.x;
+	args[1] = p0.y;
+	write_svg_path_command (writer, 'M', 2, args, kinds_xy);
+	if (x_move_is_first)
+	  {
+	    write_svg_path_command (writer, 'H', 1, &p1.x, kinds_x);
+	    write_svg_path_command (writer, 'V', 1, &p1.y, kinds_y);
+	    write_svg_path_command (writer, 'H', 1, &p0.x, kinds_x);
+	  }
+	else
+	  {
+	    write_svg_path_command (writer, 'V', 1, &p1.y, kinds_y);
+	    write_svg_path_command (writer, 'H', 1, &p1.x, kinds_x);
+	    write_svg_path_command (writer, 'V', 1, &p0.y, kinds_y);
+	  }
+	closed = true;
+      }
+      break;
+
+    default:			/* shouldn't happen */
+      break;
+    }
+
+  if (closed)
+    {
+      sprintf (writer->page->point, "z");
+      _update_buffer (writer->page);
+      writer->implied_command = '\0';
+      writer->pos = writer->start;
+    }
+}
+
+/* Write a single SVG path data command, specified by its (upper-case)
+   absolute form, in whichever of its absolute and relative forms is
+   shorter.  The command letter is omitted if SVG would imply it. */
+
+static void
+write_svg_path_command (svg_path_writer *writer, char command, int num_args, const double *args, const int *kinds)
+{
+  char abs_buf[SVG_MAX_ARGS * 64], rel_buf[SVG_MAX_ARGS * 64];
+  char abs_command, rel_command;
+  int abs_len, rel_len;
+  plPoint abs_end, rel_end;
+  const char *buf;
+  char letter;
+  plPoint end;
+
+  abs_command = command;
+  rel_command = command - 'A' + 'a';
+
+  format_svg_path_args (writer, num_args, args, kinds, 
+			abs_buf, &abs_len, &abs_end, rel_buf, &rel_len, &rel_end);
+
+  /* cost of command letter, or of separator if letter is omitted */
+  abs_len += (writer->implied_command == abs_command
+	      ? (abs_buf[0] == '-' ? 0 : 1) : 1);
+  rel_len += (writer->implied_command == rel_command
+	      ? (rel_buf[0] == '-' ? 0 : 1) : 1);
+
+  if (rel_len < abs_len)
+    {
+      letter = rel_command;
+      buf = rel_buf;
+      end = rel_end;
+    }
+  else
+    {
+      letter = abs_command;
+      buf = abs_buf;
+      end = abs_end;
+    }
+
+  if (writer->implied_command != letter)
+    sprintf (writer->page->point, "%c%s", letter, buf);
+  else if (buf[0] == '-')
+    sprintf (writer->page->point, "%s", buf);
+  else
+    sprintf (writer->page->point, " %s", buf);
+  _update_buffer (writer->page);
+
+  writer->pos = end;
+  if (command == 'M')
+    {
+      writer->start = end;
+      /* a moveto followed by coordinate pairs implies a lineto */
+      letter = (letter == 'M' ? 'L' : 'l');
+    }
+  writer->implied_command = letter;
+}
+
+/* Format the arguments of an SVG path data command, in both absolute and
+   relative form, and return the lengths of the results.  The endpoint of
+   the command, as a parser would compute it from each, is also returned. */
+
+static void
+format_svg_path_args (const svg_path_writer *writer, int num_args, const double *args, const int *kinds, char *abs_buf, int *abs_len, plPoint *abs_end, char *rel_buf, int *rel_len, plPoint *rel_end)
+{
+  char *p = abs_buf, *q = rel_buf;
+  int i;
+
+  *abs_end = writer->pos;
+  *rel_end = writer->pos;
+  for (i = 0; i < num_args; i++)
+    {
+      char abs_number[32], rel_number[64];
+      double origin, value;
+      int len, rel_number_len;
+
+      switch (kinds[i])
+	{
+	case SVG_ARG_X:
+	case SVG_ARG_Y:
+	  origin = (kinds[i] == SVG_ARG_X ? writer->pos.x : writer->pos.y);
+	  len = _svg_format_number (abs_number, args[i], 
+				    writer->precision, true);
+	  rel_number_len = 
+	    format_svg_relative_number (rel_number, abs_number, origin, 
+					writer->precision);
+	  value = strtod (abs_number, (char **)NULL);
+	  if (kinds[i] == SVG_ARG_X)
+	    {
+	      abs_end->x = value;
+	      rel_end->x = origin + strtod (rel_number, (char **)NULL);
+	    }
+	  else
+	    {
+	      abs_end->y = value;
+	      rel_end->y = origin + strtod (rel_number, (char **)NULL);
+	    }
+	  break;
+	case SVG_ARG_LENGTH:
+	default:
+	  len = _svg_format_number (abs_number, args[i], 
+				    writer->precision, true);
+	  strcpy (rel_number, abs_number);
+	  rel_number_len = len;
+	  break;
+	case SVG_ARG_FLAG:
+	  len = sprintf (abs_number, "%d", args[i] != 0.0 ? 1 : 0);
+	  strcpy (rel_number, abs_number);
+	  rel_number_len = len;
+	  break;
+	}
+
+      /* a separator is needed between numbers, unless a sign intervenes */
+      if (i > 0 && abs_number[0] != '-')
+	*p++ = ' ';
+      memcpy (p, abs_number, (size_t)(len + 1));
+      p += len;
+      if (i > 0 && rel_number[0] != '-')
+	*q++ = ' ';
+      memcpy (q, rel_number, (size_t)(rel_number_len + 1));
+      q += rel_number_len;
+    }
+
+  *abs_len = (int)(p - abs_buf);
+  *rel_len = (int)(q - rel_buf);
+}
+
+/* Format a coordinate relative to an origin, given the coordinate's
+   absolute form, and return the length of the result (the buffer should
+   have room for 64 characters).  The difference is written with as many
+   decimal places as the absolute form, so relative coordinates are no
+   less accurate than absolute ones, and are usually shorter.  Since the
+   origin is the current point as a parser would compute it, rounding
+   errors don't accumulate along a path. */
+
+static int
+format_svg_relative_number (char *buf, const char *abs_number, double origin, int precision)
+{
+  const char *p;
+  double value, delta;
+  int decimals, exponent, len;
+
+  value = strtod (abs_number, (char **)NULL);
+  delta = value - origin;
+  if (strchr (abs_number, 'e') != NULL || FABS(delta) >= 1e15)
+    /* absolute form is in exponential notation (or delta is huge) */
+    return _svg_format_number (buf, delta, 17, true);
+
+  /* the absolute form had precision - 1 - exponent decimal places, before
+     trailing zeroes were removed (cf. the definition of %g); find the
+     exponent, i.e., the position of its leading digit */
+  p = abs_number;
+  if (*p == '-')
+    p++;
+  while (*p == '0')
+    p++;
+  if (*p == '.')
+    {
+      exponent = -1;
+      for (p++; *p == '0'; p++)
+	exponent--;
+      if (*p == '\0')		/* number is zero */
+	exponent = 0;
+    }
+  else
+    {
+      exponent = -1;
+      for (; *p >= '0' && *p <= '9'; p++)
+	exponent++;
+      if (exponent < 0)		/* number is zero */
+	exponent = 0;
+    }
+  decimals = precision - 1 - exponent;
+  if (decimals < 0)
+    decimals = 0;
+  len = sprintf (buf, "%.*f", decimals, delta);
+
+  /* remove trailing zeroes, and a trailing decimal point */
+  if (decimals > 0)
+    {
+      while (buf[len - 1] == '0')
+	buf[--len] = '\0';
+      if (buf[len - 1] == '.')
+	buf[--len] = '\0';
+    }
+
+  /* remove a leading zero, and the sign of a zero */
+  if (buf[0] == '0' && buf[1] == '.')
+    {
+      memmove (buf, buf + 1, (size_t)len);
+      len--;
+    }
+  else if (buf[0] == '-' && buf[1] == '0' && buf[2] == '.')
+    {
+      memmove (buf + 1, buf + 2, (size_t)(len - 1));
+      len--;
+    }
+  else if (strcmp (buf, "-0") == 0)
+    {
+      strcpy (buf, "0");
+      len = 1;
+    }
+
+  return len;
+}
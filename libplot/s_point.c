@@ -37,14 +37,35 @@ _pl_s_paint_point (S___(Plotter *_plotter))
 
   _pl_s_set_matrix (R___(_plotter) identity_matrix); 
 
-  sprintf (_plotter->data->page->point,
-	   "cx=\"%.5g\" cy=\"%.5g\" r=\"%s\" ",
-	   _plotter->drawstate->pos.x,
-	   _plotter->drawstate->pos.y,
-	   "0.5px");		/* diameter = 1 pixel */
-  _update_buffer (_plotter->data->page);
+  if (_plotter->s_compact)
+    /* write numbers in shortest form, and style as a CSS class */
+    {
+      char xbuf[32], ybuf[32];
+
+      _svg_format_number (xbuf, _plotter->drawstate->pos.x, 
+			  _plotter->s_precision, true);
+      _svg_format_number (ybuf, _plotter->drawstate->pos.y, 
+			  _plotter->s_precision, true);
+      sprintf (_plotter->data->page->point,
+	       "cx=\"%s\" cy=\"%s\" r=\"%s\" ",
+	       xbuf, ybuf, "0.5px");
+      _update_buffer (_plotter->data->page);
+
+      _reset_outbuf (_plotter->s_scratch);
+      write_svg_point_style (_plotter->s_scratch, _plotter->drawstate);
+      _pl_s_write_style_class (R___(_plotter) _plotter->s_scratch->base);
+    }
+  else
+    {
+      sprintf (_plotter->data->page->point,
+	       "cx=\"%.5g\" cy=\"%.5g\" r=\"%s\" ",
+	       _plotter->drawstate->pos.x,
+	       _plotter->drawstate->pos.y,
+	       "0.5px");		/* diameter = 1 pixel */
+      _update_buffer (_plotter->data->page);
   
-  write_svg_point_style (_plotter->data->page, _plotter->drawstate);
+      write_svg_point_style (_plotter->data->page, _plotter->drawstate);
+    }
 
   sprintf (_plotter->data->page->point,
 	   "/>\n");
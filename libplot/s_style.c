@@ -0,0 +1,242 @@
+/* This file is part of the GNU plotutils package.  Copyright (C) 1995,
+   1996, 1997, 1998, 1999, 2000, 2005, 2008, Free Software Foundation, Inc.
+
+   The GNU plotutils package is free software.  You may redistribute it
+   and/or modify it under the terms of the GNU General Public License as
+   published by the Free Software foundation; either version 2, or (at your
+   option) any later version.
+
+   The GNU plotutils package is distributed in the hope that it will be
+   useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with the GNU plotutils package; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin St., Fifth Floor,
+   Boston, MA 02110-1301, USA. */
+
+/* This file contains support for the compact output format of SVG
+   Plotters, which is selected by setting the SVG_COMPACT parameter to
+   "yes".  In that format, the style attributes of each object on a page
+   (stroke, fill, etc.) are not written inline.  Each distinct set of them
+   is written only once, as a CSS class in a <style> element at the head
+   of the page, and objects refer to it by a `class' attribute.  Numbers
+   are written with a user-specified precision, in their shortest form.
+
+   The distinct CSS classes (and also the distinct marker symbols, see
+   s_mark.c) are kept track of in a plStringTable, which is a hashed table
+   of strings. */
+
+#include "sys-defines.h"
+#include "extern.h"
+
+/* initial lengths of the arrays in a plStringTable (hash_len must be a
+   power of 2, and is doubled whenever the table becomes half full) */
+#define INITIAL_STRING_TABLE_LEN 16
+#define INITIAL_STRING_TABLE_HASH_LEN 32
+
+/* forward references */
+static unsigned int hash_string (const char *s);
+static void rehash_string_table (plStringTable *table);
+
+plStringTable *
+_new_string_table (void)
+{
+  plStringTable *table;
+  int i;
+
+  table = (plStringTable *)_pl_xmalloc (sizeof(plStringTable));
+  table->strings = 
+    (char **)_pl_xmalloc (INITIAL_STRING_TABLE_LEN * sizeof(char *));
+  table->num_strings = 0;
+  table->strings_len = INITIAL_STRING_TABLE_LEN;
+  table->hash = 
+    (int *)_pl_xmalloc (INITIAL_STRING_TABLE_HASH_LEN * sizeof(int));
+  for (i = 0; i < INITIAL_STRING_TABLE_HASH_LEN; i++)
+    table->hash[i] = -1;
+  table->hash_len = INITIAL_STRING_TABLE_HASH_LEN;
+
+  return table;
+}
+
+void
+_delete_string_table (plStringTable *table)
+{
+  int i;
+
+  if (table == (plStringTable *)NULL)
+    return;
+
+  for (i = 0; i < table->num_strings; i++)
+    free (table->strings[i]);
+  free (table->strings);
+  free (table->hash);
+  free (table);
+}
+
+/* Look up a string in a plStringTable, adding it if it is not present.
+   Return its index, i.e. its position in order of insertion.  *is_new is
+   set to indicate whether it was added. */
+
+int
+_string_table_intern (plStringTable *table, const char *s, bool *is_new)
+{
+  unsigned int h;
+  int index;
+
+  h = hash_string (s) & (unsigned int)(table->hash_len - 1);
+  while ((index = table->hash[h]) >= 0)
+    {
+      if (strcmp (table->strings[index], s) == 0)
+	{
+	  *is_new = false;
+	  return index;
+	}
+      h = (h + 1) & (unsigned int)(table->hash_len - 1);
+    }
+
+  /* not found, so add it */
+  if (table->num_strings == table->strings_len)
+    {
+      table->strings = 
+	(char **)_pl_xrealloc (table->strings, 
+			       2 * table->strings_len * sizeof(char *));
+      table->strings_len *= 2;
+    }
+  index = table->num_strings++;
+  table->strings[index] = (char *)_pl_xmalloc (strlen (s) + 1);
+  strcpy (table->strings[index], s);
+  table->hash[h] = index;
+
+  if (2 * table->num_strings > table->hash_len)
+    rehash_string_table (table);
+
+  *is_new = true;
+  return index;
+}
+
+static void
+rehash_string_table (plStringTable *table)
+{
+  int i, new_hash_len;
+
+  new_hash_len = 2 * table->hash_len;
+  table->hash = (int *)_pl_xrealloc (table->hash, new_hash_len * sizeof(int));
+  for (i = 0; i < new_hash_len; i++)
+    table->hash[i] = -1;
+  table->hash_len = new_hash_len;
+
+  for (i = 0; i < table->num_strings; i++)
+    {
+      unsigned int h;
+
+      h = hash_string (table->strings[i]) & (unsigned int)(new_hash_len - 1);
+      while (table->hash[h] >= 0)
+	h = (h + 1) & (unsigned int)(new_hash_len - 1);
+      table->hash[h] = i;
+    }
+}
+
+/* FNV-1a */
+static unsigned int
+hash_string (const char *s)
+{
+  unsigned int h = 2166136261U;
+
+  while (*s)
+    {
+      h ^= (unsigned char)*s++;
+      h *= 16777619U;
+    }
+  return h;
+}
+
+/* Format a number for inclusion in SVG output, with the specified number
+   of significant digits, and return the length of the result.  If
+   `compact' is true, the number is shortened when SVG syntax permits it,
+   e.g., "0.25" becomes ".25" and "-0" becomes "0".  The buffer should
+   have room for at least 32 characters. */
+
+int
+_svg_format_number (char *buf, double x, int precision, bool compact)
+{
+  int len;
+
+  len = sprintf (buf, "%.*g", precision, x);
+  if (compact)
+    {
+      if (buf[0] == '0' && buf[1] == '.')
+	{
+	  memmove (buf, buf + 1, (size_t)len);
+	  len--;
+	}
+      else if (buf[0] == '-' && buf[1] == '0' && buf[2] == '.')
+	{
+	  memmove (buf + 1, buf + 2, (size_t)(len - 1));
+	  len--;
+	}
+      else if (strcmp (buf, "-0") == 0)
+	{
+	  strcpy (buf, "0");
+	  len = 1;
+	}
+    }
+
+  return len;
+}
+
+/* Write a `class' attribute for an SVG object, in place of the passed
+   style attributes (a sequence of name="value" pairs, as written in
+   non-compact output).  The attributes are converted to a CSS declaration
+   block, which is added to the page's table of distinct styles if it is
+   not already present.  The index of the block in the table is the
+   number of the CSS class. */
+
+void
+_pl_s_write_style_class (R___(Plotter *_plotter) const char *attributes)
+{
+  char *css, *q;
+  const char *p;
+  bool is_new;
+  int index;
+
+  if (*attributes == '\0')
+    /* no non-default style attributes, so don't specify a class */
+    return;
+
+  /* convert `name="value" name="value"' to `name:value;name:value' */
+  css = (char *)_pl_xmalloc (strlen (attributes) + 1);
+  p = attributes;
+  q = css;
+  while (*p)
+    {
+      const char *eq, *close;
+
+      while (*p == ' ')
+	p++;
+      if (*p == '\0')
+	break;
+      eq = strchr (p, '=');
+      if (eq == NULL || eq[1] != '"')
+	break;
+      close = strchr (eq + 2, '"');
+      if (close == NULL)
+	break;
+      if (q > css)
+	*q++ = ';';
+      memcpy (q, p, (size_t)(eq - p));
+      q += eq - p;
+      *q++ = ':';
+      memcpy (q, eq + 2, (size_t)(close - (eq + 2)));
+      q += close - (eq + 2);
+      p = close + 1;
+    }
+  *q = '\0';
+
+  index = _string_table_intern (_plotter->s_styles, css, &is_new);
+  free (css);
+
+  sprintf (_plotter->data->page->point, "class=\"s%d\" ", index);
+  _update_buffer (_plotter->data->page);
+}
@@ -70,6 +70,8 @@ const Plotter _pl_y_default_plotter =
   _pl_x_retrieve_font,
   /* `flush output' method, called only if Plotter handles its own output */
   _pl_x_flush_output,
+  /* `update raster' method, called only if Plotter renders a bitmap */
+  _pl_g_update_raster,
   /* internal error handlers */
   _pl_g_warning,
   _pl_g_error,
@@ -24,6 +24,12 @@
 #include "sys-defines.h"
 #include "extern.h"
 
+#include <png.h>
+#include <zlib.h>
+
+/* forward references */
+static int parse_png_filters (const char *s);
+
 #ifndef LIBPLOTTER
 /* In libplot, this is the initialization for the function-pointer part of
    a PNGPlotter struct.  It is the same as for a BitmapPlotter, except for
@@ -47,6 +53,8 @@ const Plotter _pl_z_default_plotter =
   _pl_g_retrieve_font,
   /* `flush output' method, called only if Plotter handles its own output */
   _pl_g_flush_output,
+  /* `update raster' method, called only if Plotter renders a bitmap */
+  _pl_b_update_raster,
   /* error handlers */
   _pl_g_warning,
   _pl_g_error,
@@ -84,6 +92,9 @@ _pl_z_initialize (S___(Plotter *_plotter))
   _plotter->z_transparent_color.red = 255; /* dummy */
   _plotter->z_transparent_color.green = 255; /* dummy */
   _plotter->z_transparent_color.blue = 255; /* dummy */
+  _plotter->z_compression_level = -1; /* i.e. libpng's default */
+  _plotter->z_compression_strategy = -1; /* i.e. libpng's default */
+  _plotter->z_filters = -1;	/* i.e. libpng's default */
 
   /* initialize certain data members from device driver parameters */
       
@@ -110,6 +121,93 @@ _pl_z_initialize (S___(Plotter *_plotter))
 	_plotter->z_transparent_color = color;
       }
   }
+
+  /* zlib compression level, 0 (none) through 9 (best) */
+  {
+    const char *level_s;
+    int level;
+
+    level_s = (const char *)_get_plot_param (_plotter->data, "PNG_COMPRESSION_LEVEL");
+    if (strcasecmp (level_s, "default") != 0)
+      {
+	if (sscanf (level_s, "%d", &level) == 1 && level >= 0 && level <= 9)
+	  _plotter->z_compression_level = level;
+      }
+  }
+
+  /* zlib compression strategy */
+  {
+    const char *strategy_s;
+
+    strategy_s = (const char *)_get_plot_param (_plotter->data, "PNG_COMPRESSION_STRATEGY");
+    if (strcasecmp (strategy_s, "filtered") == 0)
+      _plotter->z_compression_strategy = Z_FILTERED;
+    else if (strcasecmp (strategy_s, "huffman") == 0)
+      _plotter->z_compression_strategy = Z_HUFFMAN_ONLY;
+#ifdef Z_RLE
+    else if (strcasecmp (strategy_s, "rle") == 0)
+      _plotter->z_compression_strategy = Z_RLE;
+#endif
+#ifdef Z_FIXED
+    else if (strcasecmp (strategy_s, "fixed") == 0)
+      _plotter->z_compression_strategy = Z_FIXED;
+#endif
+  }
+
+  /* which PNG row filters may be applied to the image data */
+  {
+    const char *filter_s;
+
+    filter_s = (const char *)_get_plot_param (_plotter->data, "PNG_FILTER");
+    _plotter->z_filters = parse_png_filters (filter_s);
+  }
+}
+
+/* Parse a PNG_FILTER parameter: either "default", or a list of filter
+   names ("none", "sub", "up", "average", "paeth", or "all"), separated by
+   commas.  Return the corresponding mask of PNG_FILTER_* bits, or -1 if
+   the list is "default" or can't be parsed. */
+static int
+parse_png_filters (const char *s)
+{
+  static const struct { const char *name; int mask; } filter_names[] =
+  {
+    { "none", PNG_FILTER_NONE },
+    { "sub", PNG_FILTER_SUB },
+    { "up", PNG_FILTER_UP },
+    { "average", PNG_FILTER_AVG },
+    { "avg", PNG_FILTER_AVG },
+    { "paeth", PNG_FILTER_PAETH },
+    { "all", PNG_ALL_FILTERS },
+  };
+  int mask = 0;
+
+  if (s == NULL || strcasecmp (s, "default") == 0)
+    return -1;
+
+  while (*s)
+    {
+      size_t len = strcspn (s, ",");
+      bool found = false;
+      int i;
+
+      for (i = 0; i < (int)(sizeof(filter_names)/sizeof(filter_names[0])); i++)
+	if (strlen (filter_names[i].name) == len
+	    && strncasecmp (s, filter_names[i].name, len) == 0)
+	  {
+	    mask |= filter_names[i].mask;
+	    found = true;
+	    break;
+	  }
+      if (!found)
+	return -1;		/* unknown filter name */
+
+      s += len;
+      if (*s == ',')
+	s++;
+    }
+
+  return (mask == 0 ? -1 : mask);
 }
 
 /* The private `terminate' method, which is invoked when a Plotter is
@@ -68,8 +68,27 @@ extern pthread_mutex_t _message_mutex;
 static const char _short_months[12][4] =
 { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
 
+/* A hash table mapping each 24-bit color (0xRRGGBB) on the canvas to its
+   index in the PNG palette, if an indexed-color image is written.  The
+   size is a power of two, more than twice PL_MAX_BITMAP_COLORS. */
+#define PALETTE_HASH_SIZE 1024
+#define PALETTE_HASH(color) \
+  ((int)((((color) * 2654435761UL) >> 16) & (PALETTE_HASH_SIZE - 1)))
+
+typedef struct
+{
+  unsigned long color[PALETTE_HASH_SIZE];
+  int index[PALETTE_HASH_SIZE];	/* -1 means slot is empty */
+} palette_hash;
+
 /* forward references */
-static int _image_type (miPixel **pixmap, int width, int height);
+static int _image_type (const unsigned long *colors, int num_colors);
+static void _pack_mono_row (png_byte *rowbuf, const miPixel *row, int width);
+static void _pack_gray_row (png_byte *rowbuf, const miPixel *row, int width);
+static void _pack_rgb_row (png_byte *rowbuf, const miPixel *row, int width);
+static void _pack_palette_row (png_byte *rowbuf, const miPixel *row, int width, int bit_depth, const palette_hash *hash);
+static int _palette_lookup (const palette_hash *hash, unsigned long color);
+static bool _palette_covers (const palette_hash *hash, miPixel **pixmap, int width, int height);
 static void _our_error_fn_stdio (png_struct *png_ptr, const char *data);
 static void _our_warn_fn_stdio (png_struct *png_ptr, const char *data);
 #ifdef LIBPLOTTER
@@ -85,6 +104,9 @@ _pl_z_maybe_output_image (S___(Plotter *_plotter))
   miPixel **pixmap;		/* pixmap in miCanvas */
   int width, height;
   int image_type, bit_depth, color_type;
+  int num_palette = 0;
+  png_color palette[PL_MAX_BITMAP_COLORS];
+  palette_hash *hash = (palette_hash *)NULL;
   png_struct *png_ptr;
   png_info *info_ptr;
   char time_buf[32], software_buf[64];
@@ -113,6 +135,102 @@ _pl_z_maybe_output_image (S___(Plotter *_plotter))
   if (_plotter->data->page_number != 1)
     return 0;
 
+  /* extract pixmap (2D array of miPixels) from miCanvas */
+  pixmap = ((miCanvas *)(_plotter->b_canvas))->drawable->pixmap;
+
+  /* what is best image type that can be used?  0/1/2/3 =
+     mono/gray/rgb/palette.  This is determined from the colors that were
+     recorded while the canvas was being painted, so the canvas itself
+     needn't be scanned. */
+  width = _plotter->b_xn;
+  height = _plotter->b_yn;
+  image_type = _image_type (_plotter->b_colors, _plotter->b_num_colors);
+  switch (image_type)
+    {
+    case 0:			/* mono */
+      bit_depth = 1;
+      color_type = PNG_COLOR_TYPE_GRAY;
+      break;
+    case 1:			/* gray */
+      bit_depth = 8;
+      color_type = PNG_COLOR_TYPE_GRAY;
+      break;
+    case 3:			/* palette */
+      num_palette = _plotter->b_num_colors;
+      if (num_palette <= 2)
+	bit_depth = 1;
+      else if (num_palette <= 4)
+	bit_depth = 2;
+      else if (num_palette <= 16)
+	bit_depth = 4;
+      else
+	bit_depth = 8;
+      color_type = PNG_COLOR_TYPE_PALETTE;
+      break;
+    case 2:			/* rgb */
+    default:
+      bit_depth = 8;
+      color_type = PNG_COLOR_TYPE_RGB;
+      break;
+    }
+
+  if (image_type == 3)
+    /* construct palette, and hash table for looking up palette indices */
+    {
+      int i;
+
+      for (i = 0; i < num_palette; i++)
+	{
+	  unsigned long color = _plotter->b_colors[i];
+	  
+	  palette[i].red = (png_byte)((color >> 16) & 0xff);
+	  palette[i].green = (png_byte)((color >> 8) & 0xff);
+	  palette[i].blue = (png_byte)(color & 0xff);
+	}
+
+      /* move the transparent color (if any) to the front of the palette,
+	 so that a single-entry tRNS chunk will suffice */
+      if (_plotter->z_transparent)
+	for (i = 0; i < num_palette; i++)
+	  if (palette[i].red == _plotter->z_transparent_color.red
+	      && palette[i].green == _plotter->z_transparent_color.green
+	      && palette[i].blue == _plotter->z_transparent_color.blue)
+	    {
+	      png_color tmp = palette[0];
+
+	      palette[0] = palette[i];
+	      palette[i] = tmp;
+	      break;
+	    }
+
+      hash = (palette_hash *)_pl_xmalloc (sizeof (palette_hash));
+      for (i = 0; i < PALETTE_HASH_SIZE; i++)
+	hash->index[i] = -1;
+      for (i = 0; i < num_palette; i++)
+	{
+	  unsigned long color = ((unsigned long)palette[i].red << 16)
+	    | ((unsigned long)palette[i].green << 8)
+	    | (unsigned long)palette[i].blue;
+	  int slot = PALETTE_HASH(color);
+
+	  while (hash->index[slot] >= 0)
+	    slot = (slot + 1) & (PALETTE_HASH_SIZE - 1);
+	  hash->color[slot] = color;
+	  hash->index[slot] = i;
+	}
+
+      /* every color painted on the canvas should have been recorded, but
+	 if one wasn't, write an RGB image instead */
+      if (_palette_covers (hash, pixmap, width, height) == false)
+	{
+	  free (hash);
+	  hash = (palette_hash *)NULL;
+	  image_type = 2;
+	  bit_depth = 8;
+	  color_type = PNG_COLOR_TYPE_RGB;
+	}
+    }
+
   /* work out libpng error handling (i.e. callback functions and data) */
 #ifdef LIBPLOTTER
   if (errorstream)
@@ -153,13 +271,17 @@ _pl_z_maybe_output_image (S___(Plotter *_plotter))
 				     error_ptr,
 				     error_fn_ptr, warn_fn_ptr);
   if (png_ptr == (png_struct *)NULL)
-    return -1;
+    {
+      free (hash);
+      return -1;
+    }
 
   /* allocate/initialize image information data */
   info_ptr = png_create_info_struct (png_ptr);
   if (info_ptr == (png_info *)NULL)
     {
       png_destroy_write_struct (&png_ptr, (png_info **)NULL);
+      free (hash);
       return -1;
     }
 
@@ -167,6 +289,7 @@ _pl_z_maybe_output_image (S___(Plotter *_plotter))
   if (setjmp (png_jmpbuf (png_ptr)))
     {
       png_destroy_write_struct (&png_ptr, (png_info **)NULL);
+      free (hash);
       return -1;
     }
 
@@ -188,29 +311,13 @@ _pl_z_maybe_output_image (S___(Plotter *_plotter))
     png_init_io (png_ptr, fp);
 #endif /* not LIBPLOTTER */
 
-  /* extract pixmap (2D array of miPixels) from miCanvas */
-  pixmap = ((miCanvas *)(_plotter->b_canvas))->drawable->pixmap;
-
-  /* what is best image type that can be used?  0/1/2 = mono/gray/rgb */
-  width = _plotter->b_xn;
-  height = _plotter->b_yn;
-  image_type = _image_type (pixmap, width, height);
-  switch (image_type)
-    {
-    case 0:			/* mono */
-      bit_depth = 1;
-      color_type = PNG_COLOR_TYPE_GRAY;
-      break;
-    case 1:			/* gray */
-      bit_depth = 8;
-      color_type = PNG_COLOR_TYPE_GRAY;
-      break;
-    case 2:			/* rgb */
-    default:
-      bit_depth = 8;
-      color_type = PNG_COLOR_TYPE_RGB;
-      break;
-    }
+  /* user-specified zlib and row filter settings, if any */
+  if (_plotter->z_compression_level >= 0)
+    png_set_compression_level (png_ptr, _plotter->z_compression_level);
+  if (_plotter->z_compression_strategy >= 0)
+    png_set_compression_strategy (png_ptr, _plotter->z_compression_strategy);
+  if (_plotter->z_filters >= 0)
+    png_set_filter (png_ptr, PNG_FILTER_TYPE_BASE, _plotter->z_filters);
 
   /* Set image information in file header.  Width and height are up to
      2^31, bit_depth is one of 1, 2, 4, 8, or 16, but valid values also
@@ -226,6 +333,8 @@ _pl_z_maybe_output_image (S___(Plotter *_plotter))
 		_plotter->z_interlace ? PNG_INTERLACE_ADAM7
 		                      : PNG_INTERLACE_NONE,
 		PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+  if (image_type == 3)
+    png_set_PLTE (png_ptr, info_ptr, palette, num_palette);
 
   /* set transparent color (if user specified one) */
   if (_plotter->z_transparent)
@@ -258,6 +367,13 @@ _pl_z_maybe_output_image (S___(Plotter *_plotter))
 	  else
 	    trans_value.gray = (png_uint_16)transparent_color.red;
 	  break;
+	case 3:			/* palette */
+	  if (palette[0].red != transparent_color.red
+	      || palette[0].green != transparent_color.green
+	      || palette[0].blue != transparent_color.blue)
+	    /* user-specified transparent color doesn't appear in image */
+	    transparent_color_ok = false;
+	  break;
 	case 2:			/* rgb */
 	default:
 	  trans_value.red = (png_uint_16)transparent_color.red;
@@ -266,7 +382,17 @@ _pl_z_maybe_output_image (S___(Plotter *_plotter))
 	  break;
 	}
       if (transparent_color_ok)
-	png_set_tRNS (png_ptr, info_ptr, (png_byte *)NULL, 1, &trans_value);
+	{
+	  if (image_type == 3)
+	    {
+	      png_byte trans_alpha = 0;	/* palette entry #0 is transparent */
+
+	      png_set_tRNS (png_ptr, info_ptr, &trans_alpha, 1, 
+			    (png_color_16 *)NULL);
+	    }
+	  else
+	    png_set_tRNS (png_ptr, info_ptr, (png_byte *)NULL, 1, &trans_value);
+	}
     }
 
   /* add some comments to file header */
@@ -297,7 +423,7 @@ _pl_z_maybe_output_image (S___(Plotter *_plotter))
   /* Write out image data, a row at a time; support multiple passes over
      image if interlacing.  We don't simply call png_write_image() because
      the image in the miCanvas's pixmap is a 2-D array of miPixels, and
-     sizeof(miPixel) > 4 is possible.  Instead we copy each miPixel in a
+     sizeof(miPixel) > 4 is possible.  Instead we pack the miPixels in each
      row into a local row buffer, and write out the row buffer. */
   {
     png_byte *rowbuf;
@@ -311,6 +437,9 @@ _pl_z_maybe_output_image (S___(Plotter *_plotter))
       case 1:			/* gray */
 	rowbuf = (png_byte *)_pl_xmalloc(width * sizeof(png_byte));
 	break;
+      case 3:			/* palette */
+	rowbuf = (png_byte *)_pl_xmalloc(((width * bit_depth + 7)/8) * sizeof(png_byte));
+	break;
       case 2:			/* rgb */
       default:
 	rowbuf = (png_byte *)_pl_xmalloc(3 * width * sizeof(png_byte));
@@ -325,39 +454,27 @@ _pl_z_maybe_output_image (S___(Plotter *_plotter))
 
     for (pass = 0; pass < num_passes; pass++)
       {
-	int i, j;
+	int j;
 
 	for (j = 0; j < height; j++)
 	  {
-	    png_byte *ptr;
-
 	    /* fill row buffer with 3 bytes per miPixel (RGB), or 1 byte
-	       (gray), or 1 bit (mono) */
-	    ptr = rowbuf;
-	    for (i = 0; i < width; i++)
+	       (gray), or 1 bit (mono), or a palette index */
+	    switch (image_type)
 	      {
-		switch (image_type)
-		  {
-		  case 0:	/* mono */
-		    if (i % 8 == 0)
-		      {
-			if (i != 0)
-			  ptr++;
-			*ptr = (png_byte)0;
-		      }
-		    if (pixmap[j][i].u.rgb[0]) /* white pixel */
-		      *ptr |= (1 << (7 - (i % 8)));
-		    break;
-		  case 1:	/* gray */
-		    *ptr++ = (png_byte)pixmap[j][i].u.rgb[0];
-		    break;
-		  case 2:	/* rgb */
-		  default:
-		    *ptr++ = (png_byte)pixmap[j][i].u.rgb[0];
-		    *ptr++ = (png_byte)pixmap[j][i].u.rgb[1];
-		    *ptr++ = (png_byte)pixmap[j][i].u.rgb[2];
-		    break;
-		  }
+	      case 0:		/* mono */
+		_pack_mono_row (rowbuf, pixmap[j], width);
+		break;
+	      case 1:		/* gray */
+		_pack_gray_row (rowbuf, pixmap[j], width);
+		break;
+	      case 3:		/* palette */
+		_pack_palette_row (rowbuf, pixmap[j], width, bit_depth, hash);
+		break;
+	      case 2:		/* rgb */
+	      default:
+		_pack_rgb_row (rowbuf, pixmap[j], width);
+		break;
 	      }
 
 	    /* write out row buffer */
@@ -373,51 +490,161 @@ _pl_z_maybe_output_image (S___(Plotter *_plotter))
 
   /* tear down */
   png_destroy_write_struct (&png_ptr, (png_info **)NULL);
+  free (hash);
 
   return true;
 }
 
-/* return best type for writing an image (0=mono, 1=grey, 2=color) */
+/* return best type for writing an image (0=mono, 1=grey, 2=color,
+   3=indexed color), given the colors that were painted on the canvas */
 static int
-_image_type (miPixel **pixmap, int width, int height)
+_image_type (const unsigned long *colors, int num_colors)
 {
-  int i, j;
+  int i;
   int type = 0;			/* default is mono */
 
+  if (num_colors > PL_MAX_BITMAP_COLORS)
+    /* too many colors for a palette; and since there can't be more than
+       256 levels of gray, need color */
+    return 2;
+
+  for (i = 0; i < num_colors; i++)
+    {
+      unsigned long red, green, blue;
+
+      red = (colors[i] >> 16) & 0xff;
+      green = (colors[i] >> 8) & 0xff;
+      blue = colors[i] & 0xff;
+      if (! ((red == 0 && green == 0 && blue == 0)
+	     || (red == 255 && green == 255 && blue == 255)))
+	{
+	  if (red == green && red == blue)
+	    type = 1;		/* need grey */
+	  else
+	    return 3;		/* need color, but palette will do */
+	}
+    }
+  return type;
+}
+
+/* fill row buffer with 1 bit per miPixel (1 = white) */
+static void
+_pack_mono_row (png_byte *rowbuf, const miPixel *row, int width)
+{
+  png_byte byte = 0;
+  int i;
+
+  for (i = 0; i < width; i++)
+    {
+      byte = (png_byte)((byte << 1) | (row[i].u.rgb[0] ? 1 : 0));
+      if (i % 8 == 7)
+	{
+	  *rowbuf++ = byte;
+	  byte = 0;
+	}
+    }
+  if (width % 8 != 0)
+    *rowbuf = (png_byte)(byte << (8 - width % 8));
+}
+
+/* fill row buffer with 1 byte per miPixel */
+static void
+_pack_gray_row (png_byte *rowbuf, const miPixel *row, int width)
+{
+  int i;
+
+  for (i = 0; i < width; i++)
+    *rowbuf++ = (png_byte)row[i].u.rgb[0];
+}
+
+/* fill row buffer with 3 bytes per miPixel */
+static void
+_pack_rgb_row (png_byte *rowbuf, const miPixel *row, int width)
+{
+  int i;
+
+  for (i = 0; i < width; i++)
+    {
+      *rowbuf++ = (png_byte)row[i].u.rgb[0];
+      *rowbuf++ = (png_byte)row[i].u.rgb[1];
+      *rowbuf++ = (png_byte)row[i].u.rgb[2];
+    }
+}
+
+/* fill row buffer with a palette index (of 1, 2, 4, or 8 bits) per
+   miPixel; runs of identically colored pixels require only one lookup */
+static void
+_pack_palette_row (png_byte *rowbuf, const miPixel *row, int width, int bit_depth, const palette_hash *hash)
+{
+  int pixels_per_byte = 8 / bit_depth;
+  unsigned long last_color = 0;
+  int last_index = -1;
+  png_byte byte = 0;
+  int i;
+
+  for (i = 0; i < width; i++)
+    {
+      unsigned long color = ((unsigned long)row[i].u.rgb[0] << 16)
+	| ((unsigned long)row[i].u.rgb[1] << 8)
+	| (unsigned long)row[i].u.rgb[2];
+
+      if (last_index < 0 || color != last_color)
+	{
+	  last_color = color;
+	  last_index = _palette_lookup (hash, color);
+	}
+      byte = (png_byte)((byte << bit_depth) | last_index);
+      if (i % pixels_per_byte == pixels_per_byte - 1)
+	{
+	  *rowbuf++ = byte;
+	  byte = 0;
+	}
+    }
+  if (width % pixels_per_byte != 0)
+    *rowbuf = (png_byte)(byte << (bit_depth * (pixels_per_byte - width % pixels_per_byte)));
+}
+
+/* look up the palette index of a 24-bit color; return -1 if it isn't in
+   the palette */
+static int
+_palette_lookup (const palette_hash *hash, unsigned long color)
+{
+  int slot = PALETTE_HASH(color);
+
+  while (hash->index[slot] >= 0)
+    {
+      if (hash->color[slot] == color)
+	return hash->index[slot];
+      slot = (slot + 1) & (PALETTE_HASH_SIZE - 1);
+    }
+  return -1;
+}
+
+/* check that the color of every pixel on the canvas is in the palette;
+   runs of identically colored pixels require only one lookup */
+static bool
+_palette_covers (const palette_hash *hash, miPixel **pixmap, int width, int height)
+{
+  unsigned long last_color = 0;
+  bool looked_up = false;
+  int i, j;
+
   for (j = 0; j < height; j++)
     for (i = 0; i < width; i++)
       {
-	unsigned char red, green, blue;
+	unsigned long color = ((unsigned long)pixmap[j][i].u.rgb[0] << 16)
+	  | ((unsigned long)pixmap[j][i].u.rgb[1] << 8)
+	  | (unsigned long)pixmap[j][i].u.rgb[2];
 
-	red = pixmap[j][i].u.rgb[0];
-	green = pixmap[j][i].u.rgb[1];
-	blue = pixmap[j][i].u.rgb[2];
-	if (type == 0)		/* up to now, all pixels are black or white */
+	if (looked_up == false || color != last_color)
 	  {
-	    if (! ((red == (unsigned char)0 && green == (unsigned char)0
-		    && blue == (unsigned char)0)
-		   || (red == (unsigned char)255 && green == (unsigned char)255
-		    && blue == (unsigned char)255)))
-	      {
-		if (red == green && red == blue)
-		  type = 1;	/* need grey */
-		else
-		  {
-		    type = 2;	/* need color */
-		    return type;
-		  }
-	      }
-	  }
-	else if (type == 1)
-	  {
-	    if (red != green || red != blue)
-	      {
-		type = 2;	/* need color */
-		return type;
-	      }
+	    if (_palette_lookup (hash, color) < 0)
+	      return false;
+	    last_color = color;
+	    looked_up = true;
 	  }
       }
-  return type;
+  return true;
 }
 
 /* custom error and warning handlers (for stdio) */
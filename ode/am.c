@@ -18,108 +18,116 @@
 #define PASTVAL        (3)	/* previous values, val[0] is current value */
 
 void
-am (void)
+am (struct run *rp)
 {
+  int i, n = rp->r_nsyms;
+  double *value = rp->r_value, *prime = rp->r_prime;
+  double *k0 = rp->r_k[0], *k1 = rp->r_k[1], *k2 = rp->r_k[2];
+  double *k3 = rp->r_k[3];
+  double *val0, *pri0, *pri1, *pri2, *pri3;
   double t;
-  double halfstep = HALF * tstep;
-  double sconst = tstep / 24.0; /* step constant */
+  double halfstep = HALF * rp->r_tstep;
+  double sconst = rp->r_tstep / 24.0; /* step constant */
   double onesixth = 1.0 / 6.0;
 
   /* Runge-Kutta startup */
-  for (it = 0, t = tstart; it <= PASTVAL && !STOPR; t = tstart + (++it) * tstep) 
+  for (rp->r_it = 0, t = tstart; rp->r_it <= PASTVAL && !STOPR(rp->r_tstep);
+       t = tstart + (++rp->r_it) * rp->r_tstep) 
     {
-      symtab->sy_value = symtab->sy_val[0] = t;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      value[0] = t;
+      field (rp);
+      push_history (rp, rp->r_it);
+      val0 = rp->r_val[0];
+      pri0 = rp->r_pri[0];
+      for (i = 0; i < n; i++)
 	{
-	  int j;
-
-	  for (j = it; j > 0; j--) 
-	    {
-	      fsp->sy_val[j] = fsp->sy_val[j-1];
-	      fsp->sy_pri[j] = fsp->sy_pri[j-1];
-	    }
-	  fsp->sy_pri[0] = fsp->sy_prime;
-	  fsp->sy_val[0] = fsp->sy_value;
+	  pri0[i] = prime[i];
+	  val0[i] = value[i];
 	}
       /* output */
-      printq();
-      if (it == PASTVAL)
+      if (events (rp))
+	return;
+      printq (rp);
+      if (rp->r_it == PASTVAL)
 	break;  /* startup complete */
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link)   
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_k[0] = tstep * fsp->sy_prime;
-	  fsp->sy_value = fsp->sy_val[0] + HALF * fsp->sy_k[0];
+	  k0[i] = rp->r_tstep * prime[i];
+	  value[i] = val0[i] + HALF * k0[i];
 	}
-      symtab->sy_value = t + halfstep;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link)   
+      value[0] = t + halfstep;
+      field (rp);
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_k[1] = tstep * fsp->sy_prime;
-	  fsp->sy_value = fsp->sy_val[0] + HALF * fsp->sy_k[1];
+	  k1[i] = rp->r_tstep * prime[i];
+	  value[i] = val0[i] + HALF * k1[i];
 	}
-      symtab->sy_value = t + halfstep;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link)   
+      value[0] = t + halfstep;
+      field (rp);
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_k[2] = tstep * fsp->sy_prime;
-	  fsp->sy_value = fsp->sy_val[0] + fsp->sy_k[2];
+	  k2[i] = rp->r_tstep * prime[i];
+	  value[i] = val0[i] + k2[i];
 	}
-      symtab->sy_value = t + tstep;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link)
-	fsp->sy_k[3] = tstep * fsp->sy_prime;
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      value[0] = t + rp->r_tstep;
+      field (rp);
+      for (i = 1; i < n; i++)
+	k3[i] = rp->r_tstep * prime[i];
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_value = fsp->sy_val[0] 
-	    + onesixth * (fsp->sy_k[0]
-			  + TWO * fsp->sy_k[1]
-			  + TWO * fsp->sy_k[2]
-			  + fsp->sy_k[3]);
+	  value[i] = val0[i]
+	    + onesixth * (k0[i]
+			  + TWO * k1[i]
+			  + TWO * k2[i]
+			  + k3[i]);
 	}
     }
 
   /* predictor - corrector */
-  while (!STOPA)
+  while (!STOPA(rp->r_tstep))
     {
+      val0 = rp->r_val[0];
+      pri0 = rp->r_pri[0];
+      pri1 = rp->r_pri[1];
+      pri2 = rp->r_pri[2];
+      pri3 = rp->r_pri[3];
+
       /* Adams-Bashforth predictor */
-      for (fsp = dqueue; fsp != NULL ; fsp = fsp->sy_link) 
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_value = fsp->sy_val[0] 
-	    + (sconst) * (55 * fsp->sy_pri[0]
-			  -59 * fsp->sy_pri[1]
-			  +37 * fsp->sy_pri[2]
-			  -9  * fsp->sy_pri[3]);
+	  value[i] = val0[i]
+	    + (sconst) * (55 * pri0[i]
+			  -59 * pri1[i]
+			  +37 * pri2[i]
+			  -9  * pri3[i]);
 	}
-      symtab->sy_val[0] = symtab->sy_value =  t = tstart + (++it) * tstep;
-      field();
+      val0[0] = value[0] = t = tstart + (++rp->r_it) * rp->r_tstep;
+      field (rp);
 
       /* Adams-Moulton corrector */
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_value = fsp->sy_val[0] 
-	    + (sconst) * (9  * fsp->sy_prime
-			  +19 * fsp->sy_pri[0]
-			  -5  * fsp->sy_pri[1]
-			  +   fsp->sy_pri[2]);
+	  value[i] = val0[i]
+	    + (sconst) * (9  * prime[i]
+			  +19 * pri0[i]
+			  -5  * pri1[i]
+			  +   pri2[i]);
 	}
-      field();
+      field (rp);
 
       /* cycle indices */
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      push_history (rp, PASTVAL);
+      val0 = rp->r_val[0];
+      pri0 = rp->r_pri[0];
+      for (i = 0; i < n; i++)
 	{
-	  int j;
-
-	  for (j = PASTVAL; j > 0; j--) 
-	    {
-	      fsp->sy_val[j] = fsp->sy_val[j-1];
-	      fsp->sy_pri[j] = fsp->sy_pri[j-1];
-	    }
-	  fsp->sy_val[0] = fsp->sy_value;
-	  fsp->sy_pri[0] = fsp->sy_prime;
+	  val0[i] = value[i];
+	  pri0[i] = prime[i];
 	}
 
       /* output */
-      printq();
+      if (events (rp))
+	return;
+      printq (rp);
     }
 }
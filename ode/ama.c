@@ -17,14 +17,23 @@
 #include "num.h"
 
 #define PASTVAL        (3)	/* past values, val[0] is current value */
-#define T_LT_TSTOP (tstep>0 ? t<tstop:t>tstop)
-#define NEARSTOP       (tstep > 0 ? \
-                        t+0.9375*tstep > tstop && t+0.0625*tstep < tstop : \
-                        t+0.9375*tstep < tstop && t+0.0625*tstep > tstop)
+#define T_LT_TSTOP (rp->r_tstep>0 ? t<tstop:t>tstop)
+#define NEARSTOP       (rp->r_tstep > 0 ? \
+                        t+0.9375*rp->r_tstep > tstop \
+                        && t+0.0625*rp->r_tstep < tstop : \
+                        t+0.9375*rp->r_tstep < tstop \
+                        && t+0.0625*rp->r_tstep > tstop)
 
 void
-ama (void)
+ama (struct run *rp)
 {
+  int i, n = rp->r_nsyms;
+  double *value = rp->r_value, *prime = rp->r_prime;
+  double *predi = rp->r_predi;
+  double *sserr = rp->r_sserr, *aberr = rp->r_aberr;
+  double *k0 = rp->r_k[0], *k1 = rp->r_k[1], *k2 = rp->r_k[2];
+  double *k3 = rp->r_k[3], *k4 = rp->r_k[4], *k5 = rp->r_k[5];
+  double *val0, *pri0, *pri1, *pri2, *pri3;
   bool gdval = true;		/* good value to print ? */
   int overtime = 1;
   long startit = 0;
@@ -33,206 +42,204 @@ ama (void)
 
  top:
   /* fifth-order Runge-Kutta startup */
-  it = startit;
-  while (it <= startit + PASTVAL&&(T_LT_TSTOP || overtime--)) 
+  rp->r_it = startit;
+  while (rp->r_it <= startit + PASTVAL&&(T_LT_TSTOP || overtime--)) 
     {
-      symtab->sy_value = t;
-      field();
+      value[0] = t;
+      field (rp);
       if (gdval) 
 	{
-	  for (fsp = symtab; fsp != NULL; fsp = fsp->sy_link) 
+	  push_history (rp, rp->r_it - startit);
+	  for (i = 0; i < n; i++)
 	    {
-	      int j;
-	      
-	      for (j = it - startit; j > 0; j--) 
-		{
-		  fsp->sy_val[j] = fsp->sy_val[j-1];
-		  fsp->sy_pri[j] = fsp->sy_pri[j-1];
-		}
-	      fsp->sy_val[0] = fsp->sy_value;
-	      fsp->sy_pri[0] = fsp->sy_prime;
+	      rp->r_val[0][i] = value[i];
+	      rp->r_pri[0][i] = prime[i];
 	    }
-	  printq();		/* output */
-	  if (it == startit + PASTVAL)
+	  if (events (rp))
+	    return;
+	  printq (rp);		/* output */
+	  if (rp->r_it == startit + PASTVAL)
 	    break;		/* startup complete */
 	}
-      if (tstep * (t+tstep-tstop) > 0)
-	tstep = tstop - t;
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      val0 = rp->r_val[0];
+      if (rp->r_tstep * (t+rp->r_tstep-tstop) > 0)
+	rp->r_tstep = tstop - t;
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_k[0] = tstep * fsp->sy_prime;
-	  fsp->sy_value = fsp->sy_val[0] + C20 * fsp->sy_k[0];
+	  k0[i] = rp->r_tstep * prime[i];
+	  value[i] = val0[i] + C20 * k0[i];
 	}
-      symtab->sy_value = t + C2t * tstep;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      value[0] = t + C2t * rp->r_tstep;
+      field (rp);
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_k[1] = tstep * fsp->sy_prime;
-	  fsp->sy_value = fsp->sy_val[0] + C30 * fsp->sy_k[0]
-	    + C31 * fsp->sy_k[1];
+	  k1[i] = rp->r_tstep * prime[i];
+	  value[i] = val0[i] + C30 * k0[i]
+	    + C31 * k1[i];
 	}
-      symtab->sy_value = t + C3t * tstep;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      value[0] = t + C3t * rp->r_tstep;
+      field (rp);
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_k[2] = tstep * fsp->sy_prime;
-	  fsp->sy_value = fsp->sy_val[0] 
-	    + (C40 * fsp->sy_k[0]
-	       + C41 * fsp->sy_k[1]
-	       + C42 * fsp->sy_k[2]);
+	  k2[i] = rp->r_tstep * prime[i];
+	  value[i] = val0[i]
+	    + (C40 * k0[i]
+	       + C41 * k1[i]
+	       + C42 * k2[i]);
 	}
-      symtab->sy_value = t + C4t * tstep;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      value[0] = t + C4t * rp->r_tstep;
+      field (rp);
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_k[3] = tstep * fsp->sy_prime;
-	  fsp->sy_value = fsp->sy_val[0] 
-	    + (C50 * fsp->sy_k[0]
-	       + C51 * fsp->sy_k[1]
-	       + C52 * fsp->sy_k[2]
-	       + C53 * fsp->sy_k[3]);
+	  k3[i] = rp->r_tstep * prime[i];
+	  value[i] = val0[i]
+	    + (C50 * k0[i]
+	       + C51 * k1[i]
+	       + C52 * k2[i]
+	       + C53 * k3[i]);
 	}
-      symtab->sy_value = t + tstep;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      value[0] = t + rp->r_tstep;
+      field (rp);
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_k[4] = tstep * fsp->sy_prime;
-	  fsp->sy_value = fsp->sy_val[0] 
-	    + (C60 * fsp->sy_k[0]
-	       + C61 * fsp->sy_k[1]
-	       + C62 * fsp->sy_k[2]
-	       + C63 * fsp->sy_k[3]
-	       + C64 * fsp->sy_k[4]);
+	  k4[i] = rp->r_tstep * prime[i];
+	  value[i] = val0[i]
+	    + (C60 * k0[i]
+	       + C61 * k1[i]
+	       + C62 * k2[i]
+	       + C63 * k3[i]
+	       + C64 * k4[i]);
 	}
-      symtab->sy_value = t + C6t * tstep;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link)
-	fsp->sy_k[5] = tstep * fsp->sy_prime;
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      value[0] = t + C6t * rp->r_tstep;
+      field (rp);
+      for (i = 1; i < n; i++)
+	k5[i] = rp->r_tstep * prime[i];
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_predi = fsp->sy_val[0] 
-	    + (A0 * fsp->sy_k[0]
-	       + A2 * fsp->sy_k[2]
-	       + A3 * fsp->sy_k[3]
-	       + A4 * fsp->sy_k[4]);
-	  fsp->sy_value = fsp->sy_val[0] 
-	    + (B0 * fsp->sy_k[0]
-	       + B2 * fsp->sy_k[2]
-	       + B3 * fsp->sy_k[3]
-	       + B4 * fsp->sy_k[4]
-	       + B5 * fsp->sy_k[5]);
-	  if (fsp->sy_value != 0.0)
-	    fsp->sy_sserr = fabs(1.0 - fsp->sy_predi /
-				 fsp->sy_value);
-	  fsp->sy_aberr = fabs(fsp->sy_value - fsp->sy_predi);
+	  predi[i] = val0[i]
+	    + (A0 * k0[i]
+	       + A2 * k2[i]
+	       + A3 * k3[i]
+	       + A4 * k4[i]);
+	  value[i] = val0[i]
+	    + (B0 * k0[i]
+	       + B2 * k2[i]
+	       + B3 * k3[i]
+	       + B4 * k4[i]
+	       + B5 * k5[i]);
+	  if (value[i] != 0.0)
+	    sserr[i] = fabs(1.0 - predi[i] /
+			    value[i]);
+	  aberr[i] = fabs(value[i] - predi[i]);
 	}
       if (!conflag && T_LT_TSTOP) 
 	{
-	  maxerr();
-	  if (hierror()) 
+	  maxerr (rp);
+	  if (hierror (rp)) 
 	    { 
-	      tstep *= HALF;
-	      for (fsp = symtab; fsp != NULL; fsp = fsp->sy_link)
-		fsp->sy_value = fsp->sy_val[0];
+	      rp->r_tstep *= HALF;
+	      for (i = 0; i < n; i++)
+		value[i] = val0[i];
 	      gdval = false;
 	      continue;
 	    }
-	  else if (lowerror() && prevstep != tstep) 
+	  else if (lowerror (rp) && prevstep != rp->r_tstep) 
 	    {
-	      prevstep = tstep; /* prevent infinite loops */
-	      tstep *= 2.0;
-	      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link)
-		fsp->sy_value = fsp->sy_val[0];
+	      prevstep = rp->r_tstep; /* prevent infinite loops */
+	      rp->r_tstep *= 2.0;
+	      for (i = 1; i < n; i++)
+		value[i] = val0[i];
 	      gdval = false;
 	      continue;
 	    }
 	}
       gdval = true;
-      ++it;
-      t += tstep;	/* the roundoff error is gross */
+      ++rp->r_it;
+      t += rp->r_tstep;	/* the roundoff error is gross */
     }
   /* predictor - corrector */
   while (T_LT_TSTOP ) 
     {
       /* Adams-Bashforth predictor */
-      if (tstep*(t+tstep-tstop) > 0)
+      if (rp->r_tstep*(t+rp->r_tstep-tstop) > 0)
 	{
-	  startit = it;
+	  startit = rp->r_it;
 	  goto top;
 	}
-      for (fsp = dqueue; fsp != NULL ; fsp = fsp->sy_link) 
+      val0 = rp->r_val[0];
+      pri0 = rp->r_pri[0];
+      pri1 = rp->r_pri[1];
+      pri2 = rp->r_pri[2];
+      pri3 = rp->r_pri[3];
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_predi = fsp->sy_value
-	    = fsp->sy_val[0] + tstep/24.0 *
-	      (55 * fsp->sy_pri[0]
-	       -59 * fsp->sy_pri[1]
-	       +37 * fsp->sy_pri[2]
-	       -9  * fsp->sy_pri[3]);
+	  predi[i] = value[i]
+	    = val0[i] + rp->r_tstep/24.0 *
+	      (55 * pri0[i]
+	       -59 * pri1[i]
+	       +37 * pri2[i]
+	       -9  * pri3[i]);
 	}
-      ++it;
-      symtab->sy_value = t += tstep;
+      ++rp->r_it;
+      value[0] = t += rp->r_tstep;
       /* the roundoff error is gross */
-      field();
+      field (rp);
       /* Adams-Moulton corrector */
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_value = fsp->sy_val[0] + tstep/24.0 *
-	    (9  * fsp->sy_prime
-	     +19 * fsp->sy_pri[0]
-	     -5  * fsp->sy_pri[1]
-	     +     fsp->sy_pri[2]);
-	  if (fsp->sy_value != 0.0)
-	    fsp->sy_sserr = ECONST *
-	      fabs(1.0 - fsp->sy_predi / fsp->sy_value);
-	  fsp->sy_aberr = ECONST *
-	    fabs (fsp->sy_value - fsp->sy_predi);
-	  fsp->sy_value += ECONST * (fsp->sy_predi - fsp->sy_value);
+	  value[i] = val0[i] + rp->r_tstep/24.0 *
+	    (9  * prime[i]
+	     +19 * pri0[i]
+	     -5  * pri1[i]
+	     +     pri2[i]);
+	  if (value[i] != 0.0)
+	    sserr[i] = ECONST *
+	      fabs(1.0 - predi[i] / value[i]);
+	  aberr[i] = ECONST *
+	    fabs (value[i] - predi[i]);
+	  value[i] += ECONST * (predi[i] - value[i]);
 	}
       if (!conflag) 
 	{
-	  maxerr();
-	  if (hierror()) 
+	  maxerr (rp);
+	  if (hierror (rp)) 
 	    {
-	      tstep *= HALF;
-	      t = symtab->sy_val[0];
-	      for (fsp = symtab; fsp != NULL; fsp = fsp->sy_link) 
+	      rp->r_tstep *= HALF;
+	      t = val0[0];
+	      for (i = 0; i < n; i++)
 		{
-		  fsp->sy_value = fsp->sy_val[0];
-		  fsp->sy_prime = fsp->sy_pri[0];
+		  value[i] = val0[i];
+		  prime[i] = pri0[i];
 		}
-	      startit = --it;
+	      startit = --rp->r_it;
 	      gdval = false;
 	      goto top;
 	    }
-	  else if (lowerror()) 
+	  else if (lowerror (rp)) 
 	    {
-	      tstep *= TWO;
-                                        t = symtab->sy_val[0];
-	      for (fsp = symtab; fsp != NULL; fsp = fsp->sy_link) 
+	      rp->r_tstep *= TWO;
+	      t = val0[0];
+	      for (i = 0; i < n; i++)
 		{
-		  fsp->sy_value = fsp->sy_val[0];
-		  fsp->sy_prime = fsp->sy_pri[0];
+		  value[i] = val0[i];
+		  prime[i] = pri0[i];
 		}
-	      startit = --it;
+	      startit = --rp->r_it;
 	      gdval = false;
 	      goto top;
 	    }
 	}
-      field();
+      field (rp);
       /* cycle indices */
-      for (fsp = symtab; fsp != NULL; fsp = fsp->sy_link) 
+      push_history (rp, PASTVAL);
+      for (i = 0; i < n; i++)
 	{
-	  int j;
-
-	  for (j = PASTVAL; j > 0; j--) 
-	    {
-	      fsp->sy_val[j] = fsp->sy_val[j-1];
-	      fsp->sy_pri[j] = fsp->sy_pri[j-1];
-	    }
-	  fsp->sy_val[0] = fsp->sy_value;
-	  fsp->sy_pri[0] = fsp->sy_prime;
+	  rp->r_val[0][i] = value[i];
+	  rp->r_pri[0][i] = prime[i];
 	}
       /* output */
-      printq();
+      if (events (rp))
+	return;
+      printq (rp);
     }
 }
@@ -0,0 +1,1426 @@
+/* This file is part of the GNU plotutils package. */
+
+/*
+ * Copyright (C) 2008, Free Software Foundation, Inc.
+ */
+
+/*
+ * Compilation of the differential equations into register code, and the
+ * derivative evaluator (field) that runs it.  The code is shared by all
+ * runs (e.g. the members of an ensemble); each has registers of its own.
+ *
+ * Before each solve, the stack lists of all the equations are lowered
+ * into one contiguous array of three-address instructions.  Registers
+ * 0..nsyms-1 hold the values of the symbols, in symbol table order (they
+ * are the run's r_value, so the numerical routines set them directly); the
+ * rest hold constants (set once, here) and intermediate results.
+ * Operations on constants are folded, and an operation that has already
+ * been computed from the same registers, by the same equation or by an
+ * earlier one, is not computed again.  Instructions stay in the order in
+ * which eval() would perform them, so results (and run-time errors) are
+ * exactly those of the interpreter.  A power with a small integer
+ * exponent becomes a chain of multiplications.  Instructions whose
+ * operands do not change with time are run only when they must be (see
+ * hoist()).
+ *
+ * For the stiff solver, the code is then differentiated symbolically,
+ * with respect to each variable in turn, and instructions computing the
+ * partial derivatives (the Jacobian of the field) are appended to it.
+ * They use the registers left by field(), and share their constants and
+ * subexpressions with the equations and with each other.  A builtin
+ * function with no derivative rule (e.g. ibeta) makes the derivatives
+ * that depend on it unknown; they are found by finite differences.
+ *
+ * Last come the conditions of until and event statements, which are
+ * evaluated separately (see event.c), and so share no intermediate
+ * results with the code before them.
+ */
+
+#include "sys-defines.h"
+#include "ode.h"
+#include "extern.h"
+
+static double *reg = NULL;	/* initial registers (holding the constants) */
+static int *def;		/* defining instruction, or -1 */
+static int nsyms, nregs, maxregs;
+static struct insn *code = NULL;
+static int ninsns;
+static struct eqn *eqns = NULL;
+static int neqns;
+
+/* the equations' code without its time-invariant instructions, and the
+   symbols that those instructions read */
+static struct insn *vcode = NULL;
+static int *hoist_in = NULL;
+static int nhoist, nhoist_in;
+
+/* the entries of the Jacobian that are not identically zero, column by
+   column: entry e is d(eqn jac_row[e])/d(symbol of eqn jac_col[e]), or
+   d(eqn jac_row[e])/dt if jac_col[e] is neqns, and is in register
+   jac_reg[e] or is JAC_FD; column j is entries jac_first[j] on */
+#define JAC_ZERO (-1)		/* identically zero */
+#define JAC_FD (-2)		/* unknown: use finite differences */
+static int *jac_row = NULL, *jac_col = NULL, *jac_reg = NULL;
+static int *jac_first = NULL;
+static int njac;
+static bool *fdcol = NULL;	/* does the column have JAC_FD entries? */
+static int jac_start, jac_end;	/* the instructions of the Jacobian code */
+
+/* the instructions of the conditions of until and event statements */
+static struct eqn evcode[NEVENTS];
+
+/* hash table of registers, for sharing constants and common subexpressions */
+static int *htab;
+static unsigned int hmask;
+static int share_from;		/* first instruction whose result is shared */
+
+static bool fold (op_type op, double x, double y, double *result);
+static bool same_node (int r, op_type op, int a, int b, int c, double value);
+static int node (op_type op, int a, int b, int c, double value);
+static int power_chain (int a, int n);
+static int nargs (op_type op);
+static int lower (const struct expr *ep, int *stk);
+static unsigned int hash_node (op_type op, int a, int b, int c, double value);
+static void grow (void);
+static void hoist (void);
+static bool hoisted_stale (const double *r, int stride);
+static void hoisted_save (double *r, int stride);
+static void differentiate (void);
+static int compare_int (const void *a, const void *b);
+static int derivative (const struct insn *ip, const int *d);
+static bool is_const (int r, double value);
+static int konst (double value);
+static int nonzero (int r);
+static int dsum (int da, int db);
+static int ddiff (int da, int db);
+static int dprod (int da, int x);
+static int dquot (int da, int x);
+static void execute (const struct insn *ip, const struct insn *end, double *r);
+static void execute_lanes (const struct insn *ip, const struct insn *end,
+			   double *r, struct lanes *lp, const struct sym *sp);
+static void lane_error (struct lanes *lp, int l, const struct sym *sp,
+			const char *s);
+
+/*
+ * number of operands that op takes from the stack
+ */
+static int
+nargs (op_type op)
+{
+  switch (op)
+    {
+    case O_CONST:
+    case O_IDENT:
+      return 0;
+    case O_PLUS:
+    case O_MINUS:
+    case O_MULT:
+    case O_DIV:
+    case O_POWER:
+    case O_IGAMMA:
+      return 2;
+    case O_IBETA:
+      return 3;
+    default:
+      return 1;
+    }
+}
+
+static unsigned int
+hash_node (op_type op, int a, int b, int c, double value)
+{
+  unsigned int h = (unsigned int)op;
+
+  if (op == O_CONST)
+    {
+      unsigned char bytes[sizeof (double)];
+      size_t i;
+
+      memcpy (bytes, &value, sizeof (double));
+      for (i = 0; i < sizeof (double); i++)
+	h = h * 31 + bytes[i];
+    }
+  else
+    h = ((h * 31 + (unsigned int)a) * 31 + (unsigned int)b) * 31
+      + (unsigned int)c;
+  return h ^ (h >> 16);
+}
+
+/*
+ * does register r hold the given operation (or, for O_CONST, the given
+ * constant, compared bit for bit)?
+ */
+static bool
+same_node (int r, op_type op, int a, int b, int c, double value)
+{
+  const struct insn *ip;
+
+  if (r < nsyms)
+    return false;
+  if (def[r] < 0)
+    return (op == O_CONST
+	    && memcmp (&reg[r], &value, sizeof (double)) == 0);
+  if (def[r] < share_from)
+    return false;
+  ip = &code[def[r]];
+  return (ip->in_oper == op && ip->in_a == a && ip->in_b == b
+	  && ip->in_c == c);
+}
+
+/*
+ * Compute op at compile time, if that is safe: the operation must be one
+ * that cannot trigger a run-time error or a math library exception, and
+ * the result must be finite.  Anything else is left for field() to do,
+ * so that errors are reported just as they were.
+ */
+static bool
+fold (op_type op, double x, double y, double *result)
+{
+  double r;
+
+  switch (op)
+    {
+    case O_PLUS:
+      r = x + y;
+      break;
+    case O_MINUS:
+      r = x - y;
+      break;
+    case O_MULT:
+      r = x * y;
+      break;
+    case O_DIV:
+      if (y == 0)
+	return false;
+      r = x / y;
+      break;
+    case O_POWER:
+      if ((y != (int)y) && (x < 0))
+	return false;
+      r = pow (x, y);
+      break;
+    case O_SQAR:
+      r = x * x;
+      break;
+    case O_CUBE:
+      r = x * (x * x);
+      break;
+    case O_INV:
+      if (x == 0)
+	return false;
+      r = 1. / x;
+      break;
+    case O_SQRT:
+      if (x < 0)
+	return false;
+      r = sqrt (x);
+      break;
+    case O_SIN:
+      r = sin (x);
+      break;
+    case O_COS:
+      r = cos (x);
+      break;
+    case O_TAN:
+      r = tan (x);
+      break;
+    case O_ATAN:
+      r = atan (x);
+      break;
+    case O_ABS:
+      r = x;
+      if (r < 0)
+	r = -r;
+      break;
+    case O_EXP:
+      r = exp (x);
+      break;
+    case O_LOG:
+      if (x <= 0)
+	return false;
+      r = log (x);
+      break;
+    case O_LOG10:
+      if (x <= 0)
+	return false;
+      r = log10 (x);
+      break;
+    case O_SINH:
+      r = sinh (x);
+      break;
+    case O_COSH:
+      r = cosh (x);
+      break;
+    case O_TANH:
+      r = tanh (x);
+      break;
+    case O_ASINH:
+      r = asinh (x);
+      break;
+    case O_FLOOR:
+      r = floor (x);
+      break;
+    case O_CEIL:
+      r = ceil (x);
+      break;
+    case O_NEG:
+      r = -x;
+      break;
+    default:
+      return false;
+    }
+
+  if (r - r != 0.0)		/* infinite or NaN */
+    return false;
+  *result = r;
+  return true;
+}
+
+/*
+ * return the register holding op applied to registers a, b, c (or, for
+ * O_CONST, holding value), emitting an instruction if need be
+ */
+static int
+node (op_type op, int a, int b, int c, double value)
+{
+  unsigned int h;
+  int r, n;
+
+  if (op == O_POWER && b >= nsyms && def[b] < 0 && IS_IPOW (reg[b]))
+    return power_chain (a, (int)reg[b]);
+
+  n = nargs (op);
+  if (op != O_CONST && n > 0
+      && a >= nsyms && def[a] < 0
+      && (n < 2 || (b >= nsyms && def[b] < 0))
+      && n < 3
+      && fold (op, reg[a], n > 1 ? reg[b] : 0.0, &value))
+    op = O_CONST;
+  if (op == O_CONST)
+    a = b = c = -1;
+
+  for (h = hash_node (op, a, b, c, value) & hmask; htab[h] >= 0;
+       h = (h + 1) & hmask)
+    if (same_node (htab[h], op, a, b, c, value))
+      return htab[h];
+
+  if (nregs == maxregs)
+    {
+      grow ();
+      for (h = hash_node (op, a, b, c, value) & hmask; htab[h] >= 0;
+	   h = (h + 1) & hmask)
+	;
+    }
+  r = nregs++;
+  htab[h] = r;
+  if (op == O_CONST)
+    {
+      reg[r] = value;
+      def[r] = -1;
+    }
+  else
+    {
+      struct insn *ip = &code[ninsns];
+
+      ip->in_oper = op;
+      ip->in_dst = r;
+      ip->in_a = a;
+      ip->in_b = b;
+      ip->in_c = c;
+      def[r] = ninsns++;
+    }
+  return r;
+}
+
+/*
+ * return the register holding a^n, for an integer n (see IS_IPOW),
+ * computed by the multiplications ipow() does
+ */
+static int
+power_chain (int a, int n)
+{
+  int r = -1, p = a;
+  bool invert = (n < 0);
+
+  if (n == 0)
+    return konst (1.0);
+  if (invert)
+    n = -n;
+  while (n > 0)
+    {
+      if (n & 1)
+	r = (r < 0 ? p : node (O_MULT, r, p, -1, 0.0));
+      n >>= 1;
+      if (n > 0)
+	p = node (O_SQAR, p, -1, -1, 0.0);
+    }
+  return (invert ? node (O_INV, r, -1, -1, 0.0) : r);
+}
+
+/*
+ * double the room for registers and instructions (only differentiation
+ * can run out of it), and rebuild the hash table to match
+ */
+static void
+grow (void)
+{
+  unsigned int hsize, h;
+  const struct insn *ip;
+  int r;
+
+  maxregs *= 2;
+  reg = (double *)xrealloc (reg, maxregs * sizeof (double));
+  def = (int *)xrealloc (def, maxregs * sizeof (int));
+  code = (struct insn *)xrealloc (code, (maxregs - nsyms + 1)
+				  * sizeof (struct insn));
+  free (htab);
+  for (hsize = 1; hsize < 2 * (unsigned int)maxregs; hsize <<= 1)
+    ;
+  hmask = hsize - 1;
+  htab = (int *)xmalloc (hsize * sizeof (int));
+  for (h = 0; h < hsize; h++)
+    htab[h] = -1;
+  for (r = nsyms; r < nregs; r++)
+    {
+      if (def[r] < 0)
+	h = hash_node (O_CONST, -1, -1, -1, reg[r]);
+      else
+	{
+	  ip = &code[def[r]];
+	  h = hash_node (ip->in_oper, ip->in_a, ip->in_b, ip->in_c, 0.0);
+	}
+      for (h &= hmask; htab[h] >= 0; h = (h + 1) & hmask)
+	;
+      htab[h] = r;
+    }
+}
+
+/*
+ * compile the equations of the dependent variables in dqueue, and if
+ * jac_wanted is set, their Jacobian (called by solve, after check)
+ */
+void
+compile (bool jac_wanted)
+{
+  const struct expr *ep;
+  struct sym *sp;
+  int *stk;
+  int maxdepth, len, i, k;
+  unsigned int hsize;
+
+  free (reg);
+  free (code);
+  free (vcode);
+  free (hoist_in);
+  free (eqns);
+  free (symvec);
+  free (jac_row);
+  free (jac_col);
+  free (jac_reg);
+  free (jac_first);
+  free (fdcol);
+  jac_row = jac_col = jac_reg = jac_first = NULL;
+  njac = 0;
+  fdcol = NULL;
+
+  /* size everything for the worst case: nothing shared */
+  nsyms = neqns = 0;
+  maxregs = maxdepth = 0;
+  for (sp = symtab; sp != NULL; sp = sp->sy_link)
+    {
+      nsyms++;
+      if (sp == symtab)
+	continue;
+      neqns++;
+      for (len = 0, ep = sp->sy_expr; ep != NULL; ep = ep->ex_next)
+	len++;
+      maxregs += len;
+      if (len > maxdepth)
+	maxdepth = len;
+    }
+  for (k = 0; k < NEVENTS; k++)
+    {
+      for (len = 0, ep = evexpr[k]; ep != NULL; ep = ep->ex_next)
+	len++;
+      maxregs += len;
+      if (len > maxdepth)
+	maxdepth = len;
+    }
+  maxregs += nsyms;
+  for (hsize = 1; hsize < 2 * (unsigned int)maxregs; hsize <<= 1)
+    ;
+  hmask = hsize - 1;
+
+  reg = (double *)xmalloc (maxregs * sizeof (double));
+  def = (int *)xmalloc (maxregs * sizeof (int));
+  code = (struct insn *)xmalloc ((maxregs - nsyms + 1) * sizeof (struct insn));
+  eqns = (struct eqn *)xmalloc ((neqns + 1) * sizeof (struct eqn));
+  symvec = (struct sym **)xmalloc (nsyms * sizeof (struct sym *));
+  htab = (int *)xmalloc (hsize * sizeof (int));
+  stk = (int *)xmalloc ((maxdepth + 1) * sizeof (int));
+  for (i = 0; i < (int)hsize; i++)
+    htab[i] = -1;
+
+  for (i = 0, sp = symtab; sp != NULL; sp = sp->sy_link, i++)
+    {
+      sp->sy_index = i;
+      symvec[i] = sp;
+      reg[i] = 0.0;
+      def[i] = -1;
+    }
+  nregs = nsyms;
+  ninsns = 0;
+  share_from = 0;
+
+  for (i = 0, sp = symtab->sy_link; sp != NULL; sp = sp->sy_link, i++)
+    {
+      eqns[i].eq_index = sp->sy_index;
+      eqns[i].eq_start = ninsns;
+      eqns[i].eq_result = lower (sp->sy_expr, stk);
+      eqns[i].eq_end = ninsns;
+    }
+  hoist ();
+
+  if (jac_wanted)
+    differentiate ();
+  jac_end = ninsns;
+
+  /* Each condition is run on its own (by event_value), so it may share
+     constants, but no results of instructions, with the rest. */
+  for (k = 0; k < NEVENTS; k++)
+    if (evexpr[k] != NULL)
+      {
+	share_from = ninsns;
+	evcode[k].eq_index = -1;
+	evcode[k].eq_start = ninsns;
+	evcode[k].eq_result = lower (evexpr[k], stk);
+	evcode[k].eq_end = ninsns;
+      }
+
+  free (stk);
+  free (htab);
+  free (def);
+}
+
+/*
+ * Find the instructions of the equations whose operands are all
+ * time-invariant: constants, symbols whose derivative is identically
+ * zero, and the results of other such instructions.  Their results stay
+ * in a run's registers, so field() runs them again only when a symbol
+ * they read is not what it was the last time they were run (as at the
+ * first call, or when jacobian() perturbs the symbol); otherwise it runs
+ * vcode, which is the code of each equation without them.  Errors are
+ * therefore reported exactly as if everything were run every time.
+ */
+static void
+hoist (void)
+{
+  const struct insn *ip;
+  bool *inv, *read;
+  int i, j, k, n;
+
+  inv = (bool *)xmalloc (nregs * sizeof (bool));
+  read = (bool *)xmalloc (nsyms * sizeof (bool));
+  for (i = 0; i < nregs; i++)
+    inv[i] = (i >= nsyms && def[i] < 0);
+  for (i = 0; i < nsyms; i++)
+    read[i] = false;
+  for (i = 0; i < neqns; i++)
+    if (is_const (eqns[i].eq_result, 0.0))
+      inv[eqns[i].eq_index] = true;
+
+  vcode = (struct insn *)xmalloc ((ninsns + 1) * sizeof (struct insn));
+  hoist_in = (int *)xmalloc ((nsyms + 1) * sizeof (int));
+  nhoist = nhoist_in = n = 0;
+  for (i = 0; i < neqns; i++)
+    {
+      eqns[i].eq_vstart = n;
+      for (j = eqns[i].eq_start; j < eqns[i].eq_end; j++)
+	{
+	  ip = &code[j];
+	  k = nargs (ip->in_oper);
+	  if (!(inv[ip->in_a] && (k < 2 || inv[ip->in_b])
+		&& (k < 3 || inv[ip->in_c])))
+	    {
+	      vcode[n++] = *ip;
+	      continue;
+	    }
+	  inv[ip->in_dst] = true;
+	  nhoist++;
+	  if (ip->in_a < nsyms)
+	    read[ip->in_a] = true;
+	  if (k > 1 && ip->in_b < nsyms)
+	    read[ip->in_b] = true;
+	  if (k > 2 && ip->in_c < nsyms)
+	    read[ip->in_c] = true;
+	}
+      eqns[i].eq_vend = n;
+    }
+  for (i = 0; i < nsyms; i++)
+    if (read[i])
+      hoist_in[nhoist_in++] = i;
+  free (read);
+  free (inv);
+}
+
+/*
+ * must the time-invariant instructions be run again on the registers r
+ * (stride of them to a register, side by side)?  After they are run,
+ * hoisted_save() keeps the symbols they read after the other registers.
+ */
+static bool
+hoisted_stale (const double *r, int stride)
+{
+  size_t size = stride * sizeof (double);
+  int j;
+
+  for (j = 0; j < nhoist_in; j++)
+    if (memcmp (r + hoist_in[j] * stride, r + (nregs + j) * stride, size))
+      return true;
+  return false;
+}
+
+static void
+hoisted_save (double *r, int stride)
+{
+  size_t size = stride * sizeof (double);
+  int j;
+
+  for (j = 0; j < nhoist_in; j++)
+    memcpy (r + (nregs + j) * stride, r + hoist_in[j] * stride, size);
+}
+
+/*
+ * append the instructions for the stack code ep, using stk as the stack
+ * (which must be deep enough); the value is the register of the result
+ */
+static int
+lower (const struct expr *ep, int *stk)
+{
+  int depth;
+
+  for (depth = 0; ep != NULL; ep = ep->ex_next)
+    {
+      switch (nargs (ep->ex_oper))
+	{
+	case 0:
+	  if (ep->ex_oper == O_IDENT)
+	    stk[depth++] = ep->ex_sym->sy_index;
+	  else
+	    stk[depth++] = node (O_CONST, -1, -1, -1, ep->ex_value);
+	  break;
+	case 1:
+	  stk[depth - 1] = node (ep->ex_oper, stk[depth - 1], -1, -1, 0.0);
+	  break;
+	case 2:
+	  depth--;
+	  stk[depth - 1] = node (ep->ex_oper, stk[depth - 1], stk[depth],
+				 -1, 0.0);
+	  break;
+	case 3:
+	  depth -= 2;
+	  stk[depth - 1] = node (ep->ex_oper, stk[depth - 1], stk[depth],
+				 stk[depth + 1], 0.0);
+	  break;
+	}
+    }
+  if (depth != 1)
+    panicn ("bad expression (stack depth %d) in compile()", depth);
+  return stk[0];
+}
+
+/*
+ * Differentiation.  In the derivative code, JAC_ZERO stands for a
+ * derivative that is identically zero, so that none is computed for it.
+ */
+
+static bool
+is_const (int r, double value)
+{
+  return (r >= nsyms && def[r] < 0 && reg[r] == value);
+}
+
+static int
+konst (double value)
+{
+  return node (O_CONST, -1, -1, -1, value);
+}
+
+static int
+nonzero (int r)
+{
+  return (is_const (r, 0.0) ? JAC_ZERO : r);
+}
+
+/* da + db */
+static int
+dsum (int da, int db)
+{
+  if (da == JAC_ZERO)
+    return db;
+  if (db == JAC_ZERO)
+    return da;
+  return nonzero (node (O_PLUS, da, db, -1, 0.0));
+}
+
+/* da - db */
+static int
+ddiff (int da, int db)
+{
+  if (db == JAC_ZERO)
+    return da;
+  if (da == JAC_ZERO)
+    return nonzero (node (O_NEG, db, -1, -1, 0.0));
+  return nonzero (node (O_MINUS, da, db, -1, 0.0));
+}
+
+/* da * x */
+static int
+dprod (int da, int x)
+{
+  if (da == JAC_ZERO || is_const (x, 0.0))
+    return JAC_ZERO;
+  if (is_const (x, 1.0))
+    return da;
+  if (is_const (da, 1.0))
+    return x;
+  return nonzero (node (O_MULT, da, x, -1, 0.0));
+}
+
+/* da / x */
+static int
+dquot (int da, int x)
+{
+  if (da == JAC_ZERO)
+    return JAC_ZERO;
+  return nonzero (node (O_DIV, da, x, -1, 0.0));
+}
+
+/*
+ * the register holding the derivative of the result of instruction ip,
+ * given those of its operands in d (or JAC_ZERO, or JAC_FD)
+ */
+static int
+derivative (const struct insn *ip, const int *d)
+{
+  int a = ip->in_a, b = ip->in_b, u = ip->in_dst;
+  int da, db = JAC_ZERO, dc = JAC_ZERO;
+
+  da = d[a];
+  if (nargs (ip->in_oper) > 1)
+    db = d[b];
+  if (nargs (ip->in_oper) > 2)
+    dc = d[ip->in_c];
+  if (da == JAC_ZERO && db == JAC_ZERO && dc == JAC_ZERO)
+    return JAC_ZERO;
+  if (da == JAC_FD || db == JAC_FD || dc == JAC_FD)
+    return JAC_FD;
+
+  switch (ip->in_oper)
+    {
+    case O_PLUS:
+      return dsum (da, db);
+    case O_MINUS:
+      return ddiff (da, db);
+    case O_MULT:
+      return dsum (dprod (da, b), dprod (db, a));
+    case O_DIV:			/* (da - u db) / b */
+      return dquot (ddiff (da, dprod (db, u)), b);
+    case O_POWER:		/* b a^(b-1) da + u log(a) db */
+      return dsum (dprod (da, node (O_MULT, b,
+				    node (O_POWER, a,
+					  node (O_MINUS, b, konst (1.0),
+						-1, 0.0),
+					  -1, 0.0),
+				    -1, 0.0)),
+		   dprod (db, node (O_MULT, u,
+				    node (O_LOG, a, -1, -1, 0.0), -1, 0.0)));
+    case O_SQAR:
+      return dprod (da, node (O_MULT, konst (2.0), a, -1, 0.0));
+    case O_CUBE:
+      return dprod (da, node (O_MULT, konst (3.0),
+			      node (O_SQAR, a, -1, -1, 0.0), -1, 0.0));
+    case O_INV:
+      return dprod (da, node (O_NEG, node (O_SQAR, u, -1, -1, 0.0),
+			      -1, -1, 0.0));
+    case O_SQRT:
+      return dquot (da, node (O_MULT, konst (2.0), u, -1, 0.0));
+    case O_EXP:
+      return dprod (da, u);
+    case O_LOG:
+      return dquot (da, a);
+    case O_LOG10:
+      return dquot (da, node (O_MULT, a, konst (log (10.0)), -1, 0.0));
+    case O_SIN:
+      return dprod (da, node (O_COS, a, -1, -1, 0.0));
+    case O_COS:
+      return dprod (da, node (O_NEG, node (O_SIN, a, -1, -1, 0.0),
+			      -1, -1, 0.0));
+    case O_TAN:
+      return dprod (da, node (O_PLUS, konst (1.0),
+			      node (O_SQAR, u, -1, -1, 0.0), -1, 0.0));
+    case O_ASIN:
+      return dquot (da, node (O_SQRT,
+			      node (O_MINUS, konst (1.0),
+				    node (O_SQAR, a, -1, -1, 0.0), -1, 0.0),
+			      -1, -1, 0.0));
+    case O_ACOS:
+      return dquot (da, node (O_NEG,
+			      node (O_SQRT,
+				    node (O_MINUS, konst (1.0),
+					  node (O_SQAR, a, -1, -1, 0.0),
+					  -1, 0.0),
+				    -1, -1, 0.0),
+			      -1, -1, 0.0));
+    case O_ATAN:
+      return dquot (da, node (O_PLUS, konst (1.0),
+			      node (O_SQAR, a, -1, -1, 0.0), -1, 0.0));
+    case O_SINH:
+      return dprod (da, node (O_COSH, a, -1, -1, 0.0));
+    case O_COSH:
+      return dprod (da, node (O_SINH, a, -1, -1, 0.0));
+    case O_TANH:
+      return dprod (da, node (O_MINUS, konst (1.0),
+			      node (O_SQAR, u, -1, -1, 0.0), -1, 0.0));
+    case O_ASINH:
+      return dquot (da, node (O_SQRT,
+			      node (O_PLUS, node (O_SQAR, a, -1, -1, 0.0),
+				    konst (1.0), -1, 0.0),
+			      -1, -1, 0.0));
+    case O_ACOSH:
+      return dquot (da, node (O_SQRT,
+			      node (O_MINUS, node (O_SQAR, a, -1, -1, 0.0),
+				    konst (1.0), -1, 0.0),
+			      -1, -1, 0.0));
+    case O_ATANH:
+      return dquot (da, node (O_MINUS, konst (1.0),
+			      node (O_SQAR, a, -1, -1, 0.0), -1, 0.0));
+    case O_NEG:
+      return ddiff (JAC_ZERO, da);
+    case O_FLOOR:
+    case O_CEIL:
+      return JAC_ZERO;		/* almost everywhere */
+    case O_J0:
+      return dprod (da, node (O_NEG, node (O_J1, a, -1, -1, 0.0),
+			      -1, -1, 0.0));
+    case O_ERF:			/* 2/sqrt(pi) exp(-a^2) da */
+      return dprod (da, node (O_MULT, konst (2.0 / sqrt (M_PI)),
+			      node (O_EXP,
+				    node (O_NEG,
+					  node (O_SQAR, a, -1, -1, 0.0),
+					  -1, -1, 0.0),
+				    -1, -1, 0.0),
+			      -1, 0.0));
+    case O_ERFC:
+      return dprod (da, node (O_MULT, konst (-2.0 / sqrt (M_PI)),
+			      node (O_EXP,
+				    node (O_NEG,
+					  node (O_SQAR, a, -1, -1, 0.0),
+					  -1, -1, 0.0),
+				    -1, -1, 0.0),
+			      -1, 0.0));
+    case O_NORM:		/* exp(-a^2/2)/sqrt(2 pi) da */
+      return dprod (da, node (O_MULT, konst (1.0 / sqrt (2.0 * M_PI)),
+			      node (O_EXP,
+				    node (O_MULT, konst (-0.5),
+					  node (O_SQAR, a, -1, -1, 0.0),
+					  -1, 0.0),
+				    -1, -1, 0.0),
+			      -1, 0.0));
+    case O_INVERF:		/* sqrt(pi)/2 exp(u^2) da */
+      return dprod (da, node (O_MULT, konst (0.5 * sqrt (M_PI)),
+			      node (O_EXP, node (O_SQAR, u, -1, -1, 0.0),
+				    -1, -1, 0.0),
+			      -1, 0.0));
+    case O_INVNORM:		/* sqrt(2 pi) exp(u^2/2) da */
+      return dprod (da, node (O_MULT, konst (sqrt (2.0 * M_PI)),
+			      node (O_EXP,
+				    node (O_MULT, konst (0.5),
+					  node (O_SQAR, u, -1, -1, 0.0),
+					  -1, 0.0),
+				    -1, -1, 0.0),
+			      -1, 0.0));
+    default:			/* abs, j1, y0, gamma, lgamma, igamma, ibeta */
+      return JAC_FD;
+    }
+}
+
+static int
+compare_int (const void *a, const void *b)
+{
+  return *(const int *)a - *(const int *)b;
+}
+
+/*
+ * append the code for the Jacobian (called by compile, before the hash
+ * table is freed).  The derivatives with respect to a variable are taken
+ * only through the instructions that depend on it, which are found by
+ * following the uses of registers, so that the work and the space go
+ * with the number of nonzero entries rather than the size of the matrix.
+ */
+static void
+differentiate (void)
+{
+  struct insn in;
+  int *d, *ufirst, *uses, *rfirst, *reqns, *list, *deps;
+  bool *mark;
+  int nprimal = ninsns, nprimregs = nregs, ncols = neqns + 1;
+  int maxjac = 2 * ncols, nlist, ndeps, first;
+  int i, j, k, r, u, op[3];
+
+  d = (int *)xmalloc (nprimregs * sizeof (int));
+  mark = (bool *)xmalloc ((nprimal + 1) * sizeof (bool));
+  list = (int *)xmalloc ((nprimal + 1) * sizeof (int));
+  deps = (int *)xmalloc ((nprimal + 1) * sizeof (int));
+
+  /* the instructions using each register, and the equations whose
+     derivative each register holds, as lists starting at ufirst[r] in
+     uses and at rfirst[r] in reqns */
+  ufirst = (int *)xmalloc ((nprimregs + 1) * sizeof (int));
+  rfirst = (int *)xmalloc ((nprimregs + 1) * sizeof (int));
+  uses = (int *)xmalloc ((3 * nprimal + 1) * sizeof (int));
+  reqns = (int *)xmalloc ((neqns + 1) * sizeof (int));
+  for (r = 0; r <= nprimregs; r++)
+    ufirst[r] = rfirst[r] = 0;
+  for (k = 0; k < nprimal; k++)
+    {
+      op[0] = code[k].in_a;
+      op[1] = code[k].in_b;
+      op[2] = code[k].in_c;
+      for (u = 0; u < nargs (code[k].in_oper); u++)
+	ufirst[op[u] + 1]++;
+    }
+  for (i = 0; i < neqns; i++)
+    rfirst[eqns[i].eq_result + 1]++;
+  for (r = 0; r < nprimregs; r++)
+    {
+      ufirst[r + 1] += ufirst[r];
+      rfirst[r + 1] += rfirst[r];
+    }
+  for (k = 0; k < nprimal; k++)
+    {
+      op[0] = code[k].in_a;
+      op[1] = code[k].in_b;
+      op[2] = code[k].in_c;
+      for (u = 0; u < nargs (code[k].in_oper); u++)
+	uses[ufirst[op[u]]++] = k;
+    }
+  for (i = 0; i < neqns; i++)
+    reqns[rfirst[eqns[i].eq_result]++] = i;
+  for (r = nprimregs; r > 0; r--)
+    {
+      ufirst[r] = ufirst[r - 1];
+      rfirst[r] = rfirst[r - 1];
+    }
+  ufirst[0] = rfirst[0] = 0;
+
+  jac_row = (int *)xmalloc (maxjac * sizeof (int));
+  jac_col = (int *)xmalloc (maxjac * sizeof (int));
+  jac_reg = (int *)xmalloc (maxjac * sizeof (int));
+  jac_first = (int *)xmalloc ((ncols + 1) * sizeof (int));
+  fdcol = (bool *)xmalloc (ncols * sizeof (bool));
+  for (r = 0; r < nprimregs; r++)
+    d[r] = JAC_ZERO;
+  for (k = 0; k < nprimal; k++)
+    mark[k] = false;
+  jac_start = ninsns;
+  njac = 0;
+
+  for (j = 0; j < ncols; j++)
+    {
+      /* the registers that depend on the variable (deps) and the
+         instructions that compute them (list), in the order of the code */
+      deps[0] = (j < neqns ? eqns[j].eq_index : 0);
+      d[deps[0]] = konst (1.0);
+      for (nlist = 0, ndeps = 1, r = 0; r < ndeps; r++)
+	for (u = ufirst[deps[r]]; u < ufirst[deps[r] + 1]; u++)
+	  if (!mark[k = uses[u]])
+	    {
+	      mark[k] = true;
+	      list[nlist++] = k;
+	      deps[ndeps++] = code[k].in_dst;
+	    }
+      qsort (list, nlist, sizeof (int), compare_int);
+      for (k = 0; k < nlist; k++)
+	{
+	  in = code[list[k]];	/* node() may move the code */
+	  mark[list[k]] = false;
+	  d[in.in_dst] = derivative (&in, d);
+	}
+
+      /* the entries of the column, by equation */
+      first = jac_first[j] = njac;
+      for (r = 0; r < ndeps; r++)
+	for (u = rfirst[deps[r]]; u < rfirst[deps[r] + 1]; u++)
+	  if (d[deps[r]] != JAC_ZERO)
+	    {
+	      if (njac == maxjac)
+		{
+		  maxjac *= 2;
+		  jac_row = (int *)xrealloc (jac_row, maxjac * sizeof (int));
+		  jac_col = (int *)xrealloc (jac_col, maxjac * sizeof (int));
+		  jac_reg = (int *)xrealloc (jac_reg, maxjac * sizeof (int));
+		}
+	      jac_row[njac++] = reqns[u];
+	    }
+      qsort (jac_row + first, njac - first, sizeof (int), compare_int);
+      fdcol[j] = false;
+      for (k = first; k < njac; k++)
+	{
+	  jac_col[k] = j;
+	  jac_reg[k] = d[eqns[jac_row[k]].eq_result];
+	  if (jac_reg[k] == JAC_FD)
+	    fdcol[j] = true;
+	}
+      for (r = 0; r < ndeps; r++)
+	d[deps[r]] = JAC_ZERO;
+    }
+  jac_first[ncols] = njac;
+
+  free (d);
+  free (mark);
+  free (list);
+  free (deps);
+  free (ufirst);
+  free (rfirst);
+  free (uses);
+  free (reqns);
+}
+
+/*
+ * the entries of the Jacobian that may be nonzero, column by column and
+ * by row within a column: entry e is d(eqn rows[e])/d(symbol of eqn
+ * cols[e]), or d(eqn rows[e])/dt if cols[e] is the number of equations.
+ * Returns the number of entries; the arrays last until the next compile.
+ */
+int
+jacobian_pattern (const int **rows, const int **cols)
+{
+  *rows = jac_row;
+  *cols = jac_col;
+  return njac;
+}
+
+/*
+ * Find the Jacobian of the field at the current values of the symbols;
+ * field() must have been called for them last.  values[e] is entry e of
+ * the pattern given by jacobian_pattern().  scratch must have room for a
+ * value for each equation.
+ */
+void
+jacobian (struct run *rp, double *values, double *scratch)
+{
+  double *r = rp->r_reg;
+  double save, delta;
+  int n = neqns, ncols = neqns + 1;
+  int i, j, e, k;
+  bool saved = false;
+
+  execute (code + jac_start, code + jac_end, r);
+  for (e = 0; e < njac; e++)
+    values[e] = (jac_reg[e] >= 0 ? r[jac_reg[e]] : 0.0);
+
+  for (j = 0; j < ncols; j++)
+    {
+      if (!fdcol[j])
+	continue;
+      if (!saved)
+	{
+	  for (i = 0; i < n; i++)
+	    scratch[i] = rp->r_prime[eqns[i].eq_index];
+	  saved = true;
+	}
+      k = (j < n ? eqns[j].eq_index : 0);
+      save = rp->r_value[k];
+      delta = sqrt (DBL_EPSILON) * (fabs (save) > 1.0 ? fabs (save) : 1.0);
+      rp->r_value[k] = save + delta;
+      delta = rp->r_value[k] - save;
+      field (rp);
+      rp->r_value[k] = save;
+      for (e = jac_first[j]; e < jac_first[j + 1]; e++)
+	if (jac_reg[e] == JAC_FD)
+	  {
+	    i = jac_row[e];
+	    values[e] = (rp->r_prime[eqns[i].eq_index] - scratch[i]) / delta;
+	  }
+    }
+  if (saved)
+    for (i = 0; i < n; i++)
+      rp->r_prime[eqns[i].eq_index] = scratch[i];
+}
+
+/*
+ * the value of the condition of an until statement (k = EV_UNTIL) or an
+ * event statement (EV_EVENT), at the current values of the symbols
+ */
+double
+event_value (struct run *rp, int k)
+{
+  double *r = rp->r_reg;
+
+  rp->r_fsp = NULL;
+  execute (code + evcode[k].eq_start, code + evcode[k].eq_end, r);
+  return r[evcode[k].eq_result];
+}
+
+/*
+ * a fresh set of registers for a run
+ */
+double *
+new_registers (void)
+{
+  double *r;
+
+  r = (double *)xmalloc ((nregs + nhoist_in) * sizeof (double));
+  memcpy (r, reg, nregs * sizeof (double));
+  return r;
+}
+
+/*
+ * a fresh set of registers for members run in lockstep (see struct lanes)
+ */
+double *
+new_lane_registers (void)
+{
+  double *r;
+  int i, l;
+
+  r = (double *)xmalloc ((nregs + nhoist_in) * LANES * sizeof (double));
+  for (i = 0; i < nregs; i++)
+    for (l = 0; l < LANES; l++)
+      r[i * LANES + l] = reg[i];
+  return r;
+}
+
+/*
+ * run the instructions from ip up to end on the registers r
+ */
+static void
+execute (const struct insn *ip, const struct insn *end, double *r)
+{
+  double x;
+
+  for ( ; ip < end; ip++)
+    {
+      x = r[ip->in_a];
+      switch (ip->in_oper)
+	{
+	case O_PLUS:
+	  x += r[ip->in_b];
+	  break;
+	case O_MINUS:
+	  x -= r[ip->in_b];
+	  break;
+	case O_MULT:
+	  x *= r[ip->in_b];
+	  break;
+	case O_DIV:
+	  x /= r[ip->in_b];
+	  break;
+	case O_POWER:
+	  if ((r[ip->in_b] != (int)r[ip->in_b]) && (x < 0))
+	    rterror("negative number to non-integer power");
+	  x = (IS_IPOW(r[ip->in_b]) ? ipow(x, (int)r[ip->in_b])
+	       : pow(x, r[ip->in_b]));
+	  break;
+	case O_SQAR:
+	  x *= x;
+	  break;
+	case O_CUBE:
+	  x *= x * x;
+	  break;
+	case O_INV:
+	  x = 1. / x;
+	  break;
+	case O_SQRT:
+	  if (x < 0)
+	    rterror("square root of a negative number");
+	  x = sqrt(x);
+	  break;
+	case O_SIN:
+	  x = sin(x);
+	  break;
+	case O_COS:
+	  x = cos(x);
+	  break;
+	case O_TAN:
+	  x = tan(x);
+	  break;
+	case O_ASIN:
+	  x = asin(x);
+	  break;
+	case O_ACOS:
+	  x = acos(x);
+	  break;
+	case O_ATAN:
+	  x = atan(x);
+	  break;
+	case O_ABS:
+	  if (x < 0)
+	    x = -x;
+	  break;
+	case O_EXP:
+	  x = exp(x);
+	  break;
+	case O_LOG:
+	  if (x <= 0)
+	    rterror("logarithm of non-positive number");
+	  x = log(x);
+	  break;
+	case O_LOG10:
+	  if (x <= 0)
+	    rterror("logarithm of non-positive number");
+	  x = log10(x);
+	  break;
+	case O_SINH:
+	  x = sinh(x);
+	  break;
+	case O_COSH:
+	  x = cosh(x);
+	  break;
+	case O_TANH:
+	  x = tanh(x);
+	  break;
+	case O_ASINH:
+	  x = asinh(x);
+	  break;
+	case O_ACOSH:
+	  x = acosh(x);
+	  break;
+	case O_ATANH:
+	  x = atanh(x);
+	  break;
+	case O_FLOOR:
+	  x = floor(x);
+	  break;
+	case O_CEIL:
+	  x = ceil(x);
+	  break;
+	case O_J0:
+	  x = j0(x);
+	  break;
+	case O_J1:
+	  x = j1(x);
+	  break;
+	case O_Y0:
+	  x = y0(x);
+	  break;
+	case O_GAMMA:
+	  x = f_gamma(x);
+	  break;
+	case O_LGAMMA:
+	  x = locked_lgamma(x);
+	  break;
+	case O_ERFC:
+	  x = erfc(x);
+	  break;
+	case O_ERF:
+	  x = erf(x);
+	  break;
+	case O_INVERF:
+	  x = inverf(x);
+	  break;
+	case O_NORM:
+	  x = norm(x);
+	  break;
+	case O_INVNORM:
+	  x = invnorm(x);
+	  break;
+	case O_NEG:
+	  x = -x;
+	  break;
+	case O_IGAMMA:
+	  x = igamma(x, r[ip->in_b]);
+	  break;
+	case O_IBETA:
+	  x = ibeta(x, r[ip->in_b], r[ip->in_c]);
+	  break;
+	default:
+	  panicn ("bad op spec (%d) in field()", (int)(ip->in_oper));
+	}
+      r[ip->in_dst] = x;
+    }
+}
+
+/*
+ * evaluate all the derivatives
+ */
+void
+field (struct run *rp)
+{
+  const struct eqn *eq, *eqend;
+  double *r = rp->r_reg;	/* the values are already in place */
+  bool all = (nhoist > 0 && (!rp->r_hoisted || hoisted_stale (r, 1)));
+
+  for (eq = eqns, eqend = eqns + neqns; eq < eqend; eq++)
+    {
+      rp->r_fsp = symvec[eq->eq_index];
+      if (all)
+	execute (code + eq->eq_start, code + eq->eq_end, r);
+      else
+	execute (vcode + eq->eq_vstart, vcode + eq->eq_vend, r);
+      rp->r_prime[eq->eq_index] = r[eq->eq_result];
+    }
+  rp->r_fsp = NULL;
+  if (all)
+    {
+      hoisted_save (r, 1);
+      rp->r_hoisted = true;
+    }
+}
+
+/*
+ * report a run-time error in the derivative of sp for lane l, which is
+ * then no longer live (its member would have stopped here if run alone)
+ */
+static void
+lane_error (struct lanes *lp, int l, const struct sym *sp, const char *s)
+{
+  struct run *rp = lp->l_run[l];
+
+  if (!lp->l_live[l])
+    return;
+  lp->l_live[l] = false;
+  rp->r_fsp = sp;
+  set_current_run (rp);
+  rtsquawks ("%s", s);
+  set_current_run (NULL);
+  rp->r_fsp = NULL;
+}
+
+/* apply an operation to every lane: y[l] = f(a[l], b[l], c[l]) */
+#define EACH_LANE(f) for (l = 0; l < LANES; l++) y[l] = (f)
+/* check every lane, and report those for which the condition holds */
+#define LANE_CHECK(cond, s) \
+  do \
+    { \
+      bad = false; \
+      for (l = 0; l < LANES; l++) \
+	bad |= (cond); \
+      if (bad) \
+	for (l = 0; l < LANES; l++) \
+	  if (cond) \
+	    lane_error (lp, l, sp, s); \
+    } \
+  while (0)
+
+/*
+ * run the instructions from ip up to end on the lanes of the registers
+ * r, for the derivative of sp; the arithmetic is that of execute(), so
+ * each lane gets the results its member would get on its own
+ */
+static void
+execute_lanes (const struct insn *ip, const struct insn *end, double *r,
+	       struct lanes *lp, const struct sym *sp)
+{
+  double y[LANES];		/* the result (a local can't alias a, b, c) */
+  const double *a, *b, *c;
+  bool bad;
+  int l;
+
+  for ( ; ip < end; ip++)
+    {
+      a = r + ip->in_a * LANES;
+      b = c = a;
+      if (nargs (ip->in_oper) > 1)
+	b = r + ip->in_b * LANES;
+      if (nargs (ip->in_oper) > 2)
+	c = r + ip->in_c * LANES;
+      switch (ip->in_oper)
+	{
+	case O_PLUS:
+	  EACH_LANE (a[l] + b[l]);
+	  break;
+	case O_MINUS:
+	  EACH_LANE (a[l] - b[l]);
+	  break;
+	case O_MULT:
+	  EACH_LANE (a[l] * b[l]);
+	  break;
+	case O_DIV:
+	  EACH_LANE (a[l] / b[l]);
+	  break;
+	case O_POWER:
+	  LANE_CHECK (b[l] != (int)b[l] && a[l] < 0,
+		      "negative number to non-integer power");
+	  EACH_LANE (IS_IPOW (b[l]) ? ipow (a[l], (int)b[l])
+		     : pow (a[l], b[l]));
+	  break;
+	case O_SQAR:
+	  EACH_LANE (a[l] * a[l]);
+	  break;
+	case O_CUBE:
+	  EACH_LANE (a[l] * (a[l] * a[l]));
+	  break;
+	case O_INV:
+	  EACH_LANE (1. / a[l]);
+	  break;
+	case O_SQRT:
+	  LANE_CHECK (a[l] < 0, "square root of a negative number");
+	  EACH_LANE (sqrt (a[l]));
+	  break;
+	case O_ABS:
+	  EACH_LANE (a[l] < 0 ? -a[l] : a[l]);
+	  break;
+	case O_LOG:
+	  LANE_CHECK (a[l] <= 0, "logarithm of non-positive number");
+	  EACH_LANE (log (a[l]));
+	  break;
+	case O_LOG10:
+	  LANE_CHECK (a[l] <= 0, "logarithm of non-positive number");
+	  EACH_LANE (log10 (a[l]));
+	  break;
+	case O_NEG:
+	  EACH_LANE (-a[l]);
+	  break;
+	default:
+	  /* no lanewise form: one lane at a time */
+	  for (l = 0; l < LANES; l++)
+	    {
+	      struct insn in;
+	      double t[3];
+
+	      t[0] = a[l];
+	      t[1] = b[l];
+	      t[2] = c[l];
+	      in.in_oper = ip->in_oper;
+	      in.in_a = 0;
+	      in.in_b = 1;
+	      in.in_c = 2;
+	      in.in_dst = 0;
+	      execute (&in, &in + 1, t);
+	      y[l] = t[0];
+	    }
+	  break;
+	}
+      memcpy (r + ip->in_dst * LANES, y, sizeof y);
+    }
+}
+
+/*
+ * evaluate all the derivatives, for every lane
+ */
+void
+field_lanes (struct lanes *lp)
+{
+  const struct eqn *eq, *eqend;
+  double *r = lp->l_reg;
+  bool all = (nhoist > 0 && (!lp->l_hoisted || hoisted_stale (r, LANES)));
+
+  for (eq = eqns, eqend = eqns + neqns; eq < eqend; eq++)
+    {
+      if (all)
+	execute_lanes (code + eq->eq_start, code + eq->eq_end, r, lp,
+		       symvec[eq->eq_index]);
+      else
+	execute_lanes (vcode + eq->eq_vstart, vcode + eq->eq_vend, r, lp,
+		       symvec[eq->eq_index]);
+      memcpy (lp->l_prime + eq->eq_index * LANES,
+	      r + eq->eq_result * LANES, LANES * sizeof (double));
+    }
+  if (all)
+    {
+      hoisted_save (r, LANES);
+      lp->l_hoisted = true;
+    }
+}
@@ -0,0 +1,261 @@
+/* This file is part of the GNU plotutils package. */
+
+/*
+ * Copyright (C) 2008, Free Software Foundation, Inc.
+ */
+
+/*
+ * Fifth-Order Dormand-Prince with adaptive step size and dense output
+ *
+ * The last stage of each step is evaluated at the new solution, so it
+ * serves as the first stage of the next step (`first same as last'),
+ * and a step costs six evaluations of the field rather than seven.
+ * The step size is chosen from the size of the error estimate, rather
+ * than only halved or doubled.  If an output spacing is given, values
+ * are printed at multiples of it by interpolating within the steps,
+ * which are not shortened to land on them.
+ */
+
+#include "sys-defines.h"
+#include "ode.h"
+#include "extern.h"
+#include "num.h"
+
+#define T_LT_TSTOP (h>0 ? t<tstop : t>tstop)
+/* is an output time at or too close to tstop to be printed separately? */
+#define NEARSTOP(tout) (dt>0 ? (tout)>=tstop-0.0625*dt \
+			: (tout)<=tstop-0.0625*dt)
+#define PASTSTEP(tout) (dt>0 ? (tout)>tnew : (tout)<tnew)
+
+#define SAFETY  0.9		/* aim below the error bound */
+#define FACMIN  0.2		/* most the step size may shrink at once */
+#define FACMAX  5.0		/* most the step size may grow at once */
+
+static void interpolate (struct run *rp, double theta, double h);
+
+void
+dp (struct run *rp)
+{
+  int i, n = rp->r_nsyms;
+  double *value = rp->r_value, *prime = rp->r_prime;
+  double *val0 = rp->r_val[0], *pri0 = rp->r_pri[0];
+  double *val1 = rp->r_val[1], *pri1 = rp->r_pri[1];
+  double *predi = rp->r_predi;
+  double *sserr = rp->r_sserr, *aberr = rp->r_aberr;
+  double *k0 = rp->r_k[0], *k1 = rp->r_k[1], *k2 = rp->r_k[2];
+  double *k3 = rp->r_k[3], *k4 = rp->r_k[4], *k5 = rp->r_k[5];
+  double *k6 = rp->r_k[6];
+  bool dense = conflag;		/* print at multiples of dt? */
+  bool rejected = false;	/* was the last attempt at a step rejected? */
+  bool last;			/* will this step reach tstop? */
+  double dt = rp->r_tstep;	/* output spacing, if dense */
+  double h = rp->r_tstep;	/* step size */
+  double t, tnew, tout, err, fac;
+  long k = 1;			/* number of the next output time */
+
+  t = tstart;
+  value[0] = val0[0] = t;
+  field (rp);
+  for (i = 1; i < n; i++)
+    {
+      val0[i] = value[i];
+      pri0[i] = prime[i];
+    }
+  rp->r_it = 0;
+  if (events (rp))
+    return;
+  printq (rp);			/* output */
+
+  while (T_LT_TSTOP)
+    {
+      if (hflag && fabs (h) > hmax)
+	h = (h > 0 ? hmax : -hmax);
+      if (fabs (h) < hmin)
+	h = (h > 0 ? hmin : -hmin);
+      last = (h * (t + h - tstop) >= 0);
+      if (last)
+	h = tstop - t;
+      tnew = (last ? tstop : t + h);
+
+      for (i = 1; i < n; i++)
+	{
+	  k0[i] = h * pri0[i];
+	  value[i] = val0[i]
+	    + DC20 * k0[i];
+	}
+      value[0] = t + DC2t * h;
+      field (rp);
+      for (i = 1; i < n; i++)
+	{
+	  k1[i] = h * prime[i];
+	  value[i] = val0[i]
+	    + (DC30 * k0[i]
+	       + DC31 * k1[i]);
+	}
+      value[0] = t + DC3t * h;
+      field (rp);
+      for (i = 1; i < n; i++)
+	{
+	  k2[i] = h * prime[i];
+	  value[i] = val0[i]
+	    + (DC40 * k0[i]
+	       + DC41 * k1[i]
+	       + DC42 * k2[i]);
+	}
+      value[0] = t + DC4t * h;
+      field (rp);
+      for (i = 1; i < n; i++)
+	{
+	  k3[i] = h * prime[i];
+	  value[i] = val0[i]
+	    + (DC50 * k0[i]
+	       + DC51 * k1[i]
+	       + DC52 * k2[i]
+	       + DC53 * k3[i]);
+	}
+      value[0] = t + DC5t * h;
+      field (rp);
+      for (i = 1; i < n; i++)
+	{
+	  k4[i] = h * prime[i];
+	  value[i] = val0[i]
+	    + (DC60 * k0[i]
+	       + DC61 * k1[i]
+	       + DC62 * k2[i]
+	       + DC63 * k3[i]
+	       + DC64 * k4[i]);
+	}
+      value[0] = tnew;
+      field (rp);
+      for (i = 1; i < n; i++)
+	{
+	  k5[i] = h * prime[i];
+	  value[i] = val0[i]
+	    + (DB0 * k0[i]
+	       + DB2 * k2[i]
+	       + DB3 * k3[i]
+	       + DB4 * k4[i]
+	       + DB5 * k5[i]);
+	}
+      field (rp);		/* at the new solution: first same as last */
+      for (i = 1; i < n; i++)
+	{
+	  double e;
+
+	  k6[i] = h * prime[i];
+	  e = (DE0 * k0[i]
+	       + DE2 * k2[i]
+	       + DE3 * k3[i]
+	       + DE4 * k4[i]
+	       + DE5 * k5[i]
+	       + DE6 * k6[i]);
+	  predi[i] = value[i] - e;
+	  aberr[i] = fabs (e);
+	  sserr[i] = (value[i] != 0.0 ? fabs (e / value[i]) : 0.0);
+	}
+
+      maxerr (rp);
+      err = rp->r_ssemax / ssmax;
+      if (err < rp->r_abemax / abmax)
+	err = rp->r_abemax / abmax;
+      rp->r_tstep = h;
+      if (hierror (rp))
+	{
+	  fac = SAFETY * pow (err, -0.2);
+	  h *= (fac < FACMIN ? FACMIN : fac);
+	  rejected = true;
+	  continue;
+	}
+
+      /* print at the output times in this step, from the interpolant */
+      if (dense)
+	{
+	  for (i = 1; i < n; i++)
+	    {
+	      val1[i] = value[i];
+	      pri1[i] = prime[i];
+	    }
+	  rp->r_tstep = dt;
+	  for (tout = tstart + k * dt;
+	       !NEARSTOP(tout) && !PASTSTEP(tout);
+	       tout = tstart + ++k * dt)
+	    {
+	      interpolate (rp, (tout - t) / h, h);
+	      value[0] = tout;
+	      rp->r_it = k;
+	      if (events (rp))
+		return;
+	      printq (rp);	/* output */
+	    }
+	  for (i = 1; i < n; i++)
+	    {
+	      value[i] = val1[i];
+	      prime[i] = pri1[i];
+	    }
+	}
+
+      t = tnew;
+      value[0] = val0[0] = t;
+      for (i = 1; i < n; i++)
+	{
+	  val0[i] = value[i];
+	  pri0[i] = prime[i];
+	}
+      if (!dense)
+	{
+	  ++rp->r_it;
+	  if (events (rp))
+	    return;
+	  printq (rp);		/* output */
+	}
+      else if (last)
+	{
+	  rp->r_it = k;
+	  if (events (rp))
+	    return;
+	  printq (rp);		/* output */
+	}
+
+      fac = (err > 0.0 ? SAFETY * pow (err, -0.2) : FACMAX);
+      if (fac > (rejected ? 1.0 : FACMAX))
+	fac = (rejected ? 1.0 : FACMAX);
+      if (fac < FACMIN)
+	fac = FACMIN;
+      h *= fac;
+      rejected = false;
+    }
+  rp->r_tstep = (dense ? dt : h);
+}
+
+/*
+ * set the dynamic variables and their derivatives to the values of the
+ * interpolant at t + theta * h, within the step just taken
+ */
+static void
+interpolate (struct run *rp, double theta, double h)
+{
+  int i, n = rp->r_nsyms;
+  double *value = rp->r_value, *prime = rp->r_prime;
+  double *val0 = rp->r_val[0], *val1 = rp->r_val[1];
+  double *k0 = rp->r_k[0], *k2 = rp->r_k[2], *k3 = rp->r_k[3];
+  double *k4 = rp->r_k[4], *k5 = rp->r_k[5], *k6 = rp->r_k[6];
+  double r2, r3, r4, r5, a, b, c;
+
+  for (i = 1; i < n; i++)
+    {
+      r2 = val1[i] - val0[i];
+      r3 = k0[i] - r2;
+      r4 = r2 - k6[i] - r3;
+      r5 = (DD0 * k0[i]
+	    + DD2 * k2[i]
+	    + DD3 * k3[i]
+	    + DD4 * k4[i]
+	    + DD5 * k5[i]
+	    + DD6 * k6[i]);
+      a = r4 + (1.0 - theta) * r5;
+      b = r3 + theta * a;
+      c = r2 + (1.0 - theta) * b;
+      value[i] = val0[i] + theta * c;
+      prime[i] = (c + theta * ((1.0 - theta) * (a - theta * r5) - b)) / h;
+    }
+}
@@ -16,22 +16,28 @@
  */
 
 void
-eu (void)
+eu (struct run *rp)
 {
+  int i, n = rp->r_nsyms;
+  double *value = rp->r_value, *prime = rp->r_prime;
+  double *val0 = rp->r_val[0], *pri0 = rp->r_pri[0];
   double t;
   
-  for (it = 0, t = tstart; !STOPR; t = tstart + (++it) * tstep) 
+  for (rp->r_it = 0, t = tstart; !STOPR(rp->r_tstep);
+       t = tstart + (++rp->r_it) * rp->r_tstep) 
     {
-      symtab->sy_value = symtab->sy_val[0] = t;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      value[0] = val0[0] = t;
+      field (rp);
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_val[0] = fsp->sy_value;
-	  fsp->sy_pri[0] = fsp->sy_prime;
+	  val0[i] = value[i];
+	  pri0[i] = prime[i];
 	}
-      printq();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link)
-	fsp->sy_value = fsp->sy_val[0] + tstep * fsp->sy_prime;
+      if (events (rp))
+	return;
+      printq (rp);
+      for (i = 1; i < n; i++)
+	value[i] = val0[i] + rp->r_tstep * prime[i];
     }
 }
 
@@ -39,14 +45,16 @@ eu (void)
  * if tstart == tstop, i.e., step nowhere, then just print current values
  */
 void
-trivial (void)
+trivial (struct run *rp)
 {
-  symtab->sy_value = symtab->sy_val[0] = tstart;
-  field();
-  for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+  int i, n = rp->r_nsyms;
+
+  rp->r_value[0] = rp->r_val[0][0] = tstart;
+  field (rp);
+  for (i = 1; i < n; i++)
     {
-      fsp->sy_val[0] = fsp->sy_value;
-      fsp->sy_pri[0] = fsp->sy_prime;
+      rp->r_val[0][i] = rp->r_value[i];
+      rp->r_pri[0][i] = rp->r_prime[i];
     }
-  printq();
+  printq (rp);
 }
@@ -0,0 +1,248 @@
+/* This file is part of the GNU plotutils package. */
+
+/*
+ * Copyright (C) 2008, Free Software Foundation, Inc.
+ */
+
+/*
+ * Events: the points at which the condition of an until or event
+ * statement changes sign.
+ *
+ * The numerical routines call events() at each point of the solution
+ * that they may print, just before calling printq().  The conditions are
+ * evaluated there, and if one has changed sign since the last such point,
+ * the crossing is located by regula falsi (the Illinois variant) on the
+ * cubic Hermite interpolant of the values and derivatives at the two
+ * points, and a line is printed for it.  After an event the solution
+ * carries on; after an until, the run stops at the crossing, and a later
+ * step statement starts from there.  A condition that changes sign twice
+ * between two points is not noticed.
+ */
+
+#include "sys-defines.h"
+#include "ode.h"
+#include "extern.h"
+
+#define MAXITER 100		/* most iterations of regula falsi */
+/* the resolution of a time t, in a step h */
+#define TRES(t,h) (4.0 * DBL_EPSILON * (fabs (t) + fabs (h)))
+
+/* the last point seen by events(), kept in the run */
+struct events
+{
+  bool started;			/* has there been a point yet? */
+  double t;			/* its time */
+  double *val, *pri;		/* ... the values and derivatives */
+  double g[NEVENTS];		/* ... and the values of the conditions */
+  double *val1, *pri1;		/* the current point, while interpolating */
+};
+
+static bool crosses (double g0, double g1);
+static double locate (struct run *rp, int k, double g0, double g1);
+static struct events * new_events (int n);
+static void hermite (struct run *rp, double theta);
+
+/*
+ * look for events since the last point, at the current values, and
+ * print a line for each; true if the run is to stop (at an until)
+ */
+bool
+events (struct run *rp)
+{
+  struct events *evp;
+  double g[NEVENTS], tev[NEVENTS];
+  int i, k, n = rp->r_nsyms;
+  int order[NEVENTS], nev = 0;
+  bool stop = false;
+
+  if (evexpr[EV_UNTIL] == NULL && evexpr[EV_EVENT] == NULL)
+    return false;
+  if (rp->r_events == NULL)
+    rp->r_events = new_events (n);
+  evp = rp->r_events;
+
+  for (k = 0; k < NEVENTS; k++)
+    g[k] = (evexpr[k] != NULL ? event_value (rp, k) : 0.0);
+
+  if (evp->started && rp->r_value[0] != evp->t)
+    {
+      for (i = 0; i < n; i++)
+	{
+	  evp->val1[i] = rp->r_value[i];
+	  evp->pri1[i] = rp->r_prime[i];
+	}
+
+      /* the crossings, in order; an until first if they coincide */
+      for (k = 0; k < NEVENTS; k++)
+	if (evexpr[k] != NULL && crosses (evp->g[k], g[k]))
+	  {
+	    tev[k] = locate (rp, k, evp->g[k], g[k]);
+	    /* not where the run starts, e.g. where an until stopped the last */
+	    if (fabs (tev[k] - tstart)
+		<= 2.0 * TRES (tstart, evp->val1[0] - evp->t))
+	      continue;
+	    if (nev > 0 && (tev[k] - tev[order[0]]) * (evp->val1[0] - evp->t)
+		< 0.0)
+	      {
+		order[1] = order[0];
+		order[0] = k;
+	      }
+	    else
+	      order[nev] = k;
+	    nev++;
+	  }
+
+      for (i = 0; i < nev && !stop; i++)
+	{
+	  k = order[i];
+	  hermite (rp, (tev[k] - evp->t) / (evp->val1[0] - evp->t));
+	  rp->r_value[0] = tev[k];
+	  print_row (rp);
+	  stop = (k == EV_UNTIL);
+	}
+
+      if (stop)
+	{
+	  /* this is where the run ends */
+	  for (i = 0; i < n; i++)
+	    {
+	      rp->r_val[0][i] = rp->r_value[i];
+	      rp->r_pri[0][i] = rp->r_prime[i];
+	    }
+	  return true;
+	}
+      for (i = 0; i < n; i++)
+	{
+	  rp->r_value[i] = evp->val1[i];
+	  rp->r_prime[i] = evp->pri1[i];
+	}
+    }
+
+  evp->started = true;
+  evp->t = rp->r_value[0];
+  for (i = 0; i < n; i++)
+    {
+      evp->val[i] = rp->r_value[i];
+      evp->pri[i] = rp->r_prime[i];
+    }
+  for (k = 0; k < NEVENTS; k++)
+    evp->g[k] = g[k];
+  return false;
+}
+
+/*
+ * has a condition changed sign (or come to zero) from g0 to g1?
+ */
+static bool
+crosses (double g0, double g1)
+{
+  return ((g0 < 0.0 && g1 >= 0.0) || (g0 > 0.0 && g1 <= 0.0));
+}
+
+/*
+ * find where condition k, which is g0 at the last point and g1 at the
+ * current one, comes to zero between them: the end of the final bracket
+ * on the far side, so that a run which stops there does not see the same
+ * crossing again when it carries on
+ */
+static double
+locate (struct run *rp, int k, double g0, double g1)
+{
+  struct events *evp = rp->r_events;
+  double h = evp->val1[0] - evp->t;
+  double a = 0.0, fa = g0, b = 1.0, fb = g1, c, fc, tol;
+  int iter;
+
+  if (g1 == 0.0)
+    return evp->val1[0];
+
+  tol = TRES (evp->t, h) / fabs (h);	/* as a fraction of the interval */
+
+  for (iter = 0; iter < MAXITER && fabs (b - a) > tol; iter++)
+    {
+      c = b - fb * (b - a) / (fb - fa);
+      if (!(c > (a < b ? a : b) && c < (a < b ? b : a)))
+	c = 0.5 * (a + b);
+      hermite (rp, c);
+      fc = event_value (rp, k);
+      if (fc == 0.0)
+	{
+	  b = c;
+	  fb = fc;
+	  break;
+	}
+      if ((fc < 0.0) != (fb < 0.0))
+	{
+	  a = b;
+	  fa = fb;
+	}
+      else
+	fa *= HALF;		/* so the far end is not stuck */
+      b = c;
+      fb = fc;
+    }
+  return evp->t + (crosses (g0, fb) ? b : a) * h;
+}
+
+/*
+ * set the values and derivatives of the symbols to those of the cubic
+ * through the last and the current point, at the fraction theta of the
+ * way from one to the other
+ */
+static void
+hermite (struct run *rp, double theta)
+{
+  struct events *evp = rp->r_events;
+  double *value = rp->r_value, *prime = rp->r_prime;
+  double h = evp->val1[0] - evp->t, s = 1.0 - theta;
+  double h00, h10, h01, h11, d00, d10, d11, y0, y1, p0, p1;
+  int i, n = rp->r_nsyms;
+
+  h00 = (1.0 + 2.0 * theta) * s * s;
+  h01 = theta * theta * (3.0 - 2.0 * theta);
+  h10 = theta * s * s;
+  h11 = -theta * theta * s;
+  d00 = 6.0 * theta * (theta - 1.0) / h;
+  d10 = s * (1.0 - 3.0 * theta);
+  d11 = theta * (3.0 * theta - 2.0);
+
+  value[0] = evp->t + theta * h;
+  for (i = 1; i < n; i++)
+    {
+      y0 = evp->val[i];
+      y1 = evp->val1[i];
+      p0 = evp->pri[i];
+      p1 = evp->pri1[i];
+      if (y0 == y1 && p0 == 0.0 && p1 == 0.0)
+	{
+	  value[i] = y0;	/* e.g. a constant: keep it exact */
+	  prime[i] = 0.0;
+	  continue;
+	}
+      value[i] = h00 * y0 + h01 * y1 + h * (h10 * p0 + h11 * p1);
+      prime[i] = d00 * (y0 - y1) + d10 * p0 + d11 * p1;
+    }
+}
+
+static struct events *
+new_events (int n)
+{
+  struct events *evp;
+
+  evp = (struct events *)xmalloc (sizeof (struct events));
+  evp->started = false;
+  evp->val = (double *)xmalloc (4 * n * sizeof (double));
+  evp->pri = evp->val + n;
+  evp->val1 = evp->val + 2 * n;
+  evp->pri1 = evp->val + 3 * n;
+  return evp;
+}
+
+void
+free_events (struct events *evp)
+{
+  if (evp == NULL)
+    return;
+  free (evp->val);		/* and the other arrays */
+  free (evp);
+}
@@ -62,7 +62,7 @@ eval (const struct expr *ep)
 	  tmp = *sp++;
 	  if ((tmp != (int)tmp) && (*sp < 0))
 	    rterror("negative number to non-integer power");
-	  *sp = pow(*sp,tmp);
+	  *sp = (IS_IPOW(tmp) ? ipow(*sp,(int)tmp) : pow(*sp,tmp));
 	  break;
 	case O_SQAR:
 	  *sp *= *sp;
@@ -186,6 +186,33 @@ eval (const struct expr *ep)
   return *sp;
 }
 
+/*
+ * x^n, for an integer n (see IS_IPOW), by repeated squaring, which is
+ * much faster than pow(); compile() emits the same multiplications in
+ * the same order, so that eval() and field() agree
+ */
+double
+ipow (double x, int n)
+{
+  double result = 1.0, p = x;
+  bool first = true, invert = (n < 0);
+
+  if (invert)
+    n = -n;
+  while (n > 0)
+    {
+      if (n & 1)
+	{
+	  result = (first ? p : result * p);
+	  first = false;
+	}
+      n >>= 1;
+      if (n > 0)
+	p *= p;
+    }
+  return (invert ? 1. / result : result);
+}
+
 struct expr *
 ealloc (void)
 {
@@ -18,23 +18,29 @@
 /* variables defined and initted in global.c */
 extern const char     *progname, *written, *copyright;
 extern int            prec;
-extern long           it;
 extern double         hmin, hmax, ssmin, ssmax, abmin, abmax, acmax;
-extern struct sym     *symtab, *fsp;
+extern struct sym     *symtab;
 extern struct sym     *dqueue;
+extern struct sym     **symvec;
 extern struct prt     *pqueue;
+extern struct expr    *evexpr[NEVENTS];
 extern struct expr    exprzero, exprone;
 extern bool        sawstep, sawprint, sawevery, sawfrom;
 extern bool        tflag, pflag, sflag, eflag, rflag, hflag, conflag;
 extern integration_type	algorithm;
+extern bool        autostiff;
+extern data_type      output_type;
+extern bool        realtime;
+extern int            num_threads;
+extern char           *ensemble_output;
+extern struct ensemble *ensemble;
 
 /* variables defined but not initted in global.c */
 extern char    *filename;
-extern jmp_buf mark;
 extern int     fwd;
 extern int     tevery;
 extern double  tstart, tstop, tstep, tfrom;
-extern bool printnum, prerr;
+extern bool prerr;
 
 /* in parser */
 extern FILE    *yyin;
@@ -46,38 +52,72 @@ extern int     curline;
  * external function declarations
  */
 bool check (void);
-bool hierror (void);
-bool intpr (double t);
-bool lowerror (void);
+bool events (struct run *rp);
+bool fixed_step_rk (void);
+bool hierror (struct run *rp);
+bool intpr (struct run *rp, double t);
+bool lowerror (struct run *rp);
+bool print_lanes (struct lanes *lp, long it);
 double eval (const struct expr *ep);
-void am (void);
-void ama (void);
+double event_value (struct run *rp, int k);
+double ipow (double x, int n);
+double * new_registers (void);
+double * new_lane_registers (void);
+int count_member_conversions (const char *template);
+int jacobian_pattern (const int **rows, const int **cols);
+void am (struct run *rp);
+void ama (struct run *rp);
 void args (int ac, char **av);
+void compile (bool jac_wanted);
+void declare_ensemble (void);
 void defalt (void);
-void eu (void);
+void dp (struct run *rp);
+void eu (struct run *rp);
 void efree (struct expr *ep);
-void field (void);
-void maxerr (void);
+void enddataset (FILE *fp);
+void fbinval (FILE *fp, double x);
+void field (struct run *rp);
+void field_lanes (struct lanes *lp);
+void fprval (FILE *fp, double x);
+void free_run (struct run *rp);
+void free_events (struct events *evp);
+void free_lanes (struct lanes *lp);
+void free_stiff (struct stiff *stp);
+void integrate (struct run *rp);
+void integrate_lanes (struct lanes *lp);
+void jacobian (struct run *rp, double *values, double *scratch);
+void maxerr (struct run *rp);
 void panic (const char *s);
 void panicn (const char *fmt, int n);
 void pfree (struct prt *pp);
-void printq (void);
+void print_row (struct run *rp);
+void printq (struct run *rp);
+void push_history (struct run *rp, int depth);
 void prval (double x);
 void maxerror (void);
+void read_ensemble (const char *name);
 void resetflt (void);
-void rk (void);
-void rka (void);
+void rk (struct run *rp);
+void rk_lanes (struct lanes *lp);
+void rka (struct run *rp);
+void rosenbrock (struct run *rp, double t, bool dense);
 void rterror (const char *s);
 void rterrors (const char *fmt, const char *s);
 void rtsquawks (const char *fmt, const char *s);
+void rtwhere (const struct run *rp, const char *name);
+void set_current_run (struct run *rp);
 void setflt (void);
 void sfree (struct sym *sp);
 void solve (void);
+void solve_ensemble (void);
 void startstep (void);
-void title (void);
-void trivial (void);
+void title (struct run *rp);
+void trivial (struct run *rp);
 struct expr * ealloc (void);
 struct prt * palloc (void);
+struct lanes * new_lanes (struct run **runs, int count);
+struct run * current_run (void);
+struct run * new_run (int member, FILE *out);
 struct sym * lookup (const char *nam);
 struct sym * salloc (void);
 RETSIGTYPE fptrap (int sig);
@@ -118,6 +158,7 @@ extern double gamma (double x); /* declaration may be gratuitous */
 #endif
 #endif
 double f_gamma (double x);
+double locked_lgamma (double x);
 #ifndef HAVE_ERF
 double erf (double x);
 double erfc (double x);
@@ -22,7 +22,6 @@ const char    *written =  "Written by Nicholas B. Tufillaro and Robert S. Maier.
 const char    *copyright = "Copyright (C) 1994 Nicholas B. Tufillaro,\nCopyright (C) 2009 Free Software Foundation, Inc.";
 
 int	prec	= -1;
-long	it	= 0;
 double	hmin	= HMIN;
 double	hmax	= HMAX;
 double	ssmin	= 1e-11;
@@ -31,9 +30,10 @@ double	abmin	= 1e-36;
 double	abmax	= 1e36;
 double	acmax	= 1e36;
 struct	sym	*symtab = NULL;
-struct	sym	*fsp	= NULL;
 struct	sym	*dqueue	= NULL;
+struct	sym	**symvec = NULL;	/* the symbols, by number (see compile) */
 struct	prt	*pqueue = NULL;
+struct	expr	*evexpr[NEVENTS] = { NULL, NULL }; /* until, event conditions */
 struct	expr	exprzero  = 
 {
   O_CONST,
@@ -53,12 +53,17 @@ bool	    sawevery = false, sawfrom = false;
 bool     tflag = false, pflag = false, sflag = false;
 bool     eflag = false, rflag = false, hflag = false, conflag = false;
 integration_type algorithm = A_RUNGE_KUTTA_FEHLBERG;
+bool	autostiff = true;	/* may rka switch to ros?  (no scheme chosen) */
+data_type output_type = T_ASCII; /* user sets this via -O option */
+bool	realtime = false;	/* flush each line?  (--realtime option) */
+int	num_threads = 1;	/* user sets this via --threads option */
+char	*ensemble_output = NULL; /* template for members' output files */
+struct	ensemble *ensemble = NULL; /* table given with --ensemble, if any */
 
 /* defined but not initialized */
 
 char	*filename;
-jmp_buf mark;
 int	fwd;
 int     tevery;
 double  tstart, tstop, tstep, tfrom;
-bool printnum, prerr;
+bool prerr;
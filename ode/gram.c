@@ -1,14 +1,14 @@
-/* A Bison parser, made by GNU Bison 2.3.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* Skeleton implementation for Bison's Yacc-like parsers in C
+/* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-   This program is free software; you can redistribute it and/or modify
+   This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2, or (at your option)
-   any later version.
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
 
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
@@ -16,9 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street, Fifth Floor,
-   Boston, MA 02110-1301, USA.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -36,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -43,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.3"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -55,107 +57,16 @@
 /* Pure parsers.  */
 #define YYPURE 0
 
-/* Using locations.  */
-#define YYLSP_NEEDED 0
-
-
+/* Push parsers.  */
+#define YYPUSH 0
 
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     NUMBER = 258,
-     IDENT = 259,
-     SEP = 260,
-     ABS = 261,
-     SQRT = 262,
-     EXP = 263,
-     LOG = 264,
-     LOG10 = 265,
-     SIN = 266,
-     COS = 267,
-     TAN = 268,
-     ASIN = 269,
-     ACOS = 270,
-     ATAN = 271,
-     SINH = 272,
-     COSH = 273,
-     TANH = 274,
-     ASINH = 275,
-     ACOSH = 276,
-     ATANH = 277,
-     FLOOR = 278,
-     CEIL = 279,
-     J0 = 280,
-     J1 = 281,
-     Y0 = 282,
-     Y1 = 283,
-     LGAMMA = 284,
-     GAMMA = 285,
-     ERF = 286,
-     ERFC = 287,
-     INVERF = 288,
-     NORM = 289,
-     INVNORM = 290,
-     IGAMMA = 291,
-     IBETA = 292,
-     EVERY = 293,
-     FROM = 294,
-     PRINT = 295,
-     STEP = 296,
-     EXAM = 297,
-     UMINUS = 298
-   };
-#endif
-/* Tokens.  */
-#define NUMBER 258
-#define IDENT 259
-#define SEP 260
-#define ABS 261
-#define SQRT 262
-#define EXP 263
-#define LOG 264
-#define LOG10 265
-#define SIN 266
-#define COS 267
-#define TAN 268
-#define ASIN 269
-#define ACOS 270
-#define ATAN 271
-#define SINH 272
-#define COSH 273
-#define TANH 274
-#define ASINH 275
-#define ACOSH 276
-#define ATANH 277
-#define FLOOR 278
-#define CEIL 279
-#define J0 280
-#define J1 281
-#define Y0 282
-#define Y1 283
-#define LGAMMA 284
-#define GAMMA 285
-#define ERF 286
-#define ERFC 287
-#define INVERF 288
-#define NORM 289
-#define INVNORM 290
-#define IGAMMA 291
-#define IBETA 292
-#define EVERY 293
-#define FROM 294
-#define PRINT 295
-#define STEP 296
-#define EXAM 297
-#define UMINUS 298
+/* Pull parsers.  */
+#define YYPULL 1
 
 
 
 
-/* Copy the first part of user declarations.  */
+/* First part of user prologue.  */
 #line 1 "gram.y"
 
 /* Copyright Nicholas B. Tufillaro, 1982-1994. All rights reserved.
@@ -241,79 +152,337 @@ static  char    *errmess = NULL;
 
 bool erritem;
 
+#line 156 "gram.c"
 
-/* Enabling traces.  */
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+/* Use api.header.include to #include this header
+   instead of duplicating it here.  */
+#ifndef YY_YY_GRAM_H_INCLUDED
+# define YY_YY_GRAM_H_INCLUDED
+/* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 0
 #endif
-
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
+#if YYDEBUG
+extern int yydebug;
 #endif
 
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    NUMBER = 258,                  /* NUMBER  */
+    IDENT = 259,                   /* IDENT  */
+    SEP = 260,                     /* SEP  */
+    ABS = 261,                     /* ABS  */
+    SQRT = 262,                    /* SQRT  */
+    EXP = 263,                     /* EXP  */
+    LOG = 264,                     /* LOG  */
+    LOG10 = 265,                   /* LOG10  */
+    SIN = 266,                     /* SIN  */
+    COS = 267,                     /* COS  */
+    TAN = 268,                     /* TAN  */
+    ASIN = 269,                    /* ASIN  */
+    ACOS = 270,                    /* ACOS  */
+    ATAN = 271,                    /* ATAN  */
+    SINH = 272,                    /* SINH  */
+    COSH = 273,                    /* COSH  */
+    TANH = 274,                    /* TANH  */
+    ASINH = 275,                   /* ASINH  */
+    ACOSH = 276,                   /* ACOSH  */
+    ATANH = 277,                   /* ATANH  */
+    FLOOR = 278,                   /* FLOOR  */
+    CEIL = 279,                    /* CEIL  */
+    J0 = 280,                      /* J0  */
+    J1 = 281,                      /* J1  */
+    Y0 = 282,                      /* Y0  */
+    Y1 = 283,                      /* Y1  */
+    LGAMMA = 284,                  /* LGAMMA  */
+    GAMMA = 285,                   /* GAMMA  */
+    ERF = 286,                     /* ERF  */
+    ERFC = 287,                    /* ERFC  */
+    INVERF = 288,                  /* INVERF  */
+    NORM = 289,                    /* NORM  */
+    INVNORM = 290,                 /* INVNORM  */
+    IGAMMA = 291,                  /* IGAMMA  */
+    IBETA = 292,                   /* IBETA  */
+    EVERY = 293,                   /* EVERY  */
+    FROM = 294,                    /* FROM  */
+    PRINT = 295,                   /* PRINT  */
+    STEP = 296,                    /* STEP  */
+    EXAM = 297,                    /* EXAM  */
+    UNTIL = 298,                   /* UNTIL  */
+    EVENT = 299,                   /* EVENT  */
+    UMINUS = 300                   /* UMINUS  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
+#define NUMBER 258
+#define IDENT 259
+#define SEP 260
+#define ABS 261
+#define SQRT 262
+#define EXP 263
+#define LOG 264
+#define LOG10 265
+#define SIN 266
+#define COS 267
+#define TAN 268
+#define ASIN 269
+#define ACOS 270
+#define ATAN 271
+#define SINH 272
+#define COSH 273
+#define TANH 274
+#define ASINH 275
+#define ACOSH 276
+#define ATANH 277
+#define FLOOR 278
+#define CEIL 279
+#define J0 280
+#define J1 281
+#define Y0 282
+#define Y1 283
+#define LGAMMA 284
+#define GAMMA 285
+#define ERF 286
+#define ERFC 287
+#define INVERF 288
+#define NORM 289
+#define INVNORM 290
+#define IGAMMA 291
+#define IBETA 292
+#define EVERY 293
+#define FROM 294
+#define PRINT 295
+#define STEP 296
+#define EXAM 297
+#define UNTIL 298
+#define EVENT 299
+#define UMINUS 300
 
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-#line 85 "gram.y"
+union YYSTYPE
 {
+#line 85 "gram.y"
+
         struct  lex     *lexptr;
         struct  expr    *exprptr;
         struct  prt     *prtptr;
         int     simple;
-}
-/* Line 187 of yacc.c.  */
-#line 274 "gram.c"
-	YYSTYPE;
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
+
+#line 306 "gram.c"
+
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
 #endif
 
 
+extern YYSTYPE yylval;
+
+
+int yyparse (void);
+
+
+#endif /* !YY_YY_GRAM_H_INCLUDED  */
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_NUMBER = 3,                     /* NUMBER  */
+  YYSYMBOL_IDENT = 4,                      /* IDENT  */
+  YYSYMBOL_SEP = 5,                        /* SEP  */
+  YYSYMBOL_ABS = 6,                        /* ABS  */
+  YYSYMBOL_SQRT = 7,                       /* SQRT  */
+  YYSYMBOL_EXP = 8,                        /* EXP  */
+  YYSYMBOL_LOG = 9,                        /* LOG  */
+  YYSYMBOL_LOG10 = 10,                     /* LOG10  */
+  YYSYMBOL_SIN = 11,                       /* SIN  */
+  YYSYMBOL_COS = 12,                       /* COS  */
+  YYSYMBOL_TAN = 13,                       /* TAN  */
+  YYSYMBOL_ASIN = 14,                      /* ASIN  */
+  YYSYMBOL_ACOS = 15,                      /* ACOS  */
+  YYSYMBOL_ATAN = 16,                      /* ATAN  */
+  YYSYMBOL_SINH = 17,                      /* SINH  */
+  YYSYMBOL_COSH = 18,                      /* COSH  */
+  YYSYMBOL_TANH = 19,                      /* TANH  */
+  YYSYMBOL_ASINH = 20,                     /* ASINH  */
+  YYSYMBOL_ACOSH = 21,                     /* ACOSH  */
+  YYSYMBOL_ATANH = 22,                     /* ATANH  */
+  YYSYMBOL_FLOOR = 23,                     /* FLOOR  */
+  YYSYMBOL_CEIL = 24,                      /* CEIL  */
+  YYSYMBOL_J0 = 25,                        /* J0  */
+  YYSYMBOL_J1 = 26,                        /* J1  */
+  YYSYMBOL_Y0 = 27,                        /* Y0  */
+  YYSYMBOL_Y1 = 28,                        /* Y1  */
+  YYSYMBOL_LGAMMA = 29,                    /* LGAMMA  */
+  YYSYMBOL_GAMMA = 30,                     /* GAMMA  */
+  YYSYMBOL_ERF = 31,                       /* ERF  */
+  YYSYMBOL_ERFC = 32,                      /* ERFC  */
+  YYSYMBOL_INVERF = 33,                    /* INVERF  */
+  YYSYMBOL_NORM = 34,                      /* NORM  */
+  YYSYMBOL_INVNORM = 35,                   /* INVNORM  */
+  YYSYMBOL_IGAMMA = 36,                    /* IGAMMA  */
+  YYSYMBOL_IBETA = 37,                     /* IBETA  */
+  YYSYMBOL_EVERY = 38,                     /* EVERY  */
+  YYSYMBOL_FROM = 39,                      /* FROM  */
+  YYSYMBOL_PRINT = 40,                     /* PRINT  */
+  YYSYMBOL_STEP = 41,                      /* STEP  */
+  YYSYMBOL_EXAM = 42,                      /* EXAM  */
+  YYSYMBOL_UNTIL = 43,                     /* UNTIL  */
+  YYSYMBOL_EVENT = 44,                     /* EVENT  */
+  YYSYMBOL_45_ = 45,                       /* '='  */
+  YYSYMBOL_46_ = 46,                       /* '+'  */
+  YYSYMBOL_47_ = 47,                       /* '-'  */
+  YYSYMBOL_48_ = 48,                       /* '*'  */
+  YYSYMBOL_49_ = 49,                       /* '/'  */
+  YYSYMBOL_50_ = 50,                       /* '^'  */
+  YYSYMBOL_UMINUS = 51,                    /* UMINUS  */
+  YYSYMBOL_52_ = 52,                       /* '\''  */
+  YYSYMBOL_53_ = 53,                       /* ','  */
+  YYSYMBOL_54_ = 54,                       /* '~'  */
+  YYSYMBOL_55_ = 55,                       /* '!'  */
+  YYSYMBOL_56_ = 56,                       /* '?'  */
+  YYSYMBOL_57_ = 57,                       /* '('  */
+  YYSYMBOL_58_ = 58,                       /* ')'  */
+  YYSYMBOL_YYACCEPT = 59,                  /* $accept  */
+  YYSYMBOL_program = 60,                   /* program  */
+  YYSYMBOL_stat = 61,                      /* stat  */
+  YYSYMBOL_evkind = 62,                    /* evkind  */
+  YYSYMBOL_prtlist = 63,                   /* prtlist  */
+  YYSYMBOL_prtitem = 64,                   /* prtitem  */
+  YYSYMBOL_prttag = 65,                    /* prttag  */
+  YYSYMBOL_optevery = 66,                  /* optevery  */
+  YYSYMBOL_optfrom = 67,                   /* optfrom  */
+  YYSYMBOL_cexpr = 68,                     /* cexpr  */
+  YYSYMBOL_expr = 69                       /* expr  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-/* Copy the second part of user declarations.  */
 
 
-/* Line 216 of yacc.c.  */
-#line 287 "gram.c"
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
 typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef short int yytype_int8;
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -321,55 +490,106 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
-# if YYENABLE_NLS
+# if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(e) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int i)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (i)
-    int i;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return i;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -386,11 +606,11 @@ YYID (i)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#     ifndef _STDLIB_H
-#      define _STDLIB_H 1
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
 #     endif
 #    endif
 #   endif
@@ -398,8 +618,8 @@ YYID (i)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -413,125 +633,131 @@ YYID (i)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
 #   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
 #  endif
-#  if (defined __cplusplus && ! defined _STDLIB_H \
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#   ifndef _STDLIB_H
-#    define _STDLIB_H 1
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
 #   endif
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss;
-  YYSTYPE yyvs;
-  };
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
-#  endif
-# endif
+# define YYCOPY_NEEDED 1
 
 /* Relocate STACK from its old location to the new one.  The
    local variables YYSIZE and YYSTACKSIZE give the old and new number of
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack)					\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack, Stack, yysize);				\
-	Stack = &yyptr->Stack;						\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  52
+#define YYFINAL  55
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   876
+#define YYLAST   949
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  57
+#define YYNTOKENS  59
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  10
+#define YYNNTS  11
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  104
-/* YYNRULES -- Number of states.  */
-#define YYNSTATES  346
+#define YYNRULES  109
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  355
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   300
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   298
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,    53,     2,     2,     2,     2,     2,    50,
-      55,    56,    46,    44,    51,    45,     2,    47,     2,     2,
+       2,     2,     2,    55,     2,     2,     2,     2,     2,    52,
+      57,    58,    48,    46,    53,    47,     2,    49,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,    43,     2,    54,     2,     2,     2,     2,     2,     2,
+       2,    45,     2,    56,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,    48,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,    50,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,    52,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,    54,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -548,573 +774,477 @@ static const yytype_uint8 yytranslate[] =
        5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
       15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
       25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
-      35,    36,    37,    38,    39,    40,    41,    42,    49
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      51
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint16 yyprhs[] =
-{
-       0,     0,     3,     5,     8,    10,    15,    18,    24,    30,
-      36,    44,    48,    50,    54,    57,    58,    60,    62,    64,
-      66,    67,    70,    71,    74,    78,    82,    86,    90,    94,
-      98,   103,   108,   113,   118,   123,   128,   133,   138,   143,
-     148,   153,   158,   163,   168,   173,   178,   183,   188,   193,
-     198,   203,   208,   213,   218,   223,   228,   233,   238,   243,
-     248,   255,   264,   267,   269,   273,   277,   281,   285,   289,
-     293,   298,   303,   308,   313,   318,   323,   328,   333,   338,
-     343,   348,   353,   358,   363,   368,   373,   378,   383,   388,
-     393,   398,   403,   408,   413,   418,   423,   428,   433,   438,
-     443,   450,   459,   462,   464
-};
-
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      58,     0,    -1,    59,    -1,    58,    59,    -1,     5,    -1,
-       4,    43,    66,     5,    -1,     1,     5,    -1,     4,    50,
-      43,    66,     5,    -1,    40,    60,    63,    64,     5,    -1,
-      41,    65,    51,    65,     5,    -1,    41,    65,    51,    65,
-      51,    65,     5,    -1,    42,     4,     5,    -1,    61,    -1,
-      60,    51,    61,    -1,     4,    62,    -1,    -1,    50,    -1,
-      52,    -1,    53,    -1,    54,    -1,    -1,    38,    65,    -1,
-      -1,    39,    65,    -1,    55,    65,    56,    -1,    65,    44,
-      65,    -1,    65,    45,    65,    -1,    65,    46,    65,    -1,
-      65,    47,    65,    -1,    65,    48,    65,    -1,     7,    55,
-      65,    56,    -1,     6,    55,    65,    56,    -1,     8,    55,
-      65,    56,    -1,     9,    55,    65,    56,    -1,    10,    55,
-      65,    56,    -1,    11,    55,    65,    56,    -1,    12,    55,
-      65,    56,    -1,    13,    55,    65,    56,    -1,    20,    55,
-      65,    56,    -1,    21,    55,    65,    56,    -1,    22,    55,
-      65,    56,    -1,    14,    55,    65,    56,    -1,    15,    55,
-      65,    56,    -1,    16,    55,    65,    56,    -1,    17,    55,
-      65,    56,    -1,    18,    55,    65,    56,    -1,    19,    55,
-      65,    56,    -1,    23,    55,    65,    56,    -1,    24,    55,
-      65,    56,    -1,    25,    55,    65,    56,    -1,    26,    55,
-      65,    56,    -1,    27,    55,    65,    56,    -1,    28,    55,
-      65,    56,    -1,    32,    55,    65,    56,    -1,    31,    55,
-      65,    56,    -1,    33,    55,    65,    56,    -1,    29,    55,
-      65,    56,    -1,    30,    55,    65,    56,    -1,    34,    55,
-      65,    56,    -1,    35,    55,    65,    56,    -1,    36,    55,
-      65,    51,    65,    56,    -1,    37,    55,    65,    51,    65,
-      51,    65,    56,    -1,    45,    65,    -1,     3,    -1,    55,
-      66,    56,    -1,    66,    44,    66,    -1,    66,    45,    66,
-      -1,    66,    46,    66,    -1,    66,    47,    66,    -1,    66,
-      48,    66,    -1,     7,    55,    66,    56,    -1,     6,    55,
-      66,    56,    -1,     8,    55,    66,    56,    -1,     9,    55,
-      66,    56,    -1,    10,    55,    66,    56,    -1,    11,    55,
-      66,    56,    -1,    12,    55,    66,    56,    -1,    13,    55,
-      66,    56,    -1,    20,    55,    66,    56,    -1,    21,    55,
-      66,    56,    -1,    22,    55,    66,    56,    -1,    14,    55,
-      66,    56,    -1,    15,    55,    66,    56,    -1,    16,    55,
-      66,    56,    -1,    17,    55,    66,    56,    -1,    18,    55,
-      66,    56,    -1,    19,    55,    66,    56,    -1,    23,    55,
-      66,    56,    -1,    24,    55,    66,    56,    -1,    25,    55,
-      66,    56,    -1,    26,    55,    66,    56,    -1,    27,    55,
-      66,    56,    -1,    28,    55,    66,    56,    -1,    29,    55,
-      66,    56,    -1,    30,    55,    66,    56,    -1,    32,    55,
-      66,    56,    -1,    31,    55,    66,    56,    -1,    33,    55,
-      66,    56,    -1,    34,    55,    66,    56,    -1,    35,    55,
-      66,    56,    -1,    36,    55,    66,    51,    66,    56,    -1,
-      37,    55,    66,    51,    66,    51,    66,    56,    -1,    45,
-      66,    -1,     3,    -1,     4,    -1
-};
-
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
        0,   110,   110,   111,   114,   116,   127,   139,   168,   175,
-     187,   207,   247,   252,   262,   275,   276,   278,   283,   288,
-     296,   297,   306,   307,   315,   319,   323,   327,   331,   335,
-     342,   346,   352,   356,   360,   364,   368,   372,   376,   380,
-     384,   388,   392,   396,   400,   404,   408,   412,   416,   420,
-     424,   428,   432,   436,   440,   444,   448,   452,   456,   460,
-     464,   471,   479,   483,   487,   489,   496,   503,   510,   523,
-     610,   617,   628,   635,   642,   649,   656,   663,   670,   677,
-     684,   691,   698,   705,   712,   719,   726,   733,   740,   747,
-     754,   761,   768,   775,   782,   789,   796,   803,   810,   817,
-     824,   836,   849,   856,   863
+     187,   207,   245,   251,   261,   269,   271,   275,   280,   290,
+     303,   304,   306,   311,   316,   324,   325,   334,   335,   343,
+     347,   351,   355,   359,   363,   370,   374,   380,   384,   388,
+     392,   396,   400,   404,   408,   412,   416,   420,   424,   428,
+     432,   436,   440,   444,   448,   452,   456,   460,   464,   468,
+     472,   476,   480,   484,   488,   492,   499,   507,   511,   515,
+     517,   524,   531,   538,   551,   642,   649,   660,   667,   674,
+     681,   688,   695,   702,   709,   716,   723,   730,   737,   744,
+     751,   758,   765,   772,   779,   786,   793,   800,   807,   814,
+     821,   828,   835,   842,   849,   856,   868,   881,   888,   895
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "NUMBER", "IDENT", "SEP", "ABS", "SQRT",
-  "EXP", "LOG", "LOG10", "SIN", "COS", "TAN", "ASIN", "ACOS", "ATAN",
-  "SINH", "COSH", "TANH", "ASINH", "ACOSH", "ATANH", "FLOOR", "CEIL", "J0",
-  "J1", "Y0", "Y1", "LGAMMA", "GAMMA", "ERF", "ERFC", "INVERF", "NORM",
-  "INVNORM", "IGAMMA", "IBETA", "EVERY", "FROM", "PRINT", "STEP", "EXAM",
-  "'='", "'+'", "'-'", "'*'", "'/'", "'^'", "UMINUS", "'''", "','", "'~'",
-  "'!'", "'?'", "'('", "')'", "$accept", "program", "stat", "prtlist",
-  "prtitem", "prttag", "optevery", "optfrom", "cexpr", "expr", 0
+  "\"end of file\"", "error", "\"invalid token\"", "NUMBER", "IDENT",
+  "SEP", "ABS", "SQRT", "EXP", "LOG", "LOG10", "SIN", "COS", "TAN", "ASIN",
+  "ACOS", "ATAN", "SINH", "COSH", "TANH", "ASINH", "ACOSH", "ATANH",
+  "FLOOR", "CEIL", "J0", "J1", "Y0", "Y1", "LGAMMA", "GAMMA", "ERF",
+  "ERFC", "INVERF", "NORM", "INVNORM", "IGAMMA", "IBETA", "EVERY", "FROM",
+  "PRINT", "STEP", "EXAM", "UNTIL", "EVENT", "'='", "'+'", "'-'", "'*'",
+  "'/'", "'^'", "UMINUS", "'\\''", "','", "'~'", "'!'", "'?'", "'('",
+  "')'", "$accept", "program", "stat", "evkind", "prtlist", "prtitem",
+  "prttag", "optevery", "optfrom", "cexpr", "expr", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,    61,    43,    45,    42,    47,    94,   298,
-      39,    44,   126,    33,    63,    40,    41
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,    57,    58,    58,    59,    59,    59,    59,    59,    59,
-      59,    59,    60,    60,    61,    62,    62,    62,    62,    62,
-      63,    63,    64,    64,    65,    65,    65,    65,    65,    65,
-      65,    65,    65,    65,    65,    65,    65,    65,    65,    65,
-      65,    65,    65,    65,    65,    65,    65,    65,    65,    65,
-      65,    65,    65,    65,    65,    65,    65,    65,    65,    65,
-      65,    65,    65,    65,    66,    66,    66,    66,    66,    66,
-      66,    66,    66,    66,    66,    66,    66,    66,    66,    66,
-      66,    66,    66,    66,    66,    66,    66,    66,    66,    66,
-      66,    66,    66,    66,    66,    66,    66,    66,    66,    66,
-      66,    66,    66,    66,    66
-};
+#define YYPACT_NINF (-45)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+#define YYTABLE_NINF (-1)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
 {
-       0,     2,     1,     2,     1,     4,     2,     5,     5,     5,
-       7,     3,     1,     3,     2,     0,     1,     1,     1,     1,
-       0,     2,     0,     2,     3,     3,     3,     3,     3,     3,
-       4,     4,     4,     4,     4,     4,     4,     4,     4,     4,
-       4,     4,     4,     4,     4,     4,     4,     4,     4,     4,
-       4,     4,     4,     4,     4,     4,     4,     4,     4,     4,
-       6,     8,     2,     1,     3,     3,     3,     3,     3,     3,
-       4,     4,     4,     4,     4,     4,     4,     4,     4,     4,
-       4,     4,     4,     4,     4,     4,     4,     4,     4,     4,
-       4,     4,     4,     4,     4,     4,     4,     4,     4,     4,
-       6,     8,     2,     1,     1
+     303,     7,   -27,   -45,     9,    30,    11,   -45,   -45,   298,
+     -45,   172,   -45,   224,   -28,   220,   -37,   -45,   -45,   -31,
+      16,    17,    19,    21,    24,    25,    27,    29,    63,    64,
+     153,   159,   160,   161,   163,   164,   167,   168,   169,   212,
+     213,   222,   223,   232,   235,   238,   239,   240,   243,   244,
+     248,    30,    30,   848,    26,   -45,   -45,   -45,   -45,   -45,
+     249,   267,   270,   271,   272,   274,   301,   304,   305,   306,
+     319,   322,   323,   324,   337,   340,   341,   342,   355,   358,
+     359,   360,   373,   376,   377,   378,   391,   394,   395,   396,
+     409,   412,   224,   224,   217,   263,   224,   -45,   -45,   -45,
+     -45,   -45,    30,     9,   254,    30,    30,    30,    30,    30,
+      30,    30,    30,    30,    30,    30,    30,    30,    30,    30,
+      30,    30,    30,    30,    30,    30,    30,    30,    30,    30,
+      30,    30,    30,    30,    30,    30,    30,   -45,   -44,    30,
+      30,    30,    30,    30,    30,   -45,   224,   224,   224,   224,
+     224,   224,   224,   224,   224,   224,   224,   224,   224,   224,
+     224,   224,   224,   224,   224,   224,   224,   224,   224,   224,
+     224,   224,   224,   224,   224,   224,   224,   224,   -45,   -39,
+     -45,   224,   224,   224,   224,   224,   224,   -45,   268,    82,
+     -45,    30,   354,   -26,   165,   236,   302,   307,   320,   325,
+     338,   343,   356,   361,   374,   379,   392,   397,   410,   415,
+     428,   433,   446,   451,   464,   469,   482,   487,   500,   505,
+     518,   523,   536,   856,   864,   -45,   -20,   -20,   227,   227,
+     227,    22,   541,   554,   559,   572,   577,   590,   595,   608,
+     613,   626,   631,   644,   649,   662,   667,   680,   685,   698,
+     703,   716,   721,   734,   739,   752,   757,   770,   775,   788,
+     793,   806,   872,   880,   -45,   273,   117,   117,   314,   314,
+     314,   -45,    82,   -45,   -45,   -45,   -45,   -45,   -45,   -45,
+     -45,   -45,   -45,   -45,   -45,   -45,   -45,   -45,   -45,   -45,
+     -45,   -45,   -45,   -45,   -45,   -45,   -45,   -45,   -45,   -45,
+     -45,   -45,   -45,   -45,    30,    30,   -45,    30,   -45,   -45,
+     -45,   -45,   -45,   -45,   -45,   -45,   -45,   -45,   -45,   -45,
+     -45,   -45,   -45,   -45,   -45,   -45,   -45,   -45,   -45,   -45,
+     -45,   -45,   -45,   -45,   -45,   -45,   -45,   -45,   224,   224,
+     -45,   811,   888,   286,   824,   896,   -45,    30,   -45,   -45,
+     224,   829,   842,   -45,   -45
 };
 
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
    means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+static const yytype_int8 yydefact[] =
 {
-       0,     0,     0,     4,     0,     0,     0,     0,     2,     6,
-       0,     0,    15,    20,    12,    63,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     4,     0,     0,     0,    15,    16,     0,
+       2,     0,     6,     0,     0,    20,    25,    17,    68,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     1,     3,   103,   104,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     1,     3,   108,   109,    14,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,    16,    17,    18,    19,    14,     0,     0,    22,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    21,    22,    23,
+      24,    19,     0,     0,    27,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,    62,     0,     0,     0,     0,     0,     0,     0,
-      11,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    67,     0,     0,
+       0,     0,     0,     0,     0,    11,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,   102,     0,     5,     0,     0,     0,     0,
-       0,     0,    21,    13,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,   107,     0,
+      12,     0,     0,     0,     0,     0,     0,     5,     0,    26,
+      18,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,    24,    25,
-      26,    27,    28,    29,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,    29,    30,    31,    32,    33,
+      34,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,    64,    65,    66,
-      67,    68,    69,     7,    23,     8,    31,    30,    32,    33,
-      34,    35,    36,    37,    41,    42,    43,    44,    45,    46,
-      38,    39,    40,    47,    48,    49,    50,    51,    52,    56,
-      57,    54,    53,    55,    58,    59,     0,     0,     9,     0,
-      71,    70,    72,    73,    74,    75,    76,    77,    81,    82,
-      83,    84,    85,    86,    78,    79,    80,    87,    88,    89,
-      90,    91,    92,    93,    94,    96,    95,    97,    98,    99,
-       0,     0,     0,     0,     0,     0,     0,    60,     0,    10,
-     100,     0,     0,     0,    61,   101
+       0,     0,     0,     0,    69,     0,    70,    71,    72,    73,
+      74,     7,    28,     8,    36,    35,    37,    38,    39,    40,
+      41,    42,    46,    47,    48,    49,    50,    51,    43,    44,
+      45,    52,    53,    54,    55,    56,    57,    61,    62,    59,
+      58,    60,    63,    64,     0,     0,     9,     0,    76,    75,
+      77,    78,    79,    80,    81,    82,    86,    87,    88,    89,
+      90,    91,    83,    84,    85,    92,    93,    94,    95,    96,
+      97,    98,    99,   101,   100,   102,   103,   104,     0,     0,
+      13,     0,     0,     0,     0,     0,    65,     0,    10,   105,
+       0,     0,     0,    66,   106
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+     -45,   -45,   368,   -45,   -45,   279,   -45,   -45,   -45,   -17,
+     -13
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
+static const yytype_uint8 yydefgoto[] =
 {
-      -1,     7,     8,    13,    14,    96,    99,   185,    50,    90
+       0,     9,    10,    11,    16,    17,   101,   104,   192,    53,
+      94
 };
 
-/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-   STATE-NUM.  */
-#define YYPACT_NINF -50
-static const yytype_int16 yypact[] =
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
 {
-     233,    -2,   -22,   -50,    12,   181,    44,   228,   -50,   -50,
-     131,     8,   -16,   -36,   -50,   -50,    29,    30,   114,   115,
-     122,   123,   124,   126,   128,   130,   170,   172,   176,   180,
-     184,   190,   191,   192,   195,   203,   204,   206,   207,   216,
-     217,   234,   236,   238,   251,   254,   255,   256,   181,   181,
-     209,   177,   -50,   -50,   -50,   -50,   269,   272,   273,   274,
-     287,   290,   291,   292,   305,   308,   309,   310,   323,   326,
-     327,   328,   341,   344,   345,   346,   359,   362,   363,   364,
-     377,   380,   381,   382,   395,   398,   399,   400,   131,   131,
-     127,   131,   -50,   -50,   -50,   -50,   -50,   181,    12,    94,
-     181,   181,   181,   181,   181,   181,   181,   181,   181,   181,
-     181,   181,   181,   181,   181,   181,   181,   181,   181,   181,
-     181,   181,   181,   181,   181,   181,   181,   181,   181,   181,
-     181,   181,   -50,   -39,   181,   181,   181,   181,   181,   181,
-     -50,   131,   131,   131,   131,   131,   131,   131,   131,   131,
-     131,   131,   131,   131,   131,   131,   131,   131,   131,   131,
-     131,   131,   131,   131,   131,   131,   131,   131,   131,   131,
-     131,   131,   131,   -50,   -34,   -50,   131,   131,   131,   131,
-     131,   175,   828,   -50,   181,   225,   -21,   -15,   196,   232,
-     239,   252,   257,   270,   275,   288,   293,   306,   311,   324,
-     329,   342,   347,   360,   365,   378,   383,   396,   401,   414,
-     419,   432,   437,   450,   455,   468,   780,   788,   -50,   -28,
-     -28,   246,   246,   246,    -1,   473,   486,   491,   504,   509,
-     522,   527,   540,   545,   558,   563,   576,   581,   594,   599,
-     612,   617,   630,   635,   648,   653,   666,   671,   684,   689,
-     702,   707,   720,   725,   738,   796,   804,   -50,    78,    78,
-     259,   259,   259,   -50,   828,   -50,   -50,   -50,   -50,   -50,
-     -50,   -50,   -50,   -50,   -50,   -50,   -50,   -50,   -50,   -50,
-     -50,   -50,   -50,   -50,   -50,   -50,   -50,   -50,   -50,   -50,
-     -50,   -50,   -50,   -50,   -50,   -50,   181,   181,   -50,   181,
-     -50,   -50,   -50,   -50,   -50,   -50,   -50,   -50,   -50,   -50,
-     -50,   -50,   -50,   -50,   -50,   -50,   -50,   -50,   -50,   -50,
-     -50,   -50,   -50,   -50,   -50,   -50,   -50,   -50,   -50,   -50,
-     131,   131,   743,   812,   219,   756,   820,   -50,   181,   -50,
-     -50,   131,   761,   774,   -50,   -50
+      95,   102,   139,   140,   141,   142,   143,   182,   183,   184,
+     185,   186,    12,    15,   225,    54,   103,    96,    13,   264,
+     139,   140,   141,   142,   143,    14,   105,   306,   141,   142,
+     143,   145,   274,    18,   137,   138,    19,    20,    21,    22,
+      23,    24,    25,    26,    27,    28,    29,    30,    31,    32,
+      33,    34,    35,    36,    37,    38,    39,    40,    41,    42,
+      43,    44,    45,    46,    47,    48,    49,    50,   139,   140,
+     141,   142,   143,   106,   107,   307,   108,    51,   109,   178,
+     179,   110,   111,   188,   112,   189,   113,    52,   193,   194,
+     195,   196,   197,   198,   199,   200,   201,   202,   203,   204,
+     205,   206,   207,   208,   209,   210,   211,   212,   213,   214,
+     215,   216,   217,   218,   219,   220,   221,   222,   223,   224,
+     114,   115,   226,   227,   228,   229,   230,   231,   139,   140,
+     141,   142,   143,   232,   233,   234,   235,   236,   237,   238,
+     239,   240,   241,   242,   243,   244,   245,   246,   247,   248,
+     249,   250,   251,   252,   253,   254,   255,   256,   257,   258,
+     259,   260,   261,   262,   263,   184,   185,   186,   265,   266,
+     267,   268,   269,   270,   272,    57,    58,    59,    60,    61,
+      62,    63,    64,    65,    66,    67,    68,    69,    70,    71,
+      72,    73,    74,    75,    76,    77,    78,    79,    80,    81,
+      82,    83,    84,    85,    86,    87,    88,    89,    90,    91,
+     116,   139,   140,   141,   142,   143,   117,   118,   119,    92,
+     120,   121,   180,   275,   122,   123,   124,    57,    58,    93,
+      60,    61,    62,    63,    64,    65,    66,    67,    68,    69,
+      70,    71,    72,    73,    74,    75,    76,    77,    78,    79,
+      80,    81,    82,    83,    84,    85,    86,    87,    88,    89,
+      90,    91,   181,   182,   183,   184,   185,   186,   187,   125,
+     126,    92,    97,   271,    98,    99,   100,   143,   340,   127,
+     128,    93,   139,   140,   141,   142,   143,   341,   342,   129,
+     343,   348,   130,   191,   276,   131,   132,   133,    55,     1,
+     134,   135,     2,     3,     1,   136,   146,     2,     3,   182,
+     183,   184,   185,   186,   182,   183,   184,   185,   186,   182,
+     183,   184,   185,   186,   147,   344,   345,   148,   149,   150,
+     351,   151,   139,   140,   141,   142,   143,   352,     4,     5,
+       6,     7,     8,     4,     5,     6,     7,     8,   139,   140,
+     141,   142,   143,   139,   140,   141,   142,   143,   152,   273,
+     277,   153,   154,   155,   186,   278,   139,   140,   141,   142,
+     143,   139,   140,   141,   142,   143,   156,    56,   279,   157,
+     158,   159,   190,   280,   139,   140,   141,   142,   143,   139,
+     140,   141,   142,   143,   160,     0,   281,   161,   162,   163,
+       0,   282,   139,   140,   141,   142,   143,   139,   140,   141,
+     142,   143,   164,     0,   283,   165,   166,   167,     0,   284,
+     139,   140,   141,   142,   143,   139,   140,   141,   142,   143,
+     168,     0,   285,   169,   170,   171,     0,   286,   139,   140,
+     141,   142,   143,   139,   140,   141,   142,   143,   172,     0,
+     287,   173,   174,   175,     0,   288,   139,   140,   141,   142,
+     143,   139,   140,   141,   142,   143,   176,     0,   289,   177,
+       0,     0,     0,   290,   139,   140,   141,   142,   143,   139,
+     140,   141,   142,   143,     0,     0,   291,     0,     0,     0,
+       0,   292,   139,   140,   141,   142,   143,   139,   140,   141,
+     142,   143,     0,     0,   293,     0,     0,     0,     0,   294,
+     139,   140,   141,   142,   143,   139,   140,   141,   142,   143,
+       0,     0,   295,     0,     0,     0,     0,   296,   139,   140,
+     141,   142,   143,   139,   140,   141,   142,   143,     0,     0,
+     297,     0,     0,     0,     0,   298,   139,   140,   141,   142,
+     143,   139,   140,   141,   142,   143,     0,     0,   299,     0,
+       0,     0,     0,   300,   139,   140,   141,   142,   143,   139,
+     140,   141,   142,   143,     0,     0,   301,     0,     0,     0,
+       0,   302,   139,   140,   141,   142,   143,   182,   183,   184,
+     185,   186,     0,     0,   303,     0,     0,     0,     0,   308,
+     182,   183,   184,   185,   186,   182,   183,   184,   185,   186,
+       0,     0,   309,     0,     0,     0,     0,   310,   182,   183,
+     184,   185,   186,   182,   183,   184,   185,   186,     0,     0,
+     311,     0,     0,     0,     0,   312,   182,   183,   184,   185,
+     186,   182,   183,   184,   185,   186,     0,     0,   313,     0,
+       0,     0,     0,   314,   182,   183,   184,   185,   186,   182,
+     183,   184,   185,   186,     0,     0,   315,     0,     0,     0,
+       0,   316,   182,   183,   184,   185,   186,   182,   183,   184,
+     185,   186,     0,     0,   317,     0,     0,     0,     0,   318,
+     182,   183,   184,   185,   186,   182,   183,   184,   185,   186,
+       0,     0,   319,     0,     0,     0,     0,   320,   182,   183,
+     184,   185,   186,   182,   183,   184,   185,   186,     0,     0,
+     321,     0,     0,     0,     0,   322,   182,   183,   184,   185,
+     186,   182,   183,   184,   185,   186,     0,     0,   323,     0,
+       0,     0,     0,   324,   182,   183,   184,   185,   186,   182,
+     183,   184,   185,   186,     0,     0,   325,     0,     0,     0,
+       0,   326,   182,   183,   184,   185,   186,   182,   183,   184,
+     185,   186,     0,     0,   327,     0,     0,     0,     0,   328,
+     182,   183,   184,   185,   186,   182,   183,   184,   185,   186,
+       0,     0,   329,     0,     0,     0,     0,   330,   182,   183,
+     184,   185,   186,   182,   183,   184,   185,   186,     0,     0,
+     331,     0,     0,     0,     0,   332,   182,   183,   184,   185,
+     186,   182,   183,   184,   185,   186,     0,     0,   333,     0,
+       0,     0,     0,   334,   182,   183,   184,   185,   186,   182,
+     183,   184,   185,   186,     0,     0,   335,     0,     0,     0,
+       0,   336,   182,   183,   184,   185,   186,   139,   140,   141,
+     142,   143,     0,     0,   337,     0,     0,     0,     0,   346,
+     182,   183,   184,   185,   186,   139,   140,   141,   142,   143,
+       0,     0,   349,     0,     0,     0,     0,   353,   182,   183,
+     184,   185,   186,     0,   139,   140,   141,   142,   143,     0,
+     354,   144,   139,   140,   141,   142,   143,     0,     0,   304,
+     139,   140,   141,   142,   143,     0,     0,   305,   182,   183,
+     184,   185,   186,     0,     0,   338,   182,   183,   184,   185,
+     186,     0,     0,   339,   139,   140,   141,   142,   143,     0,
+       0,   347,   182,   183,   184,   185,   186,     0,     0,   350
 };
 
-/* YYPGOTO[NTERM-NUM].  */
-static const yytype_int16 yypgoto[] =
+static const yytype_int16 yycheck[] =
 {
-     -50,   -50,   318,   -50,   214,   -50,   -50,   -50,   -48,   -49
+      13,    38,    46,    47,    48,    49,    50,    46,    47,    48,
+      49,    50,     5,     4,    58,     4,    53,    45,    45,    58,
+      46,    47,    48,    49,    50,    52,    57,     5,    48,    49,
+      50,     5,    58,     3,    51,    52,     6,     7,     8,     9,
+      10,    11,    12,    13,    14,    15,    16,    17,    18,    19,
+      20,    21,    22,    23,    24,    25,    26,    27,    28,    29,
+      30,    31,    32,    33,    34,    35,    36,    37,    46,    47,
+      48,    49,    50,    57,    57,    53,    57,    47,    57,    92,
+      93,    57,    57,    96,    57,   102,    57,    57,   105,   106,
+     107,   108,   109,   110,   111,   112,   113,   114,   115,   116,
+     117,   118,   119,   120,   121,   122,   123,   124,   125,   126,
+     127,   128,   129,   130,   131,   132,   133,   134,   135,   136,
+      57,    57,   139,   140,   141,   142,   143,   144,    46,    47,
+      48,    49,    50,   146,   147,   148,   149,   150,   151,   152,
+     153,   154,   155,   156,   157,   158,   159,   160,   161,   162,
+     163,   164,   165,   166,   167,   168,   169,   170,   171,   172,
+     173,   174,   175,   176,   177,    48,    49,    50,   181,   182,
+     183,   184,   185,   186,   191,     3,     4,     5,     6,     7,
+       8,     9,    10,    11,    12,    13,    14,    15,    16,    17,
+      18,    19,    20,    21,    22,    23,    24,    25,    26,    27,
+      28,    29,    30,    31,    32,    33,    34,    35,    36,    37,
+      57,    46,    47,    48,    49,    50,    57,    57,    57,    47,
+      57,    57,     5,    58,    57,    57,    57,     3,     4,    57,
+       6,     7,     8,     9,    10,    11,    12,    13,    14,    15,
+      16,    17,    18,    19,    20,    21,    22,    23,    24,    25,
+      26,    27,    28,    29,    30,    31,    32,    33,    34,    35,
+      36,    37,    45,    46,    47,    48,    49,    50,     5,    57,
+      57,    47,    52,     5,    54,    55,    56,    50,     5,    57,
+      57,    57,    46,    47,    48,    49,    50,   304,   305,    57,
+     307,     5,    57,    39,    58,    57,    57,    57,     0,     1,
+      57,    57,     4,     5,     1,    57,    57,     4,     5,    46,
+      47,    48,    49,    50,    46,    47,    48,    49,    50,    46,
+      47,    48,    49,    50,    57,   338,   339,    57,    57,    57,
+     347,    57,    46,    47,    48,    49,    50,   350,    40,    41,
+      42,    43,    44,    40,    41,    42,    43,    44,    46,    47,
+      48,    49,    50,    46,    47,    48,    49,    50,    57,     5,
+      58,    57,    57,    57,    50,    58,    46,    47,    48,    49,
+      50,    46,    47,    48,    49,    50,    57,     9,    58,    57,
+      57,    57,   103,    58,    46,    47,    48,    49,    50,    46,
+      47,    48,    49,    50,    57,    -1,    58,    57,    57,    57,
+      -1,    58,    46,    47,    48,    49,    50,    46,    47,    48,
+      49,    50,    57,    -1,    58,    57,    57,    57,    -1,    58,
+      46,    47,    48,    49,    50,    46,    47,    48,    49,    50,
+      57,    -1,    58,    57,    57,    57,    -1,    58,    46,    47,
+      48,    49,    50,    46,    47,    48,    49,    50,    57,    -1,
+      58,    57,    57,    57,    -1,    58,    46,    47,    48,    49,
+      50,    46,    47,    48,    49,    50,    57,    -1,    58,    57,
+      -1,    -1,    -1,    58,    46,    47,    48,    49,    50,    46,
+      47,    48,    49,    50,    -1,    -1,    58,    -1,    -1,    -1,
+      -1,    58,    46,    47,    48,    49,    50,    46,    47,    48,
+      49,    50,    -1,    -1,    58,    -1,    -1,    -1,    -1,    58,
+      46,    47,    48,    49,    50,    46,    47,    48,    49,    50,
+      -1,    -1,    58,    -1,    -1,    -1,    -1,    58,    46,    47,
+      48,    49,    50,    46,    47,    48,    49,    50,    -1,    -1,
+      58,    -1,    -1,    -1,    -1,    58,    46,    47,    48,    49,
+      50,    46,    47,    48,    49,    50,    -1,    -1,    58,    -1,
+      -1,    -1,    -1,    58,    46,    47,    48,    49,    50,    46,
+      47,    48,    49,    50,    -1,    -1,    58,    -1,    -1,    -1,
+      -1,    58,    46,    47,    48,    49,    50,    46,    47,    48,
+      49,    50,    -1,    -1,    58,    -1,    -1,    -1,    -1,    58,
+      46,    47,    48,    49,    50,    46,    47,    48,    49,    50,
+      -1,    -1,    58,    -1,    -1,    -1,    -1,    58,    46,    47,
+      48,    49,    50,    46,    47,    48,    49,    50,    -1,    -1,
+      58,    -1,    -1,    -1,    -1,    58,    46,    47,    48,    49,
+      50,    46,    47,    48,    49,    50,    -1,    -1,    58,    -1,
+      -1,    -1,    -1,    58,    46,    47,    48,    49,    50,    46,
+      47,    48,    49,    50,    -1,    -1,    58,    -1,    -1,    -1,
+      -1,    58,    46,    47,    48,    49,    50,    46,    47,    48,
+      49,    50,    -1,    -1,    58,    -1,    -1,    -1,    -1,    58,
+      46,    47,    48,    49,    50,    46,    47,    48,    49,    50,
+      -1,    -1,    58,    -1,    -1,    -1,    -1,    58,    46,    47,
+      48,    49,    50,    46,    47,    48,    49,    50,    -1,    -1,
+      58,    -1,    -1,    -1,    -1,    58,    46,    47,    48,    49,
+      50,    46,    47,    48,    49,    50,    -1,    -1,    58,    -1,
+      -1,    -1,    -1,    58,    46,    47,    48,    49,    50,    46,
+      47,    48,    49,    50,    -1,    -1,    58,    -1,    -1,    -1,
+      -1,    58,    46,    47,    48,    49,    50,    46,    47,    48,
+      49,    50,    -1,    -1,    58,    -1,    -1,    -1,    -1,    58,
+      46,    47,    48,    49,    50,    46,    47,    48,    49,    50,
+      -1,    -1,    58,    -1,    -1,    -1,    -1,    58,    46,    47,
+      48,    49,    50,    46,    47,    48,    49,    50,    -1,    -1,
+      58,    -1,    -1,    -1,    -1,    58,    46,    47,    48,    49,
+      50,    46,    47,    48,    49,    50,    -1,    -1,    58,    -1,
+      -1,    -1,    -1,    58,    46,    47,    48,    49,    50,    46,
+      47,    48,    49,    50,    -1,    -1,    58,    -1,    -1,    -1,
+      -1,    58,    46,    47,    48,    49,    50,    46,    47,    48,
+      49,    50,    -1,    -1,    58,    -1,    -1,    -1,    -1,    58,
+      46,    47,    48,    49,    50,    46,    47,    48,    49,    50,
+      -1,    -1,    58,    -1,    -1,    -1,    -1,    58,    46,    47,
+      48,    49,    50,    -1,    46,    47,    48,    49,    50,    -1,
+      58,    53,    46,    47,    48,    49,    50,    -1,    -1,    53,
+      46,    47,    48,    49,    50,    -1,    -1,    53,    46,    47,
+      48,    49,    50,    -1,    -1,    53,    46,    47,    48,    49,
+      50,    -1,    -1,    53,    46,    47,    48,    49,    50,    -1,
+      -1,    53,    46,    47,    48,    49,    50,    -1,    -1,    53
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -1
-static const yytype_uint16 yytable[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
-     132,   133,    97,     9,   298,   134,   135,   136,   137,   138,
-     176,   177,   178,   179,   180,    98,    12,   218,   136,   137,
-     138,    10,   257,   134,   135,   136,   137,   138,    11,   134,
-     135,   136,   137,   138,    92,   266,    93,    94,    95,   173,
-     174,   267,   181,   134,   135,   136,   137,   138,    51,   182,
-     299,    91,   186,   187,   188,   189,   190,   191,   192,   193,
-     194,   195,   196,   197,   198,   199,   200,   201,   202,   203,
-     204,   205,   206,   207,   208,   209,   210,   211,   212,   213,
-     214,   215,   216,   217,   100,   101,   219,   220,   221,   222,
-     223,   224,   225,   226,   227,   228,   229,   230,   231,   232,
-     233,   234,   235,   236,   237,   238,   239,   240,   241,   242,
-     243,   244,   245,   246,   247,   248,   249,   250,   251,   252,
-     253,   254,   255,   256,   178,   179,   180,   258,   259,   260,
-     261,   262,   175,   184,    54,    55,   264,    56,    57,    58,
-      59,    60,    61,    62,    63,    64,    65,    66,    67,    68,
-      69,    70,    71,    72,    73,    74,    75,    76,    77,    78,
-      79,    80,    81,    82,    83,    84,    85,    86,    87,   102,
-     103,   176,   177,   178,   179,   180,    88,   104,   105,   106,
-     263,   107,   140,   108,    15,   109,    89,    16,    17,    18,
-      19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
-      29,    30,    31,    32,    33,    34,    35,    36,    37,    38,
-      39,    40,    41,    42,    43,    44,    45,    46,    47,   176,
-     177,   178,   179,   180,   339,   110,    48,   111,    52,     1,
-     265,   112,     2,     3,     1,   113,    49,     2,     3,   114,
-     134,   135,   136,   137,   138,   115,   116,   117,   332,   333,
-     118,   334,   268,   134,   135,   136,   137,   138,   119,   120,
-     139,   121,   122,   134,   135,   136,   137,   138,     4,     5,
-       6,   123,   124,     4,     5,     6,   134,   135,   136,   137,
-     138,   335,   336,   134,   135,   136,   137,   138,   269,   125,
-     342,   126,   343,   127,   138,   270,   134,   135,   136,   137,
-     138,   134,   135,   136,   137,   138,   128,   180,   271,   129,
-     130,   131,   183,   272,   134,   135,   136,   137,   138,   134,
-     135,   136,   137,   138,   141,    53,   273,   142,   143,   144,
-       0,   274,   134,   135,   136,   137,   138,   134,   135,   136,
-     137,   138,   145,     0,   275,   146,   147,   148,     0,   276,
-     134,   135,   136,   137,   138,   134,   135,   136,   137,   138,
-     149,     0,   277,   150,   151,   152,     0,   278,   134,   135,
-     136,   137,   138,   134,   135,   136,   137,   138,   153,     0,
-     279,   154,   155,   156,     0,   280,   134,   135,   136,   137,
-     138,   134,   135,   136,   137,   138,   157,     0,   281,   158,
-     159,   160,     0,   282,   134,   135,   136,   137,   138,   134,
-     135,   136,   137,   138,   161,     0,   283,   162,   163,   164,
-       0,   284,   134,   135,   136,   137,   138,   134,   135,   136,
-     137,   138,   165,     0,   285,   166,   167,   168,     0,   286,
-     134,   135,   136,   137,   138,   134,   135,   136,   137,   138,
-     169,     0,   287,   170,   171,   172,     0,   288,   134,   135,
-     136,   137,   138,   134,   135,   136,   137,   138,     0,     0,
-     289,     0,     0,     0,     0,   290,   134,   135,   136,   137,
-     138,   134,   135,   136,   137,   138,     0,     0,   291,     0,
-       0,     0,     0,   292,   134,   135,   136,   137,   138,   134,
-     135,   136,   137,   138,     0,     0,   293,     0,     0,     0,
-       0,   294,   134,   135,   136,   137,   138,   176,   177,   178,
-     179,   180,     0,     0,   295,     0,     0,     0,     0,   300,
-     176,   177,   178,   179,   180,   176,   177,   178,   179,   180,
-       0,     0,   301,     0,     0,     0,     0,   302,   176,   177,
-     178,   179,   180,   176,   177,   178,   179,   180,     0,     0,
-     303,     0,     0,     0,     0,   304,   176,   177,   178,   179,
-     180,   176,   177,   178,   179,   180,     0,     0,   305,     0,
-       0,     0,     0,   306,   176,   177,   178,   179,   180,   176,
-     177,   178,   179,   180,     0,     0,   307,     0,     0,     0,
-       0,   308,   176,   177,   178,   179,   180,   176,   177,   178,
-     179,   180,     0,     0,   309,     0,     0,     0,     0,   310,
-     176,   177,   178,   179,   180,   176,   177,   178,   179,   180,
-       0,     0,   311,     0,     0,     0,     0,   312,   176,   177,
-     178,   179,   180,   176,   177,   178,   179,   180,     0,     0,
-     313,     0,     0,     0,     0,   314,   176,   177,   178,   179,
-     180,   176,   177,   178,   179,   180,     0,     0,   315,     0,
-       0,     0,     0,   316,   176,   177,   178,   179,   180,   176,
-     177,   178,   179,   180,     0,     0,   317,     0,     0,     0,
-       0,   318,   176,   177,   178,   179,   180,   176,   177,   178,
-     179,   180,     0,     0,   319,     0,     0,     0,     0,   320,
-     176,   177,   178,   179,   180,   176,   177,   178,   179,   180,
-       0,     0,   321,     0,     0,     0,     0,   322,   176,   177,
-     178,   179,   180,   176,   177,   178,   179,   180,     0,     0,
-     323,     0,     0,     0,     0,   324,   176,   177,   178,   179,
-     180,   176,   177,   178,   179,   180,     0,     0,   325,     0,
-       0,     0,     0,   326,   176,   177,   178,   179,   180,   176,
-     177,   178,   179,   180,     0,     0,   327,     0,     0,     0,
-       0,   328,   176,   177,   178,   179,   180,   134,   135,   136,
-     137,   138,     0,     0,   329,     0,     0,     0,     0,   337,
-     176,   177,   178,   179,   180,   134,   135,   136,   137,   138,
-       0,     0,   340,     0,     0,     0,     0,   344,   176,   177,
-     178,   179,   180,     0,   134,   135,   136,   137,   138,     0,
-     345,   296,   134,   135,   136,   137,   138,     0,     0,   297,
-     176,   177,   178,   179,   180,     0,     0,   330,   176,   177,
-     178,   179,   180,     0,     0,   331,   134,   135,   136,   137,
-     138,     0,     0,   338,   176,   177,   178,   179,   180,     0,
-       0,   341,   134,   135,   136,   137,   138
+       0,     1,     4,     5,    40,    41,    42,    43,    44,    60,
+      61,    62,     5,    45,    52,     4,    63,    64,     3,     6,
+       7,     8,     9,    10,    11,    12,    13,    14,    15,    16,
+      17,    18,    19,    20,    21,    22,    23,    24,    25,    26,
+      27,    28,    29,    30,    31,    32,    33,    34,    35,    36,
+      37,    47,    57,    68,     4,     0,    61,     3,     4,     5,
+       6,     7,     8,     9,    10,    11,    12,    13,    14,    15,
+      16,    17,    18,    19,    20,    21,    22,    23,    24,    25,
+      26,    27,    28,    29,    30,    31,    32,    33,    34,    35,
+      36,    37,    47,    57,    69,    69,    45,    52,    54,    55,
+      56,    65,    38,    53,    66,    57,    57,    57,    57,    57,
+      57,    57,    57,    57,    57,    57,    57,    57,    57,    57,
+      57,    57,    57,    57,    57,    57,    57,    57,    57,    57,
+      57,    57,    57,    57,    57,    57,    57,    68,    68,    46,
+      47,    48,    49,    50,    53,     5,    57,    57,    57,    57,
+      57,    57,    57,    57,    57,    57,    57,    57,    57,    57,
+      57,    57,    57,    57,    57,    57,    57,    57,    57,    57,
+      57,    57,    57,    57,    57,    57,    57,    57,    69,    69,
+       5,    45,    46,    47,    48,    49,    50,     5,    69,    68,
+      64,    39,    67,    68,    68,    68,    68,    68,    68,    68,
+      68,    68,    68,    68,    68,    68,    68,    68,    68,    68,
+      68,    68,    68,    68,    68,    68,    68,    68,    68,    68,
+      68,    68,    68,    68,    68,    58,    68,    68,    68,    68,
+      68,    68,    69,    69,    69,    69,    69,    69,    69,    69,
+      69,    69,    69,    69,    69,    69,    69,    69,    69,    69,
+      69,    69,    69,    69,    69,    69,    69,    69,    69,    69,
+      69,    69,    69,    69,    58,    69,    69,    69,    69,    69,
+      69,     5,    68,     5,    58,    58,    58,    58,    58,    58,
+      58,    58,    58,    58,    58,    58,    58,    58,    58,    58,
+      58,    58,    58,    58,    58,    58,    58,    58,    58,    58,
+      58,    58,    58,    58,    53,    53,     5,    53,    58,    58,
+      58,    58,    58,    58,    58,    58,    58,    58,    58,    58,
+      58,    58,    58,    58,    58,    58,    58,    58,    58,    58,
+      58,    58,    58,    58,    58,    58,    58,    58,    53,    53,
+       5,    68,    68,    68,    69,    69,    58,    53,     5,    58,
+      53,    68,    69,    58,    58
 };
 
-static const yytype_int16 yycheck[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
-      48,    49,    38,     5,     5,    44,    45,    46,    47,    48,
-      44,    45,    46,    47,    48,    51,     4,    56,    46,    47,
-      48,    43,    56,    44,    45,    46,    47,    48,    50,    44,
-      45,    46,    47,    48,    50,    56,    52,    53,    54,    88,
-      89,    56,    91,    44,    45,    46,    47,    48,     4,    97,
-      51,    43,   100,   101,   102,   103,   104,   105,   106,   107,
-     108,   109,   110,   111,   112,   113,   114,   115,   116,   117,
-     118,   119,   120,   121,   122,   123,   124,   125,   126,   127,
-     128,   129,   130,   131,    55,    55,   134,   135,   136,   137,
-     138,   139,   141,   142,   143,   144,   145,   146,   147,   148,
-     149,   150,   151,   152,   153,   154,   155,   156,   157,   158,
-     159,   160,   161,   162,   163,   164,   165,   166,   167,   168,
-     169,   170,   171,   172,    46,    47,    48,   176,   177,   178,
-     179,   180,     5,    39,     3,     4,   184,     6,     7,     8,
-       9,    10,    11,    12,    13,    14,    15,    16,    17,    18,
-      19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
-      29,    30,    31,    32,    33,    34,    35,    36,    37,    55,
-      55,    44,    45,    46,    47,    48,    45,    55,    55,    55,
-       5,    55,     5,    55,     3,    55,    55,     6,     7,     8,
-       9,    10,    11,    12,    13,    14,    15,    16,    17,    18,
-      19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
-      29,    30,    31,    32,    33,    34,    35,    36,    37,    44,
-      45,    46,    47,    48,     5,    55,    45,    55,     0,     1,
-       5,    55,     4,     5,     1,    55,    55,     4,     5,    55,
-      44,    45,    46,    47,    48,    55,    55,    55,   296,   297,
-      55,   299,    56,    44,    45,    46,    47,    48,    55,    55,
-      51,    55,    55,    44,    45,    46,    47,    48,    40,    41,
-      42,    55,    55,    40,    41,    42,    44,    45,    46,    47,
-      48,   330,   331,    44,    45,    46,    47,    48,    56,    55,
-     338,    55,   341,    55,    48,    56,    44,    45,    46,    47,
-      48,    44,    45,    46,    47,    48,    55,    48,    56,    55,
-      55,    55,    98,    56,    44,    45,    46,    47,    48,    44,
-      45,    46,    47,    48,    55,     7,    56,    55,    55,    55,
-      -1,    56,    44,    45,    46,    47,    48,    44,    45,    46,
-      47,    48,    55,    -1,    56,    55,    55,    55,    -1,    56,
-      44,    45,    46,    47,    48,    44,    45,    46,    47,    48,
-      55,    -1,    56,    55,    55,    55,    -1,    56,    44,    45,
-      46,    47,    48,    44,    45,    46,    47,    48,    55,    -1,
-      56,    55,    55,    55,    -1,    56,    44,    45,    46,    47,
-      48,    44,    45,    46,    47,    48,    55,    -1,    56,    55,
-      55,    55,    -1,    56,    44,    45,    46,    47,    48,    44,
-      45,    46,    47,    48,    55,    -1,    56,    55,    55,    55,
-      -1,    56,    44,    45,    46,    47,    48,    44,    45,    46,
-      47,    48,    55,    -1,    56,    55,    55,    55,    -1,    56,
-      44,    45,    46,    47,    48,    44,    45,    46,    47,    48,
-      55,    -1,    56,    55,    55,    55,    -1,    56,    44,    45,
-      46,    47,    48,    44,    45,    46,    47,    48,    -1,    -1,
-      56,    -1,    -1,    -1,    -1,    56,    44,    45,    46,    47,
-      48,    44,    45,    46,    47,    48,    -1,    -1,    56,    -1,
-      -1,    -1,    -1,    56,    44,    45,    46,    47,    48,    44,
-      45,    46,    47,    48,    -1,    -1,    56,    -1,    -1,    -1,
-      -1,    56,    44,    45,    46,    47,    48,    44,    45,    46,
-      47,    48,    -1,    -1,    56,    -1,    -1,    -1,    -1,    56,
-      44,    45,    46,    47,    48,    44,    45,    46,    47,    48,
-      -1,    -1,    56,    -1,    -1,    -1,    -1,    56,    44,    45,
-      46,    47,    48,    44,    45,    46,    47,    48,    -1,    -1,
-      56,    -1,    -1,    -1,    -1,    56,    44,    45,    46,    47,
-      48,    44,    45,    46,    47,    48,    -1,    -1,    56,    -1,
-      -1,    -1,    -1,    56,    44,    45,    46,    47,    48,    44,
-      45,    46,    47,    48,    -1,    -1,    56,    -1,    -1,    -1,
-      -1,    56,    44,    45,    46,    47,    48,    44,    45,    46,
-      47,    48,    -1,    -1,    56,    -1,    -1,    -1,    -1,    56,
-      44,    45,    46,    47,    48,    44,    45,    46,    47,    48,
-      -1,    -1,    56,    -1,    -1,    -1,    -1,    56,    44,    45,
-      46,    47,    48,    44,    45,    46,    47,    48,    -1,    -1,
-      56,    -1,    -1,    -1,    -1,    56,    44,    45,    46,    47,
-      48,    44,    45,    46,    47,    48,    -1,    -1,    56,    -1,
-      -1,    -1,    -1,    56,    44,    45,    46,    47,    48,    44,
-      45,    46,    47,    48,    -1,    -1,    56,    -1,    -1,    -1,
-      -1,    56,    44,    45,    46,    47,    48,    44,    45,    46,
-      47,    48,    -1,    -1,    56,    -1,    -1,    -1,    -1,    56,
-      44,    45,    46,    47,    48,    44,    45,    46,    47,    48,
-      -1,    -1,    56,    -1,    -1,    -1,    -1,    56,    44,    45,
-      46,    47,    48,    44,    45,    46,    47,    48,    -1,    -1,
-      56,    -1,    -1,    -1,    -1,    56,    44,    45,    46,    47,
-      48,    44,    45,    46,    47,    48,    -1,    -1,    56,    -1,
-      -1,    -1,    -1,    56,    44,    45,    46,    47,    48,    44,
-      45,    46,    47,    48,    -1,    -1,    56,    -1,    -1,    -1,
-      -1,    56,    44,    45,    46,    47,    48,    44,    45,    46,
-      47,    48,    -1,    -1,    56,    -1,    -1,    -1,    -1,    56,
-      44,    45,    46,    47,    48,    44,    45,    46,    47,    48,
-      -1,    -1,    56,    -1,    -1,    -1,    -1,    56,    44,    45,
-      46,    47,    48,    -1,    44,    45,    46,    47,    48,    -1,
-      56,    51,    44,    45,    46,    47,    48,    -1,    -1,    51,
-      44,    45,    46,    47,    48,    -1,    -1,    51,    44,    45,
-      46,    47,    48,    -1,    -1,    51,    44,    45,    46,    47,
-      48,    -1,    -1,    51,    44,    45,    46,    47,    48,    -1,
-      -1,    51,    44,    45,    46,    47,    48
+       0,    59,    60,    60,    61,    61,    61,    61,    61,    61,
+      61,    61,    61,    61,    61,    62,    62,    63,    63,    64,
+      65,    65,    65,    65,    65,    66,    66,    67,    67,    68,
+      68,    68,    68,    68,    68,    68,    68,    68,    68,    68,
+      68,    68,    68,    68,    68,    68,    68,    68,    68,    68,
+      68,    68,    68,    68,    68,    68,    68,    68,    68,    68,
+      68,    68,    68,    68,    68,    68,    68,    68,    68,    69,
+      69,    69,    69,    69,    69,    69,    69,    69,    69,    69,
+      69,    69,    69,    69,    69,    69,    69,    69,    69,    69,
+      69,    69,    69,    69,    69,    69,    69,    69,    69,    69,
+      69,    69,    69,    69,    69,    69,    69,    69,    69,    69
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
-       0,     1,     4,     5,    40,    41,    42,    58,    59,     5,
-      43,    50,     4,    60,    61,     3,     6,     7,     8,     9,
-      10,    11,    12,    13,    14,    15,    16,    17,    18,    19,
-      20,    21,    22,    23,    24,    25,    26,    27,    28,    29,
-      30,    31,    32,    33,    34,    35,    36,    37,    45,    55,
-      65,     4,     0,    59,     3,     4,     6,     7,     8,     9,
-      10,    11,    12,    13,    14,    15,    16,    17,    18,    19,
-      20,    21,    22,    23,    24,    25,    26,    27,    28,    29,
-      30,    31,    32,    33,    34,    35,    36,    37,    45,    55,
-      66,    43,    50,    52,    53,    54,    62,    38,    51,    63,
-      55,    55,    55,    55,    55,    55,    55,    55,    55,    55,
-      55,    55,    55,    55,    55,    55,    55,    55,    55,    55,
-      55,    55,    55,    55,    55,    55,    55,    55,    55,    55,
-      55,    55,    65,    65,    44,    45,    46,    47,    48,    51,
-       5,    55,    55,    55,    55,    55,    55,    55,    55,    55,
-      55,    55,    55,    55,    55,    55,    55,    55,    55,    55,
-      55,    55,    55,    55,    55,    55,    55,    55,    55,    55,
-      55,    55,    55,    66,    66,     5,    44,    45,    46,    47,
-      48,    66,    65,    61,    39,    64,    65,    65,    65,    65,
-      65,    65,    65,    65,    65,    65,    65,    65,    65,    65,
-      65,    65,    65,    65,    65,    65,    65,    65,    65,    65,
-      65,    65,    65,    65,    65,    65,    65,    65,    56,    65,
-      65,    65,    65,    65,    65,    66,    66,    66,    66,    66,
-      66,    66,    66,    66,    66,    66,    66,    66,    66,    66,
-      66,    66,    66,    66,    66,    66,    66,    66,    66,    66,
-      66,    66,    66,    66,    66,    66,    66,    56,    66,    66,
-      66,    66,    66,     5,    65,     5,    56,    56,    56,    56,
-      56,    56,    56,    56,    56,    56,    56,    56,    56,    56,
-      56,    56,    56,    56,    56,    56,    56,    56,    56,    56,
-      56,    56,    56,    56,    56,    56,    51,    51,     5,    51,
-      56,    56,    56,    56,    56,    56,    56,    56,    56,    56,
-      56,    56,    56,    56,    56,    56,    56,    56,    56,    56,
-      56,    56,    56,    56,    56,    56,    56,    56,    56,    56,
-      51,    51,    65,    65,    65,    66,    66,    56,    51,     5,
-      56,    51,    65,    66,    56,    56
+       0,     2,     1,     2,     1,     4,     2,     5,     5,     5,
+       7,     3,     3,     5,     2,     1,     1,     1,     3,     2,
+       0,     1,     1,     1,     1,     0,     2,     0,     2,     3,
+       3,     3,     3,     3,     3,     4,     4,     4,     4,     4,
+       4,     4,     4,     4,     4,     4,     4,     4,     4,     4,
+       4,     4,     4,     4,     4,     4,     4,     4,     4,     4,
+       4,     4,     4,     4,     4,     6,     8,     2,     1,     3,
+       3,     3,     3,     3,     3,     4,     4,     4,     4,     4,
+       4,     4,     4,     4,     4,     4,     4,     4,     4,     4,
+       4,     4,     4,     4,     4,     4,     4,     4,     4,     4,
+       4,     4,     4,     4,     4,     6,     8,     2,     1,     1
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
 
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
+enum { YYENOMEM = -2 };
 
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  */
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
-#define YYFAIL		goto yyerrlab
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
-   If N is 0, then set CURRENT to the empty location which ends
-   the previous symbol: RHS[0] (always defined).  */
-
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
-#ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
-#endif
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
-   This macro was not mandated originally: define only if we know
-   we won't break user code: when these are the locations we know.  */
-
-#ifndef YY_LOCATION_PRINT
-# if YYLTYPE_IS_TRIVIAL
-#  define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-	      (Loc).first_line, (Loc).first_column,	\
-	      (Loc).last_line,  (Loc).last_column)
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
-
-
-/* YYLEX -- calling `yylex' with the right arguments.  */
-
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -1124,80 +1254,58 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
 static void
-yy_symbol_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1205,80 +1313,68 @@ yy_symbol_print (yyoutput, yytype, yyvaluep)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_stack_print (yytype_int16 *bottom, yytype_int16 *top)
-#else
-static void
-yy_stack_print (bottom, top)
-    yytype_int16 *bottom;
-    yytype_int16 *top;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
-  for (; bottom <= top; ++bottom)
-    YYFPRINTF (stderr, " %d", *bottom);
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_reduce_print (YYSTYPE *yyvsp, int yyrule)
-#else
-static void
-yy_reduce_print (yyvsp, yyrule)
-    YYSTYPE *yyvsp;
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
-      fprintf (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       );
-      fprintf (stderr, "\n");
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
+      YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -1293,478 +1389,219 @@ int yydebug;
 # define YYMAXDEPTH 10000
 #endif
 
-
-
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
 
-  if (! yyres)
-    return yystrlen (yystr);
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
 
-/* Copy into YYRESULT an error message about the unexpected token
-   YYCHAR while in state YYSTATE.  Return the number of bytes copied,
-   including the terminating null byte.  If YYRESULT is null, do not
-   copy anything; just return the number of bytes that would be
-   copied.  As a special case, return 0 if an ordinary "syntax error"
-   message will do.  Return YYSIZE_MAXIMUM if overflow occurs during
-   size calculation.  */
-static YYSIZE_T
-yysyntax_error (char *yyresult, int yystate, int yychar)
-{
-  int yyn = yypact[yystate];
 
-  if (! (YYPACT_NINF < yyn && yyn <= YYLAST))
-    return 0;
-  else
-    {
-      int yytype = YYTRANSLATE (yychar);
-      YYSIZE_T yysize0 = yytnamerr (0, yytname[yytype]);
-      YYSIZE_T yysize = yysize0;
-      YYSIZE_T yysize1;
-      int yysize_overflow = 0;
-      enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-      char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-      int yyx;
-
-# if 0
-      /* This is so xgettext sees the translatable formats that are
-	 constructed on the fly.  */
-      YY_("syntax error, unexpected %s");
-      YY_("syntax error, unexpected %s, expecting %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-# endif
-      char *yyfmt;
-      char const *yyf;
-      static char const yyunexpected[] = "syntax error, unexpected %s";
-      static char const yyexpecting[] = ", expecting %s";
-      static char const yyor[] = " or %s";
-      char yyformat[sizeof yyunexpected
-		    + sizeof yyexpecting - 1
-		    + ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-		       * (sizeof yyor - 1))];
-      char const *yyprefix = yyexpecting;
-
-      /* Start YYX at -YYN if negative to avoid negative indexes in
-	 YYCHECK.  */
-      int yyxbegin = yyn < 0 ? -yyn : 0;
-
-      /* Stay within bounds of both yycheck and yytname.  */
-      int yychecklim = YYLAST - yyn + 1;
-      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-      int yycount = 1;
-
-      yyarg[0] = yytname[yytype];
-      yyfmt = yystpcpy (yyformat, yyunexpected);
-
-      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-	if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR)
-	  {
-	    if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-	      {
-		yycount = 1;
-		yysize = yysize0;
-		yyformat[sizeof yyunexpected - 1] = '\0';
-		break;
-	      }
-	    yyarg[yycount++] = yytname[yyx];
-	    yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-	    yysize_overflow |= (yysize1 < yysize);
-	    yysize = yysize1;
-	    yyfmt = yystpcpy (yyfmt, yyprefix);
-	    yyprefix = yyor;
-	  }
-
-      yyf = YY_(yyformat);
-      yysize1 = yysize + yystrlen (yyf);
-      yysize_overflow |= (yysize1 < yysize);
-      yysize = yysize1;
-
-      if (yysize_overflow)
-	return YYSIZE_MAXIMUM;
-
-      if (yyresult)
-	{
-	  /* Avoid sprintf, as that infringes on the user's name space.
-	     Don't have undefined behavior even if the translation
-	     produced a string with the wrong number of "%s"s.  */
-	  char *yyp = yyresult;
-	  int yyi = 0;
-	  while ((*yyp = *yyf) != '\0')
-	    {
-	      if (*yyp == '%' && yyf[1] == 's' && yyi < yycount)
-		{
-		  yyp += yytnamerr (yyp, yyarg[yyi++]);
-		  yyf += 2;
-		}
-	      else
-		{
-		  yyp++;
-		  yyf++;
-		}
-	    }
-	}
-      return yysize;
-    }
-}
-#endif /* YYERROR_VERBOSE */
-
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
-#else
 static void
-yydestruct (yymsg, yytype, yyvaluep)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
 {
-  YYUSE (yyvaluep);
-
+  YY_USE (yyvaluep);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
-
-  switch (yytype)
-    {
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
-
-
-/* Prevent warnings from -Wmissing-prototypes.  */
-
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
 
 
-
-/* The look-ahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
-/* The semantic value of the look-ahead symbol.  */
+/* The semantic value of the lookahead symbol.  */
 YYSTYPE yylval;
-
 /* Number of syntax errors so far.  */
 int yynerrs;
 
 
 
+
 /*----------.
 | yyparse.  |
 `----------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 int
 yyparse (void)
-#else
-int
-yyparse ()
-
-#endif
-#endif
 {
-  
-  int yystate;
-  int yyn;
-  int yyresult;
-  /* Number of tokens to shift before error messages enabled.  */
-  int yyerrstatus;
-  /* Look-ahead token as an internal (translated) token number.  */
-  int yytoken = 0;
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
 
-  /* Three stacks and their tools:
-     `yyss': related to states,
-     `yyvs': related to semantic values,
-     `yyls': related to locations.
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
 
-     Refer to the stacks thru separate pointers, to allow yyoverflow
-     to reallocate them elsewhere.  */
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-  /* The state stack.  */
-  yytype_int16 yyssa[YYINITDEPTH];
-  yytype_int16 *yyss = yyssa;
-  yytype_int16 *yyssp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-  /* The semantic value stack.  */
-  YYSTYPE yyvsa[YYINITDEPTH];
-  YYSTYPE *yyvs = yyvsa;
-  YYSTYPE *yyvsp;
-
-
-
-#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
-
-  YYSIZE_T yystacksize = YYINITDEPTH;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
 
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
   /* The number of symbols on the RHS of the reduced rule.
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
-  yychar = YYEMPTY;		/* Cause a token to be read.  */
-
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-
-  yyssp = yyss;
-  yyvsp = yyvs;
+  yychar = YYEMPTY; /* Cause a token to be read.  */
 
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss);
-	YYSTACK_RELOCATE (yyvs);
-
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
-     look-ahead token if we need one and don't already have one.  */
+     lookahead token if we need one and don't already have one.  */
 
-  /* First try to decide what to do without reference to look-ahead token.  */
+  /* First try to decide what to do without reference to lookahead token.  */
   yyn = yypact[yystate];
-  if (yyn == YYPACT_NINF)
+  if (yypact_value_is_default (yyn))
     goto yydefault;
 
-  /* Not known => get a look-ahead token if don't already have one.  */
+  /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid look-ahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1779,30 +1616,26 @@ yybackup:
   yyn = yytable[yyn];
   if (yyn <= 0)
     {
-      if (yyn == 0 || yyn == YYTABLE_NINF)
-	goto yyerrlab;
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
       yyn = -yyn;
       goto yyreduce;
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
   /* Count tokens shifted since error; after three, turn off error
      status.  */
   if (yyerrstatus)
     yyerrstatus--;
 
-  /* Shift the look-ahead token.  */
+  /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token unless it is eof.  */
-  if (yychar != YYEOF)
-    yychar = YYEMPTY;
-
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1817,14 +1650,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1837,49 +1670,52 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 4:
+  case 4: /* stat: SEP  */
 #line 115 "gram.y"
-    { lfree((yyvsp[(1) - (1)].lexptr)); }
+                        { lfree((yyvsp[0].lexptr)); }
+#line 1677 "gram.c"
     break;
 
-  case 5:
+  case 5: /* stat: IDENT '=' expr SEP  */
 #line 117 "gram.y"
-    {
+                        {
 			  struct sym *sp;
 			  
-			  sp = lookup((yyvsp[(1) - (4)].lexptr)->lx_u.lxu_name);
-			  sp->sy_value = eval((yyvsp[(3) - (4)].exprptr));
+			  sp = lookup((yyvsp[-3].lexptr)->lx_u.lxu_name);
+			  sp->sy_value = eval((yyvsp[-1].exprptr));
 			  sp->sy_flags |= SF_INIT;
-			  lfree((yyvsp[(1) - (4)].lexptr));
-			  efree((yyvsp[(3) - (4)].exprptr));
-			  lfree((yyvsp[(4) - (4)].lexptr));
+			  lfree((yyvsp[-3].lexptr));
+			  efree((yyvsp[-1].exprptr));
+			  lfree((yyvsp[0].lexptr));
                         }
+#line 1692 "gram.c"
     break;
 
-  case 6:
+  case 6: /* stat: error SEP  */
 #line 128 "gram.y"
-    {
+                        {
 			  if (errmess == NULL)
 			    errmess = "syntax error";
 			  fprintf (stderr, "%s:%s:%d: %s\n", 
 				   progname, filename,
-				   ((yyvsp[(2) - (2)].lexptr)->lx_lino), errmess);
+				   ((yyvsp[0].lexptr)->lx_lino), errmess);
 			  errmess = NULL;
-			  lfree((yyvsp[(2) - (2)].lexptr));
+			  lfree((yyvsp[0].lexptr));
 			  yyerrok;
 			  yyclearin;
                         }
+#line 1708 "gram.c"
     break;
 
-  case 7:
+  case 7: /* stat: IDENT '\'' '=' expr SEP  */
 #line 140 "gram.y"
-    {
+                        {
 			  struct sym *sp;
 			  struct prt *pp, *qp;
 			  
-			  sp = lookup((yyvsp[(1) - (5)].lexptr)->lx_u.lxu_name);
+			  sp = lookup((yyvsp[-4].lexptr)->lx_u.lxu_name);
 			  efree(sp->sy_expr);
-			  sp->sy_expr = (yyvsp[(4) - (5)].exprptr);
+			  sp->sy_expr = (yyvsp[-1].exprptr);
 			  sp->sy_flags |= SF_ISEQN;
 			  if (!sawprint) 
 			    {
@@ -1898,50 +1734,53 @@ yyreduce:
                                 }
 			    }
 			found:
-			  lfree((yyvsp[(1) - (5)].lexptr));
-			  lfree((yyvsp[(5) - (5)].lexptr));
+			  lfree((yyvsp[-4].lexptr));
+			  lfree((yyvsp[0].lexptr));
                         }
+#line 1741 "gram.c"
     break;
 
-  case 8:
+  case 8: /* stat: PRINT prtlist optevery optfrom SEP  */
 #line 169 "gram.y"
-    {
+                        {
 			  sawprint = true;
 			  prerr = erritem;
 			  erritem = false;
-			  lfree((yyvsp[(5) - (5)].lexptr));
+			  lfree((yyvsp[0].lexptr));
                         }
+#line 1752 "gram.c"
     break;
 
-  case 9:
+  case 9: /* stat: STEP cexpr ',' cexpr SEP  */
 #line 176 "gram.y"
-    {
-			  lfree((yyvsp[(5) - (5)].lexptr));
-			  tstart = (yyvsp[(2) - (5)].lexptr)->lx_u.lxu_value;
-			  lfree((yyvsp[(2) - (5)].lexptr));
-			  tstop = (yyvsp[(4) - (5)].lexptr)->lx_u.lxu_value;
-			  lfree((yyvsp[(4) - (5)].lexptr));
+                        {
+			  lfree((yyvsp[0].lexptr));
+			  tstart = (yyvsp[-3].lexptr)->lx_u.lxu_value;
+			  lfree((yyvsp[-3].lexptr));
+			  tstop = (yyvsp[-1].lexptr)->lx_u.lxu_value;
+			  lfree((yyvsp[-1].lexptr));
 			  if (!conflag)
 			    startstep();
 			  solve();
 			  sawstep = true;
                         }
+#line 1768 "gram.c"
     break;
 
-  case 10:
+  case 10: /* stat: STEP cexpr ',' cexpr ',' cexpr SEP  */
 #line 188 "gram.y"
-    {
+                        {
 			  double savstep;
 			  bool savconflag;
 			  
-			  lfree((yyvsp[(7) - (7)].lexptr));
-			  tstart = (yyvsp[(2) - (7)].lexptr)->lx_u.lxu_value;
-			  lfree((yyvsp[(2) - (7)].lexptr));
-			  tstop = (yyvsp[(4) - (7)].lexptr)->lx_u.lxu_value;
-			  lfree((yyvsp[(4) - (7)].lexptr));
+			  lfree((yyvsp[0].lexptr));
+			  tstart = (yyvsp[-5].lexptr)->lx_u.lxu_value;
+			  lfree((yyvsp[-5].lexptr));
+			  tstop = (yyvsp[-3].lexptr)->lx_u.lxu_value;
+			  lfree((yyvsp[-3].lexptr));
 			  savstep = tstep;
-			  tstep = (yyvsp[(6) - (7)].lexptr)->lx_u.lxu_value;
-			  lfree((yyvsp[(6) - (7)].lexptr));
+			  tstep = (yyvsp[-1].lexptr)->lx_u.lxu_value;
+			  lfree((yyvsp[-1].lexptr));
 			  savconflag = conflag;
 			  conflag = true;
 			  solve();
@@ -1949,16 +1788,17 @@ yyreduce:
 			  conflag = savconflag;
 			  sawstep = true;
                         }
+#line 1792 "gram.c"
     break;
 
-  case 11:
+  case 11: /* stat: EXAM IDENT SEP  */
 #line 208 "gram.y"
-    {
+                        {
 			  struct sym *sp;
 			  
-			  lfree((yyvsp[(3) - (3)].lexptr));
-			  sp = lookup((yyvsp[(2) - (3)].lexptr)->lx_u.lxu_name);
-			  lfree((yyvsp[(2) - (3)].lexptr));
+			  lfree((yyvsp[0].lexptr));
+			  sp = lookup((yyvsp[-1].lexptr)->lx_u.lxu_name);
+			  lfree((yyvsp[-1].lexptr));
 			  printf ("\"%.*s\" is ",NAMMAX,sp->sy_name);
 			  switch (sp->sy_flags & SF_DEPV)
 			    {
@@ -1990,471 +1830,579 @@ yyreduce:
 			  prexq(sp->sy_expr);
 			  fflush(stdout);
                         }
+#line 1834 "gram.c"
     break;
 
-  case 12:
-#line 248 "gram.y"
-    {
+  case 12: /* stat: evkind expr SEP  */
+#line 246 "gram.y"
+                        {
+			  efree(evexpr[(yyvsp[-2].simple)]);
+			  evexpr[(yyvsp[-2].simple)] = (yyvsp[-1].exprptr);
+			  lfree((yyvsp[0].lexptr));
+                        }
+#line 1844 "gram.c"
+    break;
+
+  case 13: /* stat: evkind expr '=' expr SEP  */
+#line 252 "gram.y"
+                        {
+			  /* when the two sides are equal, i.e. lhs - rhs = 0 */
+			  efree(evexpr[(yyvsp[-4].simple)]);
+			  if (TWOCON((yyvsp[-3].exprptr),(yyvsp[-1].exprptr)))
+			    COMBINE((yyvsp[-3].exprptr),(yyvsp[-1].exprptr),evexpr[(yyvsp[-4].simple)],-=)
+			  else
+			    BINARY((yyvsp[-3].exprptr),(yyvsp[-1].exprptr),evexpr[(yyvsp[-4].simple)],O_MINUS);
+			  lfree((yyvsp[0].lexptr));
+                        }
+#line 1858 "gram.c"
+    break;
+
+  case 14: /* stat: evkind SEP  */
+#line 262 "gram.y"
+                        {
+			  efree(evexpr[(yyvsp[-1].simple)]);
+			  evexpr[(yyvsp[-1].simple)] = NULL;
+			  lfree((yyvsp[0].lexptr));
+                        }
+#line 1868 "gram.c"
+    break;
+
+  case 15: /* evkind: UNTIL  */
+#line 270 "gram.y"
+                        { (yyval.simple) = EV_UNTIL; }
+#line 1874 "gram.c"
+    break;
+
+  case 16: /* evkind: EVENT  */
+#line 272 "gram.y"
+                        { (yyval.simple) = EV_EVENT; }
+#line 1880 "gram.c"
+    break;
+
+  case 17: /* prtlist: prtitem  */
+#line 276 "gram.y"
+                        {
 			  pfree(pqueue);
-			  pqueue = (yyvsp[(1) - (1)].prtptr);
+			  pqueue = (yyvsp[0].prtptr);
                         }
+#line 1889 "gram.c"
     break;
 
-  case 13:
-#line 253 "gram.y"
-    {
+  case 18: /* prtlist: prtlist ',' prtitem  */
+#line 281 "gram.y"
+                        {
 			  struct prt *pp;
 			  
 			  for (pp=pqueue; pp->pr_link!=NULL; pp=pp->pr_link)
 			    ;
-			  pp->pr_link = (yyvsp[(3) - (3)].prtptr);
+			  pp->pr_link = (yyvsp[0].prtptr);
                         }
+#line 1901 "gram.c"
     break;
 
-  case 14:
-#line 263 "gram.y"
-    {
+  case 19: /* prtitem: IDENT prttag  */
+#line 291 "gram.y"
+                        {
 			  struct prt *pp;
 			  
 			  pp = palloc();
-			  pp->pr_sym = lookup((yyvsp[(1) - (2)].lexptr)->lx_u.lxu_name);
-			  pp->pr_which = (ent_cell)((yyvsp[(2) - (2)].simple));
-			  lfree((yyvsp[(1) - (2)].lexptr));
+			  pp->pr_sym = lookup((yyvsp[-1].lexptr)->lx_u.lxu_name);
+			  pp->pr_which = (ent_cell)((yyvsp[0].simple));
+			  lfree((yyvsp[-1].lexptr));
 			  (yyval.prtptr) = pp;
                         }
+#line 1915 "gram.c"
     break;
 
-  case 15:
-#line 275 "gram.y"
-    { (yyval.simple) = P_VALUE; }
+  case 20: /* prttag: %empty  */
+#line 303 "gram.y"
+                        { (yyval.simple) = P_VALUE; }
+#line 1921 "gram.c"
     break;
 
-  case 16:
-#line 277 "gram.y"
-    { (yyval.simple) = P_PRIME; }
+  case 21: /* prttag: '\''  */
+#line 305 "gram.y"
+                        { (yyval.simple) = P_PRIME; }
+#line 1927 "gram.c"
     break;
 
-  case 17:
-#line 279 "gram.y"
-    {
+  case 22: /* prttag: '~'  */
+#line 307 "gram.y"
+                        {
 			  (yyval.simple) = P_ACERR;
 			  erritem = true;
                         }
+#line 1936 "gram.c"
     break;
 
-  case 18:
-#line 284 "gram.y"
-    {
+  case 23: /* prttag: '!'  */
+#line 312 "gram.y"
+                        {
 			  (yyval.simple) = P_ABERR;
 			  erritem = true;
                         }
+#line 1945 "gram.c"
     break;
 
-  case 19:
-#line 289 "gram.y"
-    {
+  case 24: /* prttag: '?'  */
+#line 317 "gram.y"
+                        {
 			  (yyval.simple) = P_SSERR;
 			  erritem = true;
                         }
+#line 1954 "gram.c"
     break;
 
-  case 20:
-#line 296 "gram.y"
-    { sawevery = false; }
-    break;
-
-  case 21:
-#line 298 "gram.y"
-    {
-                        sawevery = true;
-                        tevery = IROUND((yyvsp[(2) - (2)].lexptr)->lx_u.lxu_value);
-                        lfree((yyvsp[(2) - (2)].lexptr));
-                        }
-    break;
-
-  case 22:
-#line 306 "gram.y"
-    { sawfrom = false; }
-    break;
-
-  case 23:
-#line 308 "gram.y"
-    {
-			  sawfrom = true;
-			  tfrom = (yyvsp[(2) - (2)].lexptr)->lx_u.lxu_value;
-			  lfree((yyvsp[(2) - (2)].lexptr));
-                        }
-    break;
-
-  case 24:
-#line 316 "gram.y"
-    {
-			  (yyval.lexptr) = (yyvsp[(2) - (3)].lexptr);
-                        }
-    break;
-
-  case 25:
-#line 320 "gram.y"
-    {
-			  CEXOP((yyvsp[(1) - (3)].lexptr),(yyvsp[(3) - (3)].lexptr),(yyval.lexptr),+=)
-                        }
-    break;
-
-  case 26:
+  case 25: /* optevery: %empty  */
 #line 324 "gram.y"
-    {
-			  CEXOP((yyvsp[(1) - (3)].lexptr),(yyvsp[(3) - (3)].lexptr),(yyval.lexptr),-=)
-                        }
+                        { sawevery = false; }
+#line 1960 "gram.c"
     break;
 
-  case 27:
-#line 328 "gram.y"
-    {
-			  CEXOP((yyvsp[(1) - (3)].lexptr),(yyvsp[(3) - (3)].lexptr),(yyval.lexptr),*=)
+  case 26: /* optevery: EVERY cexpr  */
+#line 326 "gram.y"
+                        {
+                        sawevery = true;
+                        tevery = IROUND((yyvsp[0].lexptr)->lx_u.lxu_value);
+                        lfree((yyvsp[0].lexptr));
                         }
+#line 1970 "gram.c"
     break;
 
-  case 28:
-#line 332 "gram.y"
-    {
-			  CEXOP((yyvsp[(1) - (3)].lexptr),(yyvsp[(3) - (3)].lexptr),(yyval.lexptr),/=)
-                        }
+  case 27: /* optfrom: %empty  */
+#line 334 "gram.y"
+                        { sawfrom = false; }
+#line 1976 "gram.c"
     break;
 
-  case 29:
+  case 28: /* optfrom: FROM cexpr  */
 #line 336 "gram.y"
-    {
-			  (yyvsp[(1) - (3)].lexptr)->lx_u.lxu_value =
-			    pow((yyvsp[(1) - (3)].lexptr)->lx_u.lxu_value,(yyvsp[(3) - (3)].lexptr)->lx_u.lxu_value);
-			  lfree((yyvsp[(3) - (3)].lexptr));
-			  (yyval.lexptr) = (yyvsp[(1) - (3)].lexptr);
-                        }
-    break;
-
-  case 30:
-#line 343 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),sqrt)
+                        {
+			  sawfrom = true;
+			  tfrom = (yyvsp[0].lexptr)->lx_u.lxu_value;
+			  lfree((yyvsp[0].lexptr));
                         }
+#line 1986 "gram.c"
     break;
 
-  case 31:
-#line 347 "gram.y"
-    {
-			  if ((yyvsp[(3) - (4)].lexptr)->lx_u.lxu_value < 0)
-			    (yyvsp[(3) - (4)].lexptr)->lx_u.lxu_value = -((yyvsp[(3) - (4)].lexptr)->lx_u.lxu_value);
-			  (yyval.lexptr) = (yyvsp[(3) - (4)].lexptr);
+  case 29: /* cexpr: '(' cexpr ')'  */
+#line 344 "gram.y"
+                        {
+			  (yyval.lexptr) = (yyvsp[-1].lexptr);
                         }
+#line 1994 "gram.c"
     break;
 
-  case 32:
-#line 353 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),exp)
+  case 30: /* cexpr: cexpr '+' cexpr  */
+#line 348 "gram.y"
+                        {
+			  CEXOP((yyvsp[-2].lexptr),(yyvsp[0].lexptr),(yyval.lexptr),+=)
                         }
+#line 2002 "gram.c"
     break;
 
-  case 33:
-#line 357 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),log)
+  case 31: /* cexpr: cexpr '-' cexpr  */
+#line 352 "gram.y"
+                        {
+			  CEXOP((yyvsp[-2].lexptr),(yyvsp[0].lexptr),(yyval.lexptr),-=)
                         }
+#line 2010 "gram.c"
     break;
 
-  case 34:
-#line 361 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),log10)
+  case 32: /* cexpr: cexpr '*' cexpr  */
+#line 356 "gram.y"
+                        {
+			  CEXOP((yyvsp[-2].lexptr),(yyvsp[0].lexptr),(yyval.lexptr),*=)
                         }
+#line 2018 "gram.c"
     break;
 
-  case 35:
-#line 365 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),sin)
+  case 33: /* cexpr: cexpr '/' cexpr  */
+#line 360 "gram.y"
+                        {
+			  CEXOP((yyvsp[-2].lexptr),(yyvsp[0].lexptr),(yyval.lexptr),/=)
                         }
+#line 2026 "gram.c"
     break;
 
-  case 36:
-#line 369 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),cos)
+  case 34: /* cexpr: cexpr '^' cexpr  */
+#line 364 "gram.y"
+                        {
+			  (yyvsp[-2].lexptr)->lx_u.lxu_value =
+			    pow((yyvsp[-2].lexptr)->lx_u.lxu_value,(yyvsp[0].lexptr)->lx_u.lxu_value);
+			  lfree((yyvsp[0].lexptr));
+			  (yyval.lexptr) = (yyvsp[-2].lexptr);
                         }
+#line 2037 "gram.c"
     break;
 
-  case 37:
-#line 373 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),tan)
+  case 35: /* cexpr: SQRT '(' cexpr ')'  */
+#line 371 "gram.y"
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),sqrt)
                         }
+#line 2045 "gram.c"
     break;
 
-  case 38:
-#line 377 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),asinh)
+  case 36: /* cexpr: ABS '(' cexpr ')'  */
+#line 375 "gram.y"
+                        {
+			  if ((yyvsp[-1].lexptr)->lx_u.lxu_value < 0)
+			    (yyvsp[-1].lexptr)->lx_u.lxu_value = -((yyvsp[-1].lexptr)->lx_u.lxu_value);
+			  (yyval.lexptr) = (yyvsp[-1].lexptr);
                         }
+#line 2055 "gram.c"
     break;
 
-  case 39:
+  case 37: /* cexpr: EXP '(' cexpr ')'  */
 #line 381 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),acosh)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),exp)
                         }
+#line 2063 "gram.c"
     break;
 
-  case 40:
+  case 38: /* cexpr: LOG '(' cexpr ')'  */
 #line 385 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),atanh)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),log)
                         }
+#line 2071 "gram.c"
     break;
 
-  case 41:
+  case 39: /* cexpr: LOG10 '(' cexpr ')'  */
 #line 389 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),asin)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),log10)
                         }
+#line 2079 "gram.c"
     break;
 
-  case 42:
+  case 40: /* cexpr: SIN '(' cexpr ')'  */
 #line 393 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),acos)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),sin)
                         }
+#line 2087 "gram.c"
     break;
 
-  case 43:
+  case 41: /* cexpr: COS '(' cexpr ')'  */
 #line 397 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),atan)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),cos)
                         }
+#line 2095 "gram.c"
     break;
 
-  case 44:
+  case 42: /* cexpr: TAN '(' cexpr ')'  */
 #line 401 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),sinh)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),tan)
                         }
+#line 2103 "gram.c"
     break;
 
-  case 45:
+  case 43: /* cexpr: ASINH '(' cexpr ')'  */
 #line 405 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),cosh)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),asinh)
                         }
+#line 2111 "gram.c"
     break;
 
-  case 46:
+  case 44: /* cexpr: ACOSH '(' cexpr ')'  */
 #line 409 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),tanh)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),acosh)
                         }
+#line 2119 "gram.c"
     break;
 
-  case 47:
+  case 45: /* cexpr: ATANH '(' cexpr ')'  */
 #line 413 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),floor)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),atanh)
                         }
+#line 2127 "gram.c"
     break;
 
-  case 48:
+  case 46: /* cexpr: ASIN '(' cexpr ')'  */
 #line 417 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),ceil)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),asin)
                         }
+#line 2135 "gram.c"
     break;
 
-  case 49:
+  case 47: /* cexpr: ACOS '(' cexpr ')'  */
 #line 421 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),j0)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),acos)
                         }
+#line 2143 "gram.c"
     break;
 
-  case 50:
+  case 48: /* cexpr: ATAN '(' cexpr ')'  */
 #line 425 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),j1)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),atan)
                         }
+#line 2151 "gram.c"
     break;
 
-  case 51:
+  case 49: /* cexpr: SINH '(' cexpr ')'  */
 #line 429 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),y0)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),sinh)
                         }
+#line 2159 "gram.c"
     break;
 
-  case 52:
+  case 50: /* cexpr: COSH '(' cexpr ')'  */
 #line 433 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),y1)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),cosh)
                         }
+#line 2167 "gram.c"
     break;
 
-  case 53:
+  case 51: /* cexpr: TANH '(' cexpr ')'  */
 #line 437 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),erfc)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),tanh)
                         }
+#line 2175 "gram.c"
     break;
 
-  case 54:
+  case 52: /* cexpr: FLOOR '(' cexpr ')'  */
 #line 441 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),erf)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),floor)
                         }
+#line 2183 "gram.c"
     break;
 
-  case 55:
+  case 53: /* cexpr: CEIL '(' cexpr ')'  */
 #line 445 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),inverf)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),ceil)
                         }
+#line 2191 "gram.c"
     break;
 
-  case 56:
+  case 54: /* cexpr: J0 '(' cexpr ')'  */
 #line 449 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),F_LGAMMA)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),j0)
                         }
+#line 2199 "gram.c"
     break;
 
-  case 57:
+  case 55: /* cexpr: J1 '(' cexpr ')'  */
 #line 453 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),f_gamma)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),j1)
                         }
+#line 2207 "gram.c"
     break;
 
-  case 58:
+  case 56: /* cexpr: Y0 '(' cexpr ')'  */
 #line 457 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),norm)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),y0)
                         }
+#line 2215 "gram.c"
     break;
 
-  case 59:
+  case 57: /* cexpr: Y1 '(' cexpr ')'  */
 #line 461 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(3) - (4)].lexptr),(yyval.lexptr),invnorm)
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),y1)
                         }
+#line 2223 "gram.c"
     break;
 
-  case 60:
+  case 58: /* cexpr: ERFC '(' cexpr ')'  */
 #line 465 "gram.y"
-    {
-			  (yyvsp[(3) - (6)].lexptr)->lx_u.lxu_value =
-			    igamma((yyvsp[(3) - (6)].lexptr)->lx_u.lxu_value,(yyvsp[(5) - (6)].lexptr)->lx_u.lxu_value);
-			  lfree((yyvsp[(5) - (6)].lexptr));
-			  (yyval.lexptr) = (yyvsp[(3) - (6)].lexptr);
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),erfc)
                         }
+#line 2231 "gram.c"
     break;
 
-  case 61:
-#line 472 "gram.y"
-    {
-			  (yyvsp[(3) - (8)].lexptr)->lx_u.lxu_value =
-			    ibeta((yyvsp[(3) - (8)].lexptr)->lx_u.lxu_value,(yyvsp[(5) - (8)].lexptr)->lx_u.lxu_value,(yyvsp[(7) - (8)].lexptr)->lx_u.lxu_value);
-			  lfree((yyvsp[(5) - (8)].lexptr));
-			  lfree((yyvsp[(7) - (8)].lexptr));
-			  (yyval.lexptr) = (yyvsp[(3) - (8)].lexptr);
+  case 59: /* cexpr: ERF '(' cexpr ')'  */
+#line 469 "gram.y"
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),erf)
                         }
+#line 2239 "gram.c"
     break;
 
-  case 62:
-#line 480 "gram.y"
-    {
-			  CEXFUNC((yyvsp[(2) - (2)].lexptr),(yyval.lexptr),-)
+  case 60: /* cexpr: INVERF '(' cexpr ')'  */
+#line 473 "gram.y"
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),inverf)
+                        }
+#line 2247 "gram.c"
+    break;
+
+  case 61: /* cexpr: LGAMMA '(' cexpr ')'  */
+#line 477 "gram.y"
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),F_LGAMMA)
+                        }
+#line 2255 "gram.c"
+    break;
+
+  case 62: /* cexpr: GAMMA '(' cexpr ')'  */
+#line 481 "gram.y"
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),f_gamma)
                         }
+#line 2263 "gram.c"
     break;
 
-  case 63:
-#line 484 "gram.y"
-    { (yyval.lexptr) = (yyvsp[(1) - (1)].lexptr); }
+  case 63: /* cexpr: NORM '(' cexpr ')'  */
+#line 485 "gram.y"
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),norm)
+                        }
+#line 2271 "gram.c"
     break;
 
-  case 64:
-#line 488 "gram.y"
-    { (yyval.exprptr) = (yyvsp[(2) - (3)].exprptr); }
+  case 64: /* cexpr: INVNORM '(' cexpr ')'  */
+#line 489 "gram.y"
+                        {
+			  CEXFUNC((yyvsp[-1].lexptr),(yyval.lexptr),invnorm)
+                        }
+#line 2279 "gram.c"
     break;
 
-  case 65:
-#line 490 "gram.y"
-    {
-			  if (TWOCON((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr)))
-			    COMBINE((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr),(yyval.exprptr),+=)
+  case 65: /* cexpr: IGAMMA '(' cexpr ',' cexpr ')'  */
+#line 493 "gram.y"
+                        {
+			  (yyvsp[-3].lexptr)->lx_u.lxu_value =
+			    igamma((yyvsp[-3].lexptr)->lx_u.lxu_value,(yyvsp[-1].lexptr)->lx_u.lxu_value);
+			  lfree((yyvsp[-1].lexptr));
+			  (yyval.lexptr) = (yyvsp[-3].lexptr);
+                        }
+#line 2290 "gram.c"
+    break;
+
+  case 66: /* cexpr: IBETA '(' cexpr ',' cexpr ',' cexpr ')'  */
+#line 500 "gram.y"
+                        {
+			  (yyvsp[-5].lexptr)->lx_u.lxu_value =
+			    ibeta((yyvsp[-5].lexptr)->lx_u.lxu_value,(yyvsp[-3].lexptr)->lx_u.lxu_value,(yyvsp[-1].lexptr)->lx_u.lxu_value);
+			  lfree((yyvsp[-3].lexptr));
+			  lfree((yyvsp[-1].lexptr));
+			  (yyval.lexptr) = (yyvsp[-5].lexptr);
+                        }
+#line 2302 "gram.c"
+    break;
+
+  case 67: /* cexpr: '-' cexpr  */
+#line 508 "gram.y"
+                        {
+			  CEXFUNC((yyvsp[0].lexptr),(yyval.lexptr),-)
+                        }
+#line 2310 "gram.c"
+    break;
+
+  case 68: /* cexpr: NUMBER  */
+#line 512 "gram.y"
+                        { (yyval.lexptr) = (yyvsp[0].lexptr); }
+#line 2316 "gram.c"
+    break;
+
+  case 69: /* expr: '(' expr ')'  */
+#line 516 "gram.y"
+                        { (yyval.exprptr) = (yyvsp[-1].exprptr); }
+#line 2322 "gram.c"
+    break;
+
+  case 70: /* expr: expr '+' expr  */
+#line 518 "gram.y"
+                        {
+			  if (TWOCON((yyvsp[-2].exprptr),(yyvsp[0].exprptr)))
+			    COMBINE((yyvsp[-2].exprptr),(yyvsp[0].exprptr),(yyval.exprptr),+=)
 			  else
-			    BINARY((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr),(yyval.exprptr),O_PLUS);
+			    BINARY((yyvsp[-2].exprptr),(yyvsp[0].exprptr),(yyval.exprptr),O_PLUS);
                         }
+#line 2333 "gram.c"
     break;
 
-  case 66:
-#line 497 "gram.y"
-    {
-			  if (TWOCON((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr)))
-			    COMBINE((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr),(yyval.exprptr),-=)
+  case 71: /* expr: expr '-' expr  */
+#line 525 "gram.y"
+                        {
+			  if (TWOCON((yyvsp[-2].exprptr),(yyvsp[0].exprptr)))
+			    COMBINE((yyvsp[-2].exprptr),(yyvsp[0].exprptr),(yyval.exprptr),-=)
 			  else
-			    BINARY((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr),(yyval.exprptr),O_MINUS);
+			    BINARY((yyvsp[-2].exprptr),(yyvsp[0].exprptr),(yyval.exprptr),O_MINUS);
                         }
+#line 2344 "gram.c"
     break;
 
-  case 67:
-#line 504 "gram.y"
-    {
-			  if (TWOCON((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr)))
-			    COMBINE((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr),(yyval.exprptr),*=)
+  case 72: /* expr: expr '*' expr  */
+#line 532 "gram.y"
+                        {
+			  if (TWOCON((yyvsp[-2].exprptr),(yyvsp[0].exprptr)))
+			    COMBINE((yyvsp[-2].exprptr),(yyvsp[0].exprptr),(yyval.exprptr),*=)
 			  else
-			    BINARY((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr),(yyval.exprptr),O_MULT);
+			    BINARY((yyvsp[-2].exprptr),(yyvsp[0].exprptr),(yyval.exprptr),O_MULT);
                         }
+#line 2355 "gram.c"
     break;
 
-  case 68:
-#line 511 "gram.y"
-    {
-			  if (TWOCON((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr)))
-			    COMBINE((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr),(yyval.exprptr),/=)
-			  else if (ONECON((yyvsp[(3) - (3)].exprptr)) && (yyvsp[(3) - (3)].exprptr)->ex_value!=0.) 
+  case 73: /* expr: expr '/' expr  */
+#line 539 "gram.y"
+                        {
+			  if (TWOCON((yyvsp[-2].exprptr),(yyvsp[0].exprptr)))
+			    COMBINE((yyvsp[-2].exprptr),(yyvsp[0].exprptr),(yyval.exprptr),/=)
+			  else if (ONECON((yyvsp[0].exprptr)) && (yyvsp[0].exprptr)->ex_value!=0.) 
 			    {
 			      /* division by constant */
-			      (yyvsp[(3) - (3)].exprptr)->ex_value = 1./(yyvsp[(3) - (3)].exprptr)->ex_value;
-			      BINARY((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr),(yyval.exprptr),O_MULT);
+			      (yyvsp[0].exprptr)->ex_value = 1./(yyvsp[0].exprptr)->ex_value;
+			      BINARY((yyvsp[-2].exprptr),(yyvsp[0].exprptr),(yyval.exprptr),O_MULT);
 			    } 
 			  else
-			    BINARY((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr),(yyval.exprptr),O_DIV);
+			    BINARY((yyvsp[-2].exprptr),(yyvsp[0].exprptr),(yyval.exprptr),O_DIV);
                         }
+#line 2372 "gram.c"
     break;
 
-  case 69:
-#line 524 "gram.y"
-    {
+  case 74: /* expr: expr '^' expr  */
+#line 552 "gram.y"
+                        {
 			  double f;
 			  bool invert = false;
 			  
-			  if (TWOCON((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr))) 
+			  if (TWOCON((yyvsp[-2].exprptr),(yyvsp[0].exprptr))) 
 			    {
-			      /* case const ^ const */
-			      (yyvsp[(1) - (3)].exprptr)->ex_value = pow((yyvsp[(1) - (3)].exprptr)->ex_value,(yyvsp[(3) - (3)].exprptr)->ex_value);
-			      efree((yyvsp[(3) - (3)].exprptr));
+			      /* case const ^ const, as eval() would do it */
+			      if (IS_IPOW((yyvsp[0].exprptr)->ex_value))
+				(yyvsp[-2].exprptr)->ex_value = ipow((yyvsp[-2].exprptr)->ex_value,
+						    (int)(yyvsp[0].exprptr)->ex_value);
+			      else
+				(yyvsp[-2].exprptr)->ex_value = pow((yyvsp[-2].exprptr)->ex_value,(yyvsp[0].exprptr)->ex_value);
+			      efree((yyvsp[0].exprptr));
 			    } 
-			  else if (ONECON((yyvsp[(1) - (3)].exprptr))) 
+			  else if (ONECON((yyvsp[-2].exprptr))) 
 			    {
-			      if ((yyvsp[(1) - (3)].exprptr)->ex_value == 1.)
+			      if ((yyvsp[-2].exprptr)->ex_value == 1.)
 				{
 				  /* case 1 ^ x */
-				  efree((yyvsp[(3) - (3)].exprptr));
-				  (yyval.exprptr) = (yyvsp[(1) - (3)].exprptr);
+				  efree((yyvsp[0].exprptr));
+				  (yyval.exprptr) = (yyvsp[-2].exprptr);
                                 }
 			      else
 				goto other;
 			    }
-			  else if (!ONECON((yyvsp[(3) - (3)].exprptr)))
+			  else if (!ONECON((yyvsp[0].exprptr)))
 			    goto other;
 			  else 
 			    {
-			      f = (yyvsp[(3) - (3)].exprptr)->ex_value;
+			      f = (yyvsp[0].exprptr)->ex_value;
 			      if (f < 0.) 
 				{
 				  /*
@@ -2467,517 +2415,528 @@ yyreduce:
 			      if (f == 2.) 
 				{
 				  /* case x ^ 2 */
-				  (yyvsp[(3) - (3)].exprptr)->ex_oper = O_SQAR;
-				  concat((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr));
-				  (yyval.exprptr) = (yyvsp[(1) - (3)].exprptr);
+				  (yyvsp[0].exprptr)->ex_oper = O_SQAR;
+				  concat((yyvsp[-2].exprptr),(yyvsp[0].exprptr));
+				  (yyval.exprptr) = (yyvsp[-2].exprptr);
                                 }
 			      else if (f == 3.) 
 				{
 				  /* case x ^ 3 */
-				  (yyvsp[(3) - (3)].exprptr)->ex_oper = O_CUBE;
-				  concat((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr));
-				  (yyval.exprptr) = (yyvsp[(1) - (3)].exprptr);
+				  (yyvsp[0].exprptr)->ex_oper = O_CUBE;
+				  concat((yyvsp[-2].exprptr),(yyvsp[0].exprptr));
+				  (yyval.exprptr) = (yyvsp[-2].exprptr);
                                 }
 			      else if (f == 0.5) 
 				{
 				  /* case x ^ .5 */
-				  (yyvsp[(3) - (3)].exprptr)->ex_oper = O_SQRT;
-				  concat((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr));
-				  (yyval.exprptr) = (yyvsp[(1) - (3)].exprptr);
+				  (yyvsp[0].exprptr)->ex_oper = O_SQRT;
+				  concat((yyvsp[-2].exprptr),(yyvsp[0].exprptr));
+				  (yyval.exprptr) = (yyvsp[-2].exprptr);
                                 }
 			      else if (f == 1.5) 
 				{
 				  /* case x ^ 1.5 */
-				  (yyvsp[(3) - (3)].exprptr)->ex_oper = O_CUBE;
-				  BINARY((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr),(yyval.exprptr),O_SQRT);
+				  (yyvsp[0].exprptr)->ex_oper = O_CUBE;
+				  BINARY((yyvsp[-2].exprptr),(yyvsp[0].exprptr),(yyval.exprptr),O_SQRT);
                                 }
 			      else if (f == 1.) 
 				{
 				  /* case x ^ 1 */
-				  efree((yyvsp[(3) - (3)].exprptr));
-				  (yyval.exprptr) = (yyvsp[(1) - (3)].exprptr);
+				  efree((yyvsp[0].exprptr));
+				  (yyval.exprptr) = (yyvsp[-2].exprptr);
                                 }
 			      else if (f == 0.) 
 				{
 				  /* case x ^ 0 */
-				  efree((yyvsp[(1) - (3)].exprptr));
-				  (yyvsp[(3) - (3)].exprptr)->ex_value = 1.;
-				  (yyval.exprptr) = (yyvsp[(3) - (3)].exprptr);
+				  efree((yyvsp[-2].exprptr));
+				  (yyvsp[0].exprptr)->ex_value = 1.;
+				  (yyval.exprptr) = (yyvsp[0].exprptr);
                                 } 
 			      else 
 				{
 				other:
 				  /* default */
 				  invert = false;
-				  BINARY((yyvsp[(1) - (3)].exprptr),(yyvsp[(3) - (3)].exprptr),(yyval.exprptr),O_POWER);
+				  BINARY((yyvsp[-2].exprptr),(yyvsp[0].exprptr),(yyval.exprptr),O_POWER);
                                 }
 			      if (invert)
 				UNARY((yyval.exprptr),(yyval.exprptr),O_INV)
 			    }
                         }
+#line 2467 "gram.c"
     break;
 
-  case 70:
-#line 611 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),sqrt)
+  case 75: /* expr: SQRT '(' expr ')'  */
+#line 643 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),sqrt)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_SQRT);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_SQRT);
                         }
+#line 2478 "gram.c"
     break;
 
-  case 71:
-#line 618 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr))) 
+  case 76: /* expr: ABS '(' expr ')'  */
+#line 650 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr))) 
 			    {
-			      if ((yyvsp[(3) - (4)].exprptr)->ex_value < 0)
-				(yyvsp[(3) - (4)].exprptr)->ex_value = -((yyvsp[(3) - (4)].exprptr)->ex_value);
-			      (yyval.exprptr) = (yyvsp[(3) - (4)].exprptr);
+			      if ((yyvsp[-1].exprptr)->ex_value < 0)
+				(yyvsp[-1].exprptr)->ex_value = -((yyvsp[-1].exprptr)->ex_value);
+			      (yyval.exprptr) = (yyvsp[-1].exprptr);
 			  } 
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_ABS);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_ABS);
                         }
+#line 2493 "gram.c"
     break;
 
-  case 72:
-#line 629 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),exp)
+  case 77: /* expr: EXP '(' expr ')'  */
+#line 661 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),exp)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_EXP);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_EXP);
                         }
+#line 2504 "gram.c"
     break;
 
-  case 73:
-#line 636 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),log)
+  case 78: /* expr: LOG '(' expr ')'  */
+#line 668 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),log)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_LOG);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_LOG);
                         }
+#line 2515 "gram.c"
     break;
 
-  case 74:
-#line 643 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),log10)
+  case 79: /* expr: LOG10 '(' expr ')'  */
+#line 675 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),log10)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_LOG10);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_LOG10);
                         }
+#line 2526 "gram.c"
     break;
 
-  case 75:
-#line 650 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),sin)
+  case 80: /* expr: SIN '(' expr ')'  */
+#line 682 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),sin)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_SIN);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_SIN);
                         }
+#line 2537 "gram.c"
     break;
 
-  case 76:
-#line 657 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),cos)
+  case 81: /* expr: COS '(' expr ')'  */
+#line 689 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),cos)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_COS);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_COS);
                         }
+#line 2548 "gram.c"
     break;
 
-  case 77:
-#line 664 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),tan)
+  case 82: /* expr: TAN '(' expr ')'  */
+#line 696 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),tan)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_TAN);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_TAN);
                         }
+#line 2559 "gram.c"
     break;
 
-  case 78:
-#line 671 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),asinh)
+  case 83: /* expr: ASINH '(' expr ')'  */
+#line 703 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),asinh)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_ASINH);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_ASINH);
                         }
+#line 2570 "gram.c"
     break;
 
-  case 79:
-#line 678 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),acosh)
+  case 84: /* expr: ACOSH '(' expr ')'  */
+#line 710 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),acosh)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_ACOSH);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_ACOSH);
                         }
+#line 2581 "gram.c"
     break;
 
-  case 80:
-#line 685 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),atanh)
+  case 85: /* expr: ATANH '(' expr ')'  */
+#line 717 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),atanh)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_ATANH);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_ATANH);
                         }
+#line 2592 "gram.c"
     break;
 
-  case 81:
-#line 692 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),asin)
+  case 86: /* expr: ASIN '(' expr ')'  */
+#line 724 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),asin)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_ASIN);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_ASIN);
                         }
+#line 2603 "gram.c"
     break;
 
-  case 82:
-#line 699 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),acos)
+  case 87: /* expr: ACOS '(' expr ')'  */
+#line 731 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),acos)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_ACOS);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_ACOS);
                         }
+#line 2614 "gram.c"
     break;
 
-  case 83:
-#line 706 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),atan)
+  case 88: /* expr: ATAN '(' expr ')'  */
+#line 738 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),atan)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_ATAN);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_ATAN);
                         }
+#line 2625 "gram.c"
     break;
 
-  case 84:
-#line 713 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),sinh)
+  case 89: /* expr: SINH '(' expr ')'  */
+#line 745 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),sinh)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_SINH);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_SINH);
                         }
+#line 2636 "gram.c"
     break;
 
-  case 85:
-#line 720 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),cosh)
+  case 90: /* expr: COSH '(' expr ')'  */
+#line 752 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),cosh)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_COSH);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_COSH);
                         }
+#line 2647 "gram.c"
     break;
 
-  case 86:
-#line 727 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),tanh)
+  case 91: /* expr: TANH '(' expr ')'  */
+#line 759 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),tanh)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_TANH);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_TANH);
                         }
+#line 2658 "gram.c"
     break;
 
-  case 87:
-#line 734 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),floor)
+  case 92: /* expr: FLOOR '(' expr ')'  */
+#line 766 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),floor)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_FLOOR);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_FLOOR);
                         }
+#line 2669 "gram.c"
     break;
 
-  case 88:
-#line 741 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),ceil)
+  case 93: /* expr: CEIL '(' expr ')'  */
+#line 773 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),ceil)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_CEIL);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_CEIL);
                         }
+#line 2680 "gram.c"
     break;
 
-  case 89:
-#line 748 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),j0)
+  case 94: /* expr: J0 '(' expr ')'  */
+#line 780 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),j0)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_J0);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_J0);
                         }
+#line 2691 "gram.c"
     break;
 
-  case 90:
-#line 755 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),j1)
+  case 95: /* expr: J1 '(' expr ')'  */
+#line 787 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),j1)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_J1);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_J1);
                         }
+#line 2702 "gram.c"
     break;
 
-  case 91:
-#line 762 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),y0)
+  case 96: /* expr: Y0 '(' expr ')'  */
+#line 794 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),y0)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_Y0);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_Y0);
                         }
+#line 2713 "gram.c"
     break;
 
-  case 92:
-#line 769 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),y1)
+  case 97: /* expr: Y1 '(' expr ')'  */
+#line 801 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),y1)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_Y1);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_Y1);
                         }
+#line 2724 "gram.c"
     break;
 
-  case 93:
-#line 776 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),F_LGAMMA)
+  case 98: /* expr: LGAMMA '(' expr ')'  */
+#line 808 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),F_LGAMMA)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_LGAMMA);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_LGAMMA);
                         }
+#line 2735 "gram.c"
     break;
 
-  case 94:
-#line 783 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),f_gamma)
+  case 99: /* expr: GAMMA '(' expr ')'  */
+#line 815 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),f_gamma)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_GAMMA);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_GAMMA);
                         }
+#line 2746 "gram.c"
     break;
 
-  case 95:
-#line 790 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),erfc)
+  case 100: /* expr: ERFC '(' expr ')'  */
+#line 822 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),erfc)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_ERFC);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_ERFC);
                         }
+#line 2757 "gram.c"
     break;
 
-  case 96:
-#line 797 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),erf)
+  case 101: /* expr: ERF '(' expr ')'  */
+#line 829 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),erf)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_ERF);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_ERF);
                         }
+#line 2768 "gram.c"
     break;
 
-  case 97:
-#line 804 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),inverf)
+  case 102: /* expr: INVERF '(' expr ')'  */
+#line 836 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),inverf)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_INVERF);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_INVERF);
                         }
+#line 2779 "gram.c"
     break;
 
-  case 98:
-#line 811 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),norm)
+  case 103: /* expr: NORM '(' expr ')'  */
+#line 843 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),norm)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_NORM);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_NORM);
                         }
+#line 2790 "gram.c"
     break;
 
-  case 99:
-#line 818 "gram.y"
-    {
-			  if (ONECON((yyvsp[(3) - (4)].exprptr)))
-			    CONFUNC((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),invnorm)
+  case 104: /* expr: INVNORM '(' expr ')'  */
+#line 850 "gram.y"
+                        {
+			  if (ONECON((yyvsp[-1].exprptr)))
+			    CONFUNC((yyvsp[-1].exprptr),(yyval.exprptr),invnorm)
 			  else
-			    UNARY((yyvsp[(3) - (4)].exprptr),(yyval.exprptr),O_INVNORM);
+			    UNARY((yyvsp[-1].exprptr),(yyval.exprptr),O_INVNORM);
                         }
+#line 2801 "gram.c"
     break;
 
-  case 100:
-#line 825 "gram.y"
-    {
-			  if (TWOCON((yyvsp[(3) - (6)].exprptr),(yyvsp[(5) - (6)].exprptr))) 
+  case 105: /* expr: IGAMMA '(' expr ',' expr ')'  */
+#line 857 "gram.y"
+                        {
+			  if (TWOCON((yyvsp[-3].exprptr),(yyvsp[-1].exprptr))) 
 			    {
-			      (yyvsp[(3) - (6)].exprptr)->ex_value = 
-				igamma((yyvsp[(3) - (6)].exprptr)->ex_value,(yyvsp[(5) - (6)].exprptr)->ex_value);
-			      efree((yyvsp[(5) - (6)].exprptr));
-			      (yyval.exprptr) = (yyvsp[(3) - (6)].exprptr);
+			      (yyvsp[-3].exprptr)->ex_value = 
+				igamma((yyvsp[-3].exprptr)->ex_value,(yyvsp[-1].exprptr)->ex_value);
+			      efree((yyvsp[-1].exprptr));
+			      (yyval.exprptr) = (yyvsp[-3].exprptr);
 			    }
 			  else 
-			    BINARY((yyvsp[(3) - (6)].exprptr),(yyvsp[(5) - (6)].exprptr),(yyval.exprptr),O_IGAMMA);
+			    BINARY((yyvsp[-3].exprptr),(yyvsp[-1].exprptr),(yyval.exprptr),O_IGAMMA);
 		        }
+#line 2817 "gram.c"
     break;
 
-  case 101:
-#line 837 "gram.y"
-    {
-			  if (THREECON((yyvsp[(3) - (8)].exprptr),(yyvsp[(5) - (8)].exprptr),(yyvsp[(7) - (8)].exprptr))) 
+  case 106: /* expr: IBETA '(' expr ',' expr ',' expr ')'  */
+#line 869 "gram.y"
+                        {
+			  if (THREECON((yyvsp[-5].exprptr),(yyvsp[-3].exprptr),(yyvsp[-1].exprptr))) 
 			    {
-			      (yyvsp[(3) - (8)].exprptr)->ex_value = 
-				ibeta((yyvsp[(3) - (8)].exprptr)->ex_value,(yyvsp[(5) - (8)].exprptr)->ex_value,(yyvsp[(7) - (8)].exprptr)->ex_value);
-			      efree((yyvsp[(5) - (8)].exprptr));
-			      efree((yyvsp[(7) - (8)].exprptr));
-			      (yyval.exprptr) = (yyvsp[(3) - (8)].exprptr);
+			      (yyvsp[-5].exprptr)->ex_value = 
+				ibeta((yyvsp[-5].exprptr)->ex_value,(yyvsp[-3].exprptr)->ex_value,(yyvsp[-1].exprptr)->ex_value);
+			      efree((yyvsp[-3].exprptr));
+			      efree((yyvsp[-1].exprptr));
+			      (yyval.exprptr) = (yyvsp[-5].exprptr);
 			    }
 			  else 
-			    TERNARY((yyvsp[(3) - (8)].exprptr),(yyvsp[(5) - (8)].exprptr),(yyvsp[(7) - (8)].exprptr),(yyval.exprptr),O_IBETA);
+			    TERNARY((yyvsp[-5].exprptr),(yyvsp[-3].exprptr),(yyvsp[-1].exprptr),(yyval.exprptr),O_IBETA);
 		        }
+#line 2834 "gram.c"
     break;
 
-  case 102:
-#line 850 "gram.y"
-    {
-			  if (ONECON((yyvsp[(2) - (2)].exprptr)))
-			    CONFUNC((yyvsp[(2) - (2)].exprptr),(yyval.exprptr),-)
+  case 107: /* expr: '-' expr  */
+#line 882 "gram.y"
+                        {
+			  if (ONECON((yyvsp[0].exprptr)))
+			    CONFUNC((yyvsp[0].exprptr),(yyval.exprptr),-)
 			  else
-			    UNARY((yyvsp[(2) - (2)].exprptr),(yyval.exprptr),O_NEG);
+			    UNARY((yyvsp[0].exprptr),(yyval.exprptr),O_NEG);
                         }
+#line 2845 "gram.c"
     break;
 
-  case 103:
-#line 857 "gram.y"
-    {
+  case 108: /* expr: NUMBER  */
+#line 889 "gram.y"
+                        {
 			  (yyval.exprptr) = ealloc();
 			  (yyval.exprptr)->ex_oper = O_CONST;
-			  (yyval.exprptr)->ex_value = (yyvsp[(1) - (1)].lexptr)->lx_u.lxu_value;
-			  lfree((yyvsp[(1) - (1)].lexptr));
+			  (yyval.exprptr)->ex_value = (yyvsp[0].lexptr)->lx_u.lxu_value;
+			  lfree((yyvsp[0].lexptr));
                         }
+#line 2856 "gram.c"
     break;
 
-  case 104:
-#line 864 "gram.y"
-    {
+  case 109: /* expr: IDENT  */
+#line 896 "gram.y"
+                        {
 			  (yyval.exprptr) = ealloc();
 			  (yyval.exprptr)->ex_oper = O_IDENT;
-			  (yyval.exprptr)->ex_sym = lookup((yyvsp[(1) - (1)].lexptr)->lx_u.lxu_name);
-			  lfree((yyvsp[(1) - (1)].lexptr));
+			  (yyval.exprptr)->ex_sym = lookup((yyvsp[0].lexptr)->lx_u.lxu_name);
+			  lfree((yyvsp[0].lexptr));
                         }
+#line 2867 "gram.c"
     break;
 
 
-/* Line 1267 of yacc.c.  */
-#line 2888 "gram.c"
+#line 2871 "gram.c"
+
       default: break;
     }
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
-
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (YY_("syntax error"));
-#else
-      {
-	YYSIZE_T yysize = yysyntax_error (0, yystate, yychar);
-	if (yymsg_alloc < yysize && yymsg_alloc < YYSTACK_ALLOC_MAXIMUM)
-	  {
-	    YYSIZE_T yyalloc = 2 * yysize;
-	    if (! (yysize <= yyalloc && yyalloc <= YYSTACK_ALLOC_MAXIMUM))
-	      yyalloc = YYSTACK_ALLOC_MAXIMUM;
-	    if (yymsg != yymsgbuf)
-	      YYSTACK_FREE (yymsg);
-	    yymsg = (char *) YYSTACK_ALLOC (yyalloc);
-	    if (yymsg)
-	      yymsg_alloc = yyalloc;
-	    else
-	      {
-		yymsg = yymsgbuf;
-		yymsg_alloc = sizeof yymsgbuf;
-	      }
-	  }
-
-	if (0 < yysize && yysize <= yymsg_alloc)
-	  {
-	    (void) yysyntax_error (yymsg, yystate, yychar);
-	    yyerror (yymsg);
-	  }
-	else
-	  {
-	    yyerror (YY_("syntax error"));
-	    if (yysize != 0)
-	      goto yyexhaustedlab;
-	  }
-      }
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
-      /* If just tried and failed to reuse look-ahead token after an
-	 error, discard it.  */
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
     }
 
-  /* Else will try to reuse look-ahead token after shifting the error
+  /* Else will try to reuse lookahead token after shifting the error
      token.  */
   goto yyerrlab1;
 
@@ -2986,14 +2945,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -3006,42 +2964,42 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
-      if (yyn != YYPACT_NINF)
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
 
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -3052,53 +3010,57 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#ifndef yyoverflow
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
-yyreturn:
-  if (yychar != YYEOF && yychar != YYEMPTY)
-     yydestruct ("Cleanup: discarding lookahead",
-		 yytoken, &yylval);
-  /* Do not reclaim the symbols of the rule which action triggered
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
-}
 
+  return yyresult;
+}
 
-#line 871 "gram.y"
+#line 903 "gram.y"
 
 
 int
@@ -3204,4 +3166,3 @@ prexq (const struct expr *ep)
 	printf ("\t%s\n",s);
     }
 }
-
@@ -1,14 +1,14 @@
-/* A Bison parser, made by GNU Bison 2.3.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* Skeleton interface for Bison's Yacc-like parsers in C
+/* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-   This program is free software; you can redistribute it and/or modify
+   This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2, or (at your option)
-   any later version.
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
 
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
@@ -16,9 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street, Fifth Floor,
-   Boston, MA 02110-1301, USA.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,56 +31,80 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
-/* Tokens.  */
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_GRAM_H_INCLUDED
+# define YY_YY_GRAM_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     NUMBER = 258,
-     IDENT = 259,
-     SEP = 260,
-     ABS = 261,
-     SQRT = 262,
-     EXP = 263,
-     LOG = 264,
-     LOG10 = 265,
-     SIN = 266,
-     COS = 267,
-     TAN = 268,
-     ASIN = 269,
-     ACOS = 270,
-     ATAN = 271,
-     SINH = 272,
-     COSH = 273,
-     TANH = 274,
-     ASINH = 275,
-     ACOSH = 276,
-     ATANH = 277,
-     FLOOR = 278,
-     CEIL = 279,
-     J0 = 280,
-     J1 = 281,
-     Y0 = 282,
-     Y1 = 283,
-     LGAMMA = 284,
-     GAMMA = 285,
-     ERF = 286,
-     ERFC = 287,
-     INVERF = 288,
-     NORM = 289,
-     INVNORM = 290,
-     IGAMMA = 291,
-     IBETA = 292,
-     EVERY = 293,
-     FROM = 294,
-     PRINT = 295,
-     STEP = 296,
-     EXAM = 297,
-     UMINUS = 298
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    NUMBER = 258,                  /* NUMBER  */
+    IDENT = 259,                   /* IDENT  */
+    SEP = 260,                     /* SEP  */
+    ABS = 261,                     /* ABS  */
+    SQRT = 262,                    /* SQRT  */
+    EXP = 263,                     /* EXP  */
+    LOG = 264,                     /* LOG  */
+    LOG10 = 265,                   /* LOG10  */
+    SIN = 266,                     /* SIN  */
+    COS = 267,                     /* COS  */
+    TAN = 268,                     /* TAN  */
+    ASIN = 269,                    /* ASIN  */
+    ACOS = 270,                    /* ACOS  */
+    ATAN = 271,                    /* ATAN  */
+    SINH = 272,                    /* SINH  */
+    COSH = 273,                    /* COSH  */
+    TANH = 274,                    /* TANH  */
+    ASINH = 275,                   /* ASINH  */
+    ACOSH = 276,                   /* ACOSH  */
+    ATANH = 277,                   /* ATANH  */
+    FLOOR = 278,                   /* FLOOR  */
+    CEIL = 279,                    /* CEIL  */
+    J0 = 280,                      /* J0  */
+    J1 = 281,                      /* J1  */
+    Y0 = 282,                      /* Y0  */
+    Y1 = 283,                      /* Y1  */
+    LGAMMA = 284,                  /* LGAMMA  */
+    GAMMA = 285,                   /* GAMMA  */
+    ERF = 286,                     /* ERF  */
+    ERFC = 287,                    /* ERFC  */
+    INVERF = 288,                  /* INVERF  */
+    NORM = 289,                    /* NORM  */
+    INVNORM = 290,                 /* INVNORM  */
+    IGAMMA = 291,                  /* IGAMMA  */
+    IBETA = 292,                   /* IBETA  */
+    EVERY = 293,                   /* EVERY  */
+    FROM = 294,                    /* FROM  */
+    PRINT = 295,                   /* PRINT  */
+    STEP = 296,                    /* STEP  */
+    EXAM = 297,                    /* EXAM  */
+    UNTIL = 298,                   /* UNTIL  */
+    EVENT = 299,                   /* EVENT  */
+    UMINUS = 300                   /* UMINUS  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
 #define NUMBER 258
 #define IDENT 259
 #define SEP 260
@@ -123,27 +145,34 @@
 #define PRINT 295
 #define STEP 296
 #define EXAM 297
-#define UMINUS 298
-
-
-
+#define UNTIL 298
+#define EVENT 299
+#define UMINUS 300
 
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-#line 85 "gram.y"
+union YYSTYPE
 {
+#line 85 "gram.y"
+
         struct  lex     *lexptr;
         struct  expr    *exprptr;
         struct  prt     *prtptr;
         int     simple;
-}
-/* Line 1489 of yacc.c.  */
-#line 142 "gram.h"
-	YYSTYPE;
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
+
+#line 164 "gram.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
 #endif
 
+
 extern YYSTYPE yylval;
 
+
+int yyparse (void);
+
+
+#endif /* !YY_YY_GRAM_H_INCLUDED  */
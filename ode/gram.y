@@ -95,9 +95,9 @@ bool erritem;
 %token FLOOR CEIL J0 J1 Y0 Y1
 %token LGAMMA GAMMA ERF ERFC INVERF NORM INVNORM
 %token IGAMMA IBETA
-%token EVERY FROM PRINT STEP EXAM
+%token EVERY FROM PRINT STEP EXAM UNTIL EVENT
 %start program
-%type <simple> prttag
+%type <simple> prttag evkind
 %type <lexptr> cexpr
 %type <exprptr> expr
 %type <prtptr> prtitem
@@ -242,6 +242,34 @@ stat            : SEP
 			  prexq(sp->sy_expr);
 			  fflush(stdout);
                         }
+                | evkind expr SEP
+                        {
+			  efree(evexpr[$1]);
+			  evexpr[$1] = $2;
+			  lfree($3);
+                        }
+                | evkind expr '=' expr SEP
+                        {
+			  /* when the two sides are equal, i.e. lhs - rhs = 0 */
+			  efree(evexpr[$1]);
+			  if (TWOCON($2,$4))
+			    COMBINE($2,$4,evexpr[$1],-=)
+			  else
+			    BINARY($2,$4,evexpr[$1],O_MINUS);
+			  lfree($5);
+                        }
+                | evkind SEP
+                        {
+			  efree(evexpr[$1]);
+			  evexpr[$1] = NULL;
+			  lfree($2);
+                        }
+                ;
+
+evkind          : UNTIL
+                        { $$ = EV_UNTIL; }
+                | EVENT
+                        { $$ = EV_EVENT; }
                 ;
 
 prtlist         : prtitem
@@ -527,8 +555,12 @@ expr            : '(' expr ')'
 			  
 			  if (TWOCON($1,$3)) 
 			    {
-			      /* case const ^ const */
-			      $1->ex_value = pow($1->ex_value,$3->ex_value);
+			      /* case const ^ const, as eval() would do it */
+			      if (IS_IPOW($3->ex_value))
+				$1->ex_value = ipow($1->ex_value,
+						    (int)$3->ex_value);
+			      else
+				$1->ex_value = pow($1->ex_value,$3->ex_value);
 			      efree($3);
 			    } 
 			  else if (ONECON($1)) 
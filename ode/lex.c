@@ -363,8 +363,8 @@ static void yy_fatal_error (yyconst char msg[]  );
 	*yy_cp = '\0'; \
 	(yy_c_buf_p) = yy_cp;
 
-#define YY_NUM_RULES 51
-#define YY_END_OF_BUFFER 52
+#define YY_NUM_RULES 53
+#define YY_END_OF_BUFFER 54
 /* This struct is not used in this scanner,
    but its presence is necessary. */
 struct yy_trans_info
@@ -372,55 +372,57 @@ struct yy_trans_info
 	flex_int32_t yy_verify;
 	flex_int32_t yy_nxt;
 	};
-static yyconst flex_int16_t yy_acclist[232] =
+static yyconst flex_int16_t yy_acclist[243] =
     {   0,
-       52,   50,   51,    3,   50,   51,    4,   51,   49,   50,
-       51,   50,   51,   50,   51,   46,   50,   51,    4,   50,
-       51,   45,   50,   51,   45,   50,   51,   50,   51,   45,
-       50,   51,   45,   50,   51,   45,   50,   51,   45,   50,
-       51,   45,   50,   51,   45,   50,   51,   45,   50,   51,
-       45,   50,   51,   45,   50,   51,   45,   50,   51,   45,
-       50,   51,   45,   50,   51,   50,   51,    1,   48,   47,
-       46,   45,    5,   45,    2,   45,   45,   45,   45,   45,
-       45,   45,   45,   45,   45,   45,   45,   45,   45,   45,
-       45,   45,   16,   45,   45,   45,   45,   45,   45,   45,
-
-       45,    6,   47,   48,   46,   12,   45,   45,   45,   45,
-       45,   45,   19,   45,   37,   45,   45,   45,   14,   45,
-       45,   45,   45,   45,   45,   45,   45,   17,   45,   45,
-       45,   18,   45,   45,   45,   20,   45,   48,   47,   46,
-       25,   45,   24,   45,   26,   45,   45,   45,   31,   45,
-       28,   45,   36,   45,   45,   45,   45,    8,   45,   45,
-       45,   45,   45,   45,   45,   45,   41,   45,   45,   27,
-       45,   13,   45,   10,   45,   29,   45,   48,   47,   48,
-       47,   46,   22,   45,   21,   45,   23,   45,   32,   45,
-       33,   45,   34,   45,   35,   45,    7,   45,   45,   30,
-
-       45,   40,   45,   43,   45,   45,   45,   45,   45,   15,
-       45,    9,   45,   48,   47,   48,   47,   45,   44,   45,
-       38,   45,   45,   39,   45,   47,   48,   11,   45,   42,
-       45
+       54,   52,   53,    3,   52,   53,    4,   53,   51,   52,
+       53,   52,   53,   52,   53,   48,   52,   53,    4,   52,
+       53,   47,   52,   53,   47,   52,   53,   52,   53,   47,
+       52,   53,   47,   52,   53,   47,   52,   53,   47,   52,
+       53,   47,   52,   53,   47,   52,   53,   47,   52,   53,
+       47,   52,   53,   47,   52,   53,   47,   52,   53,   47,
+       52,   53,   47,   52,   53,   47,   52,   53,   52,   53,
+        1,   50,   49,   48,   47,    5,   47,    2,   47,   47,
+       47,   47,   47,   47,   47,   47,   47,   47,   47,   47,
+       47,   47,   47,   47,   47,   18,   47,   47,   47,   47,
+
+       47,   47,   47,   47,   47,    6,   49,   50,   48,   14,
+       47,   47,   47,   47,   47,   47,   21,   47,   39,   47,
+       47,   47,   16,   47,   47,   47,   47,   47,   47,   47,
+       47,   19,   47,   47,   47,   20,   47,   47,   47,   22,
+       47,   47,   50,   49,   48,   27,   47,   26,   47,   28,
+       47,   47,   47,   33,   47,   30,   47,   38,   47,   47,
+       47,   47,   47,    8,   47,   47,   47,   47,   47,   47,
+       47,   47,   43,   47,   47,   29,   47,   15,   47,   10,
+       47,   31,   47,   47,   50,   49,   50,   49,   48,   24,
+       47,   23,   47,   25,   47,   34,   47,   35,   47,   36,
+
+       47,   37,   47,   13,   47,    7,   47,   47,   32,   47,
+       42,   47,   45,   47,   47,   47,   47,   47,   17,   47,
+        9,   47,   12,   47,   50,   49,   50,   49,   47,   46,
+       47,   40,   47,   47,   41,   47,   49,   50,   11,   47,
+       44,   47
     } ;
 
-static yyconst flex_int16_t yy_accept[160] =
+static yyconst flex_int16_t yy_accept[167] =
     {   0,
         1,    1,    1,    2,    4,    7,    9,   12,   14,   16,
        19,   22,   25,   28,   30,   33,   36,   39,   42,   45,
-       48,   51,   54,   57,   60,   63,   66,   68,   68,   69,
-       70,   71,   72,   72,   73,   75,   76,   77,   78,   79,
-       80,   81,   82,   83,   84,   85,   86,   87,   88,   89,
-       90,   91,   92,   93,   95,   96,   97,   98,   99,  100,
-      101,  102,  103,  103,  105,  105,  105,  106,  108,  109,
-      110,  111,  112,  113,  115,  117,  118,  119,  121,  122,
-      123,  124,  125,  126,  127,  128,  130,  131,  132,  134,
-      135,  136,  138,  138,  139,  139,  139,  140,  141,  143,
-
-      145,  147,  148,  149,  151,  153,  155,  156,  157,  158,
-      160,  161,  162,  163,  164,  165,  166,  167,  169,  170,
-      172,  174,  176,  178,  179,  179,  181,  182,  183,  185,
-      187,  189,  191,  193,  195,  197,  199,  200,  202,  204,
-      206,  207,  208,  209,  210,  212,  214,  215,  217,  218,
-      219,  221,  223,  224,  226,  228,  230,  232,  232
+       48,   51,   54,   57,   60,   63,   66,   69,   71,   71,
+       72,   73,   74,   75,   75,   76,   78,   79,   80,   81,
+       82,   83,   84,   85,   86,   87,   88,   89,   90,   91,
+       92,   93,   94,   95,   96,   98,   99,  100,  101,  102,
+      103,  104,  105,  106,  107,  107,  109,  109,  109,  110,
+      112,  113,  114,  115,  116,  117,  119,  121,  122,  123,
+      125,  126,  127,  128,  129,  130,  131,  132,  134,  135,
+      136,  138,  139,  140,  142,  143,  143,  144,  144,  144,
+
+      145,  146,  148,  150,  152,  153,  154,  156,  158,  160,
+      161,  162,  163,  164,  166,  167,  168,  169,  170,  171,
+      172,  173,  175,  176,  178,  180,  182,  184,  185,  186,
+      186,  188,  189,  190,  192,  194,  196,  198,  200,  202,
+      204,  206,  208,  209,  211,  213,  215,  216,  217,  218,
+      219,  221,  223,  225,  226,  228,  229,  230,  232,  234,
+      235,  237,  239,  241,  243,  243
     } ;
 
 static yyconst flex_int32_t yy_ec[256] =
@@ -437,8 +439,8 @@ static yyconst flex_int32_t yy_ec[256] =
         1,   16,    1,    4,   12,    1,   17,   18,   19,   12,
 
        20,   21,   22,   23,   24,   25,   12,   26,   27,   28,
-       29,   30,   31,   32,   33,   34,   12,   35,   12,   36,
-       37,   12,    1,    1,    1,    4,    1,    1,    1,    1,
+       29,   30,   31,   32,   33,   34,   35,   36,   12,   37,
+       38,   12,    1,    1,    1,    4,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
@@ -455,120 +457,134 @@ static yyconst flex_int32_t yy_ec[256] =
         1,    1,    1,    1,    1
     } ;
 
-static yyconst flex_int32_t yy_meta[38] =
+static yyconst flex_int32_t yy_meta[39] =
     {   0,
-        1,    1,    1,    1,    1,    1,    1,    2,    2,    2,
-        1,    2,    2,    2,    2,    1,    2,    2,    2,    2,
-        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
-        2,    2,    2,    2,    2,    2,    2
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1
     } ;
 
-static yyconst flex_int16_t yy_base[161] =
+static yyconst flex_int16_t yy_base[166] =
     {   0,
-        0,  219,  225,  227,  227,  227,  227,  221,   30,   34,
-      227,    0,  209,  219,   27,  201,   28,   17,   24,  203,
-       37,   40,  190,  186,   39,  200,   68,  213,  227,   71,
-       77,    0,   86,    0,    0,  227,  182,  185,  189,  195,
-      178,  186,  176,  187,  187,   34,  177,  176,  177,  183,
-      185,  166,  183,    0,  177,  166,  173,  168,  163,  174,
-      165,  227,   92,   95,  101,  104,  108,    0,  159,  163,
-      162,   94,  163,  165,  168,  154,  158,    0,  155,  156,
-      155,  147,  153,   38,  152,  169,  150,  148,  152,  140,
-      143,  149,  112,  115,  120,  124,  127,  130,  148,  147,
-
-      146,   66,   74,    0,    0,    0,  131,  143,  134,    0,
-      148,  147,  136,  130,  132,  133,  151,    0,  124,    0,
-        0,    0,    0,  133,  136,  139,  142,  227,    0,    0,
-        0,    0,    0,    0,    0,    0,   99,    0,    0,    0,
-       89,   78,   61,   72,    0,    0,  227,  145,  227,   68,
-        0,    0,   45,    0,  227,    0,    0,  227,  155,   65
+        1,   33,    1,  279,  279,  279,  279,   40,   71,   75,
+      279,   84,   72,   84,  105,   69,   71,   93,  100,   73,
+      109,  106,  104,  104,  116,  124,  114,  140,    0,  279,
+      131,  144,    0,  150,    0,    0,  279,  112,  117,  124,
+      132,  122,  137,  129,  142,  145,  149,  138,  139,  142,
+      150,  154,  136,  156,    0,  152,  143,  152,  149,  146,
+      160,  153,  148,  279,  177,  171,  184,  182,  187,    0,
+      156,  170,  171,  175,  175,  179,  184,  176,  178,    0,
+      177,  180,  182,  176,  184,  192,  187,  206,  189,  189,
+      195,  185,  191,  199,  199,  218,  217,  222,  223,  225,
+
+      228,  216,  217,  218,  234,  236,    0,    0,    0,  212,
+      209,  224,  217,    0,  233,  234,  225,  221,  225,  228,
+      248,    0,  223,    0,    0,    0,    0,  232,  251,  256,
+      255,  258,  279,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,  241,    0,    0,    0,  253,  250,  240,  256,
+        0,    0,    0,  279,  266,  279,  257,    0,    0,  251,
+        0,  279,    0,    0,  279
     } ;
 
-static yyconst flex_int16_t yy_def[161] =
+static yyconst flex_int16_t yy_def[166] =
     {   0,
-      158,    1,  158,  158,  158,  158,  158,  159,  158,  158,
-      158,  160,  160,  158,  160,  160,  160,  160,  160,  160,
-      160,  160,  160,  160,  160,  160,  158,  159,  158,  158,
-      158,   10,  158,  160,  160,  158,  160,  160,  160,  160,
-      160,  160,  160,  160,  160,  160,  160,  160,  160,  160,
-      160,  160,  160,  160,  160,  160,  160,  160,  160,  160,
-      160,  158,  158,  158,  158,  158,  158,  160,  160,  160,
-      160,  160,  160,  160,  160,  160,  160,  160,  160,  160,
-      160,  160,  160,  160,  160,  160,  160,  160,  160,  160,
-      160,  160,  158,  158,  158,  158,  158,  158,  160,  160,
-
-      160,  160,  160,  160,  160,  160,  160,  160,  160,  160,
-      160,  160,  160,  160,  160,  160,  160,  160,  160,  160,
-      160,  160,  160,  158,  158,  158,  158,  158,  160,  160,
-      160,  160,  160,  160,  160,  160,  160,  160,  160,  160,
-      160,  160,  160,  160,  160,  160,  158,  158,  158,  160,
-      160,  160,  160,  160,  158,  160,  160,    0,  158,  158
+      165,    1,  165,  165,  165,  165,  165,  165,  165,  165,
+      165,  165,   12,  165,   12,   12,   12,   12,   12,   12,
+       12,   12,   12,   12,   12,   12,   12,    9,    8,  165,
+        9,  165,   10,  165,   12,   12,  165,   12,   12,   12,
+       12,   12,   12,   12,   12,   12,   12,   12,   12,   12,
+       12,   12,   12,   12,   12,   12,   12,   12,   12,   12,
+       12,   12,   12,  165,  165,   32,  165,   34,  165,   12,
+       12,   12,   12,   12,   12,   12,   12,   12,   12,   12,
+       12,   12,   12,   12,   12,   12,   12,   12,   12,   12,
+       12,   12,   12,   12,   12,   65,  165,  165,   67,  165,
+
+      165,   12,   12,   12,   12,   12,   12,   12,   12,   12,
+       12,   12,   12,   12,   12,   12,   12,   12,   12,   12,
+       12,   12,   12,   12,   12,   12,   12,   12,  165,   98,
+      165,  165,  165,   12,   12,   12,   12,   12,   12,   12,
+       12,   12,   12,   12,   12,   12,   12,   12,   12,   12,
+       12,   12,   12,  165,  165,  165,   12,   12,   12,   12,
+       12,  165,   12,   12,    0
     } ;
 
-static yyconst flex_int16_t yy_nxt[265] =
+static yyconst flex_int16_t yy_nxt[318] =
     {   0,
-        4,    5,    6,    7,    8,    7,    9,   10,   10,   10,
-       11,   12,   12,   12,   13,   14,   15,   16,   17,   18,
-       19,   20,   12,   21,   12,   22,   12,   23,   12,   24,
-       12,   12,   25,   26,   12,   12,   12,   30,   30,   30,
-       31,   32,   32,   32,   37,   38,   33,   42,   44,   47,
-       77,   45,   46,   33,   50,   48,   43,  114,   51,   39,
-       40,   53,   58,   78,   52,  115,   34,   54,   55,   59,
-       62,  157,   60,  132,  133,   30,   30,   30,   30,   30,
-       30,  134,  135,   63,   64,   64,   64,  156,  154,   65,
-       63,   66,  153,   67,   67,   67,   65,   93,  152,   94,
-
-       94,   94,   64,   64,   64,  151,   96,   95,   97,   97,
-       97,   67,   67,   67,   95,   98,   98,   98,  102,   94,
-       94,   94,  124,  124,  124,  125,  150,  126,  126,  126,
-      103,   97,   97,   97,  127,  127,  127,  128,  128,  128,
-      147,  147,  147,  126,  126,  126,  148,  148,  148,  149,
-      149,  149,  155,  155,  155,   28,   28,  146,  145,  144,
-      143,  142,  141,  140,  139,  138,  137,  136,  131,  130,
-      129,  123,  122,  121,  120,  119,  118,  117,  116,  113,
-      112,  111,  110,  109,  108,  107,  106,  105,  104,  101,
-      100,   99,   92,   91,   90,   89,   88,   87,   86,   85,
-
-       84,   83,   82,   81,   80,   79,   76,   75,   74,   73,
-       72,   71,   70,   69,   68,   29,   61,   57,   56,   49,
-       41,   36,   35,   29,  158,   27,    3,  158,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158
+      165,    4,    5,    6,    7,    8,    7,    9,   10,   10,
+       10,   11,   12,   12,   12,   13,   14,   15,   16,   17,
+       18,   19,   20,   12,   21,   12,   22,   12,   23,   12,
+       24,   12,   12,   25,   26,   27,   12,   12,   12,   28,
+       29,   29,   30,   29,   29,   29,   29,   29,   29,   29,
+       29,   29,   29,   29,   29,   29,   29,   29,   29,   29,
+       29,   29,   29,   29,   29,   29,   29,   29,   29,   29,
+       29,   29,   29,   29,   29,   29,   29,   29,   31,   31,
+       31,   32,   33,   33,   33,   36,   37,   34,   42,   50,
+       43,   35,   35,   35,   34,   35,   35,   35,   35,   44,
+
+       35,   35,   35,   35,   35,   35,   35,   35,   35,   35,
+       35,   35,   35,   35,   35,   35,   35,   35,   35,   35,
+       35,   35,   38,   39,   45,   48,   51,   54,   46,   47,
+       52,   49,   57,   55,   56,   58,   53,   40,   41,   59,
+       62,   63,   64,   65,   70,   71,   60,   72,   73,   61,
+       65,   66,   66,   66,   74,   68,   67,   69,   69,   69,
+       75,   76,   77,   67,   78,   79,   81,   82,   83,   84,
+       85,   86,   87,   88,   89,   90,   91,   92,   80,   93,
+       94,   95,   96,   98,   97,   97,   97,  165,  102,   99,
+       98,  100,  100,  100,  101,  101,  101,  103,  104,  105,
+
+      107,  108,  109,  110,  112,  113,  114,  111,  115,  116,
+      117,  118,  106,  120,  121,  122,  123,  124,  125,  119,
+      126,  127,  128,  165,  129,  129,  129,  130,  165,  131,
+      131,  131,  132,  132,  132,  133,  133,  133,  134,  135,
+      136,  137,  138,  139,  140,  141,  142,  143,  144,  145,
+      146,  147,  148,  149,  150,  151,  152,  153,  154,  154,
+      154,  165,  155,  155,  155,  156,  156,  156,  157,  158,
+      159,  160,  161,  162,  162,  162,  163,  164,    3,  165,
+      165,  165,  165,  165,  165,  165,  165,  165,  165,  165,
+      165,  165,  165,  165,  165,  165,  165,  165,  165,  165,
+
+      165,  165,  165,  165,  165,  165,  165,  165,  165,  165,
+      165,  165,  165,  165,  165,  165,  165
     } ;
 
-static yyconst flex_int16_t yy_chk[265] =
+static yyconst flex_int16_t yy_chk[318] =
     {   0,
+        3,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    9,    9,    9,
-       10,   10,   10,   10,   15,   15,   10,   17,   18,   19,
-       46,   18,   18,   10,   21,   19,   17,   84,   21,   15,
-       15,   22,   25,   46,   21,   84,  160,   22,   22,   25,
-       27,  153,   25,  102,  102,   27,   27,   27,   30,   30,
-       30,  103,  103,   30,   31,   31,   31,  150,  144,   31,
-       30,   33,  143,   33,   33,   33,   31,   63,  142,   63,
-
-       63,   63,   64,   64,   64,  141,   65,   64,   65,   65,
-       65,   66,   66,   66,   64,   67,   67,   67,   72,   93,
-       93,   93,   94,   94,   94,   95,  137,   95,   95,   95,
-       72,   96,   96,   96,   97,   97,   97,   98,   98,   98,
-      124,  124,  124,  125,  125,  125,  126,  126,  126,  127,
-      127,  127,  148,  148,  148,  159,  159,  119,  117,  116,
-      115,  114,  113,  112,  111,  109,  108,  107,  101,  100,
-       99,   92,   91,   90,   89,   88,   87,   86,   85,   83,
-       82,   81,   80,   79,   77,   76,   75,   74,   73,   71,
-       70,   69,   61,   60,   59,   58,   57,   56,   55,   53,
-
-       52,   51,   50,   49,   48,   47,   45,   44,   43,   42,
-       41,   40,   39,   38,   37,   28,   26,   24,   23,   20,
-       16,   14,   13,    8,    3,    2,  158,  158,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158,  158,  158,  158,  158,  158,  158,
-      158,  158,  158,  158
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    2,
+        8,    8,    8,    8,    8,    8,    8,    8,    8,    8,
+        8,    8,    8,    8,    8,    8,    8,    8,    8,    8,
+        8,    8,    8,    8,    8,    8,    8,    8,    8,    8,
+        8,    8,    8,    8,    8,    8,    8,    8,    9,    9,
+        9,   10,   10,   10,   10,   13,   14,   10,   16,   20,
+       17,   12,   12,   12,   10,   12,   12,   12,   12,   17,
+
+       12,   12,   12,   12,   12,   12,   12,   12,   12,   12,
+       12,   12,   12,   12,   12,   12,   12,   12,   12,   12,
+       12,   12,   15,   15,   18,   19,   21,   22,   18,   18,
+       21,   19,   23,   22,   22,   24,   21,   15,   15,   25,
+       26,   27,   28,   31,   38,   39,   25,   40,   41,   25,
+       31,   32,   32,   32,   42,   34,   32,   34,   34,   34,
+       43,   44,   45,   32,   46,   47,   48,   49,   50,   51,
+       52,   53,   54,   56,   57,   58,   59,   60,   47,   61,
+       62,   63,   65,   66,   65,   65,   65,   68,   71,   67,
+       66,   67,   67,   67,   69,   69,   69,   72,   73,   74,
+
+       75,   76,   77,   78,   79,   81,   82,   78,   83,   84,
+       85,   86,   74,   87,   88,   89,   90,   91,   92,   86,
+       93,   94,   95,   96,   97,   97,   97,   98,   99,   98,
+       98,   98,  100,  100,  100,  101,  101,  101,  102,  103,
+      104,  105,  105,  106,  106,  110,  111,  112,  113,  115,
+      116,  117,  118,  119,  120,  121,  123,  128,  129,  129,
+      129,  130,  131,  131,  131,  132,  132,  132,  143,  147,
+      148,  149,  150,  155,  155,  155,  157,  160,  165,  165,
+      165,  165,  165,  165,  165,  165,  165,  165,  165,  165,
+      165,  165,  165,  165,  165,  165,  165,  165,  165,  165,
+
+      165,  165,  165,  165,  165,  165,  165,  165,  165,  165,
+      165,  165,  165,  165,  165,  165,  165
     } ;
 
 extern int yy_flex_debug;
@@ -603,7 +619,7 @@ char *yytext;
 #include "gram.h"
 
 int curline = 1;
-#line 607 "lex.c"
+#line 623 "lex.c"
 
 #define INITIAL 0
 
@@ -761,7 +777,7 @@ YY_DECL
     
 #line 18 "lex.l"
 
-#line 765 "lex.c"
+#line 781 "lex.c"
 
 	if ( !(yy_init) )
 		{
@@ -818,14 +834,14 @@ yy_match:
 			while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 				{
 				yy_current_state = (int) yy_def[yy_current_state];
-				if ( yy_current_state >= 159 )
+				if ( yy_current_state >= 166 )
 					yy_c = yy_meta[(unsigned int) yy_c];
 				}
 			yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
 			*(yy_state_ptr)++ = yy_current_state;
 			++yy_cp;
 			}
-		while ( yy_base[yy_current_state] != 227 );
+		while ( yy_base[yy_current_state] != 279 );
 
 yy_find_action:
 		yy_current_state = *--(yy_state_ptr);
@@ -935,184 +951,194 @@ YY_RULE_SETUP
 case 12:
 YY_RULE_SETUP
 #line 47 "lex.l"
-{ return ABS; }
+{ return UNTIL; }
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
 #line 48 "lex.l"
-{ return SQRT; }
+{ return EVENT; }
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
 #line 49 "lex.l"
-{ return EXP; }
+{ return ABS; }
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
 #line 50 "lex.l"
-{ return LOG10; }
+{ return SQRT; }
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
 #line 51 "lex.l"
-{ return LOG; }
+{ return EXP; }
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
 #line 52 "lex.l"
-{ return LOG; }
+{ return LOG10; }
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
 #line 53 "lex.l"
-{ return SIN; }
+{ return LOG; }
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
 #line 54 "lex.l"
-{ return COS; }
+{ return LOG; }
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
 #line 55 "lex.l"
-{ return TAN; }
+{ return SIN; }
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
 #line 56 "lex.l"
-{ return ASINH; }
+{ return COS; }
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
 #line 57 "lex.l"
-{ return ACOSH; }
+{ return TAN; }
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
 #line 58 "lex.l"
-{ return ATANH; }
+{ return ASINH; }
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
 #line 59 "lex.l"
-{ return ASIN; }
+{ return ACOSH; }
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
 #line 60 "lex.l"
-{ return ACOS; }
+{ return ATANH; }
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
 #line 61 "lex.l"
-{ return ATAN; }
+{ return ASIN; }
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
 #line 62 "lex.l"
-{ return SINH; }
+{ return ACOS; }
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
 #line 63 "lex.l"
-{ return COSH; }
+{ return ATAN; }
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
 #line 64 "lex.l"
-{ return TANH; }
+{ return SINH; }
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
 #line 65 "lex.l"
-{ return FLOOR; }
+{ return COSH; }
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
 #line 66 "lex.l"
-{ return CEIL; }
+{ return TANH; }
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
 #line 67 "lex.l"
-{ return J0; }
+{ return FLOOR; }
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
 #line 68 "lex.l"
-{ return J1; }
+{ return CEIL; }
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
 #line 69 "lex.l"
-{ return Y0; }
+{ return J0; }
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
 #line 70 "lex.l"
-{ return Y1; }
+{ return J1; }
 	YY_BREAK
 case 36:
 YY_RULE_SETUP
 #line 71 "lex.l"
-{ return ERFC; }
+{ return Y0; }
 	YY_BREAK
 case 37:
 YY_RULE_SETUP
 #line 72 "lex.l"
-{ return ERF; }
+{ return Y1; }
 	YY_BREAK
 case 38:
 YY_RULE_SETUP
 #line 73 "lex.l"
-{ return INVERF; }
+{ return ERFC; }
 	YY_BREAK
 case 39:
 YY_RULE_SETUP
 #line 74 "lex.l"
-{ return LGAMMA; }
+{ return ERF; }
 	YY_BREAK
 case 40:
 YY_RULE_SETUP
 #line 75 "lex.l"
-{ return GAMMA; }
+{ return INVERF; }
 	YY_BREAK
 case 41:
 YY_RULE_SETUP
 #line 76 "lex.l"
-{ return NORM; }
+{ return LGAMMA; }
 	YY_BREAK
 case 42:
 YY_RULE_SETUP
 #line 77 "lex.l"
-{ return INVNORM; }
+{ return GAMMA; }
 	YY_BREAK
 case 43:
 YY_RULE_SETUP
 #line 78 "lex.l"
-{ return IBETA; }
+{ return NORM; }
 	YY_BREAK
 case 44:
 YY_RULE_SETUP
 #line 79 "lex.l"
-{ return IGAMMA; }
+{ return INVNORM; }
 	YY_BREAK
 case 45:
 YY_RULE_SETUP
 #line 80 "lex.l"
+{ return IBETA; }
+	YY_BREAK
+case 46:
+YY_RULE_SETUP
+#line 81 "lex.l"
+{ return IGAMMA; }
+	YY_BREAK
+case 47:
+YY_RULE_SETUP
+#line 82 "lex.l"
 {
 			yylval.lexptr = lalloc();
 			strncpy(yylval.lexptr->lx_u.lxu_name,yytext,NAMMAX);
 			return IDENT;
 		}
 	YY_BREAK
-case 46:
-#line 86 "lex.l"
-case 47:
-#line 87 "lex.l"
 case 48:
+#line 88 "lex.l"
+case 49:
+#line 89 "lex.l"
+case 50:
 YY_RULE_SETUP
-#line 87 "lex.l"
+#line 89 "lex.l"
 {
 			/*
 			 * restrictions on numbers:
@@ -1124,9 +1150,9 @@ YY_RULE_SETUP
 			return NUMBER;
 		}
 	YY_BREAK
-case 49:
+case 51:
 YY_RULE_SETUP
-#line 97 "lex.l"
+#line 99 "lex.l"
 {
 			/*
 			 * accept as few as possible so the error
@@ -1135,9 +1161,9 @@ YY_RULE_SETUP
 			return yytext[0];
 		}
 	YY_BREAK
-case 50:
+case 52:
 YY_RULE_SETUP
-#line 104 "lex.l"
+#line 106 "lex.l"
 {
 			if (*yytext > '~' || *yytext < ' ')
 				fprintf (stderr, 
@@ -1152,12 +1178,12 @@ YY_RULE_SETUP
 			return *yytext;
 		}
 	YY_BREAK
-case 51:
+case 53:
 YY_RULE_SETUP
-#line 117 "lex.l"
+#line 119 "lex.l"
 ECHO;
 	YY_BREAK
-#line 1161 "lex.c"
+#line 1187 "lex.c"
 			case YY_STATE_EOF(INITIAL):
 				yyterminate();
 
@@ -1411,7 +1437,7 @@ static int yy_get_next_buffer (void)
 		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 			{
 			yy_current_state = (int) yy_def[yy_current_state];
-			if ( yy_current_state >= 159 )
+			if ( yy_current_state >= 166 )
 				yy_c = yy_meta[(unsigned int) yy_c];
 			}
 		yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
@@ -1434,11 +1460,11 @@ static int yy_get_next_buffer (void)
 	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 		{
 		yy_current_state = (int) yy_def[yy_current_state];
-		if ( yy_current_state >= 159 )
+		if ( yy_current_state >= 166 )
 			yy_c = yy_meta[(unsigned int) yy_c];
 		}
 	yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
-	yy_is_jam = (yy_current_state == 158);
+	yy_is_jam = (yy_current_state == 165);
 	if ( ! yy_is_jam )
 		*(yy_state_ptr)++ = yy_current_state;
 
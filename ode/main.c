@@ -26,6 +26,7 @@
 #include "ode.h"
 #include "extern.h"
 #include "getopt.h"
+#include <unistd.h>		/* for isatty() */
 
 #define	ARG_NONE	0
 #define	ARG_REQUIRED	1
@@ -34,11 +35,14 @@
 struct option long_options[] =
 {
   {"input-file",		ARG_REQUIRED,	NULL, 'f'},
+  {"output-type",		ARG_REQUIRED,	NULL, 'O'},
   {"precision",			ARG_REQUIRED,	NULL, 'p'},
   /* integration algorithms */
   {"adams-moulton",		ARG_OPTIONAL,	NULL, 'A'}, /* 0 or 1 */
+  {"dormand-prince",		ARG_OPTIONAL,	NULL, 'D'}, /* 0 or 1 */
   {"euler",			ARG_OPTIONAL,	NULL, 'E'}, /* 0 or 1 */
   {"runge-kutta",		ARG_OPTIONAL,	NULL, 'R'}, /* 0 or 1 */
+  {"stiff",			ARG_OPTIONAL,	NULL, 'S'}, /* 0 or 1 */
   /* error bounds */
   {"absolute-error-bound",	ARG_REQUIRED,	NULL, 'e'}, /* 1 or 2 */
   {"step-size-bound",		ARG_REQUIRED,	NULL, 'h'}, /* 1 or 2 */
@@ -46,6 +50,10 @@ struct option long_options[] =
   {"suppress-error-bound",	ARG_NONE,	NULL, 's'},
   {"title",			ARG_NONE,	NULL, 't'},
   /* Long options with no equivalent short option alias */
+  {"realtime",			ARG_NONE,	NULL, 'R' << 8},
+  {"ensemble",			ARG_REQUIRED,	NULL, 'n' << 8},
+  {"ensemble-output",		ARG_REQUIRED,	NULL, 'o' << 8},
+  {"threads",			ARG_REQUIRED,	NULL, 'j' << 8},
   {"version",			ARG_NONE,	NULL, 'V' << 8},
   {"help",			ARG_NONE,	NULL, 'h' << 8},
   {NULL, 0, 0, 0}
@@ -77,10 +85,11 @@ main (int argc, char *argv[])
   bool show_usage = false;	/* remember whether to output usage message. */
   double local_tstep, local_hmax;
   FILE *infile = NULL;
+  char *ensemble_file = NULL;
 
   for ( ; ; )
     {
-      option = getopt_long (argc, argv, "e:f:h:p:r:stA::E::R::V", long_options, &opt_index);
+      option = getopt_long (argc, argv, "e:f:h:p:r:stA::D::E::O:R::S::V", long_options, &opt_index);
       if (option == 0)
 	option = long_options[opt_index].val;
 
@@ -99,6 +108,9 @@ main (int argc, char *argv[])
 	      fwd = 13;
 	    }
 	  break;
+	case 'R' << 8:		/* Realtime, ARG NONE		*/
+	  realtime = true;
+	  break;
 	case 'V' << 8:		/* Version, ARG NONE		*/
 	  show_version = true;
 	  break;
@@ -111,6 +123,46 @@ main (int argc, char *argv[])
 	case 'f':		/* File name, ARG REQUIRED	*/
 	  filename = xstrdup (optarg);
 	  break;
+	case 'O':		/* Output type, ARG REQUIRED	*/
+	  switch (optarg[0])
+	    {
+	    case 'a':
+	    case 'A':
+	      output_type = T_ASCII;
+	      break;
+	    case 'f':
+	    case 'F':
+	      output_type = T_SINGLE;
+	      break;
+	    case 'd':
+	    case 'D':
+	      output_type = T_DOUBLE;
+	      break;
+	    default:
+	      fatal ("-O: the output type must be `a', `f', or `d'");
+	      break;
+	    }
+	  break;
+	case 'n' << 8:		/* Ensemble, ARG REQUIRED	*/
+	  ensemble_file = xstrdup (optarg);
+	  break;
+	case 'o' << 8:		/* Ensemble output, ARG REQUIRED	*/
+	  if (count_member_conversions (optarg) != 1)
+	    fatal ("--ensemble-output: the file name must contain one member number conversion, such as `%d' or `%04d'");
+	  ensemble_output = xstrdup (optarg);
+	  break;
+	case 'j' << 8:		/* Threads, ARG REQUIRED	*/
+	  {
+	    char *end;
+	    long local_num_threads;
+
+	    local_num_threads = strtol (optarg, &end, 10);
+	    if (end == optarg || *end != '\0' || local_num_threads < 1
+		|| local_num_threads > INT_MAX)
+	      fatal ("--threads: argument must be a positive integer");
+	    num_threads = (int)local_num_threads;
+	  }
+	  break;
 	case 'p':		/* Precision, ARG REQUIRED 	*/
 	  pflag = true;
 	  if (sscanf (optarg, "%d", &prec) <= 0)
@@ -127,6 +179,19 @@ main (int argc, char *argv[])
 
 	case 'A':		/* Adams-Moulton */
 	  algorithm = A_ADAMS_MOULTON;
+	  autostiff = false;
+	  if (optind >= argc)
+	    break;
+	  /* try to parse next arg as a float */
+	  if (sscanf (argv[optind], "%lf", &local_tstep) <= 0)
+	    break;
+	  tstep = local_tstep;
+	  optind++;	/* tell getopt we recognized timestep */
+	  conflag = true;
+	  break;
+	case 'D':		/* Dormand-Prince */
+	  algorithm = A_DORMAND_PRINCE;
+	  autostiff = false;
 	  if (optind >= argc)
 	    break;
 	  /* try to parse next arg as a float */
@@ -138,6 +203,7 @@ main (int argc, char *argv[])
 	  break;
 	case 'E':		/* Euler */
 	  algorithm = A_EULER;
+	  autostiff = false;
 	  conflag = true;
 	  tstep = 0.1;
 	  if (optind >= argc)
@@ -150,6 +216,20 @@ main (int argc, char *argv[])
 	  break;
 	case 'R':		/* Runge-Kutta-Fehlberg */
 	  algorithm = A_RUNGE_KUTTA_FEHLBERG;
+	  autostiff = false;
+	  if (optind >= argc)
+	    break;
+	  /* try to parse next arg as a float */
+	  if (sscanf (argv[optind], "%lf", &local_tstep) <= 0)
+	    break;
+	  tstep = local_tstep;
+	  optind++;	/* tell getopt we recognized timestep */
+	  conflag = true;
+	  break;
+
+	case 'S':		/* Rosenbrock, for stiff systems */
+	  algorithm = A_ROSENBROCK;
+	  autostiff = false;
 	  if (optind >= argc)
 	    break;
 	  /* try to parse next arg as a float */
@@ -251,9 +331,26 @@ main (int argc, char *argv[])
 
   if (algorithm == A_EULER && (eflag || rflag))
     fatal ("-E [Euler] illegal with -e or -r");
+  if (tflag && output_type != T_ASCII)
+    fatal ("-t [title] illegal with binary output");
+  if (ensemble_output != NULL && ensemble_file == NULL)
+    fatal ("--ensemble-output requires --ensemble");
+  if (ensemble_file != NULL && strcmp (ensemble_file, "-") == 0
+      && filename == NULL)
+    fatal ("--ensemble -: the equations must be read with -f");
+#ifndef ODE_THREADS
+  num_threads = 1;		/* no threads, so members are done in turn */
+#endif
+
+  /* Unless output is wanted in real time, or is going to a terminal,
+     buffer it heavily; it is flushed at the end of each dataset. */
+  if (!realtime && !isatty (fileno (stdout)))
+    setvbuf (stdout, NULL, _IOFBF, OUTPUT_BUFSIZE);
 
   /* DO IT */
 
+  if (ensemble_file != NULL)
+    read_ensemble (ensemble_file);
   if (filename != NULL)
     {
       infile = fopen (filename, "r");
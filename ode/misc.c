@@ -26,10 +26,11 @@ bool
 check (void)
 {
   struct sym *sp, *ivp, *prevp;
-  struct prt *pp;
+  struct prt *pp, **ppp;
   
   /*
-   * discard any previous entry for "(indep)"
+   * discard any previous entry for "(indep)", and any reference
+   * to it in the print queue
    */
   prevp = NULL;
   for (sp = symtab; sp != NULL; sp = sp->sy_link) 
@@ -40,6 +41,15 @@ check (void)
 	    symtab = sp->sy_link;
 	  else
 	    prevp->sy_link = sp->sy_link;
+	  for (ppp = &pqueue; *ppp != NULL; )
+	    if ((*ppp)->pr_sym == sp)
+	      {
+		pp = *ppp;
+		*ppp = pp->pr_link;
+		free ((void *)pp);
+	      }
+	    else
+	      ppp = &(*ppp)->pr_link;
 	  sfree(sp);
 	  break;
 	}
@@ -139,7 +149,6 @@ check (void)
 /*
  * set default values
  * determine step direction (forgive confused users)
- * initialize values for printq() and numerical routines
  */
 void
 defalt (void)
@@ -152,17 +161,6 @@ defalt (void)
     tstep = -tstep;
   else if (tstart<tstop && tstep<0)
     tstep = -tstep;
-  printnum = false;
-}
-
-/*
- * evaluate all the derivatives
- */
-void
-field(void)
-{
-  for (fsp = symtab->sy_link; fsp!=NULL; fsp = fsp->sy_link)
-    fsp->sy_prime = eval(fsp->sy_expr);
 }
 
 /*
@@ -184,58 +182,79 @@ panicn (const char *fmt, int n)
   exit (EXIT_FAILURE);
 }
 
-#define	LASTVAL (tstep>0 ? t>=tstop-0.0625*tstep : t<=tstop-0.0625*tstep)
-#define	TFROM	(tfrom - 0.0625*tstep)
-#define	PRFROM	(tstep>0 ? t >= TFROM : t<= TFROM)
+#define	LASTVAL (rp->r_tstep>0 ? t>=tstop-0.0625*rp->r_tstep \
+		 : t<=tstop-0.0625*rp->r_tstep)
+#define	TFROM	(tfrom - 0.0625*rp->r_tstep)
+#define	PRFROM	(rp->r_tstep>0 ? t >= TFROM : t<= TFROM)
 
+/*
+ * print the current values, if this is a step at which they're wanted
+ */
 void
-printq (void)
+printq (struct run *rp)
 {
-  double f = 0.0;
   double t;
+
+  t = rp->r_value[0];
+  if (!rp->r_printnum && PRFROM)
+    rp->r_printnum = true;
+  if (((rp->r_it % tevery == 0) && rp->r_printnum) || LASTVAL) 
+    print_row (rp);
+  if (rp->r_it == LONGMAX)
+    rp->r_it = 0;
+}
+
+/*
+ * print the items of the print queue, at the current values
+ */
+void
+print_row (struct run *rp)
+{
+  double f = 0.0;
   struct prt *pp;
+  int i;
+  FILE *out = rp->r_out;
 
-  t = symtab->sy_value;
-  if (!printnum && PRFROM)
-    printnum = true;
-  if (((it % tevery == 0) && printnum) || LASTVAL) 
-    {
-      pp = pqueue;
-      if (pp != NULL) 
-	for (;;) 
+  pp = pqueue;
+  if (pp != NULL) 
+    for (;;) 
+      {
+	i = pp->pr_sym->sy_index;
+	switch (pp->pr_which) 
 	  {
-	    switch (pp->pr_which) 
-	      {
-	      case P_VALUE:
-		f = pp->pr_sym->sy_value;
-		break;
-	      case P_PRIME:
-		f = pp->pr_sym->sy_prime;
-		break;
-	      case P_ACERR:
-		f = pp->pr_sym->sy_acerr;
-		break;
-	      case P_ABERR:
-		f = pp->pr_sym->sy_aberr;
-		break;
-	      case P_SSERR:
-		f = pp->pr_sym->sy_sserr;
-		break;
-	      default:
-		panicn ("bad cell spec (%d) in printq()", (int)(pp->pr_which));
-		break;
-	      }
-	    prval (f);
-	    pp = pp->pr_link;
-	    if (pp == NULL)
-	      break;
-	    putchar (' ');
+	  case P_VALUE:
+	    f = rp->r_value[i];
+	    break;
+	  case P_PRIME:
+	    f = rp->r_prime[i];
+	    break;
+	  case P_ACERR:
+	    f = rp->r_acerr[i];
+	    break;
+	  case P_ABERR:
+	    f = rp->r_aberr[i];
+	    break;
+	  case P_SSERR:
+	    f = rp->r_sserr[i];
+	    break;
+	  default:
+	    panicn ("bad cell spec (%d) in printq()", (int)(pp->pr_which));
+	    break;
 	  }
-      putchar ('\n');
-      fflush (stdout);
-    }
-  if (it == LONGMAX)
-    it = 0;
+	if (output_type == T_ASCII)
+	  fprval (out, f);
+	else
+	  fbinval (out, f);
+	pp = pp->pr_link;
+	if (pp == NULL)
+	  break;
+	if (output_type == T_ASCII)
+	  putc (' ', out);
+      }
+  if (output_type == T_ASCII)
+    putc ('\n', out);
+  if (realtime && out == stdout)
+    fflush (out);
 }
 
 /*
@@ -244,22 +263,79 @@ printq (void)
  */
 void
 prval (double x)
+{
+  fprval (stdout, x);
+}
+
+void
+fprval (FILE *fp, double x)
 {
   if (prec < 0) 
     {
       char outbuf[20];
       if (x < 0) 
 	{
-	  putchar ('-');
+	  putc ('-', fp);
 	  x = -x;
 	}
       sprintf (outbuf, "%.7g", x);
       if (*outbuf == '.')
-	putchar ('0');
-      printf ("%s", outbuf);
+	putc ('0', fp);
+      fputs (outbuf, fp);
   } 
   else
-    printf ("%*.*e", fwd, prec, x);
+    fprintf (fp, "%*.*e", fwd, prec, x);
+}
+
+/*
+ * write a value in binary, in the format that graph -I d (or -I f) reads
+ */
+void
+fbinval (FILE *fp, double x)
+{
+  if (output_type == T_SINGLE)
+    {
+      float fx = x;
+
+      if (fx == FLT_MAX)
+	fx *= 0.99999;		/* FLT_MAX would end the dataset */
+      fwrite ((void *) &fx, sizeof (fx), 1, fp);
+    }
+  else
+    {
+      if (x == DBL_MAX)
+	x *= 0.99999;		/* DBL_MAX would end the dataset */
+      fwrite ((void *) &x, sizeof (x), 1, fp);
+    }
+}
+
+/*
+ * end a dataset: with a blank line, or in binary, a DBL_MAX (or FLT_MAX)
+ */
+void
+enddataset (FILE *fp)
+{
+  switch (output_type)
+    {
+    case T_ASCII:
+    default:
+      putc ('\n', fp);
+      break;
+    case T_SINGLE:
+      {
+	float fdummy = FLT_MAX;
+
+	fwrite ((void *) &fdummy, sizeof (fdummy), 1, fp);
+      }
+      break;
+    case T_DOUBLE:
+      {
+	double ddummy = DBL_MAX;
+
+	fwrite ((void *) &ddummy, sizeof (ddummy), 1, fp);
+      }
+      break;
+    }
 }
 
 /*
@@ -310,37 +386,23 @@ matherr (struct exception *x)
 
 /*
  * print a diagnostic for run-time errors.
- * uses fsp to decide which dependent variable was being worked
+ * uses the current run to decide which dependent variable
+ * (and which member of an ensemble) was being worked on
  */
 void
 rterror (const char *s)
 {
-  if (fsp == NULL)		/* no computation, just print message */
-    fprintf (stderr, "%s: %s\n", progname, s);
-  else
-    {
-      fprintf (stderr, "%s: %s while calculating %.*s'\n", progname, s,
-	       NAMMAX, fsp->sy_name);
-      longjmp (mark, 1);	/* interrupt computation */
-    }
+  rterrors ("%s", s);
 }
 
 void
 rterrors (const char *fmt, const char *s)
 {
-  if (fsp != NULL)		/* interrupt computation */
-    {
-      fprintf (stderr, "%s: ", progname);
-      fprintf (stderr, fmt, s);
-      fprintf (stderr, " while calculating %.*s'\n", NAMMAX, fsp->sy_name);
-      longjmp (mark, 1);
-    }
-  else				/* just print error message */
-    {
-      fprintf (stderr, "%s: ", progname);
-      fprintf (stderr, fmt, s);
-      fprintf (stderr, "\n");
-    }
+  struct run *rp = current_run ();
+
+  rtsquawks (fmt, s);
+  if (rp != NULL)		/* interrupt computation */
+    longjmp (rp->r_mark, 1);
 }
 
 /*
@@ -350,12 +412,36 @@ rterrors (const char *fmt, const char *s)
 void
 rtsquawks (const char *fmt, const char *s)
 {
+  struct run *rp = current_run ();
+
+#ifdef ODE_THREADS
+  flockfile (stderr);
+#endif
+  if (rp != NULL)
+    fflush (rp->r_out);		/* so it precedes the message */
   fprintf (stderr, "%s: ", progname);
   fprintf (stderr, fmt, s);
-  if (fsp != NULL)
-    fprintf (stderr, " while calculating %.*s'", NAMMAX, fsp->sy_name);
+  if (rp != NULL)
+    rtwhere (rp, rp->r_fsp ? rp->r_fsp->sy_name : NULL);
+  else
+    fprintf (stderr, "\n");
+#ifdef ODE_THREADS
+  funlockfile (stderr);
+#endif
+}
+
+/*
+ * finish a diagnostic: say which variable, if any, and which member
+ * of an ensemble
+ */
+void
+rtwhere (const struct run *rp, const char *name)
+{
+  if (name != NULL)
+    fprintf (stderr, " while calculating %.*s'", NAMMAX, name);
+  if (rp->r_member > 0)
+    fprintf (stderr, " in ensemble member %d", rp->r_member);
   fprintf (stderr, "\n");
-  return;
 }
 
 /*
@@ -367,53 +453,130 @@ rtsquawks (const char *fmt, const char *s)
 void
 solve (void)
 {
+  struct run *rp;
   struct sym *sp;
-  bool adapt;
-  
+  int i;
+
+  if (ensemble != NULL)
+    declare_ensemble ();
   if (check() == false)
     return;
+  compile (algorithm == A_ROSENBROCK || autostiff);
   defalt ();
-  if (tflag)
-    title ();
 
   fflush (stderr);
   setflt ();
-  if (!setjmp (mark)) 
+  if (ensemble != NULL)
+    solve_ensemble ();
+  else
+    {
+      rp = new_run (0, stdout);
+      integrate (rp);
+
+      /* the next step statement carries on from here */
+      tstep = rp->r_tstep;
+      for (i = 0, sp = symtab; sp != NULL; sp = sp->sy_link, i++)
+	{
+	  sp->sy_value = rp->r_val[0][i];
+	  sp->sy_prime = rp->r_pri[0][i];
+	  sp->sy_sserr = rp->r_sserr[i];
+	  sp->sy_aberr = rp->r_aberr[i];
+	  sp->sy_acerr = rp->r_acerr[i];
+	}
+      free_run (rp);
+    }
+  resetflt();
+}
+
+/*
+ * integrate from tstart to tstop with the chosen scheme, and print
+ */
+void
+integrate (struct run *rp)
+{
+  bool adapt;
+
+  if (tflag)
+    title (rp);
+
+  set_current_run (rp);
+  if (!setjmp (rp->r_mark)) 
     {
       adapt = eflag|rflag|!conflag ? true : false;
       if (tstart == tstop)
-	trivial();
+	trivial (rp);
       else switch (algorithm)
 	{
 	case A_EULER:
-	  eu();
+	  eu (rp);
 	  break;
 	case A_ADAMS_MOULTON:
 	  if (adapt || prerr)
-	    ama();
+	    ama (rp);
 	  else
-	    am();
+	    am (rp);
+	  break;
+	case A_DORMAND_PRINCE:
+	  dp (rp);
+	  break;
+	case A_ROSENBROCK:
+	  rp->r_it = 0;
+	  rosenbrock (rp, tstart, conflag);
 	  break;
 	case A_RUNGE_KUTTA_FEHLBERG:
 	default:
 	  if (adapt || prerr)
-	    rka();
+	    rka (rp);
 	  else
-	    rk();
+	    rk (rp);
 	  break;
 	}
     }
-  resetflt();
+  set_current_run (NULL);
 
-  /* add final newline (to aid realtime postprocessing of dataset by graph) */
-  putchar ('\n');
-  fflush (stdout);
+  /* end the dataset (to aid realtime postprocessing of dataset by graph),
+     and flush it */
+  enddataset (rp->r_out);
+  fflush (rp->r_out);
+}
 
-  for (sp = symtab; sp != NULL; sp = sp->sy_link) 
-    {
-      sp->sy_prime = sp->sy_pri[0];
-      sp->sy_value = sp->sy_val[0];
-    }
+/*
+ * would integrate() use the fixed-step Runge-Kutta scheme, which (alone)
+ * can take the members of an ensemble in lockstep?  Not if there are
+ * events to look for, since each member finds its own.
+ */
+bool
+fixed_step_rk (void)
+{
+  return (algorithm == A_RUNGE_KUTTA_FEHLBERG && tstart != tstop
+	  && !(eflag || rflag || !conflag || prerr)
+	  && evexpr[EV_UNTIL] == NULL && evexpr[EV_EVENT] == NULL);
+}
+
+/*
+ * integrate members of an ensemble in lockstep, from tstart to tstop,
+ * with the fixed-step Runge-Kutta scheme, and print
+ */
+void
+integrate_lanes (struct lanes *lp)
+{
+  int l;
+
+  if (tflag)
+    for (l = 0; l < LANES; l++)
+      if (lp->l_run[l] != NULL)
+	title (lp->l_run[l]);
+
+  /* run-time errors are reported lane by lane (see execute_lanes) */
+  set_current_run (NULL);
+  rk_lanes (lp);
+
+  for (l = 0; l < LANES; l++)
+    if (lp->l_run[l] != NULL)
+      {
+	enddataset (lp->l_run[l]->r_out);
+	fflush (lp->l_run[l]->r_out);
+      }
 }
 
 /* 
@@ -440,7 +603,7 @@ startstep (void)
  * Try to center the headings over the columns
  */
 void
-title (void)
+title (struct run *rp)
 {
   struct prt *pp;
   char tag = '\0';
@@ -470,11 +633,11 @@ title (void)
 	    panicn ("bad cell spec (%d) in title()", (int)(pp->pr_which));
 	    break;
 	  }
-	printf (" %*.*s%c", fwd - 2, NAMMAX, pp->pr_sym->sy_name, tag);
+	fprintf (rp->r_out, " %*.*s%c", fwd - 2, NAMMAX, pp->pr_sym->sy_name,
+		 tag);
 	if ((pp=pp->pr_link) == NULL)
 	  break;
-	putchar (' ');
+	putc (' ', rp->r_out);
       }
-  putchar ('\n');
-  fflush (stdout);
+  putc ('\n', rp->r_out);
 }
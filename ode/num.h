@@ -38,3 +38,48 @@
 #define C62     -1.38167641325536062378 /* -3544/2565   */
 #define C63     .45297270955165692007   /* 1859/4104    */
 #define C64     -.27500000000000000000  /* -11/40       */
+
+/*
+ * Constants used in the Dormand-Prince 5(4) routine (dp.c).  DB* are the
+ * weights of the fifth-order solution, DE* the differences between them
+ * and the weights of the embedded fourth-order one, and DD* the weights
+ * of the dense output (Hairer, Norsett & Wanner, "Solving Ordinary
+ * Differential Equations I", 2nd ed., 1993, pp. 178 and 191-192).
+ */
+
+#define DC2t    .20000000000000000000   /* 1/5          */
+#define DC20    .20000000000000000000   /* 1/5          */
+#define DC3t    .30000000000000000000   /* 3/10         */
+#define DC30    .07500000000000000000   /* 3/40         */
+#define DC31    .22500000000000000000   /* 9/40         */
+#define DC4t    .80000000000000000000   /* 4/5          */
+#define DC40    .97777777777777777778   /* 44/45        */
+#define DC41    -3.73333333333333333333 /* -56/15       */
+#define DC42    3.55555555555555555556  /* 32/9         */
+#define DC5t    .88888888888888888889   /* 8/9          */
+#define DC50    2.95259868922420362750  /* 19372/6561   */
+#define DC51    -11.595793324188385917  /* -25360/2187  */
+#define DC52    9.82289285169943606158  /* 64448/6561   */
+#define DC53    -.29080932784636488340  /* -212/729     */
+#define DC60    2.84627525252525252525  /* 9017/3168    */
+#define DC61    -10.757575757575757576  /* -355/33      */
+#define DC62    8.90642271774347246045  /* 46732/5247   */
+#define DC63    .27840909090909090909   /* 49/176       */
+#define DC64    -.27353130360205831904  /* -5103/18656  */
+#define DB0     .09114583333333333333   /* 35/384       */
+#define DB2     .44923629829290206649   /* 500/1113     */
+#define DB3     .65104166666666666667   /* 125/192      */
+#define DB4     -.32237617924528301887  /* -2187/6784   */
+#define DB5     .13095238095238095238   /* 11/84        */
+#define DE0     .00123263888888888889   /* 71/57600     */
+#define DE2     -.00425277029050613956  /* -71/16695    */
+#define DE3     .03697916666666666667   /* 71/1920      */
+#define DE4     -.05086379716981132075  /* -17253/339200 */
+#define DE5     .04190476190476190476   /* 22/525       */
+#define DE6     -.02500000000000000000  /* -1/40        */
+#define DD0     -1.12701756538628346728 /* -12715105075/11282082432 */
+#define DD2     2.67542448435159794642  /* 87487479700/32700410799 */
+#define DD3     -5.68552696158850401848 /* -10690763975/1880347072 */
+#define DD4     3.52193236792079137636  /* 701980252875/199316789632 */
+#define DD5     -1.76728125707574539880 /* -1453857185/822651844 */
+#define DD6     2.38246893177814356179  /* 69997945/29380423 */
@@ -12,6 +12,15 @@
 
 #include <setjmp.h>
 
+/* Members of an ensemble (see --ensemble) may be integrated on several
+   threads. */
+#ifdef HAVE_PTHREAD_H
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#define ODE_THREADS
+#endif
+#endif
+
 #define NAMMAX  32      /* size of identifiers */
 #define KMAX    7       /* size of k vector */
 #define PASTMAX 7       /* size of history vector */
@@ -23,17 +32,15 @@ struct sym
 {
   char    sy_name[NAMMAX];
   double  sy_value;
-  double  sy_val[PASTMAX];
   double  sy_prime;
-  double  sy_pri[PASTMAX];
-  double  sy_predi;		/* predictor value */
   double  sy_sserr;		/* relative single step error */
   double  sy_aberr;		/* absolute single step error */
   double  sy_acerr;		/* accumulated error */
-  double  sy_k[KMAX];
   int     sy_flags;
+  int     sy_index;		/* number of the symbol (see compile) */
   struct  expr    *sy_expr;
   struct  sym     *sy_link;
+  struct  sym     *sy_hash;	/* next symbol in its hash chain (sym.c) */
 };
 
 /*
@@ -53,6 +60,16 @@ typedef enum
   P_VALUE, P_PRIME, P_SSERR, P_ACERR, P_ABERR
 } ent_cell;
 
+/*
+ * conditions given by `until' and `event' statements: the run stops,
+ * or a line is printed, where the condition's value changes sign
+ */
+typedef enum
+{
+  EV_UNTIL, EV_EVENT
+} event_type;
+#define NEVENTS 2
+
 /*
  * the print queue is made
  * of these
@@ -102,12 +119,117 @@ struct expr
   struct expr    *ex_next;
 };
 
+/*
+ * an instruction in the compiled form of the differential equations:
+ * apply in_oper to registers in_a, in_b, in_c (as many as it takes),
+ * and put the result in register in_dst
+ */
+struct insn
+{
+  op_type        in_oper;
+  int            in_dst;
+  int            in_a, in_b, in_c;
+};
+
+/*
+ * the instructions [eq_start, eq_end) compute the derivative of the
+ * symbol with sy_index eq_index, leaving it in register eq_result;
+ * [eq_vstart, eq_vend) of the time-varying code are those of them whose
+ * results can change from one call of field() to the next
+ */
+struct eqn
+{
+  int            eq_index;
+  int            eq_start, eq_end;
+  int            eq_vstart, eq_vend;
+  int            eq_result;
+};
+
+/*
+ * The state of one integration: everything that the numerical routines
+ * change as they go.  Each member of an ensemble gets one of its own.
+ * The values and derivatives of the symbols are kept in arrays, one per
+ * quantity, indexed by symbol number (sy_index): the independent
+ * variable is number 0, and the dependent variables 1 to r_nsyms - 1.
+ */
+struct run
+{
+  int            r_nsyms;	/* number of symbols */
+  double         *r_value;	/* current values (the first registers) */
+  double         *r_prime;	/* ... and derivatives */
+  double         *r_val[PASTMAX]; /* values at the last steps, latest first */
+  double         *r_pri[PASTMAX]; /* ... and derivatives */
+  double         *r_k[KMAX];	/* stages of the Runge-Kutta schemes */
+  double         *r_predi;	/* predicted values */
+  double         *r_sserr;	/* relative single step errors */
+  double         *r_aberr;	/* absolute single step errors */
+  double         *r_acerr;	/* accumulated errors */
+  const struct sym *r_fsp;	/* variable whose derivative is being found */
+  double         *r_reg;	/* registers for the compiled equations */
+  bool           r_hoisted;	/* ... are their time-invariant ones set? */
+  double         r_tstep;	/* current step size */
+  long           r_it;		/* step counter */
+  bool           r_printnum;	/* past tfrom yet? */
+  double         r_ssemax, r_abemax, r_acemax; /* largest errors */
+  char           *r_ssenam, *r_abenam, *r_acenam; /* ... and where */
+  int            r_member;	/* number of ensemble member, or 0 */
+  FILE           *r_out;	/* output stream */
+  struct stiff   *r_stiff;	/* matrices of the stiff solver (ros.c) */
+  struct events  *r_events;	/* the last point, for finding events */
+  jmp_buf        r_mark;	/* run-time errors jump here */
+};
+
+/*
+ * Members of an ensemble integrated in lockstep, by the fixed-step
+ * Runge-Kutta scheme: one run of each for its output and diagnostics,
+ * and arrays like those of a run, but with the members' values side by
+ * side, so that the value of symbol i for member l is l_reg[i*LANES+l].
+ * The same instruction is applied to all the lanes at once.  Lanes with
+ * no member, or whose member has had a run-time error, are not live;
+ * they are computed with the others, but never printed.
+ */
+#define LANES 8
+
+struct lanes
+{
+  int            l_nsyms;	/* number of symbols */
+  struct run     *l_run[LANES];	/* the members' runs (NULL if none) */
+  bool           l_live[LANES];	/* ... and whether to carry on with them */
+  double         *l_reg;	/* registers; the first are the values */
+  bool           l_hoisted;	/* ... are their time-invariant ones set? */
+  double         *l_prime;	/* derivatives */
+  double         *l_val0, *l_pri0; /* values and derivatives at the step */
+  double         *l_k[4];	/* stages */
+};
+
+/*
+ * a table of initial values and constants (see --ensemble), one row
+ * per member of the ensemble
+ */
+struct ensemble
+{
+  int            en_ncols, en_nrows;
+  char           (*en_names)[NAMMAX]; /* a symbol for each column */
+  double         *en_values;	/* en_nrows rows of en_ncols values */
+  bool           en_solved;	/* solved at least once (by a step)? */
+};
+
 /* integration algorithm type */
 typedef enum 
 { 
-  A_EULER, A_ADAMS_MOULTON, A_RUNGE_KUTTA_FEHLBERG
+  A_EULER, A_ADAMS_MOULTON, A_RUNGE_KUTTA_FEHLBERG, A_DORMAND_PRINCE,
+  A_ROSENBROCK
 } integration_type;
 
+/* output format type */
+typedef enum
+{
+  T_ASCII, T_SINGLE, T_DOUBLE
+} data_type;
+
+/* size of stdout's buffer, when not writing in real time */
+#define OUTPUT_BUFSIZE (64 * 1024)
+
 /*
  * misc. consts
  */
@@ -118,7 +240,10 @@ typedef enum
 #define        HMAX    (0.5)	/* Maximum step size */
 #define        LONGMAX (2147483647) /* 2^31-1 */
 #define        MESH    (2)
-#define        STOPR   (tstep>0 ? \
-                        t-0.0625*tstep>=tstop : t-0.0625*tstep<=tstop )
-#define        STOPA   (tstep>0 ? \
-                        t+0.9375*tstep>=tstop : t+0.9375*tstep<=tstop )
+#define        STOPR(h) ((h)>0 ? \
+                        t-0.0625*(h)>=tstop : t-0.0625*(h)<=tstop )
+#define        STOPA(h) ((h)>0 ? \
+                        t+0.9375*(h)>=tstop : t+0.9375*(h)<=tstop )
+/* is y an integer power that is found by multiplication (ipow)? */
+#define        IPOWMAX (16)
+#define        IS_IPOW(y) (fabs (y) <= IPOWMAX && (y) == (int)(y))
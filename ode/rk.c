@@ -17,51 +17,123 @@
 #include "extern.h"
 
 void
-rk (void)
+rk (struct run *rp)
 {
+  int i, n = rp->r_nsyms;
+  double *value = rp->r_value, *prime = rp->r_prime;
+  double *val0 = rp->r_val[0], *pri0 = rp->r_pri[0];
+  double *k0 = rp->r_k[0], *k1 = rp->r_k[1], *k2 = rp->r_k[2];
+  double *k3 = rp->r_k[3];
   double t;
-  double halfstep = HALF * tstep;
+  double halfstep = HALF * rp->r_tstep;
   double onesixth = 1.0 / 6.0;
 
-  for (it = 0, t = tstart; !STOPR; t = tstart + (++it) * tstep) 
+  for (rp->r_it = 0, t = tstart; !STOPR(rp->r_tstep);
+       t = tstart + (++rp->r_it) * rp->r_tstep) 
     {
-      symtab->sy_val[0] = symtab->sy_value = t;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      val0[0] = value[0] = t;
+      field (rp);
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_val[0] = fsp->sy_value;
-	  fsp->sy_pri[0] = fsp->sy_prime;
+	  val0[i] = value[i];
+	  pri0[i] = prime[i];
 	}
       /* output */
-      printq();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link)   
+      if (events (rp))
+	return;
+      printq (rp);
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_k[0] = tstep * fsp->sy_prime;
-	  fsp->sy_value = fsp->sy_val[0] + HALF * fsp->sy_k[0];
+	  k0[i] = rp->r_tstep * prime[i];
+	  value[i] = val0[i] + HALF * k0[i];
 	}
-      symtab->sy_value = t + halfstep;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link)   
+      value[0] = t + halfstep;
+      field (rp);
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_k[1] = tstep * fsp->sy_prime;
-	  fsp->sy_value = fsp->sy_val[0] + HALF * fsp->sy_k[1];
+	  k1[i] = rp->r_tstep * prime[i];
+	  value[i] = val0[i] + HALF * k1[i];
 	}
-      symtab->sy_value = t + halfstep;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link)   
+      value[0] = t + halfstep;
+      field (rp);
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_k[2] = tstep * fsp->sy_prime;
-	  fsp->sy_value = fsp->sy_val[0] + fsp->sy_k[2];
+	  k2[i] = rp->r_tstep * prime[i];
+	  value[i] = val0[i] + k2[i];
 	}
-      symtab->sy_value = t + tstep;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link)
-	fsp->sy_k[3] = tstep * fsp->sy_prime;
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link)
-	fsp->sy_value = fsp->sy_val[0] 
-	  + onesixth * (fsp->sy_k[0]
-			+ TWO * fsp->sy_k[1]
-			+ TWO * fsp->sy_k[2]
-			+ fsp->sy_k[3]);
+      value[0] = t + rp->r_tstep;
+      field (rp);
+      for (i = 1; i < n; i++)
+	k3[i] = rp->r_tstep * prime[i];
+      for (i = 1; i < n; i++)
+	value[i] = val0[i]
+	  + onesixth * (k0[i]
+			+ TWO * k1[i]
+			+ TWO * k2[i]
+			+ k3[i]);
+    }
+}
+
+/*
+ * the same, for members of an ensemble in lockstep (see struct lanes)
+ */
+void
+rk_lanes (struct lanes *lp)
+{
+  int j, l, n = lp->l_nsyms * LANES;
+  double *value = lp->l_reg, *prime = lp->l_prime;
+  double *val0 = lp->l_val0, *pri0 = lp->l_pri0;
+  double *k0 = lp->l_k[0], *k1 = lp->l_k[1], *k2 = lp->l_k[2];
+  double *k3 = lp->l_k[3];
+  double t, step = tstep;
+  double halfstep = HALF * step;
+  double onesixth = 1.0 / 6.0;
+  long it;
+
+  for (it = 0, t = tstart; !STOPR(step); t = tstart + (++it) * step)
+    {
+      for (l = 0; l < LANES; l++)
+	val0[l] = value[l] = t;
+      field_lanes (lp);
+      for (j = LANES; j < n; j++)
+	{
+	  val0[j] = value[j];
+	  pri0[j] = prime[j];
+	}
+      /* output */
+      if (!print_lanes (lp, it))
+	break;			/* every member has stopped */
+      for (j = LANES; j < n; j++)
+	{
+	  k0[j] = step * prime[j];
+	  value[j] = val0[j] + HALF * k0[j];
+	}
+      for (l = 0; l < LANES; l++)
+	value[l] = t + halfstep;
+      field_lanes (lp);
+      for (j = LANES; j < n; j++)
+	{
+	  k1[j] = step * prime[j];
+	  value[j] = val0[j] + HALF * k1[j];
+	}
+      for (l = 0; l < LANES; l++)
+	value[l] = t + halfstep;
+      field_lanes (lp);
+      for (j = LANES; j < n; j++)
+	{
+	  k2[j] = step * prime[j];
+	  value[j] = val0[j] + k2[j];
+	}
+      for (l = 0; l < LANES; l++)
+	value[l] = t + step;
+      field_lanes (lp);
+      for (j = LANES; j < n; j++)
+	k3[j] = step * prime[j];
+      for (j = LANES; j < n; j++)
+	value[j] = val0[j]
+	  + onesixth * (k0[j]
+			+ TWO * k1[j]
+			+ TWO * k2[j]
+			+ k3[j]);
     }
 }
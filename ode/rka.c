@@ -17,124 +17,168 @@
 #include "extern.h"
 #include "num.h"
 
-#define T_LT_TSTOP (tstep>0 ? t<tstop : t>tstop)
+#define T_LT_TSTOP (rp->r_tstep>0 ? t<tstop : t>tstop)
+
+/* If no scheme was asked for, switch to the stiff solver (ros.c) after
+   this many steps in a row whose size times the estimated largest
+   eigenvalue of the Jacobian is near the edge of the stability region
+   (which crosses the real axis at about -3.7), since the step size is
+   then being kept down by stability rather than accuracy. */
+#define STIFF_HRHO   1.5
+#define STIFF_STEPS  15
 
 void
-rka (void)
+rka (struct run *rp)
 {
+  int i, n = rp->r_nsyms;
+  double *value = rp->r_value, *prime = rp->r_prime;
+  double *val0 = rp->r_val[0], *pri0 = rp->r_pri[0];
+  double *predi = rp->r_predi;
+  double *sserr = rp->r_sserr, *aberr = rp->r_aberr;
+  double *k0 = rp->r_k[0], *k1 = rp->r_k[1], *k2 = rp->r_k[2];
+  double *k3 = rp->r_k[3], *k4 = rp->r_k[4], *k5 = rp->r_k[5];
+  double *y5 = rp->r_k[6];	/* the fifth stage's point */
   bool gdval = true; 		/* good value to print ? */
   int overtime = 1;
+  int nstiff = 0;		/* stiff-looking steps in a row */
   double prevstep = 0.0;
   double t;
 
-  for (it = 0, t = tstart; T_LT_TSTOP || overtime--; ) 
+  for (rp->r_it = 0, t = tstart; T_LT_TSTOP || overtime--; ) 
     {
-      symtab->sy_value = symtab->sy_val[0] = t;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      value[0] = val0[0] = t;
+      field (rp);
+      for (i = 1; i < n; i++)
+	{
+	  val0[i] = value[i];
+	  pri0[i] = prime[i];
+	}
+      if (autostiff && !conflag && gdval && rp->r_it > 0 && T_LT_TSTOP)
 	{
-	  fsp->sy_val[0] = fsp->sy_value;
-	  fsp->sy_pri[0] = fsp->sy_prime;
+	  double num = 0.0, den = 0.0, d;
+
+	  /* compare the field at the new point and at the fifth stage */
+	  for (i = 1; i < n; i++)
+	    {
+	      d = rp->r_tstep * prime[i] - k4[i];
+	      num += d * d;
+	      d = value[i] - y5[i];
+	      den += d * d;
+	    }
+	  if (num > STIFF_HRHO * STIFF_HRHO * den && den > 0.0)
+	    nstiff++;
+	  else
+	    nstiff = 0;
+	  if (nstiff >= STIFF_STEPS)
+	    {
+	      rosenbrock (rp, t, false);
+	      return;
+	    }
 	}
       if (gdval)
-	printq();       /* output */
-      if (tstep * (t+tstep-tstop) > 0)
-	tstep = tstop - t;
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
 	{
-	  fsp->sy_k[0] = tstep * fsp->sy_prime;
-	  fsp->sy_value = fsp->sy_val[0] 
-	    + C20 * fsp->sy_k[0];
+	  if (events (rp))
+	    return;
+	  printq (rp);		/* output */
+	}
+      if (rp->r_tstep * (t+rp->r_tstep-tstop) > 0)
+	rp->r_tstep = tstop - t;
+      for (i = 1; i < n; i++)
+	{
+	  k0[i] = rp->r_tstep * prime[i];
+	  value[i] = val0[i]
+	    + C20 * k0[i];
 	}
-      symtab->sy_value = t + C2t * tstep;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      value[0] = t + C2t * rp->r_tstep;
+      field (rp);
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_k[1] = tstep * fsp->sy_prime;
-	  fsp->sy_value = fsp->sy_val[0] 
-	    + (C30 * fsp->sy_k[0]
-	       + C31 * fsp->sy_k[1]);
+	  k1[i] = rp->r_tstep * prime[i];
+	  value[i] = val0[i]
+	    + (C30 * k0[i]
+	       + C31 * k1[i]);
 	}
-      symtab->sy_value = t + C3t * tstep;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      value[0] = t + C3t * rp->r_tstep;
+      field (rp);
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_k[2] = tstep * fsp->sy_prime;
-	  fsp->sy_value = fsp->sy_val[0] 
-	    + (C40 * fsp->sy_k[0]
-	       + C41 * fsp->sy_k[1]
-	       + C42 * fsp->sy_k[2]);
+	  k2[i] = rp->r_tstep * prime[i];
+	  value[i] = val0[i]
+	    + (C40 * k0[i]
+	       + C41 * k1[i]
+	       + C42 * k2[i]);
 	}
-      symtab->sy_value = t + C4t * tstep;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      value[0] = t + C4t * rp->r_tstep;
+      field (rp);
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_k[3] = tstep * fsp->sy_prime;
-	  fsp->sy_value = fsp->sy_val[0] 
-	    + (C50 * fsp->sy_k[0]
-	       + C51 * fsp->sy_k[1]
-	       + C52 * fsp->sy_k[2]
-	       + C53 * fsp->sy_k[3]);
+	  k3[i] = rp->r_tstep * prime[i];
+	  value[i] = val0[i]
+	    + (C50 * k0[i]
+	       + C51 * k1[i]
+	       + C52 * k2[i]
+	       + C53 * k3[i]);
 	}
-      symtab->sy_value = t + tstep;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      value[0] = t + rp->r_tstep;
+      field (rp);
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_k[4] = tstep * fsp->sy_prime;
-	  fsp->sy_value = fsp->sy_val[0]
-	    + (C60 * fsp->sy_k[0]
-	       + C61 * fsp->sy_k[1]
-	       + C62 * fsp->sy_k[2]
-	       + C63 * fsp->sy_k[3]
-	       + C64 * fsp->sy_k[4]);
+	  k4[i] = rp->r_tstep * prime[i];
+	  y5[i] = value[i];
+	  value[i] = val0[i]
+	    + (C60 * k0[i]
+	       + C61 * k1[i]
+	       + C62 * k2[i]
+	       + C63 * k3[i]
+	       + C64 * k4[i]);
 	}
-      symtab->sy_value = t + C6t * tstep;
-      field();
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link)
-	fsp->sy_k[5] = tstep * fsp->sy_prime;
-      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link) 
+      value[0] = t + C6t * rp->r_tstep;
+      field (rp);
+      for (i = 1; i < n; i++)
+	k5[i] = rp->r_tstep * prime[i];
+      for (i = 1; i < n; i++)
 	{
-	  fsp->sy_predi = fsp->sy_val[0] 
-	    + (A0 * fsp->sy_k[0]
-	       + A2 * fsp->sy_k[2]
-	       + A3 * fsp->sy_k[3]
-	       + A4 * fsp->sy_k[4]);
-	  fsp->sy_value = fsp->sy_val[0] 
-	    + (B0 * fsp->sy_k[0]
-	       + B2 * fsp->sy_k[2]
-	       + B3 * fsp->sy_k[3]
-	       + B4 * fsp->sy_k[4]
-	       + B5 * fsp->sy_k[5]);
-	  if (fsp->sy_value != 0.0)
-	    fsp->sy_sserr = fabs(1.0 - fsp->sy_predi / fsp->sy_value);
-	  fsp->sy_aberr = fabs(fsp->sy_value - fsp->sy_predi);
+	  predi[i] = val0[i]
+	    + (A0 * k0[i]
+	       + A2 * k2[i]
+	       + A3 * k3[i]
+	       + A4 * k4[i]);
+	  value[i] = val0[i]
+	    + (B0 * k0[i]
+	       + B2 * k2[i]
+	       + B3 * k3[i]
+	       + B4 * k4[i]
+	       + B5 * k5[i]);
+	  if (value[i] != 0.0)
+	    sserr[i] = fabs(1.0 - predi[i] / value[i]);
+	  aberr[i] = fabs(value[i] - predi[i]);
 	}
 
       if (!conflag && T_LT_TSTOP) 
 	{
-	  maxerr();
-	  if (hierror()) 
+	  maxerr (rp);
+	  if (hierror (rp)) 
 	    {
-	      tstep *= HALF;
-	      for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link)
-		fsp->sy_value = fsp->sy_val[0];
+	      rp->r_tstep *= HALF;
+	      for (i = 1; i < n; i++)
+		value[i] = val0[i];
 	      gdval = false;
 	      continue;
 	    }
 	  else 
-	    if (lowerror() && prevstep != tstep) 
+	    if (lowerror (rp) && prevstep != rp->r_tstep) 
 	      {
-		prevstep = tstep; /* prevent infinite loops */
-		tstep *= TWO;
-		for (fsp = dqueue; fsp != NULL; fsp = fsp->sy_link)
-		  fsp->sy_value = fsp->sy_val[0];
+		prevstep = rp->r_tstep; /* prevent infinite loops */
+		rp->r_tstep *= TWO;
+		for (i = 1; i < n; i++)
+		  value[i] = val0[i];
 		gdval = false;
 		continue;
 	      }
 	}
       gdval = true;
       prevstep = 0.0;
-      ++it;
-      t += tstep; /* the roundoff error is gross */
+      ++rp->r_it;
+      t += rp->r_tstep; /* the roundoff error is gross */
     }
 }
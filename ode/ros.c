@@ -0,0 +1,516 @@
+/* This file is part of the GNU plotutils package. */
+
+/*
+ * Copyright (C) 2008, Free Software Foundation, Inc.
+ */
+
+/*
+ * Rosenbrock method for stiff systems, with adaptive step size
+ *
+ * This is the L-stable second-order Rosenbrock (W-) method of Shampine
+ * and Reichelt ("The MATLAB ODE Suite", SIAM J. Sci. Comput. 18, 1997),
+ * with a third-order error estimate.  Each step solves three linear
+ * systems with the matrix W = I - h*D*J, where J is the Jacobian of the
+ * field (see jacobian() in code.c).  W is stored and factored as a band
+ * matrix if the Jacobian is narrowly banded, and as a dense matrix
+ * otherwise.  A dependent variable whose derivative depends on none of
+ * them (e.g. a constant) is left out of W, since its row of W is that
+ * of the identity matrix.
+ */
+
+#include "sys-defines.h"
+#include "ode.h"
+#include "extern.h"
+
+#define D       .29289321881345247560   /* 1/(2+sqrt(2)) */
+#define E32     7.41421356237309504880  /* 6+sqrt(2)     */
+
+#define T_LT_TSTOP (h>0 ? t<tstop : t>tstop)
+/* is an output time at or too close to tstop to be printed separately? */
+#define NEARSTOP(tout) (dt>0 ? (tout)>=tstop-0.0625*dt \
+			: (tout)<=tstop-0.0625*dt)
+#define PASTSTEP(tout) (dt>0 ? (tout)>tnew : (tout)<tnew)
+
+#define SAFETY  0.9		/* aim below the error bound */
+#define FACMIN  0.2		/* most the step size may shrink at once */
+#define FACMAX  5.0		/* most the step size may grow at once */
+
+/* The relative error of a variable is measured against the larger of
+   its sizes before and after the step, or this fraction of the size of
+   the largest variable if that is larger.  A variable growing from zero
+   like t^3 has a relative error of the order of 1 after a step of any
+   size under a second-order method, and would otherwise stop the run. */
+#define RELFLOOR 1e-3
+
+/* the matrices of a run, kept from one step statement to the next */
+struct stiff
+{
+  int n;			/* number of dependent variables */
+  int m;			/* number of them in W */
+  int *act;			/* ... and their numbers */
+  int *pos;			/* the place of each variable in W, or -1 */
+  bool band;			/* is W stored as a band matrix? */
+  int ml, mu;			/* if so, its lower and upper bandwidths */
+  int lda;			/* ... and the length of its stored columns */
+  int nent;			/* number of entries of the Jacobian */
+  const int *row, *col;		/* ... their places (see jacobian_pattern) */
+  double *jv;			/* ... and values */
+  double *dfdt;			/* d(field)/dt */
+  double *w;			/* W, factored */
+  int *pivot;			/* row interchanges made in factoring W */
+  double *b, *x, *scratch;
+};
+
+static struct stiff * new_stiff (struct run *rp);
+static bool factor (struct stiff *stp, double gamma);
+static void solve_w (struct stiff *stp, double gamma);
+static void interpolate (struct run *rp, double theta, double h);
+
+/*
+ * integrate from t (tstart, or a point reached by rka) to tstop; if
+ * dense, print at multiples of the output spacing from tstart, and
+ * otherwise at the end of each step
+ */
+void
+rosenbrock (struct run *rp, double t, bool dense)
+{
+  int i, e, n = rp->r_nsyms;
+  double *value = rp->r_value, *prime = rp->r_prime;
+  double *val0 = rp->r_val[0], *pri0 = rp->r_pri[0];
+  double *val1 = rp->r_val[1], *pri1 = rp->r_pri[1];
+  double *predi = rp->r_predi;
+  double *sserr = rp->r_sserr, *aberr = rp->r_aberr;
+  double *k0 = rp->r_k[0], *k1 = rp->r_k[1], *k2 = rp->r_k[2];
+  double *k3 = rp->r_k[3];
+  struct stiff *stp;
+  bool rejected = false;	/* was the last attempt at a step rejected? */
+  bool newjac = true;		/* need the Jacobian at the current point? */
+  bool last;			/* will this step reach tstop? */
+  double dt = rp->r_tstep;	/* output spacing, if dense */
+  double h = rp->r_tstep;	/* step size */
+  double tnew, tout, err, fac, least, *b;
+  long k = 1;			/* number of the next output time */
+
+  if (rp->r_stiff == NULL)
+    rp->r_stiff = new_stiff (rp);
+  stp = rp->r_stiff;
+  b = stp->b;
+
+  value[0] = val0[0] = t;
+  field (rp);
+  for (i = 1; i < n; i++)
+    {
+      val0[i] = value[i];
+      pri0[i] = prime[i];
+    }
+  if (events (rp))
+    return;
+  printq (rp);			/* output */
+
+  while (T_LT_TSTOP)
+    {
+      if (hflag && fabs (h) > hmax)
+	h = (h > 0 ? hmax : -hmax);
+      if (fabs (h) < hmin)
+	h = (h > 0 ? hmin : -hmin);
+      last = (h * (t + h - tstop) >= 0);
+      if (last)
+	h = tstop - t;
+      tnew = (last ? tstop : t + h);
+
+      if (newjac)
+	{
+	  /* field() was last called at this point */
+	  jacobian (rp, stp->jv, stp->scratch);
+	  for (i = 0; i < stp->n; i++)
+	    stp->dfdt[i] = 0.0;
+	  for (e = 0; e < stp->nent; e++)
+	    if (stp->col[e] == stp->n)
+	      stp->dfdt[stp->row[e]] = stp->jv[e];
+	  newjac = false;
+	}
+      if (!factor (stp, D * h))
+	{
+	  h *= HALF;		/* W is singular: shorten the step */
+	  rejected = true;
+	  continue;
+	}
+
+      for (i = 1; i < n; i++)
+	b[i - 1] = pri0[i] + h * D * stp->dfdt[i - 1];
+      solve_w (stp, D * h);
+      for (i = 1; i < n; i++)
+	{
+	  k0[i] = b[i - 1];
+	  value[i] = val0[i] + HALF * h * k0[i];
+	}
+      value[0] = t + HALF * h;
+      field (rp);
+      for (i = 1; i < n; i++)
+	{
+	  k3[i] = prime[i];
+	  b[i - 1] = prime[i] - k0[i];
+	}
+      solve_w (stp, D * h);
+      for (i = 1; i < n; i++)
+	{
+	  k1[i] = b[i - 1] + k0[i];
+	  value[i] = val0[i] + h * k1[i];
+	}
+      value[0] = tnew;
+      field (rp);		/* at the new solution */
+      for (i = 1; i < n; i++)
+	b[i - 1] = (prime[i]
+		    - E32 * (k1[i] - k3[i])
+		    - 2.0 * (k0[i] - pri0[i])
+		    + h * D * stp->dfdt[i - 1]);
+      solve_w (stp, D * h);
+      least = 0.0;
+      for (i = 1; i < n; i++)
+	if (fabs (value[i]) > least)
+	  least = fabs (value[i]);
+      least *= RELFLOOR;
+      for (i = 1; i < n; i++)
+	{
+	  double e, size;
+
+	  k2[i] = b[i - 1];
+	  e = h / 6.0 * (k0[i] - 2.0 * k1[i] + k2[i]);
+	  size = fabs (value[i]);
+	  if (size < fabs (val0[i]))
+	    size = fabs (val0[i]);
+	  if (size < least)
+	    size = least;
+	  predi[i] = value[i] - e;
+	  aberr[i] = fabs (e);
+	  sserr[i] = (size != 0.0 ? fabs (e) / size : 0.0);
+	}
+
+      maxerr (rp);
+      err = rp->r_ssemax / ssmax;
+      if (err < rp->r_abemax / abmax)
+	err = rp->r_abemax / abmax;
+      rp->r_tstep = h;
+      if (hierror (rp))
+	{
+	  fac = SAFETY * pow (err, -1.0 / 3.0);
+	  h *= (fac < FACMIN ? FACMIN : fac);
+	  rejected = true;
+	  continue;
+	}
+
+      /* print at the output times in this step, from the interpolant */
+      if (dense)
+	{
+	  for (i = 1; i < n; i++)
+	    {
+	      val1[i] = value[i];
+	      pri1[i] = prime[i];
+	    }
+	  rp->r_tstep = dt;
+	  for (tout = tstart + k * dt;
+	       !NEARSTOP(tout) && !PASTSTEP(tout);
+	       tout = tstart + ++k * dt)
+	    {
+	      interpolate (rp, (tout - t) / h, h);
+	      value[0] = tout;
+	      rp->r_it = k;
+	      if (events (rp))
+		return;
+	      printq (rp);	/* output */
+	    }
+	  for (i = 1; i < n; i++)
+	    {
+	      value[i] = val1[i];
+	      prime[i] = pri1[i];
+	    }
+	}
+
+      t = tnew;
+      value[0] = val0[0] = t;
+      for (i = 1; i < n; i++)
+	{
+	  val0[i] = value[i];
+	  pri0[i] = prime[i];
+	}
+      if (!dense)
+	{
+	  ++rp->r_it;
+	  if (events (rp))
+	    return;
+	  printq (rp);		/* output */
+	}
+      else if (last)
+	{
+	  rp->r_it = k;
+	  if (events (rp))
+	    return;
+	  printq (rp);		/* output */
+	}
+      newjac = true;
+
+      fac = (err > 0.0 ? SAFETY * pow (err, -1.0 / 3.0) : FACMAX);
+      if (fac > (rejected ? 1.0 : FACMAX))
+	fac = (rejected ? 1.0 : FACMAX);
+      if (fac < FACMIN)
+	fac = FACMIN;
+      h *= fac;
+      rejected = false;
+    }
+  rp->r_tstep = (dense ? dt : h);
+}
+
+/*
+ * set the dynamic variables and their derivatives to the values of the
+ * interpolant at t + theta * h, within the step just taken
+ */
+static void
+interpolate (struct run *rp, double theta, double h)
+{
+  int i, n = rp->r_nsyms;
+  double *value = rp->r_value, *prime = rp->r_prime;
+  double *val0 = rp->r_val[0];
+  double *k0 = rp->r_k[0], *k1 = rp->r_k[1];
+
+  for (i = 1; i < n; i++)
+    {
+      value[i] = val0[i]
+	+ h * (theta * (1.0 - theta) * k0[i]
+	       + theta * (theta - 2.0 * D) * k1[i]) / (1.0 - 2.0 * D);
+      prime[i] = ((1.0 - 2.0 * theta) * k0[i]
+		  + 2.0 * (theta - D) * k1[i]) / (1.0 - 2.0 * D);
+    }
+}
+
+/*
+ * allocate the matrices for a run, and choose the variables in W and
+ * the way it is stored, from which entries of the Jacobian can be nonzero
+ */
+static struct stiff *
+new_stiff (struct run *rp)
+{
+  struct stiff *stp;
+  int n, m, i, e, p, q;
+
+  n = rp->r_nsyms - 1;		/* t is not one of them */
+  stp = (struct stiff *)xmalloc (sizeof (struct stiff));
+  stp->n = n;
+  stp->nent = jacobian_pattern (&stp->row, &stp->col);
+  stp->act = (int *)xmalloc ((n + 1) * sizeof (int));
+  stp->pos = (int *)xmalloc ((n + 1) * sizeof (int));
+  for (i = 0; i < n; i++)
+    stp->pos[i] = -1;
+  for (e = 0; e < stp->nent; e++)
+    if (stp->col[e] < n)
+      stp->pos[stp->row[e]] = 0;
+  for (m = 0, i = 0; i < n; i++)
+    if (stp->pos[i] >= 0)
+      {
+	stp->pos[i] = m;
+	stp->act[m++] = i;
+      }
+  stp->m = m;
+
+  stp->ml = stp->mu = 0;
+  for (e = 0; e < stp->nent; e++)
+    if (stp->col[e] < n && stp->pos[stp->col[e]] >= 0)
+      {
+	p = stp->pos[stp->row[e]];
+	q = stp->pos[stp->col[e]];
+	if (p - q > stp->ml)
+	  stp->ml = p - q;
+	if (q - p > stp->mu)
+	  stp->mu = q - p;
+      }
+  /* the factors of a band matrix have ml more upper diagonals */
+  stp->lda = 2 * stp->ml + stp->mu + 1;
+  stp->band = (m > 8 && 3 * stp->lda < m);
+
+  stp->jv = (double *)xmalloc ((stp->nent + 1) * sizeof (double));
+  stp->dfdt = (double *)xmalloc ((n + 1) * sizeof (double));
+  stp->w = (double *)xmalloc (((stp->band ? stp->lda : m) * m + 1)
+			      * sizeof (double));
+  stp->pivot = (int *)xmalloc ((m + 1) * sizeof (int));
+  stp->b = (double *)xmalloc ((n + 1) * sizeof (double));
+  stp->x = (double *)xmalloc ((m + 1) * sizeof (double));
+  stp->scratch = (double *)xmalloc ((n + 1) * sizeof (double));
+  return stp;
+}
+
+void
+free_stiff (struct stiff *stp)
+{
+  if (stp == NULL)
+    return;
+  free (stp->act);
+  free (stp->pos);
+  free (stp->jv);
+  free (stp->dfdt);
+  free (stp->w);
+  free (stp->pivot);
+  free (stp->b);
+  free (stp->x);
+  free (stp->scratch);
+  free (stp);
+}
+
+/* W[p][q], dense or banded; the band storage is that of LINPACK's dgbfa */
+#define WD(p,q) (stp->w[(p) * m + (q)])
+#define WB(p,q) (stp->w[(q) * stp->lda + kv + (p) - (q)])
+
+/*
+ * form W = I - gamma * J, for the variables in it, and factor it by
+ * Gaussian elimination with partial pivoting; false if it is singular
+ */
+static bool
+factor (struct stiff *stp, double gamma)
+{
+  int n = stp->n, m = stp->m, kv = stp->ml + stp->mu;
+  int e, p, q, r, piv, last, ju;
+  double x, big;
+
+  for (p = 0; p < (stp->band ? stp->lda : m) * m; p++)
+    stp->w[p] = 0.0;
+  for (p = 0; p < m; p++)
+    *(stp->band ? &WB(p,p) : &WD(p,p)) = 1.0;
+  for (e = 0; e < stp->nent; e++)
+    if (stp->col[e] < n && stp->pos[stp->col[e]] >= 0)
+      {
+	p = stp->pos[stp->row[e]];
+	q = stp->pos[stp->col[e]];
+	*(stp->band ? &WB(p,q) : &WD(p,q))
+	  = (p == q ? 1.0 : 0.0) - gamma * stp->jv[e];
+      }
+
+  if (!stp->band)
+    {
+      for (q = 0; q < m; q++)
+	{
+	  piv = q;
+	  big = fabs (WD(q,q));
+	  for (p = q + 1; p < m; p++)
+	    if (fabs (WD(p,q)) > big)
+	      {
+		big = fabs (WD(p,q));
+		piv = p;
+	      }
+	  stp->pivot[q] = piv;
+	  if (big == 0.0)
+	    return false;
+	  if (piv != q)
+	    for (r = 0; r < m; r++)
+	      {
+		x = WD(q,r);
+		WD(q,r) = WD(piv,r);
+		WD(piv,r) = x;
+	      }
+	  for (p = q + 1; p < m; p++)
+	    {
+	      x = (WD(p,q) /= WD(q,q));
+	      if (x != 0.0)
+		for (r = q + 1; r < m; r++)
+		  WD(p,r) -= x * WD(q,r);
+	    }
+	}
+      return true;
+    }
+
+  ju = 0;			/* last column touched by the upper factor */
+  for (q = 0; q < m; q++)
+    {
+      last = (q + stp->ml < m ? q + stp->ml : m - 1);
+      piv = q;
+      big = fabs (WB(q,q));
+      for (p = q + 1; p <= last; p++)
+	if (fabs (WB(p,q)) > big)
+	  {
+	    big = fabs (WB(p,q));
+	    piv = p;
+	  }
+      stp->pivot[q] = piv;
+      if (big == 0.0)
+	return false;
+      if (piv + stp->mu > ju)
+	ju = (piv + stp->mu < m ? piv + stp->mu : m - 1);
+      if (piv != q)
+	for (r = q; r <= ju; r++)
+	  {
+	    x = WB(q,r);
+	    WB(q,r) = WB(piv,r);
+	    WB(piv,r) = x;
+	  }
+      for (p = q + 1; p <= last; p++)
+	WB(p,q) /= WB(q,q);
+      for (r = q + 1; r <= ju; r++)
+	{
+	  x = WB(q,r);
+	  if (x != 0.0)
+	    for (p = q + 1; p <= last; p++)
+	      WB(p,r) -= WB(p,q) * x;
+	}
+    }
+  return true;
+}
+
+/*
+ * solve W x = b, where b holds a value for each dependent variable, and
+ * leave x in b
+ */
+static void
+solve_w (struct stiff *stp, double gamma)
+{
+  int n = stp->n, m = stp->m, kv = stp->ml + stp->mu;
+  double *b = stp->b, *x = stp->x;
+  int e, j, p, q, last, first;
+  double s;
+
+  /* the variables not in W are known; move them to the right side */
+  for (p = 0; p < m; p++)
+    x[p] = b[stp->act[p]];
+  if (m < n)
+    for (e = 0; e < stp->nent; e++)
+      {
+	j = stp->col[e];
+	if (j < n && stp->pos[j] < 0 && stp->pos[stp->row[e]] >= 0)
+	  x[stp->pos[stp->row[e]]] += gamma * stp->jv[e] * b[j];
+      }
+
+  /* forward substitution, applying the row interchanges */
+  for (q = 0; q < m; q++)
+    {
+      p = stp->pivot[q];
+      s = x[p];
+      x[p] = x[q];
+      x[q] = s;
+      if (stp->band)
+	{
+	  last = (q + stp->ml < m ? q + stp->ml : m - 1);
+	  for (p = q + 1; p <= last; p++)
+	    x[p] -= WB(p,q) * s;
+	}
+      else
+	for (p = q + 1; p < m; p++)
+	  x[p] -= WD(p,q) * s;
+    }
+
+  /* back substitution */
+  for (q = m - 1; q >= 0; q--)
+    {
+      if (stp->band)
+	{
+	  x[q] /= WB(q,q);
+	  first = (q > kv ? q - kv : 0);
+	  for (p = first; p < q; p++)
+	    x[p] -= WB(p,q) * x[q];
+	}
+      else
+	{
+	  x[q] /= WD(q,q);
+	  for (p = 0; p < q; p++)
+	    x[p] -= WD(p,q) * x[q];
+	}
+    }
+
+  for (p = 0; p < m; p++)
+    b[stp->act[p]] = x[p];
+}
@@ -0,0 +1,678 @@
+/* This file is part of the GNU plotutils package. */
+
+/*
+ * Copyright (C) 2008, Free Software Foundation, Inc.
+ */
+
+/*
+ * Runs of the numerical routines, and ensembles of runs.
+ *
+ * Each run has its own arrays of values and derivatives, and the other
+ * state that the numerical routines change (see struct run in ode.h),
+ * so the members of an ensemble can be integrated side by side, on as
+ * many threads as the user asks for (see --threads).  The compiled equations
+ * and everything set up by the parser are shared, and not changed while
+ * an ensemble is being solved.
+ *
+ * When the scheme is the fixed-step Runge-Kutta one, each thread takes
+ * the members LANES at a time, and integrates them in lockstep (see
+ * struct lanes in ode.h), so that each instruction of the compiled
+ * equations is applied to several members at once.
+ */
+
+#include "sys-defines.h"
+#include "ode.h"
+#include "extern.h"
+
+/* Members may be this many places ahead of the one whose output is
+   being copied to stdout, per thread.  This bounds the number of
+   temporary files that are open at once. */
+#define MEMBERS_AHEAD_PER_THREAD 4
+
+static void apply_member (struct run *rp, const int *columns, int member);
+static void solve_block (const int *columns, int first, int count,
+			 FILE **outputs);
+static FILE *open_member_output (int member, bool direct);
+static void close_member_output (FILE *fp);
+#ifdef ODE_THREADS
+static void *solve_members (void *arg);
+#endif
+
+/* the run being done on this thread, if any (for the error handlers) */
+#ifdef ODE_THREADS
+static pthread_key_t run_key;
+static pthread_once_t run_key_once = PTHREAD_ONCE_INIT;
+
+static void make_run_key (void);
+
+static void
+make_run_key (void)
+{
+  pthread_key_create (&run_key, NULL);
+}
+#else
+static struct run *the_run = NULL;
+#endif
+
+struct run *
+current_run (void)
+{
+#ifdef ODE_THREADS
+  pthread_once (&run_key_once, make_run_key);
+  return (struct run *)pthread_getspecific (run_key);
+#else
+  return the_run;
+#endif
+}
+
+void
+set_current_run (struct run *rp)
+{
+#ifdef ODE_THREADS
+  pthread_once (&run_key_once, make_run_key);
+  pthread_setspecific (run_key, (void *)rp);
+#else
+  the_run = rp;
+#endif
+}
+
+/*
+ * start a run from the current state of the symbol table
+ * (which must have been checked and compiled)
+ */
+struct run *
+new_run (int member, FILE *out)
+{
+  struct run *rp;
+  struct sym *sp;
+  double *p;
+  int i, n;
+
+  for (n = 0, sp = symtab; sp != NULL; sp = sp->sy_link)
+    n++;
+  rp = (struct run *)xmalloc (sizeof (struct run));
+  rp->r_nsyms = n;
+  rp->r_reg = new_registers ();
+  rp->r_value = rp->r_reg;
+  rp->r_hoisted = false;
+
+  /* the other arrays, in one block */
+  p = (double *)xmalloc ((2 * PASTMAX + KMAX + 5) * n * sizeof (double));
+  rp->r_prime = p;
+  p += n;
+  for (i = 0; i < PASTMAX; i++, p += n)
+    rp->r_val[i] = p;
+  for (i = 0; i < PASTMAX; i++, p += n)
+    rp->r_pri[i] = p;
+  for (i = 0; i < KMAX; i++, p += n)
+    rp->r_k[i] = p;
+  rp->r_predi = p;
+  rp->r_sserr = p + n;
+  rp->r_aberr = p + 2 * n;
+  rp->r_acerr = p + 3 * n;
+
+  for (i = 0, sp = symtab; sp != NULL; sp = sp->sy_link, i++)
+    {
+      rp->r_value[i] = rp->r_val[0][i] = sp->sy_value;
+      rp->r_prime[i] = rp->r_pri[0][i] = sp->sy_prime;
+      rp->r_sserr[i] = sp->sy_sserr;
+      rp->r_aberr[i] = sp->sy_aberr;
+      rp->r_acerr[i] = sp->sy_acerr;
+    }
+  rp->r_fsp = NULL;
+  rp->r_tstep = tstep;
+  rp->r_it = 0;
+  rp->r_printnum = false;
+  rp->r_ssemax = rp->r_abemax = rp->r_acemax = 0.0;
+  rp->r_ssenam = rp->r_abenam = rp->r_acenam = NULL;
+  rp->r_member = member;
+  rp->r_out = out;
+  rp->r_stiff = NULL;
+  rp->r_events = NULL;
+  return rp;
+}
+
+void
+free_run (struct run *rp)
+{
+  free (rp->r_prime);		/* and the other arrays */
+  free (rp->r_reg);
+  free_stiff (rp->r_stiff);
+  free_events (rp->r_events);
+  free (rp);
+}
+
+/*
+ * start integrating count members (at most LANES) in lockstep, from
+ * their runs, which have their own values already
+ */
+struct lanes *
+new_lanes (struct run **runs, int count)
+{
+  struct lanes *lp;
+  struct run *rp;
+  double *p;
+  int i, j, l, n;
+
+  n = runs[0]->r_nsyms;
+  lp = (struct lanes *)xmalloc (sizeof (struct lanes));
+  lp->l_nsyms = n;
+  lp->l_reg = new_lane_registers ();
+  lp->l_hoisted = false;
+
+  /* the other arrays, in one block */
+  p = (double *)xmalloc (7 * n * LANES * sizeof (double));
+  lp->l_prime = p;
+  lp->l_val0 = p + n * LANES;
+  lp->l_pri0 = p + 2 * n * LANES;
+  for (i = 0; i < 4; i++)
+    lp->l_k[i] = p + (3 + i) * n * LANES;
+
+  /* spare lanes get copies of the first member */
+  for (l = 0; l < LANES; l++)
+    {
+      rp = runs[l < count ? l : 0];
+      lp->l_run[l] = (l < count ? rp : NULL);
+      lp->l_live[l] = (l < count);
+      for (i = 0; i < n; i++)
+	{
+	  j = i * LANES + l;
+	  lp->l_reg[j] = lp->l_val0[j] = rp->r_value[i];
+	  lp->l_prime[j] = lp->l_pri0[j] = rp->r_prime[i];
+	}
+    }
+  return lp;
+}
+
+void
+free_lanes (struct lanes *lp)
+{
+  free (lp->l_prime);		/* and the other arrays */
+  free (lp->l_reg);
+  free (lp);
+}
+
+/*
+ * print the current values of each live lane, as step it of its member's
+ * run; false if no lane is live
+ */
+bool
+print_lanes (struct lanes *lp, long it)
+{
+  const struct prt *pp;
+  struct run *rp;
+  bool live = false;
+  int i, l;
+
+  for (l = 0; l < LANES; l++)
+    {
+      if (!lp->l_live[l])
+	continue;
+      live = true;
+      rp = lp->l_run[l];
+      rp->r_value[0] = lp->l_reg[l];
+      for (pp = pqueue; pp != NULL; pp = pp->pr_link)
+	{
+	  i = pp->pr_sym->sy_index;
+	  rp->r_value[i] = lp->l_reg[i * LANES + l];
+	  rp->r_prime[i] = lp->l_prime[i * LANES + l];
+	}
+      rp->r_it = it;
+      printq (rp);
+    }
+  return live;
+}
+
+/*
+ * make room at the head of the history (for the Adams-Moulton schemes):
+ * r_val[0..depth-1] become r_val[1..depth], and the array that was
+ * r_val[depth] is reused as r_val[0]; likewise r_pri
+ */
+void
+push_history (struct run *rp, int depth)
+{
+  double *val = rp->r_val[depth], *pri = rp->r_pri[depth];
+  int j;
+
+  for (j = depth; j > 0; j--)
+    {
+      rp->r_val[j] = rp->r_val[j - 1];
+      rp->r_pri[j] = rp->r_pri[j - 1];
+    }
+  rp->r_val[0] = val;
+  rp->r_pri[0] = pri;
+}
+
+/*
+ * Read a table of initial values and constants (see --ensemble).  The
+ * first line names the symbols, and each later line gives values for
+ * them, for one member of the ensemble.  Blank lines, and anything
+ * from a `#' to the end of a line, are ignored.
+ */
+void
+read_ensemble (const char *name)
+{
+  FILE *fp;
+  char *text, *s, *end;
+  size_t len, size;
+  int lineno, col, maxrows = 0;
+  bool header = true;
+
+  if (strcmp (name, "-") == 0)
+    fp = stdin;
+  else if ((fp = fopen (name, "r")) == NULL)
+    {
+      fprintf (stderr, "%s: %s: %s\n", progname, name, strerror (errno));
+      exit (EXIT_FAILURE);
+    }
+  size = 4096;
+  text = (char *)xmalloc (size);
+  len = 0;
+  for (;;)
+    {
+      len += fread (text + len, 1, size - len - 1, fp);
+      if (len < size - 1)
+	break;
+      size *= 2;
+      text = (char *)xrealloc (text, size);
+    }
+  text[len] = '\0';
+  if (fp != stdin)
+    fclose (fp);
+
+  ensemble = (struct ensemble *)xmalloc (sizeof (struct ensemble));
+  ensemble->en_ncols = ensemble->en_nrows = 0;
+  ensemble->en_names = (char (*)[NAMMAX])xmalloc (NAMMAX);
+  ensemble->en_values = NULL;
+  ensemble->en_solved = false;
+
+  for (s = text, lineno = 1; *s != '\0'; lineno++)
+    {
+      double *row = NULL;
+
+      col = 0;
+      for (;;)
+	{
+	  while (*s == ' ' || *s == '\t' || *s == '\r')
+	    s++;
+	  if (*s == '#')
+	    while (*s != '\0' && *s != '\n')
+	      s++;
+	  if (*s == '\0' || *s == '\n')
+	    break;
+
+	  if (header)
+	    {
+	      if (!(isalpha ((unsigned char)*s) || *s == '_'))
+		goto bad;
+	      for (end = s; isalnum ((unsigned char)*end) || *end == '_';
+		   end++)
+		;
+	      ensemble->en_names = (char (*)[NAMMAX])
+		xrealloc (ensemble->en_names, (col + 1) * NAMMAX);
+	      memset (ensemble->en_names[col], 0, NAMMAX);
+	      strncpy (ensemble->en_names[col], s,
+		       (size_t)(end - s) < NAMMAX ? (size_t)(end - s) : NAMMAX);
+	    }
+	  else
+	    {
+	      if (col == ensemble->en_ncols)
+		goto bad;
+	      if (row == NULL)
+		{
+		  if (ensemble->en_nrows == maxrows)
+		    {
+		      maxrows = (maxrows == 0 ? 16 : 2 * maxrows);
+		      ensemble->en_values = (double *)
+			xrealloc (ensemble->en_values,
+				  maxrows * ensemble->en_ncols
+				  * sizeof (double));
+		    }
+		  row = ensemble->en_values
+		    + ensemble->en_nrows * ensemble->en_ncols;
+		}
+	      row[col] = strtod (s, &end);
+	      if (end == s)
+		goto bad;
+	    }
+	  col++;
+	  s = end;
+	  if (*s != '\0' && !isspace ((unsigned char)*s) && *s != '#')
+	    goto bad;
+	}
+      if (*s == '\n')
+	s++;
+      if (col == 0)
+	continue;		/* nothing on this line */
+
+      if (header)
+	{
+	  ensemble->en_ncols = col;
+	  header = false;
+	}
+      else if (col < ensemble->en_ncols)
+	goto bad;
+      else
+	ensemble->en_nrows++;
+    }
+  free (text);
+
+  if (ensemble->en_nrows == 0)
+    {
+      fprintf (stderr, "%s: %s: the ensemble has no members\n",
+	       progname, name);
+      exit (EXIT_FAILURE);
+    }
+  return;
+
+ bad:
+  if (header)
+    fprintf (stderr, "%s: %s:%d: expected the names of variables\n",
+	     progname, name, lineno);
+  else
+    fprintf (stderr, "%s: %s:%d: expected %d number%s\n",
+	     progname, name, lineno, ensemble->en_ncols,
+	     ensemble->en_ncols == 1 ? "" : "s");
+  exit (EXIT_FAILURE);
+}
+
+/*
+ * make sure each symbol named in the ensemble's table exists, and has
+ * an initial value (called by solve, before check)
+ */
+void
+declare_ensemble (void)
+{
+  int col;
+
+  for (col = 0; col < ensemble->en_ncols; col++)
+    lookup (ensemble->en_names[col])->sy_flags |= SF_INIT;
+}
+
+/*
+ * Check the name of an output file for the members of an ensemble (see
+ * --ensemble-output).  Return value is the number of member number
+ * conversions it contains (0 or 1), or -1 if it contains any other
+ * printf-style conversion.  A member number conversion is `%d',
+ * optionally with a flag `0' or `-' and a width of at most two digits,
+ * e.g. `%04d'; `%%' stands for a percent sign.
+ */
+int
+count_member_conversions (const char *template)
+{
+  const char *s;
+  int count = 0, digits;
+
+  for (s = template; *s; s++)
+    {
+      if (*s != '%')
+	continue;
+      s++;
+      if (*s == '%')
+	continue;
+      if (*s == '0' || *s == '-')
+	s++;
+      for (digits = 0; *s >= '0' && *s <= '9'; s++)
+	digits++;
+      if (*s != 'd' || digits > 2)
+	return -1;
+      count++;
+    }
+
+  return (count > 1 ? -1 : count);
+}
+
+/*
+ * where a member's output goes: a file of its own if there's a template
+ * for their names, and otherwise stdout if it may be written directly,
+ * or (if the members before it aren't done yet) a temporary file to be
+ * copied to stdout when they are.  A member's file is created by the
+ * first step statement, and appended to by later ones.
+ */
+static FILE *
+open_member_output (int member, bool direct)
+{
+  FILE *fp;
+
+  if (ensemble_output != NULL)
+    {
+      char *name;
+
+      name = (char *)xmalloc (strlen (ensemble_output)
+			      + 3 * sizeof (int) + 1);
+      sprintf (name, ensemble_output, member);
+      fp = fopen (name, ensemble->en_solved ? "a" : "w");
+      if (fp == NULL)
+	fprintf (stderr, "%s: %s: %s\n", progname, name, strerror (errno));
+      free (name);
+      return fp;
+    }
+  if (direct)
+    return stdout;
+  fp = tmpfile ();
+  if (fp == NULL)
+    {
+      fprintf (stderr, "%s: can't create a temporary file: %s\n",
+	       progname, strerror (errno));
+      exit (EXIT_FAILURE);
+    }
+  return fp;
+}
+
+static void
+close_member_output (FILE *fp)
+{
+  if (fp == stdout)
+    fflush (fp);
+  else if (ensemble_output != NULL)
+    fclose (fp);
+  else
+    {
+      char buf[BUFSIZ];
+      size_t n;
+
+      rewind (fp);
+      while ((n = fread (buf, 1, sizeof buf, fp)) > 0)
+	fwrite (buf, 1, n, stdout);
+      fclose (fp);
+      fflush (stdout);
+    }
+}
+
+/*
+ * give a member its own values, from its row of the table
+ */
+static void
+apply_member (struct run *rp, const int *columns, int member)
+{
+  const double *row;
+  int col;
+
+  row = ensemble->en_values + (member - 1) * ensemble->en_ncols;
+  for (col = 0; col < ensemble->en_ncols; col++)
+    rp->r_value[columns[col]] = row[col];
+}
+
+#ifdef ODE_THREADS
+/* state shared by the threads solving an ensemble */
+static struct
+{
+  const int *columns;		/* symbol for each column of the table */
+  int block;			/* members a thread takes at once */
+  int next;			/* members taken by the threads */
+  int written;			/* members whose output has been copied */
+  int ahead;			/* how far past `written' `next' may go */
+  FILE **outputs;		/* each member's output */
+  bool *finished;		/* each member's done */
+  pthread_mutex_t lock;		/* protects all of the above */
+  pthread_cond_t changed;	/* signalled when one of them changes */
+} work;
+
+/*
+ * body of each thread: solve members, a block at a time, until there
+ * are none left
+ */
+static void *
+solve_members (void *arg)
+{
+  int first, count, member;
+
+  for (;;)
+    {
+      pthread_mutex_lock (&work.lock);
+      while (work.next < ensemble->en_nrows
+	     && work.next >= work.written + work.ahead)
+	pthread_cond_wait (&work.changed, &work.lock);
+      first = work.next + 1;
+      count = ensemble->en_nrows - work.next;
+      if (count > work.block)
+	count = work.block;
+      work.next += count;
+      pthread_mutex_unlock (&work.lock);
+      if (count <= 0)
+	break;
+
+      for (member = first; member < first + count; member++)
+	work.outputs[member - 1] = open_member_output (member, false);
+      solve_block (work.columns, first, count, work.outputs + first - 1);
+
+      pthread_mutex_lock (&work.lock);
+      for (member = first; member < first + count; member++)
+	work.finished[member - 1] = true;
+      pthread_cond_broadcast (&work.changed);
+      pthread_mutex_unlock (&work.lock);
+    }
+  return arg;
+}
+#endif /* ODE_THREADS */
+
+/*
+ * solve count members, starting at first, which write to the outputs
+ * given (NULL for a member to be skipped): in lockstep if the scheme
+ * allows it, and otherwise one at a time
+ */
+static void
+solve_block (const int *columns, int first, int count, FILE **outputs)
+{
+  struct run *runs[LANES];
+  int i, n;
+
+  for (i = n = 0; i < count; i++)
+    if (outputs[i] != NULL)
+      {
+	runs[n] = new_run (first + i, outputs[i]);
+	apply_member (runs[n], columns, first + i);
+	if (!fixed_step_rk () || count == 1)
+	  {
+	    integrate (runs[n]);
+	    free_run (runs[n]);
+	  }
+	else
+	  n++;
+      }
+  if (n > 0)
+    {
+      struct lanes *lp;
+
+      lp = new_lanes (runs, n);
+      integrate_lanes (lp);
+      free_lanes (lp);
+      for (i = 0; i < n; i++)
+	free_run (runs[i]);
+    }
+}
+
+/*
+ * solve every member of the ensemble, writing their output in order
+ * (called by solve, which has checked and compiled the equations)
+ */
+void
+solve_ensemble (void)
+{
+  FILE *out, *outputs[LANES];
+  int *columns;
+  int col, member, block, i;
+
+  columns = (int *)xmalloc (ensemble->en_ncols * sizeof (int));
+  for (col = 0; col < ensemble->en_ncols; col++)
+    columns[col] = lookup (ensemble->en_names[col])->sy_index;
+  block = (fixed_step_rk () ? LANES : 1);
+
+#ifdef ODE_THREADS
+  if (num_threads > 1)
+    {
+      pthread_t *threads;
+      int i, nthreads = 0;
+
+      work.columns = columns;
+      work.block = block;
+      work.next = work.written = 0;
+      work.ahead = MEMBERS_AHEAD_PER_THREAD * num_threads * block;
+      work.outputs = (FILE **)xmalloc (ensemble->en_nrows * sizeof (FILE *));
+      work.finished = (bool *)xmalloc (ensemble->en_nrows * sizeof (bool));
+      for (member = 0; member < ensemble->en_nrows; member++)
+	work.finished[member] = false;
+      pthread_mutex_init (&work.lock, NULL);
+      pthread_cond_init (&work.changed, NULL);
+
+      threads = (pthread_t *)xmalloc (num_threads * sizeof (pthread_t));
+      for (i = 0; i < num_threads; i++)
+	{
+	  if (pthread_create (&threads[i], NULL, solve_members, NULL) != 0)
+	    break;		/* make do with fewer threads */
+	  nthreads++;
+	}
+      if (nthreads > 0)
+	{
+	  /* copy each member's output, in order, as soon as it's done */
+	  for (member = 0; member < ensemble->en_nrows; member++)
+	    {
+	      pthread_mutex_lock (&work.lock);
+	      while (!work.finished[member])
+		pthread_cond_wait (&work.changed, &work.lock);
+	      out = work.outputs[member];
+	      pthread_mutex_unlock (&work.lock);
+
+	      if (out != NULL)
+		close_member_output (out);
+
+	      pthread_mutex_lock (&work.lock);
+	      work.written++;
+	      pthread_cond_broadcast (&work.changed);
+	      pthread_mutex_unlock (&work.lock);
+	    }
+	  for (i = 0; i < nthreads; i++)
+	    pthread_join (threads[i], NULL);
+	}
+
+      free (threads);
+      free (work.outputs);
+      free (work.finished);
+      pthread_mutex_destroy (&work.lock);
+      pthread_cond_destroy (&work.changed);
+      if (nthreads > 0)
+	{
+	  free (columns);
+	  ensemble->en_solved = true;
+	  return;
+	}
+      /* otherwise do them all on this thread */
+    }
+#endif /* ODE_THREADS */
+
+  for (member = 1; member <= ensemble->en_nrows; member += block)
+    {
+      int count = ensemble->en_nrows - member + 1;
+
+      if (count > block)
+	count = block;
+      for (i = 0; i < count; i++)
+	outputs[i] = open_member_output (member + i, i == 0);
+      solve_block (columns, member, count, outputs);
+      for (i = 0; i < count; i++)
+	if (outputs[i] != NULL)
+	  close_member_output (outputs[i]);
+    }
+  free (columns);
+  ensemble->en_solved = true;
+}
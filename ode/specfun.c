@@ -96,6 +96,14 @@ extern int SIGNGAM;
 #endif
 double f_gamma (double x);
 
+double locked_lgamma (double x);
+
+#ifdef ODE_THREADS
+/* F_LGAMMA() returns a sign in a global variable, so the members of an
+   ensemble must take turns calling it */
+static pthread_mutex_t gamma_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
 #ifndef HAVE_ERF
 double erf (double x);
 double erfc (double x);
@@ -128,7 +136,17 @@ f_gamma (double x)
 #endif
 #endif
 
-  double y = F_LGAMMA(x);
+  double y;
+  int sign;
+
+#ifdef ODE_THREADS
+  pthread_mutex_lock (&gamma_lock);
+#endif
+  y = F_LGAMMA(x);
+  sign = SIGNGAM;
+#ifdef ODE_THREADS
+  pthread_mutex_unlock (&gamma_lock);
+#endif
 
   if (y > MAXEXP)
     {
@@ -149,7 +167,24 @@ f_gamma (double x)
 #endif
     }
   else
-    return SIGNGAM * exp (y);
+    return sign * exp (y);
+}
+
+/* F_LGAMMA(), for use while members of an ensemble may be running on
+   other threads */
+double
+locked_lgamma (double x)
+{
+  double y;
+
+#ifdef ODE_THREADS
+  pthread_mutex_lock (&gamma_lock);
+#endif
+  y = F_LGAMMA(x);
+#ifdef ODE_THREADS
+  pthread_mutex_unlock (&gamma_lock);
+#endif
+  return y;
 }
 
 #ifdef NO_SYSTEM_GAMMA
@@ -731,8 +766,8 @@ static const double d3[4] =
 double
 inverf (double x)
 {
-  static double num, den, retval;
-  static int xsign;
+  double num, den, retval;
+  int xsign;
 
 #ifdef HAVE_MATHERR
 #ifdef __cplusplus
@@ -16,75 +16,88 @@
 #include "ode.h"
 #include "extern.h"
 
-static double   ssemax, abemax, acemax;
-static char     *ssenam, *abenam, *acenam;
-
 void
-maxerr (void)
+maxerr (struct run *rp)
 {
-  struct sym *sp, *dq;
+  int i;
   
-  dq = symtab->sy_link;
-  ssemax = abemax = acemax = 0.0;
-  for (sp = dq; sp != NULL; sp = sp->sy_link) 
+  rp->r_ssemax = rp->r_abemax = rp->r_acemax = 0.0;
+  for (i = 1; i < rp->r_nsyms; i++)
     {
-      if (ssemax < sp->sy_sserr) 
+      if (rp->r_ssemax < rp->r_sserr[i])
 	{
-	  ssemax = sp->sy_sserr;
-	  ssenam = sp->sy_name;
+	  rp->r_ssemax = rp->r_sserr[i];
+	  rp->r_ssenam = symvec[i]->sy_name;
 	}
-      if (abemax < sp->sy_aberr) 
+      if (rp->r_abemax < rp->r_aberr[i])
 	{
-	  abemax = sp->sy_aberr;
-	  abenam = sp->sy_name;
+	  rp->r_abemax = rp->r_aberr[i];
+	  rp->r_abenam = symvec[i]->sy_name;
 	}
-      if (acmax < sp->sy_acerr) 
+      if (acmax < rp->r_acerr[i])
 	{
-	  acemax = sp->sy_acerr;
-	  acenam = sp->sy_name;
+	  rp->r_acemax = rp->r_acerr[i];
+	  rp->r_acenam = symvec[i]->sy_name;
 	}
     }
 }
 
 bool
-hierror (void) /* not enough accuracy */
+hierror (struct run *rp) /* not enough accuracy */
 {
-  double t = symtab->sy_val[0];
+  double t = rp->r_val[0][0];
+  const char *what, *name;
 
-  if (t + tstep == t) 
+  if (t + rp->r_tstep == t) 
+    {
+      what = "step size below lower limit";
+      name = NULL;
+    }
+  else
     {
-      fprintf (stderr, "%s: %s\n", progname, "step size below lower limit");
-      longjmp (mark, 1);
+      if (rp->r_ssemax <= ssmax && rp->r_abemax <= abmax
+	  && rp->r_acemax <= acmax)
+	return false;
+      if (fabs(rp->r_tstep) >= fabs(hmin))
+	return true;
+      if (sflag)
+	return false;
+      if (rp->r_ssemax > ssmax)
+	{
+	  what = "relative error limit exceeded";
+	  name = rp->r_ssenam;
+	}
+      else if (rp->r_abemax > abmax)
+	{
+	  what = "absolute error limit exceeded";
+	  name = rp->r_abenam;
+	}
+      else
+	{
+	  what = "accumulated error limit exceeded";
+	  name = rp->r_acenam;
+	}
     }
-  if (ssemax <= ssmax && abemax <= abmax && acemax <= acmax)
-    return false;
-  if (fabs(tstep) >= fabs(hmin))
-    return true;
-  if (sflag)
-    return false;
-  if (ssemax > ssmax)
-    fprintf (stderr, 
-	     "%s: relative error limit exceeded while calculating %.*s'\n",
-	     progname, NAMMAX, ssenam);
-  else if (abemax > abmax)
-    fprintf (stderr, 
-	     "%s: absolute error limit exceeded while calculating %.*s'\n",
-	     progname, NAMMAX, abenam);
-  else if (acemax > acmax)
-    fprintf (stderr, 
-	     "%s: accumulated error limit exceeded while calculating %.*s'\n",
-	     progname, NAMMAX, acenam);
-  longjmp (mark, 1);
+  fflush (rp->r_out);		/* so it precedes the message */
+#ifdef ODE_THREADS
+  flockfile (stderr);
+#endif
+  fprintf (stderr, "%s: %s", progname, what);
+  rtwhere (rp, name);
+#ifdef ODE_THREADS
+  funlockfile (stderr);
+#endif
+  longjmp (rp->r_mark, 1);
 
   /* doesn't return, but must keep unintelligent compilers happy */
   return false;
 }
 
 bool
-lowerror (void) /* more than enough accuracy */
+lowerror (struct run *rp) /* more than enough accuracy */
 {
-  if (ssemax < ssmin || abemax < abmin)
-    if (fabs(tstep) <= fabs(hmax))
+  if (rp->r_ssemax < ssmin || rp->r_abemax < abmin)
+    if (fabs(rp->r_tstep) <= fabs(hmax))
       return true;
   return false;
 }
@@ -98,19 +111,19 @@ lowerror (void) /* more than enough accuracy */
                                 t + 0.0625*stepvar > tstop)
 
 bool
-intpr (double t)
+intpr (struct run *rp, double t)
 {
-  if (tstep > 0)
-    if (!PASTSTOP(tstep))
+  if (rp->r_tstep > 0)
+    if (!PASTSTOP(rp->r_tstep))
       return false;
-  if (tstep < 0)
-    if (!BEFORESTOP(tstep))
+  if (rp->r_tstep < 0)
+    if (!BEFORESTOP(rp->r_tstep))
       return false;
-  if (tstep > 0)
-    while (PASTSTOP(tstep))
-      tstep = HALF * tstep;
-  if (tstep < 0)
-    while (BEFORESTOP(tstep))
-      tstep = HALF * tstep;
+  if (rp->r_tstep > 0)
+    while (PASTSTOP(rp->r_tstep))
+      rp->r_tstep = HALF * rp->r_tstep;
+  if (rp->r_tstep < 0)
+    while (BEFORESTOP(rp->r_tstep))
+      rp->r_tstep = HALF * rp->r_tstep;
   return true;
 }
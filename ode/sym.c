@@ -16,19 +16,80 @@
 #include "ode.h"
 #include "extern.h"
 
+/* Symbols made by lookup() are also kept in a hash table, chained
+   through sy_hash, which is doubled in size whenever it holds as many
+   symbols as it has chains. */
+#define HASHMIN 64		/* initial number of chains */
+
+static struct sym **hashtab = NULL;
+static unsigned int hashsize, nhashed;
+
+static unsigned int hash_name (const char *nam);
+static void rehash (void);
+
 struct sym *
 lookup (const char *nam)
 {
   struct sym *sp;
+  unsigned int h;
   
-  for (sp = symtab; sp != NULL; sp = sp->sy_link)
+  if (hashtab == NULL)
+    rehash ();
+  h = hash_name (nam);
+  for (sp = hashtab[h & (hashsize - 1)]; sp != NULL; sp = sp->sy_hash)
     if (strncmp (sp->sy_name, nam, NAMMAX) == 0)
       return sp;
   sp = salloc();
   strncpy (sp->sy_name, nam, NAMMAX);
+  sp->sy_hash = hashtab[h & (hashsize - 1)];
+  hashtab[h & (hashsize - 1)] = sp;
+  if (++nhashed >= hashsize)
+    rehash ();
   return sp;
 }
 
+/*
+ * hash the first NAMMAX characters of a name (all that are kept)
+ */
+static unsigned int
+hash_name (const char *nam)
+{
+  unsigned int h = 2166136261U;	/* FNV-1a */
+  int i;
+
+  for (i = 0; i < NAMMAX && nam[i] != '\0'; i++)
+    h = (h ^ (unsigned char)nam[i]) * 16777619U;
+  return h;
+}
+
+/*
+ * make the hash table, or double its size
+ */
+static void
+rehash (void)
+{
+  struct sym **old = hashtab, *sp, *next;
+  unsigned int oldsize = hashsize, i, h;
+
+  hashsize = (old == NULL ? HASHMIN : 2 * oldsize);
+  hashtab = (struct sym **)xmalloc (hashsize * sizeof (struct sym *));
+  for (i = 0; i < hashsize; i++)
+    hashtab[i] = NULL;
+  for (i = 0; i < oldsize; i++)
+    for (sp = old[i]; sp != NULL; sp = next)
+      {
+	next = sp->sy_hash;
+	h = hash_name (sp->sy_name) & (hashsize - 1);
+	sp->sy_hash = hashtab[h];
+	hashtab[h] = sp;
+      }
+  free (old);
+}
+
+/*
+ * a new symbol, at the head of symtab (not in the hash table, so not
+ * found by lookup, unless made by it)
+ */
 struct sym *
 salloc (void)
 {
@@ -37,6 +98,7 @@ salloc (void)
   sp = (struct sym *)xmalloc(sizeof(struct sym));
   sp->sy_link = symtab;
   symtab = sp;
+  sp->sy_hash = NULL;
   sp->sy_expr = NULL;
   sp->sy_value = sp->sy_prime = 0.0;
   sp->sy_sserr = sp->sy_aberr = sp->sy_acerr = 0.0;
@@ -44,6 +106,7 @@ salloc (void)
   return sp;
 }
 
+/* only for symbols made by salloc (lookup's are never freed) */
 void
 sfree (struct sym *sp)
 {
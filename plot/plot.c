@@ -27,17 +27,46 @@
 #include "fontlist.h"
 #include "plot.h"
 
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>		/* for read() */
+#endif
+
+/* A growing input file is followed by watching it with inotify, if
+   available, or else by checking its size periodically (see --follow). */
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>		/* for fstat() */
+#endif
+#ifdef HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+#endif
+
+#ifdef INCLUDE_PNG_SUPPORT
+#include <zlib.h>		/* libpng requires zlib, so it's available */
+#endif
+
+/* Pages written to separate output files (see -o option) may be rendered
+   on several threads, if libplot is thread-safe. */
+#ifdef PTHREAD_SUPPORT
+#ifdef HAVE_PTHREAD_H
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#define PAGE_THREADS
+#endif
+#endif
+#endif
+
 /* Obsolete op codes (no longer listed in plot.h) */
 #define O_COLOR 'C'
 #define O_FROTATE 'V'
 #define O_FSCALE 'X'
 #define O_FTRANSLATE 'Q'
 
-/* The six input formats we recognize */
+/* The seven input formats we recognize */
 typedef enum 
 {
-  /* There are two GNU metafile formats: binary and portable (ascii). */
-  GNU_BINARY, GNU_PORTABLE, 
+  /* There are three GNU metafile formats: binary, portable (ascii), and
+     compact binary, which is machine-independent. */
+  GNU_BINARY, GNU_PORTABLE, GNU_COMPACT,
 
   /* PLOT5_HIGH and PLOT5_LOW are the two distinct versions of Unix plot(5)
      format (high/low byte first), which we also support.  They are
@@ -62,6 +91,124 @@ typedef enum
 
 } plot_format;
 
+/* Whether a format is a modern GNU metafile format, with OPENPL and
+   CLOSEPL directives */
+#define IS_MODERN_FORMAT(format) ((format) == GNU_BINARY \
+	|| (format) == GNU_PORTABLE || (format) == GNU_COMPACT)
+
+/* Input is read from the stream into a buffer, in large blocks, and
+   decoded from there.  That is much faster than reading it one op code or
+   argument at a time with stdio. */
+typedef struct
+{
+  FILE *stream;			/* stream being read (NULL if none) */
+  plot_format format;		/* format of data */
+  bool stream_done;		/* no more data can be read from stream */
+  bool read_error;		/* stream_done because of a read error? */
+  bool eof;			/* decoder ran out of data? */
+  unsigned char *buffer;	/* data read from stream, null-terminated */
+  size_t start, end;		/* unread data is buffer[start..end-1] */
+  long base;			/* stream position of beginning of data */
+  long buffer_offset;		/* offset of buffer[0] in data */
+  long instruction_offset;	/* offset of instruction being parsed */
+  /* decoding of coordinates in GNU_COMPACT format (see libplot/m_emit.c) */
+  int coordinates_left;		/* coordinate args of instruction not yet read */
+  bool coordinate_is_y;		/* next coordinate arg is a y coordinate? */
+  unsigned int prev_x, prev_y;	/* previous coordinates, encoded */
+  /* copy of a page being made, to be rendered separately (see -o option) */
+  bool capturing;		/* making a copy? */
+  long capture_offset;		/* offset of next byte to be copied */
+  unsigned char *capture;	/* copied data */
+  size_t capture_len, capture_size; /* length of data, size of storage */
+  int capture_page;		/* number of page being copied */
+  /* page index appended to metafile, if any (see load_page_index()) */
+  bool have_page_index;		/* index present and valid? */
+  int num_pages;		/* number of pages in index */
+  long *page_offsets;		/* offset of each page's OPENPL */
+  long index_offset;		/* offset of the index itself */
+  /* following of a growing input file (see --follow option) */
+  bool follow;			/* wait for more data at end of input? */
+  char *checkpoint;		/* name of checkpoint file, or NULL */
+  long resume_offset;		/* offset just after last completed page */
+  int resume_page;		/* number of the page that follows it */
+  long saved_offset;		/* resume_offset last saved in checkpoint */
+  int watch_fd;			/* inotify instance watching input, or -1 */
+} plot_input;
+
+/* A page split off from the input, to be rendered on a Plotter of its own
+   and written to a separate output file (see -o option).  It begins with
+   an OPENPL, unless the input is in a pre-modern format. */
+typedef struct plot_page_struct
+{
+  unsigned char *data;		/* page data, null-terminated */
+  size_t len;			/* length of data */
+  plot_format format;		/* format of data */
+  int number;			/* page number */
+  struct plot_page_struct *next; /* next page in queue */
+} plot_page;
+
+/* Pages to be written to separate output files are passed to a renderer,
+   which renders them on the current thread, or queues them for a pool of
+   threads. */
+typedef struct
+{
+  const char *output_format;	/* libplot output format */
+  plPlotterParams *plotter_params; /* Plotter parameters */
+  const char *output_template;	/* template for output file names */
+  bool failed;			/* some page couldn't be rendered? */
+  bool newest_only;		/* render only the newest page (see --follow)? */
+  plot_page *newest;		/* newest page, if not yet rendered */
+#ifdef PAGE_THREADS
+  int num_threads;		/* number of threads in pool */
+  pthread_t *threads;		/* the threads */
+  pthread_mutex_t lock;		/* protects the members below */
+  pthread_cond_t nonempty;	/* signalled when a page is queued */
+  pthread_cond_t nonfull;	/* signalled when a page is dequeued */
+  plot_page *head, *tail;	/* queue of pages */
+  int queue_len;		/* length of queue */
+  bool done;			/* no more pages will be queued */
+#endif
+} page_renderer;
+
+/* If the output is a GNU metafile, pages can be passed to a copier
+   instead, which appends each page that's in the output's metafile format
+   to the output verbatim, rather than replaying it on a MetaPlotter (see
+   copy_page()).  Only the header, the CLOSEPL that ends each page, and the
+   page index (if any) are written afresh. */
+typedef struct
+{
+  plot_format format;		/* metafile format of output */
+  bool page_index;		/* append an index of pages? */
+  plPlotterParams *plotter_params; /* for re-encoding pages in other formats */
+  FILE *stream;			/* output stream */
+  long offset;			/* number of bytes written to it */
+  int num_pages;		/* number of pages written to it */
+  long *page_offsets;		/* offset of each page's OPENPL */
+  int page_offsets_len;		/* size of page_offsets array */
+  bool failed;			/* some page couldn't be written? */
+} page_copier;
+
+/* Size of input buffer; this is also the maximum block size. */
+#define INPUT_BUFFER_LEN 65536
+
+/* Maximum length of a number in a portable (ascii) metafile. */
+#define MAX_NUMBER_LEN 128
+
+/* Maximum length of a line of the page index at the end of a metafile. */
+#define MAX_PAGE_INDEX_LINE_LEN 64
+
+/* Maximum number of characters that replacing the page number conversion
+   in an output file name template (e.g. `%04d') can add to it. */
+#define MAX_PAGE_NUMBER_LEN 128
+
+/* Maximum number of pages waiting to be rendered, per thread. */
+#define PAGES_QUEUED_PER_THREAD 2
+
+/* A gzip-compressed stream begins with a byte (0x1f) that can't begin a
+   metafile or plot(5) file. */
+#define GZIP_MAGIC_BYTE 0x1f
+#define DECOMPRESSION_CHUNK_LEN 16384
+
 const char *progname = "plot";	/* name of this program */
 const char *written = "Written by Robert S. Maier.";
 const char *copyright = "Copyright (C) 2009 Free Software Foundation, Inc.";
@@ -69,32 +216,70 @@ const char *copyright = "Copyright (C) 2009 Free Software Foundation, Inc.";
 const char *usage_appendage = " [FILE]...\n\
 With no FILE, or when FILE is -, read standard input.\n";
 
-bool single_page_is_requested = false; /* set if user uses -p option */
+bool pages_are_requested = false; /* set if user uses -p option */
 char *bg_color = NULL;		/* initial bg color, can be spec'd by user */
 char *font_name = NULL;		/* initial font name, can be spec'd by user */
 char *pen_color = NULL;		/* initial pen color, can be spec'd by user */
 double font_size = -1.0;	/* initial fractional size, <0 means default */
 double line_width = -1.0;	/* initial line width, <0 means default */
-int requested_page = 0;		/* user sets this via -p option */
+int first_requested_page = 0;	/* user sets this via -p option */
+int last_requested_page = 0;	/* ditto (INT_MAX means last page of all) */
+
+/* Whether a page should be displayed */
+#define PAGE_IS_REQUESTED(page) (pages_are_requested == false \
+	|| ((page) >= first_requested_page && (page) <= last_requested_page))
 
 /* Default input file format (see list of supported formats above).  Don't
    change this (GNU_OLD_BINARY is an obsolete format, but it subsumes
    plot(5) format on many operating systems).  We'll switch to the
    appropriate modern format by peeking at the first line of the input file. */
 plot_format user_specified_input_format = GNU_OLD_BINARY;
-plot_format input_format = GNU_OLD_BINARY;
 
 /* Whether to remove all page breaks and frame breaks (i.e. invocations
    of erase()) from the output */
 bool merge_pages = false;
 
+/* Name of output file (NULL means stdout), or if it contains a page
+   number conversion such as `%d', template for the names of separate
+   output files, one per page.  In the latter case, pages are split off
+   from the input and passed to a renderer, which may use several threads. */
+char *output_file = NULL;
+int num_threads = 1;		/* user sets this via --threads option */
+page_renderer *renderer = NULL;	/* non-NULL if pages are split off */
+
+/* Name of the input file, if it's to be followed as it grows (see --follow
+   option), rather than read only until its end.  Each time its end is
+   reached, the offset after the last completed page is saved in a
+   checkpoint file (named after the output file, or the template for
+   output file names, or if there's none, the input file; see
+   checkpoint_name()), so that a later run can resume there. */
+bool follow_input = false;	/* user sets this via --follow option */
+char *followed_file = NULL;
+
+/* Interval between checks of the size of a followed file, in seconds,
+   if inotify isn't available. */
+#define FOLLOW_POLL_INTERVAL 1
+
+/* Suffix appended to a file name, to name the checkpoint file. */
+#define CHECKPOINT_SUFFIX ".follow"
+
+/* Whether the metafile output was requested in portable or compact format
+   (see -O and --compact-output options), and whether any other option
+   that may alter the output sets a Plotter parameter.  If the output is a
+   metafile and the latter is false, pages are copied rather than replayed,
+   whenever that yields the same drawing (see can_copy_pages()). */
+bool portable_output = false;
+bool compact_output = false;
+bool output_params_given = false;
+page_copier *copier = NULL;	/* non-NULL if pages are copied */
+
 /* options */
 
 #define	ARG_NONE	0
 #define	ARG_REQUIRED	1
 #define	ARG_OPTIONAL	2
 
-const char *optstring = "shlAIOp:F:f:W:T:";
+const char *optstring = "shlAIOo:p:F:f:W:T:";
 
 struct option long_options[] = 
 {
@@ -109,14 +294,19 @@ struct option long_options[] =
   { "bg-color",		ARG_REQUIRED,	NULL, 'q' << 8 },
   { "bitmap-size",	ARG_REQUIRED,	NULL, 'B' << 8 },
   { "emulate-color",	ARG_REQUIRED,	NULL, 'e' << 8},  
+  { "follow",		ARG_NONE,	NULL, 'w' << 8 },
   { "max-line-length",	ARG_REQUIRED,	NULL, 'M' << 8 },
   { "merge-pages",	ARG_NONE,	NULL, 's' },
+  { "output-file",	ARG_REQUIRED,	NULL, 'o' },
   { "page-number",	ARG_REQUIRED,	NULL, 'p' },
   { "page-size",	ARG_REQUIRED,	NULL, 'P' << 8 },
   { "pen-color",	ARG_REQUIRED,	NULL, 'C' << 8 },
   { "rotation",		ARG_REQUIRED,	NULL, 'r' << 8},
+  { "threads",		ARG_REQUIRED,	NULL, 'j' << 8},
   /* Options relevant only to raw plot (refers to metafile output) */
   { "portable-output",	ARG_NONE,	NULL, 'O' },
+  { "compact-output",	ARG_NONE,	NULL, 'c' << 8 },
+  { "optimize",		ARG_NONE,	NULL, 'z' << 8 },
   /* Old input formats, for backward compatibility */
   { "high-byte-first-input",	ARG_NONE,	NULL, 'h' },
   { "low-byte-first-input",	ARG_NONE,	NULL, 'l' },
@@ -137,15 +327,55 @@ const int hidden_options[] = { (int)'I', (int)('T' << 8), 0 };
 
 
 /* forward references */
+FILE *decompress_input (plot_input *input);
+bool can_copy_pages (const char *output_format);
+bool copy_page (page_copier *dest, plot_page *page);
+bool fill_input (plot_input *input, size_t len);
+bool finish_copier (page_copier *dest);
+bool parse_plot (plPlotter *plotter, plot_input *in, int *page);
+bool read_binary (plot_input *input, void *ptr, size_t len, bool *badstatus);
+bool read_page_index (plot_input *input, long length);
 bool read_plot (plPlotter *plotter, FILE *in_stream);
-char *read_string (FILE *input, bool *badstatus);
-double read_float (FILE *input, bool *badstatus);
-double read_int (FILE *input, bool *badstatus);
-int maybe_closepl (plPlotter *plotter);
-int maybe_openpl (plPlotter *plotter);
-int read_true_int (FILE *input, bool *badstatus);
-unsigned char read_byte_as_unsigned_char (FILE *input, bool *badstatus);
-unsigned int read_byte_as_unsigned_int (FILE *input, bool *badstatus);
+bool resume_input (plot_input *input, int *page);
+bool render_page (plot_page *page);
+bool seek_input (plot_input *input, long position);
+bool skip_to_requested_page (plot_input *input, int *page, int first_page);
+bool wait_for_input (plot_input *input);
+bool write_copy (page_copier *dest, const unsigned char *data, size_t len);
+char *checkpoint_name (void);
+char *read_string (plot_input *input, bool *badstatus);
+const char *binary_arg_layout (int instruction);
+double read_ascii_number (plot_input *input, int conversion, bool *badstatus);
+double read_float (plot_input *input, bool *badstatus);
+double read_int (plot_input *input, bool *badstatus);
+float read_compact_float (plot_input *input, bool *badstatus);
+int count_page_conversions (const char *template);
+int maybe_closepl (plPlotter *plotter, plot_input *input);
+int maybe_openpl (plPlotter *plotter, plot_input *input, int page);
+int read_instruction (plot_input *input);
+int num_coordinates (int instruction);
+int read_true_int (plot_input *input, bool *badstatus);
+long input_offset (plot_input *input);
+size_t number_prefix_length (const char *s, int conversion);
+unsigned char read_byte_as_unsigned_char (plot_input *input, bool *badstatus);
+unsigned int read_byte_as_unsigned_int (plot_input *input, bool *badstatus);
+unsigned int read_zigzag (plot_input *input, bool *badstatus);
+void capture_input (plot_input *input, long offset);
+void finish_renderer (void);
+void init_input (plot_input *input, FILE *stream);
+void init_memory_input (plot_input *input, unsigned char *data, size_t len, plot_format format);
+void input_failed (plot_input *input, bool *badstatus);
+void load_page_index (plot_input *input);
+void render_newest_page (void);
+void save_checkpoint (plot_input *input);
+void skip_instructions (plot_input *input);
+void start_copier (void);
+void start_following (plot_input *input, int *page);
+void start_renderer (const char *output_format, plPlotterParams *plotter_params);
+void submit_page (plot_page *page);
+#ifdef PAGE_THREADS
+void *render_pages (void *arg);
+#endif
 
 
 int
@@ -158,8 +388,9 @@ main (int argc, char *argv[])
   bool show_usage = false;	/* show usage message? */
   bool show_version = false;	/* show version message? */
   char *output_format = (char *)"meta"; /* default libplot output format */
+  FILE *output_stream = stdout;	/* output stream, if not split into pages */
   int errcnt = 0;		/* errors encountered */
-  int local_page_number;	/* temporary storage */
+  long local_first_page, local_last_page; /* temporary storage */
   int opt_index;		/* long option index */
   int option;			/* option character */
   int retval;			/* return value */
@@ -179,6 +410,27 @@ main (int argc, char *argv[])
 	  break;
 	case 'O':		/* Ascii output */
 	  pl_setplparam (plotter_params, "META_PORTABLE", (void *)"yes");
+	  portable_output = true;
+	  break;
+	case 'c' << 8:		/* Compact binary output */
+	  pl_setplparam (plotter_params, "META_COMPACT", (void *)"yes");
+	  compact_output = true;
+	  break;
+	case 'z' << 8:		/* Merge paths in metafile output */
+	  pl_setplparam (plotter_params, "META_OPTIMIZE", (void *)"yes");
+	  output_params_given = true;
+	  break;
+	case 'o':		/* Output file, or template for names of files */
+	  if (count_page_conversions (optarg) < 0)
+	    {
+	      fprintf (stderr,
+		       "%s: error: the output file name `%s' is bad (it may contain at most one page number conversion, such as `%%d' or `%%04d')\n",
+		       progname, optarg);
+	      errcnt++;
+	      break;
+	    }
+	  output_file = (char *)xmalloc (strlen (optarg) + 1);
+	  strcpy (output_file, optarg);
 	  break;
 	case 'F':		/* set the initial font */
 	  font_name = (char *)xmalloc (strlen (optarg) + 1);
@@ -186,6 +438,7 @@ main (int argc, char *argv[])
 	  break;
 	case 'e' << 8:		/* emulate color by grayscale */
 	  pl_setplparam (plotter_params, "EMULATE_COLOR", (void *)optarg);
+	  output_params_given = true;
 	  break;
 	case 'C' << 8:		/* set the initial pen color */
 	  pen_color = (char *)xmalloc (strlen (optarg) + 1);
@@ -197,9 +450,11 @@ main (int argc, char *argv[])
 	  break;
 	case 'B' << 8:		/* Bitmap size */
 	  pl_setplparam (plotter_params, "BITMAPSIZE", (void *)optarg);
+	  output_params_given = true;
 	  break;
 	case 'P' << 8:		/* Page size */
 	  pl_setplparam (plotter_params, "PAGESIZE", (void *)optarg);
+	  output_params_given = true;
 	  break;
 	case 'f':		/* set the initial fontsize */
 	  {
@@ -223,20 +478,41 @@ main (int argc, char *argv[])
 	      font_size = local_font_size;
 	    break;
 	  }
-	case 'p':		/* page number */
-	  if (sscanf (optarg, "%d", &local_page_number) <= 0
-	      || local_page_number < 1)
-	    {
-	      fprintf (stderr,
-		       "%s: error: the page number `%s' is bad (it should be a positive integer)\n",
-		       progname, optarg);
-	      errcnt++;
-	    }
-	  else
-	    {
-	      requested_page = local_page_number;
-	      single_page_is_requested = true;
-	    }
+	case 'p':		/* page number, or range of page numbers */
+	  {
+	    char *first_end, *last_end;
+
+	    local_first_page = strtol (optarg, &first_end, 10);
+	    local_last_page = local_first_page;
+	    if (first_end != optarg && *first_end == '-')
+	      /* a range, N-M, or N- (meaning N through last page) */
+	      {
+		if (*(first_end + 1) == '\0')
+		  local_last_page = INT_MAX;
+		else
+		  {
+		    local_last_page = strtol (first_end + 1, &last_end, 10);
+		    if (last_end == first_end + 1)
+		      local_last_page = 0; /* bad */
+		  }
+	      }
+	    if (first_end == optarg || local_first_page < 1 
+		|| local_first_page > INT_MAX
+		|| local_last_page < local_first_page
+		|| local_last_page > INT_MAX)
+	      {
+		fprintf (stderr,
+			 "%s: error: the page number `%s' is bad (it should be a positive integer, or a range such as 3-5)\n",
+			 progname, optarg);
+		errcnt++;
+	      }
+	    else
+	      {
+		first_requested_page = (int)local_first_page;
+		last_requested_page = (int)local_last_page;
+		pages_are_requested = true;
+	      }
+	  }
 	  break;
 	case 'W':		/* set the initial line width */
 	  {
@@ -269,13 +545,36 @@ main (int argc, char *argv[])
 	  break;
 	case 'r' << 8:		/* Plot rotation angle, ARG REQUIRED	*/
 	  pl_setplparam (plotter_params, "ROTATION", (void *)optarg);
+	  output_params_given = true;
 	  break;
 	case 'M' << 8:		/* Max line length */
 	  pl_setplparam (plotter_params, "MAX_LINE_LENGTH", (void *)optarg);
+	  output_params_given = true;
 	  break;
 	case 's':		/* Merge pages */
 	  merge_pages = true;
 	  break;
+	case 'w' << 8:		/* Follow growing input file */
+	  follow_input = true;
+	  break;
+	case 'j' << 8:		/* Number of threads, ARG REQUIRED */
+	  {
+	    char *end;
+	    long local_num_threads;
+
+	    local_num_threads = strtol (optarg, &end, 10);
+	    if (end == optarg || *end != '\0' || local_num_threads < 1
+		|| local_num_threads > INT_MAX)
+	      {
+		fprintf (stderr,
+			 "%s: error: the number of threads `%s' is bad (it should be a positive integer)\n",
+			 progname, optarg);
+		errcnt++;
+	      }
+	    else
+	      num_threads = (int)local_num_threads;
+	  }
+	  break;
 
 	case 'V' << 8:		/* Version */
 	  show_version = true;
@@ -336,11 +635,76 @@ main (int argc, char *argv[])
     /* select user-specified background color */
     pl_setplparam (plotter_params, "BG_COLOR", (void *)bg_color);
 
-  if ((plotter = pl_newpl_r (output_format, NULL, stdout, stderr,
-			     plotter_params)) == NULL)
+  if (follow_input)
     {
-      fprintf (stderr, "%s: error: the plot device could not be created\n", progname);
-      return EXIT_FAILURE;
+      if (optind != argc - 1 || strcmp (argv[optind], "-") == 0)
+	{
+	  fprintf (stderr, "%s: error: only a single input file, named on the command line, can be followed\n",
+		   progname);
+	  return EXIT_FAILURE;
+	}
+      followed_file = argv[optind];
+      /* pages are rendered as soon as they're completed, in order */
+      num_threads = 1;
+    }
+
+  if (can_copy_pages (output_format))
+    /* pages will be copied to the output, or split off and copied to
+       separate files, rather than replayed */
+    start_copier ();
+
+  if (output_file 
+      && (count_page_conversions (output_file) > 0 || follow_input))
+    /* each page will be written to a separate file, or if the input is
+       followed and there's no page number conversion, the newest page
+       will repeatedly be written to the output file */
+    {
+      if (merge_pages)
+	{
+	  fprintf (stderr, "%s: error: pages can't be merged if each is written to a separate file\n",
+		   progname);
+	  return EXIT_FAILURE;
+	}
+      if (strcmp (output_format, "X") == 0)
+	{
+	  fprintf (stderr, "%s: error: pages can't be written to files if the output format is `X'\n",
+		   progname);
+	  return EXIT_FAILURE;
+	}
+      start_renderer (output_format, plotter_params);
+      renderer->newest_only = (count_page_conversions (output_file) == 0);
+      plotter = (plPlotter *)NULL; /* input is only split into pages */
+    }
+  else
+    {
+      if (output_file)
+	{
+	  char *name;
+
+	  /* name contains no conversion, but may contain `%%' */
+	  name = (char *)xmalloc (strlen (output_file) + 1);
+	  sprintf (name, output_file, 0);
+	  strcpy (output_file, name);
+	  free (name);
+	  output_stream = fopen (output_file, "w");
+	  if (output_stream == NULL)
+	    {
+	      fprintf (stderr, "%s: %s: %s\n", progname, output_file, 
+		       strerror (errno));
+	      return EXIT_FAILURE;
+	    }
+	}
+      if (copier)
+	{
+	  copier->stream = output_stream;
+	  plotter = (plPlotter *)NULL; /* input is only split into pages */
+	}
+      else if ((plotter = pl_newpl_r (output_format, NULL, output_stream, 
+				      stderr, plotter_params)) == NULL)
+	{
+	  fprintf (stderr, "%s: error: the plot device could not be created\n", progname);
+	  return EXIT_FAILURE;
+	}
     }
 
   if (merge_pages)
@@ -412,11 +776,34 @@ main (int argc, char *argv[])
 	return EXIT_FAILURE;
       }
 
-  if (pl_deletepl_r (plotter) < 0)
+  if (renderer)
+    /* wait for all pages to be written */
     {
-      fprintf (stderr, "%s: error: the plot device could not be deleted\n", progname);
-      retval = EXIT_FAILURE;
+      finish_renderer ();
+      if (renderer->failed)
+	retval = EXIT_FAILURE;
+    }
+  else
+    {
+      if (copier)
+	{
+	  if (finish_copier (copier) == false)
+	    retval = EXIT_FAILURE;
+	}
+      else if (pl_deletepl_r (plotter) < 0)
+	{
+	  fprintf (stderr, "%s: error: the plot device could not be deleted\n", progname);
+	  retval = EXIT_FAILURE;
+	}
+      if (output_stream != stdout && fclose (output_stream) < 0)
+	{
+	  fprintf (stderr, "%s: %s: %s\n", progname, output_file, 
+		   strerror (errno));
+	  retval = EXIT_FAILURE;
+	}
     }
+  if (copier)
+    pl_deleteplparams (copier->plotter_params);
   pl_deleteplparams (plotter_params);
 
   return retval;
@@ -429,6 +816,71 @@ main (int argc, char *argv[])
    successfully. */
 bool
 read_plot (plPlotter *plotter, FILE *in_stream)
+{
+  static int current_page = 1;	/* page count is continued from file to file */
+  plot_input input;
+  FILE *plain_stream = NULL;
+  bool success;
+
+  init_input (&input, in_stream);
+
+  /* if input is gzip-compressed, decompress it first */
+  if (fill_input (&input, 1) 
+      && input.buffer[input.start] == GZIP_MAGIC_BYTE)
+    {
+      if (followed_file)
+	{
+	  fprintf (stderr, "%s: error: a compressed input file can't be followed\n",
+		   progname);
+	  free (input.buffer);
+	  return false;
+	}
+      plain_stream = decompress_input (&input);
+      free (input.buffer);
+      if (plain_stream == NULL)
+	return false;
+      init_input (&input, plain_stream);
+    }
+
+  /* if only certain pages are to be displayed, a page index at the end of
+     the input will let us go directly to them */
+  if (pages_are_requested && followed_file == NULL)
+    load_page_index (&input);
+
+  /* User may specify one of the formats PLOT5_HIGH, PLOT5_LOW, and
+     GNU_OLD_PORTABLE on the command line.  If user doesn't specify a
+     format, this is by default set to GNU_OLD_BINARY [obsolete], and
+     parse_plot() will figure out whether the file is in a modern format,
+     and if so, which one. */
+  input.format = user_specified_input_format;
+
+  if (followed_file)
+    start_following (&input, &current_page);
+
+  success = parse_plot (plotter, &input, &current_page);
+  free (input.buffer);
+  if (input.checkpoint)
+    free (input.checkpoint);
+#ifdef HAVE_SYS_INOTIFY_H
+  if (input.watch_fd >= 0)
+    close (input.watch_fd);
+#endif
+  if (input.capture)		/* page being split off was incomplete */
+    free (input.capture);
+  if (input.page_offsets)
+    free (input.page_offsets);
+  if (plain_stream)
+    fclose (plain_stream);
+
+  return success;
+}
+
+/* parse_plot() does the work of read_plot(), reading from an input
+   buffer.  `*page' is the number of the first page in the input, and is
+   updated.  If `plotter' is NULL, nothing is drawn; instead, the pages are
+   split off and passed to the renderer. */
+bool
+parse_plot (plPlotter *plotter, plot_input *in, int *page)
 {
   bool argerr = false;	/* error occurred while reading argument? */
   bool display_open = false;	/* display device open? */
@@ -440,26 +892,23 @@ read_plot (plPlotter *plotter, FILE *in_stream)
   double x0, y0, x1, y1, x2, y2, x3, y3;
   int i0, i1, i2;
   int instruction;
-  static int current_page = 1;	/* page count is continued from file to file */
-  
-  /* User may specify one of the formats PLOT5_HIGH, PLOT5_LOW, and
-     GNU_OLD_PORTABLE on the command line.  If user doesn't specify a
-     format, this is by default set to GNU_OLD_BINARY [obsolete], and we'll
-     figure out whether the file is in a modern format, and if so, 
-     which one. */
-  input_format = user_specified_input_format;
+  int current_page = *page;
+  int first_page = current_page; /* number of first page in this file */
+  bool displaying;		/* drawing the current page? */
+
+  displaying = (plotter != NULL && PAGE_IS_REQUESTED (current_page));
 
   /* peek at first instruction in file */
-  instruction = getc (in_stream);
+  instruction = read_instruction (in);
 
   /* Switch away from GNU_OLD_BINARY to GNU_BINARY if a GNU metafile magic
      string, interpreted here as a comment, is seen at top of file.  See
      also parsing of the COMMENT instruction below (we further switch to
      GNU_PORTABLE if the header line indicates we should). */
-  if (input_format == GNU_OLD_BINARY && instruction == (int)O_COMMENT)
-    input_format = GNU_BINARY;
+  if (in->format == GNU_OLD_BINARY && instruction == (int)O_COMMENT)
+    in->format = GNU_BINARY;
 
-/* Note: we use `input_format' as a way of working around a problem:
+/* Note: we use `in->format' as a way of working around a problem:
    absurdly large font size requests, which can crash X servers.  (You used
    to be able to crash an X server by piping any EPS file to `plot -TX',
    since the `S' on the first line was interepreted as an op code for a
@@ -472,11 +921,11 @@ read_plot (plPlotter *plotter, FILE *in_stream)
       /* If a pre-modern format, OPENPL directive is not supported.  So
 	 open display device if it hasn't already been opened, and
 	 we're on the right page. */
-      if (input_format != GNU_BINARY && input_format != GNU_PORTABLE)
-	if ((!single_page_is_requested || current_page == requested_page)
+      if (!IS_MODERN_FORMAT (in->format))
+	if (PAGE_IS_REQUESTED (current_page)
 	    && instruction != (int)O_COMMENT && display_open == false)
 	  {
-	    if (maybe_openpl (plotter) < 0)
+	    if (maybe_openpl (plotter, in, current_page) < 0)
 	      {
 		fprintf (stderr, "%s: error: the plot device could not be opened\n", 
 			 progname);
@@ -492,180 +941,181 @@ read_plot (plPlotter *plotter, FILE *in_stream)
 	  {
 	    char x_adjust, y_adjust;
 
-	    x_adjust = (char)read_byte_as_unsigned_char (in_stream, &argerr);
-	    y_adjust = (char)read_byte_as_unsigned_char (in_stream, &argerr); 
-	    s = read_string (in_stream, &argerr);
+	    x_adjust = (char)read_byte_as_unsigned_char (in, &argerr);
+	    y_adjust = (char)read_byte_as_unsigned_char (in, &argerr); 
+	    s = read_string (in, &argerr);
 	    if (!argerr)
 	      {
-		if (!single_page_is_requested || current_page == requested_page)
+		if (displaying)
 		  pl_alabel_r (plotter, x_adjust, y_adjust, s);
 		free (s);
 	      }
 	  }
 	  break;
 	case (int)O_ARC:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr); 
-	  x2 = read_int (in_stream, &argerr);
-	  y2 = read_int (in_stream, &argerr); 
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
+	  y1 = read_int (in, &argerr); 
+	  x2 = read_int (in, &argerr);
+	  y2 = read_int (in, &argerr); 
+	  if (!argerr)
+	    if (displaying)
 	      pl_farc_r (plotter, x0, y0, x1, y1, x2, y2);
 	  break;
 	case (int)O_ARCREL:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr); 
-	  x2 = read_int (in_stream, &argerr);
-	  y2 = read_int (in_stream, &argerr); 
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
+	  y1 = read_int (in, &argerr); 
+	  x2 = read_int (in, &argerr);
+	  y2 = read_int (in, &argerr); 
+	  if (!argerr)
+	    if (displaying)
 	      pl_farcrel_r (plotter, x0, y0, x1, y1, x2, y2);
 	  break;
 	case (int)O_BEZIER2:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr); 
-	  x2 = read_int (in_stream, &argerr);
-	  y2 = read_int (in_stream, &argerr); 
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
+	  y1 = read_int (in, &argerr); 
+	  x2 = read_int (in, &argerr);
+	  y2 = read_int (in, &argerr); 
+	  if (!argerr)
+	    if (displaying)
 	      pl_fbezier2_r (plotter, x0, y0, x1, y1, x2, y2);
 	  break;
 	case (int)O_BEZIER2REL:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr); 
-	  x2 = read_int (in_stream, &argerr);
-	  y2 = read_int (in_stream, &argerr); 
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
+	  y1 = read_int (in, &argerr); 
+	  x2 = read_int (in, &argerr);
+	  y2 = read_int (in, &argerr); 
+	  if (!argerr)
+	    if (displaying)
 	      pl_fbezier2rel_r (plotter, x0, y0, x1, y1, x2, y2);
 	  break;
 	case (int)O_BEZIER3:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr); 
-	  x2 = read_int (in_stream, &argerr);
-	  y2 = read_int (in_stream, &argerr); 
-	  x3 = read_int (in_stream, &argerr);
-	  y3 = read_int (in_stream, &argerr); 
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
+	  y1 = read_int (in, &argerr); 
+	  x2 = read_int (in, &argerr);
+	  y2 = read_int (in, &argerr); 
+	  x3 = read_int (in, &argerr);
+	  y3 = read_int (in, &argerr); 
+	  if (!argerr)
+	    if (displaying)
 	      pl_fbezier3_r (plotter, x0, y0, x1, y1, x2, y2, x3, y3);
 	  break;
 	case (int)O_BEZIER3REL:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr); 
-	  x2 = read_int (in_stream, &argerr);
-	  y2 = read_int (in_stream, &argerr); 
-	  x3 = read_int (in_stream, &argerr);
-	  y3 = read_int (in_stream, &argerr); 
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
+	  y1 = read_int (in, &argerr); 
+	  x2 = read_int (in, &argerr);
+	  y2 = read_int (in, &argerr); 
+	  x3 = read_int (in, &argerr);
+	  y3 = read_int (in, &argerr); 
+	  if (!argerr)
+	    if (displaying)
 	      pl_fbezier3rel_r (plotter, x0, y0, x1, y1, x2, y2, x3, y3);
 	  break;
 	case (int)O_BGCOLOR:
 	  /* parse args as unsigned ints rather than ints */
-	  i0 = read_true_int (in_stream, &argerr)&0xFFFF;
-	  i1 = read_true_int (in_stream, &argerr)&0xFFFF;
-	  i2 = read_true_int (in_stream, &argerr)&0xFFFF;
+	  i0 = read_true_int (in, &argerr)&0xFFFF;
+	  i1 = read_true_int (in, &argerr)&0xFFFF;
+	  i2 = read_true_int (in, &argerr)&0xFFFF;
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_bgcolor_r (plotter, i0, i1, i2);
 	  break;
 	case (int)O_BOX:
-	  	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr); 
+	  	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
+	  y1 = read_int (in, &argerr); 
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fbox_r (plotter, x0, y0, x1, y1);
 	  break;
 	case (int)O_BOXREL:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr); 
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
+	  y1 = read_int (in, &argerr); 
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fboxrel_r (plotter, x0, y0, x1, y1);
 	  break;
 	case (int)O_CAPMOD:
-	  s = read_string (in_stream, &argerr);
+	  s = read_string (in, &argerr);
 	  if (!argerr)
 	    {
-	      if (!single_page_is_requested || current_page == requested_page)
+	      if (displaying)
 		pl_capmod_r (plotter, s);
 	      free (s);
 	    }
 	  break;
 	case (int)O_CIRCLE:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fcircle_r (plotter, x0, y0, x1);
 	  break;
 	case (int)O_CIRCLEREL:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fcirclerel_r (plotter, x0, y0, x1);
 	  break;
 	case (int)O_COLOR:	/* obsolete op code, to be removed */
-	  i0 = read_true_int (in_stream, &argerr)&0xFFFF;
-	  i1 = read_true_int (in_stream, &argerr)&0xFFFF;
-	  i2 = read_true_int (in_stream, &argerr)&0xFFFF;
+	  i0 = read_true_int (in, &argerr)&0xFFFF;
+	  i1 = read_true_int (in, &argerr)&0xFFFF;
+	  i2 = read_true_int (in, &argerr)&0xFFFF;
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_color_r (plotter, i0, i1, i2);
 	  break;
 	case (int)O_CLOSEPATH:
-	  if (!single_page_is_requested || current_page == requested_page)
+	  if (displaying)
 	    pl_closepath_r (plotter);
 	  break;
 	case (int)O_CLOSEPL:
-	  if (input_format != GNU_BINARY && input_format != GNU_PORTABLE)
+	  if (!IS_MODERN_FORMAT (in->format))
 	    /* shouldn't be seeing a CLOSEPL */
 	    {
-	      if (display_open && maybe_closepl (plotter) < 0)
+	      if (display_open && maybe_closepl (plotter, in) < 0)
 		{
 		  fprintf (stderr, "%s: error: the plot device could not be closed\n",
 			   progname);
 		  exit (EXIT_FAILURE);
 		}
 	      current_page++;
+	      *page = current_page;
 	      return false;	/* signal a parse error */
 	    }
 	  else
-	    /* GNU_BINARY or GNU_PORTABLE format, so this may be legitimate */
+	    /* a modern format, so this may be legitimate */
 	    {
 	      if (in_page == false)
 		/* shouldn't be seeing a CLOSEPL */
 		{
 		  current_page++;
+		  *page = current_page;
 		  return false;	/* signal a parse error */
 		}
 	      else
 		/* the CLOSEPL is legitimate */
 		{
-		  if (!single_page_is_requested 
-		      || current_page == requested_page)
+		  if (PAGE_IS_REQUESTED (current_page))
 		    {
-		      if (maybe_closepl (plotter) < 0)
+		      if (maybe_closepl (plotter, in) < 0)
 			{
 			  fprintf (stderr, 
 				   "%s: error: the plot device could not be closed\n", 
@@ -676,27 +1126,38 @@ read_plot (plPlotter *plotter, FILE *in_stream)
 		    }
 		  in_page = false;
 		  current_page++; /* `page' is an OPENPL..CLOSEPL */
+		  displaying = (plotter != NULL 
+				&& PAGE_IS_REQUESTED (current_page));
+		  if (in->follow)
+		    /* a later run can resume here (see --follow) */
+		    {
+		      in->resume_offset = input_offset (in);
+		      in->resume_page = current_page;
+		    }
 		}
 	    }
 	  break;
 	case (int)O_COMMENT:
-	  s = read_string (in_stream, &argerr);
+	  s = read_string (in, &argerr);
 	  if (!argerr)
 	    {
 	      /* if a header line, switch to appropriate modern format */
 	      if (first_command
-		  && input_format != PLOT5_HIGH
-		  && input_format != PLOT5_LOW
+		  && in->format != PLOT5_HIGH
+		  && in->format != PLOT5_LOW
 		  && (strlen (s) >= 6)
 		  /* check magic number */
 		  && strncmp (s, "PLOT ", 5) == 0)
 		switch (s[5])
 		  {
 		  case '1':
-		    input_format = GNU_BINARY;
+		    in->format = GNU_BINARY;
 		    break;		
 		  case '2':
-		    input_format = GNU_PORTABLE;
+		    in->format = GNU_PORTABLE;
+		    break;		
+		  case '3':
+		    in->format = GNU_COMPACT;
 		    break;		
 		  default:
 		    fprintf (stderr, 
@@ -708,144 +1169,143 @@ read_plot (plPlotter *plotter, FILE *in_stream)
 	    }
 	  break;
 	case (int)O_CONT:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fcont_r (plotter, x0, y0);
 	  break;
 	case (int)O_CONTREL:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fcontrel_r (plotter, x0, y0);
 	  break;
 	case (int)O_ELLARC:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr);
-	  x2 = read_int (in_stream, &argerr);
-	  y2 = read_int (in_stream, &argerr);
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
+	  y1 = read_int (in, &argerr);
+	  x2 = read_int (in, &argerr);
+	  y2 = read_int (in, &argerr);
+	  if (!argerr)
+	    if (displaying)
 	      pl_fellarc_r (plotter, x0, y0, x1, y1, x2, y2);	  
 	  break;
 	case (int)O_ELLARCREL:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr);
-	  x2 = read_int (in_stream, &argerr);
-	  y2 = read_int (in_stream, &argerr);
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
+	  y1 = read_int (in, &argerr);
+	  x2 = read_int (in, &argerr);
+	  y2 = read_int (in, &argerr);
+	  if (!argerr)
+	    if (displaying)
 	      pl_fellarcrel_r (plotter, x0, y0, x1, y1, x2, y2);	  
 	  break;
 	case (int)O_ELLIPSE:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr);
-	  x2 = read_int (in_stream, &argerr);
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
+	  y1 = read_int (in, &argerr);
+	  x2 = read_int (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fellipse_r (plotter, x0, y0, x1, y1, x2);
 	  break;
 	case (int)O_ELLIPSEREL:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr);
-	  x2 = read_int (in_stream, &argerr);
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
+	  y1 = read_int (in, &argerr);
+	  x2 = read_int (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fellipserel_r (plotter, x0, y0, x1, y1, x2);
 	  break;
 	case (int)O_ENDPATH:
-	  if (!single_page_is_requested || current_page == requested_page)
+	  if (displaying)
 	    pl_endpath_r (plotter);
 	  break;
 	case (int)O_ENDSUBPATH:
-	  if (!single_page_is_requested || current_page == requested_page)
+	  if (displaying)
 	    pl_endsubpath_r (plotter);
 	  break;
 	case (int)O_ERASE:
-	  if (!single_page_is_requested || current_page == requested_page)
+	  if (displaying)
 	    if (merge_pages == false) /* i.e. not merging frames */
 	      pl_erase_r (plotter);
 	  break;
 	case (int)O_FILLCOLOR:
 	  /* parse args as unsigned ints rather than ints */
-	  i0 = read_true_int (in_stream, &argerr)&0xFFFF;
-	  i1 = read_true_int (in_stream, &argerr)&0xFFFF;
-	  i2 = read_true_int (in_stream, &argerr)&0xFFFF;
+	  i0 = read_true_int (in, &argerr)&0xFFFF;
+	  i1 = read_true_int (in, &argerr)&0xFFFF;
+	  i2 = read_true_int (in, &argerr)&0xFFFF;
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fillcolor_r (plotter, i0, i1, i2);
 	  break;
 	case (int)O_FILLMOD:
-	  s = read_string (in_stream, &argerr);
+	  s = read_string (in, &argerr);
 	  if (!argerr)
 	    {
-	      if (!single_page_is_requested || current_page == requested_page)
+	      if (displaying)
 		pl_fillmod_r (plotter, s);
 	      free (s);
 	    }
 	  break;
 	case (int)O_FILLTYPE:
 	  /* parse args as unsigned ints rather than ints */
-	  i0 = read_true_int (in_stream, &argerr)&0xFFFF;
+	  i0 = read_true_int (in, &argerr)&0xFFFF;
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_filltype_r (plotter, i0);
 	  break;
 	case (int)O_FONTNAME:
-	  s = read_string (in_stream, &argerr);
+	  s = read_string (in, &argerr);
 	  if (!argerr)
 	    {
-	      if (!single_page_is_requested || current_page == requested_page)
+	      if (displaying)
 		pl_fontname_r (plotter, s);
 	      free (s);
 	    }
 	  break;
 	case (int)O_FONTSIZE:
-	  x0 = read_int (in_stream, &argerr);
-	  if (input_format == GNU_BINARY || input_format == GNU_PORTABLE)
+	  x0 = read_int (in, &argerr);
+	  if (IS_MODERN_FORMAT (in->format))
 	    /* workaround, see comment above */
 	    {
 	      if (!argerr)
-		if (!single_page_is_requested 
-		    || current_page == requested_page)
+		if (displaying)
 		  pl_ffontsize_r (plotter, x0);
 	    }
 	  break;
 	case (int)O_JOINMOD:
-	  s = read_string (in_stream, &argerr);
+	  s = read_string (in, &argerr);
 	  if (!argerr)
 	    {
-	      if (!single_page_is_requested || current_page == requested_page)
+	      if (displaying)
 		pl_joinmod_r (plotter, s);
 	      free (s);
 	    }
 	  break;
 	case (int)O_LABEL:
-	  s = read_string (in_stream, &argerr);
+	  s = read_string (in, &argerr);
 	  if (!argerr)
 	    {
-	      if (!single_page_is_requested || current_page == requested_page)
+	      if (displaying)
 		pl_label_r (plotter, s);
 	      free (s);
 	    }
 	  break;
 	case (int)O_LINE:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr); 
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
+	  y1 = read_int (in, &argerr); 
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fline_r (plotter, x0, y0, x1, y1);
 	  break;
 	case (int)O_LINEDASH:
@@ -853,96 +1313,97 @@ read_plot (plPlotter *plotter, FILE *in_stream)
 	    int n, i;
 	    double *dash_array, phase;
 
-	    n = read_true_int (in_stream, &argerr);
+	    n = read_true_int (in, &argerr);
 	    if (n > 0)
 	      dash_array = (double *)xmalloc((unsigned int)n * sizeof(double));
 	    else
 	      dash_array = NULL;
 	    for (i = 0; i < n; i++)
-	      dash_array[i] = read_int (in_stream, &argerr);
-	    phase = read_int (in_stream, &argerr);
+	      dash_array[i] = read_int (in, &argerr);
+	    phase = read_int (in, &argerr);
 	    if (!argerr)
-	      if (!single_page_is_requested || current_page == requested_page)
+	      if (displaying)
 		pl_flinedash_r (plotter, n, dash_array, phase);
 	    free (dash_array);
 	    break;
 	  }
 	case (int)O_LINEREL:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr); 
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
+	  y1 = read_int (in, &argerr); 
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_flinerel_r (plotter, x0, y0, x1, y1);
 	  break;
 	case (int)O_LINEMOD:
-	  s = read_string (in_stream, &argerr);
+	  s = read_string (in, &argerr);
 	  if (!argerr)
 	    {
-	      if (!single_page_is_requested || current_page == requested_page)
+	      if (displaying)
 		pl_linemod_r (plotter, s);
 	      free (s);
 	    }
 	  break;
 	case (int)O_LINEWIDTH:
-	  x0 = read_int (in_stream, &argerr);
+	  x0 = read_int (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_flinewidth_r (plotter, x0);
 	  break;
 	case (int)O_MARKER:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  i0 = read_true_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr);
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  i0 = read_true_int (in, &argerr);
+	  y1 = read_int (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fmarker_r (plotter, x0, y0, i0, y1);
 	  break;
 	case (int)O_MARKERREL:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  i0 = read_true_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr);
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  i0 = read_true_int (in, &argerr);
+	  y1 = read_int (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fmarkerrel_r (plotter, x0, y0, i0, y1);
 	  break;
 	case (int)O_MOVE:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fmove_r (plotter, x0, y0);
 	  break;
 	case (int)O_MOVEREL:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fmoverel_r (plotter, x0, y0);
 	  break;
 	case (int)O_OPENPL:
-	  if (input_format != GNU_BINARY && input_format != GNU_PORTABLE)
+	  if (!IS_MODERN_FORMAT (in->format))
 	    /* shouldn't be seeing an OPENPL */
 	    {
-	      if (display_open && maybe_closepl (plotter) < 0)
+	      if (display_open && maybe_closepl (plotter, in) < 0)
 		{
 		  fprintf (stderr, "%s: error: the plot device could not be closed\n",
 			   progname);
 		  exit (EXIT_FAILURE);
 		}
 	      current_page++;
+	      *page = current_page;
 	      return false;	/* signal a parse error */
 	    }
 	  else
-	    /* GNU_BINARY or GNU_PORTABLE format, so may be legitimate */
+	    /* a modern format, so may be legitimate */
 	    {
 	      if (in_page)
 		/* shouldn't be seeing another OPENPL */
 		{
-		  if (display_open && maybe_closepl (plotter) < 0)
+		  if (display_open && maybe_closepl (plotter, in) < 0)
 		    {
 		      fprintf (stderr, 
 			       "%s: error: the plot device could not be closed\n",
@@ -950,13 +1411,24 @@ read_plot (plPlotter *plotter, FILE *in_stream)
 		      exit (EXIT_FAILURE);
 		    }
 		  current_page++;
+		  *page = current_page;
 		  return false;	/* signal a parse error */
 		}
 
-	      /* this OPENPL is legitimate */
-	      if (!single_page_is_requested || current_page == requested_page)
+	      /* this OPENPL is legitimate; if the page isn't to be displayed
+		 and there's a page index, go directly to the next page that
+		 is (the OPENPL there will be read next) */
+	      if (!PAGE_IS_REQUESTED (current_page) && in->have_page_index
+		  && skip_to_requested_page (in, &current_page, first_page))
+		{
+		  displaying = (plotter != NULL
+				&& PAGE_IS_REQUESTED (current_page));
+		  break;
+		}
+
+	      if (PAGE_IS_REQUESTED (current_page))
 		{
-		  if (maybe_openpl (plotter) < 0)
+		  if (maybe_openpl (plotter, in, current_page) < 0)
 		    {
 		      fprintf (stderr, 
 			       "%s: error: the plot device could not be opened\n", 
@@ -971,61 +1443,60 @@ read_plot (plPlotter *plotter, FILE *in_stream)
 	    }
 	  break;
 	case (int)O_ORIENTATION:
-	  i0 = read_true_int (in_stream, &argerr);
+	  i0 = read_true_int (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_orientation_r (plotter, i0);
 	  break;
 	case (int)O_PENCOLOR:
 	  /* parse args as unsigned ints rather than ints */
-	  i0 = read_true_int (in_stream, &argerr)&0xFFFF;
-	  i1 = read_true_int (in_stream, &argerr)&0xFFFF;
-	  i2 = read_true_int (in_stream, &argerr)&0xFFFF;
+	  i0 = read_true_int (in, &argerr)&0xFFFF;
+	  i1 = read_true_int (in, &argerr)&0xFFFF;
+	  i2 = read_true_int (in, &argerr)&0xFFFF;
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_pencolor_r (plotter, i0, i1, i2);
 	  break;
 	case (int)O_PENTYPE:
 	  /* parse args as unsigned ints rather than ints */
-	  i0 = read_true_int (in_stream, &argerr)&0xFFFF;
+	  i0 = read_true_int (in, &argerr)&0xFFFF;
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_pentype_r (plotter, i0);
 	  break;
 	case (int)O_POINT:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fpoint_r (plotter, x0, y0);
 	  break;
 	case (int)O_POINTREL:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fpointrel_r (plotter, x0, y0);
 	  break;
 	case (int)O_RESTORESTATE:
-	  if (!single_page_is_requested || current_page == requested_page)
+	  if (displaying)
 	    pl_restorestate_r (plotter);
 	  break;
 	case (int)O_SAVESTATE:
-	  if (!single_page_is_requested || current_page == requested_page)
+	  if (displaying)
 	    pl_savestate_r (plotter);
 	  break;
 	case (int)O_SPACE:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr); 
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
+	  y1 = read_int (in, &argerr); 
 	  if (argerr)
 	    break;
-	  if (!single_page_is_requested || current_page == requested_page)
+	  if (displaying)
 	    pl_fspace_r (plotter, x0, y0, x1, y1);
-	  if (parameters_initted == false && 
-	      ((!single_page_is_requested && current_page == 1)
-	      || (single_page_is_requested && current_page == requested_page)))
+	  if (displaying && parameters_initted == false 
+	      && current_page == (pages_are_requested ? first_requested_page : 1))
 	    /* insert these after the call to space(), if user insists on
 	       including them (should estimate sizes better) */
 	    {
@@ -1041,19 +1512,18 @@ read_plot (plPlotter *plotter, FILE *in_stream)
 	    }
 	  break;
 	case (int)O_SPACE2:
-	  x0 = read_int (in_stream, &argerr);
-	  y0 = read_int (in_stream, &argerr);
-	  x1 = read_int (in_stream, &argerr);
-	  y1 = read_int (in_stream, &argerr); 
-	  x2 = read_int (in_stream, &argerr);
-	  y2 = read_int (in_stream, &argerr); 
+	  x0 = read_int (in, &argerr);
+	  y0 = read_int (in, &argerr);
+	  x1 = read_int (in, &argerr);
+	  y1 = read_int (in, &argerr); 
+	  x2 = read_int (in, &argerr);
+	  y2 = read_int (in, &argerr); 
 	  if (argerr)
 	    break;
-	  if (!single_page_is_requested || current_page == requested_page)
+	  if (displaying)
 	    pl_fspace2_r (plotter, x0, y0, x1, y1, x2, y2);
-	  if (parameters_initted == false && 
-	      ((!single_page_is_requested && current_page == 1)
-	      || (single_page_is_requested && current_page == requested_page)))
+	  if (displaying && parameters_initted == false 
+	      && current_page == (pages_are_requested ? first_requested_page : 1))
 	    /* insert these after the call to space2(), if user insists on
 	       including them (should estimate sizes better) */
 	    {
@@ -1074,190 +1544,190 @@ read_plot (plPlotter *plotter, FILE *in_stream)
 	    }
 	  break;
 	case (int)O_TEXTANGLE:
-	  x0 = read_int (in_stream, &argerr);
+	  x0 = read_int (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_ftextangle_r (plotter, x0);
 	  break;
 
         /* floating point counterparts to some of the above */
 	case (int)O_FARC:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr); 
-	  x2 = read_float (in_stream, &argerr);
-	  y2 = read_float (in_stream, &argerr); 
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr); 
+	  x2 = read_float (in, &argerr);
+	  y2 = read_float (in, &argerr); 
+	  if (!argerr)
+	    if (displaying)
 	      pl_farc_r (plotter, x0, y0, x1, y1, x2, y2);
 	  break;
 	case (int)O_FARCREL:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr); 
-	  x2 = read_float (in_stream, &argerr);
-	  y2 = read_float (in_stream, &argerr); 
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr); 
+	  x2 = read_float (in, &argerr);
+	  y2 = read_float (in, &argerr); 
+	  if (!argerr)
+	    if (displaying)
 	      pl_farcrel_r (plotter, x0, y0, x1, y1, x2, y2);
 	  break;
 	case (int)O_FBEZIER2:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr); 
-	  x2 = read_float (in_stream, &argerr);
-	  y2 = read_float (in_stream, &argerr); 
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr); 
+	  x2 = read_float (in, &argerr);
+	  y2 = read_float (in, &argerr); 
+	  if (!argerr)
+	    if (displaying)
 	      pl_fbezier2_r (plotter, x0, y0, x1, y1, x2, y2);
 	  break;
 	case (int)O_FBEZIER2REL:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr); 
-	  x2 = read_float (in_stream, &argerr);
-	  y2 = read_float (in_stream, &argerr); 
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr); 
+	  x2 = read_float (in, &argerr);
+	  y2 = read_float (in, &argerr); 
+	  if (!argerr)
+	    if (displaying)
 	      pl_fbezier2rel_r (plotter, x0, y0, x1, y1, x2, y2);
 	  break;
 	case (int)O_FBEZIER3:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr); 
-	  x2 = read_float (in_stream, &argerr);
-	  y2 = read_float (in_stream, &argerr); 
-	  x3 = read_float (in_stream, &argerr);
-	  y3 = read_float (in_stream, &argerr); 
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr); 
+	  x2 = read_float (in, &argerr);
+	  y2 = read_float (in, &argerr); 
+	  x3 = read_float (in, &argerr);
+	  y3 = read_float (in, &argerr); 
+	  if (!argerr)
+	    if (displaying)
 	      pl_fbezier3_r (plotter, x0, y0, x1, y1, x2, y2, x3, y3);
 	  break;
 	case (int)O_FBEZIER3REL:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr); 
-	  x2 = read_float (in_stream, &argerr);
-	  y2 = read_float (in_stream, &argerr); 
-	  x3 = read_float (in_stream, &argerr);
-	  y3 = read_float (in_stream, &argerr); 
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr); 
+	  x2 = read_float (in, &argerr);
+	  y2 = read_float (in, &argerr); 
+	  x3 = read_float (in, &argerr);
+	  y3 = read_float (in, &argerr); 
+	  if (!argerr)
+	    if (displaying)
 	      pl_fbezier3rel_r (plotter, x0, y0, x1, y1, x2, y2, x3, y3);
 	  break;
 	case (int)O_FBOX:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr); 
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr); 
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fbox_r (plotter, x0, y0, x1, y1);
 	  break;
 	case (int)O_FBOXREL:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr); 
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr); 
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fboxrel_r (plotter, x0, y0, x1, y1);
 	  break;
 	case (int)O_FCIRCLE:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fcircle_r (plotter, x0, y0, x1);
 	  break;
 	case (int)O_FCIRCLEREL:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fcirclerel_r (plotter, x0, y0, x1);
 	  break;
 	case (int)O_FCONT:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fcont_r (plotter, x0, y0);
 	  break;
 	case (int)O_FCONTREL:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fcontrel_r (plotter, x0, y0);
 	  break;
 	case (int)O_FELLARC:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr);
-	  x2 = read_float (in_stream, &argerr);
-	  y2 = read_float (in_stream, &argerr);
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr);
+	  x2 = read_float (in, &argerr);
+	  y2 = read_float (in, &argerr);
+	  if (!argerr)
+	    if (displaying)
 	      pl_fellarc_r (plotter, x0, y0, x1, y1, x2, y2);
 	  break;
 	case (int)O_FELLARCREL:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr);
-	  x2 = read_float (in_stream, &argerr);
-	  y2 = read_float (in_stream, &argerr);
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr);
+	  x2 = read_float (in, &argerr);
+	  y2 = read_float (in, &argerr);
+	  if (!argerr)
+	    if (displaying)
 	      pl_fellarcrel_r (plotter, x0, y0, x1, y1, x2, y2);
 	  break;
 	case (int)O_FELLIPSE:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr);
-	  x2 = read_float (in_stream, &argerr);
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr);
+	  x2 = read_float (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fellipse_r (plotter, x0, y0, x1, y1, x2);
 	  break;
 	case (int)O_FELLIPSEREL:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr);
-	  x2 = read_float (in_stream, &argerr);
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr);
+	  x2 = read_float (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fellipserel_r (plotter, x0, y0, x1, y1, x2);
 	  break;
 	case (int)O_FFONTSIZE:
-	  x0 = read_float (in_stream, &argerr);
-	  if (input_format == GNU_BINARY || input_format == GNU_PORTABLE)
+	  x0 = read_float (in, &argerr);
+	  if (IS_MODERN_FORMAT (in->format))
 	    /* workaround, see comment above */
 	    {
 	      if (!argerr)
-		if (!single_page_is_requested || current_page == requested_page)
+		if (displaying)
 		  pl_ffontsize_r (plotter, x0);
 	    }
 	  break;
 	case (int)O_FLINE:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr); 
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr); 
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fline_r (plotter, x0, y0, x1, y1);
 	  break;
 	case (int)O_FLINEDASH:
@@ -1265,92 +1735,109 @@ read_plot (plPlotter *plotter, FILE *in_stream)
 	    int n, i;
 	    double *dash_array, phase;
 
-	    n = read_true_int (in_stream, &argerr);
+	    n = read_true_int (in, &argerr);
 	    if (n > 0)
 	      dash_array = (double *)xmalloc((unsigned int)n * sizeof(double));
 	    else
 	      dash_array = NULL;
 	    for (i = 0; i < n; i++)
-	      dash_array[i] = read_float (in_stream, &argerr);
-	    phase = read_float (in_stream, &argerr);
+	      dash_array[i] = read_float (in, &argerr);
+	    phase = read_float (in, &argerr);
 	    if (!argerr)
-	      if (!single_page_is_requested || current_page == requested_page)
+	      if (displaying)
 		pl_flinedash_r (plotter, n, dash_array, phase);
 	    free (dash_array);
 	    break;
 	  }
 	case (int)O_FLINEREL:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr); 
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr); 
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_flinerel_r (plotter, x0, y0, x1, y1);
 	  break;
 	case (int)O_FLINEWIDTH:
-	  x0 = read_float (in_stream, &argerr);
+	  x0 = read_float (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_flinewidth_r (plotter, x0);
 	  break;
 	case (int)O_FMARKER:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  i0 = read_true_int (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr);
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  i0 = read_true_int (in, &argerr);
+	  y1 = read_float (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fmarker_r (plotter, x0, y0, i0, y1);
 	  break;
 	case (int)O_FMARKERREL:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  i0 = read_true_int (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr);
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  i0 = read_true_int (in, &argerr);
+	  y1 = read_float (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fmarkerrel_r (plotter, x0, y0, i0, y1);
 	  break;
 	case (int)O_FMOVE:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fmove_r (plotter, x0, y0);
 	  break;
 	case (int)O_FMOVEREL:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fmoverel_r (plotter, x0, y0);
 	  break;
 	case (int)O_FPOINT:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fpoint_r (plotter, x0, y0);
 	  break;
 	case (int)O_FPOINTREL:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  if (displaying)
 	    pl_fpointrel_r (plotter, x0, y0);
 	  break;
+	case (int)O_FPOLYLINE:	/* a run of fcont's, in compact format only */
+	  if (in->format != GNU_COMPACT)
+	    {
+	      unrec = true;
+	      break;
+	    }
+	  i0 = read_true_int (in, &argerr);
+	  if (i0 < 0)
+	    argerr = true;
+	  for ( ; i0 > 0 && !argerr; i0--)
+	    {
+	      x0 = read_float (in, &argerr);
+	      y0 = read_float (in, &argerr);
+	      if (!argerr)
+		if (displaying)
+		  pl_fcont_r (plotter, x0, y0);
+	    }
+	  break;
 	case (int)O_FSPACE:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr); 
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr); 
 	  if (argerr)
 	    break;
-	  if (!single_page_is_requested || current_page == requested_page)
+	  if (displaying)
 	    pl_fspace_r (plotter, x0, y0, x1, y1);
-	  if (parameters_initted == false && 
-	      ((!single_page_is_requested && current_page == 1)
-	      || (single_page_is_requested && current_page == requested_page)))
+	  if (displaying && parameters_initted == false 
+	      && current_page == (pages_are_requested ? first_requested_page : 1))
 	    /* insert these after the call to fspace(), if user insists on
 	       including them (should estimate sizes better) */
 	    {
@@ -1371,19 +1858,18 @@ read_plot (plPlotter *plotter, FILE *in_stream)
 	    }
 	  break;
 	case (int)O_FSPACE2:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr); 
-	  x2 = read_float (in_stream, &argerr);
-	  y2 = read_float (in_stream, &argerr); 
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr); 
+	  x2 = read_float (in, &argerr);
+	  y2 = read_float (in, &argerr); 
 	  if (argerr)
 	    break;
-	  if (!single_page_is_requested || current_page == requested_page)
+	  if (displaying)
 		pl_fspace2_r (plotter, x0, y0, x1, y1, x2, y2);
-	  if (parameters_initted == false && 
-	      ((!single_page_is_requested && current_page == 1)
-	      || (single_page_is_requested && current_page == requested_page)))
+	  if (displaying && parameters_initted == false 
+	      && current_page == (pages_are_requested ? first_requested_page : 1))
 	    /* insert these after the call to fspace2(), if user insists on
 	       including them (should estimate sizes better) */
 	    {
@@ -1404,43 +1890,42 @@ read_plot (plPlotter *plotter, FILE *in_stream)
 	    }
 	  break;
 	case (int)O_FTEXTANGLE:
-	  x0 = read_float (in_stream, &argerr);
+	  x0 = read_float (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_ftextangle_r (plotter, x0);
 	  break;
 
         /* floating point routines with no integer counterpart */
 	case (int)O_FCONCAT:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr); 
-	  x2 = read_float (in_stream, &argerr);
-	  y2 = read_float (in_stream, &argerr); 
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr); 
+	  x2 = read_float (in, &argerr);
+	  y2 = read_float (in, &argerr); 
+	  if (!argerr)
+	    if (displaying)
 	      pl_fconcat_r (plotter, x0, y0, x1, y1, x2, y2);
 	  break;
 	case (int)O_FMITERLIMIT:
-	  x0 = read_float (in_stream, &argerr);
+	  x0 = read_float (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fmiterlimit_r (plotter, x0);
 	  break;
 	case (int)O_FSETMATRIX:
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
-	  x1 = read_float (in_stream, &argerr);
-	  y1 = read_float (in_stream, &argerr); 
-	  x2 = read_float (in_stream, &argerr);
-	  y2 = read_float (in_stream, &argerr); 
-	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
+	  x1 = read_float (in, &argerr);
+	  y1 = read_float (in, &argerr); 
+	  x2 = read_float (in, &argerr);
+	  y2 = read_float (in, &argerr); 
+	  if (!argerr)
+	    if (displaying)
 	      pl_fsetmatrix_r (plotter, x0, y0, x1, y1, x2, y2);
-	  if (parameters_initted == false && 
-	      ((!single_page_is_requested && current_page == 1)
-	      || (single_page_is_requested && current_page == requested_page)))
+	  if (displaying && parameters_initted == false 
+	      && current_page == (pages_are_requested ? first_requested_page : 1))
 	    /* insert these after the call to fsetmatrix(), if user insists
 	       on including them (should estimate sizes better) */
 	    {
@@ -1459,23 +1944,23 @@ read_plot (plPlotter *plotter, FILE *in_stream)
 	    }
 	  break;
 	case (int)O_FROTATE:	/* obsolete op code, to be removed */
-	  x0 = read_float (in_stream, &argerr);
+	  x0 = read_float (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_frotate_r (plotter, x0);
 	  break;
 	case (int)O_FSCALE:	/* obsolete op code, to be removed */
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_fscale_r (plotter, x0, y0);
 	  break;
 	case (int)O_FTRANSLATE:	/* obsolete op code, to be removed */
-	  x0 = read_float (in_stream, &argerr);
-	  y0 = read_float (in_stream, &argerr);
+	  x0 = read_float (in, &argerr);
+	  y0 = read_float (in, &argerr);
 	  if (!argerr)
-	    if (!single_page_is_requested || current_page == requested_page)
+	    if (displaying)
 	      pl_ftranslate_r (plotter, x0, y0);
 	  break;
 	case ' ':
@@ -1485,8 +1970,8 @@ read_plot (plPlotter *plotter, FILE *in_stream)
         case '\v':
         case '\f':
 	  /* extra whitespace is all right in portable formats */
-	  if (input_format == GNU_PORTABLE
-	      || input_format == GNU_OLD_PORTABLE)
+	  if (in->format == GNU_PORTABLE
+	      || in->format == GNU_OLD_PORTABLE)
 	    break;
 	  else			/* not harmless */
 	    unrec = true;
@@ -1506,7 +1991,7 @@ read_plot (plPlotter *plotter, FILE *in_stream)
 	}
       if (argerr)
 	{
-	  int eof = feof (in_stream);
+	  bool eof = in->eof;
 	  
 	  if (eof)
 	    fprintf (stderr, "%s: the input terminated prematurely\n",
@@ -1517,14 +2002,19 @@ read_plot (plPlotter *plotter, FILE *in_stream)
 	  break;		/* break out of while loop */
 	}
       
-      instruction = getc (in_stream); /* get next instruction */
+      /* within a page that isn't to be displayed, skip quickly over
+	 instructions that don't need to be examined closely */
+      if (in_page && in->format == GNU_BINARY && !displaying)
+	skip_instructions (in);
+
+      instruction = read_instruction (in); /* get next instruction */
     } /* end of while loop, EOF reached */
 
-  if (input_format != GNU_BINARY && input_format != GNU_PORTABLE)
+  if (!IS_MODERN_FORMAT (in->format))
     /* if a premodern format, this file contains only one page */
     {
       /* close display device at EOF, if it was ever opened */
-      if (display_open && maybe_closepl (plotter) < 0)
+      if (display_open && maybe_closepl (plotter, in) < 0)
 	{
 	  fprintf (stderr, "%s: error: the plot device could not be closed\n",
 		   progname);
@@ -1539,193 +2029,1416 @@ read_plot (plPlotter *plotter, FILE *in_stream)
       if (in_page)
 	/* shouldn't be the case; parse error */
 	{
-	  if (display_open && maybe_closepl (plotter) < 0)
+	  if (display_open && maybe_closepl (plotter, in) < 0)
 	    {
 	      fprintf (stderr, "%s: error: the plot device could not be closed\n",
 		       progname);
 	      exit (EXIT_FAILURE);
 	    }
 	  current_page++;
+	  *page = current_page;
 	  return false;		/* signal parse error */
 	}
     }
 
+  *page = current_page;
   return ((argerr || unrec) ? false : true); /* file parsed successfully? */
 }
 
+/* Decompress gzip-compressed input (as written by a Plotter with
+   OUTPUT_COMPRESSION set to "gzip") to a temporary file, and return that.
+   NULL is returned on error. */
+FILE *
+decompress_input (plot_input *input)
+{
+#ifdef INCLUDE_PNG_SUPPORT
+  {
+    FILE *out_stream;
+    z_stream z;
+    unsigned char out[DECOMPRESSION_CHUNK_LEN];
+    int status = Z_OK;
+    
+    if ((out_stream = tmpfile ()) == NULL)
+      {
+	fprintf (stderr, "%s: %s\n", progname, strerror (errno));
+	return NULL;
+      }
+    
+    z.zalloc = Z_NULL;
+    z.zfree = Z_NULL;
+    z.opaque = Z_NULL;
+    z.next_in = input->buffer + input->start;
+    z.avail_in = (unsigned int)(input->end - input->start);
+    /* 32 + 15 = detect gzip or zlib wrapper, with largest window */
+    if (inflateInit2 (&z, 32 + 15) != Z_OK)
+      {
+	fclose (out_stream);
+	return NULL;
+      }
+
+    for ( ; ; )
+      {
+	if (z.avail_in == 0)
+	  {
+	    input->start = input->end;
+	    if (fill_input (input, 1) == false)
+	      break;		/* end of input */
+	    z.next_in = input->buffer + input->start;
+	    z.avail_in = (unsigned int)(input->end - input->start);
+	  }
+	z.next_out = out;
+	z.avail_out = DECOMPRESSION_CHUNK_LEN;
+	status = inflate (&z, Z_NO_FLUSH);
+	if (status != Z_OK && status != Z_STREAM_END)
+	  break;
+	fwrite (out, 1, DECOMPRESSION_CHUNK_LEN - z.avail_out, out_stream);
+	if (status == Z_STREAM_END)
+	  /* may be followed by another gzip member, e.g., if several
+	     compressed metafiles were concatenated */
+	  {
+	    if (inflateReset (&z) != Z_OK)
+	      break;
+	  }
+      }
+    inflateEnd (&z);
+
+    if (status != Z_STREAM_END)	/* corrupt or truncated */
+      {
+	fprintf (stderr, "%s: the compressed input is corrupt\n", progname);
+	fclose (out_stream);
+	return NULL;
+      }
+    rewind (out_stream);
+    return out_stream;
+  }
+#else
+  fprintf (stderr, "%s: compressed input is not supported\n", progname);
+  return NULL;
+#endif
+}
+
+/* Open the display device at the beginning of a page.  If there's no
+   Plotter, start making a copy of the page instead, beginning with the
+   current instruction. */
 int
-maybe_openpl (plPlotter *plotter)
+maybe_openpl (plPlotter *plotter, plot_input *input, int page)
 {
-  if (merge_pages)
+  if (plotter == NULL)
+    {
+      input->capturing = true;
+      input->capture_offset = input->instruction_offset;
+      input->capture_size = INPUT_BUFFER_LEN + 1;
+      input->capture = (unsigned char *)xmalloc (input->capture_size);
+      input->capture_len = 0;
+      input->capture_page = page;
+      return 0;
+    }
+  else if (merge_pages)
     return 0;
   else
     return (pl_openpl_r (plotter));
 }
 
+/* Close the display device at the end of a page.  If there's no Plotter,
+   finish the copy of the page (excluding the current instruction, which
+   is a CLOSEPL or can't be parsed, unless we're at end of input), and pass
+   it to the renderer, or to the copier if pages aren't split off. */
 int
-maybe_closepl (plPlotter *plotter)
+maybe_closepl (plPlotter *plotter, plot_input *input)
 {
-  if (merge_pages)
+  if (plotter == NULL)
+    {
+      plot_page *page;
+
+      capture_input (input, input->instruction_offset);
+      page = (plot_page *)xmalloc (sizeof (plot_page));
+      page->data = input->capture;
+      page->len = input->capture_len;
+      page->data[page->len] = '\0';
+      page->format = input->format;
+      page->number = input->capture_page;
+      page->next = (plot_page *)NULL;
+      input->capturing = false;
+      input->capture = (unsigned char *)NULL;
+      input->capture_size = 0;
+      if (renderer)
+	submit_page (page);
+      else
+	/* no separate files, so append page to output */
+	{
+	  if (copy_page (copier, page) == false)
+	    copier->failed = true;
+	  free (page->data);
+	  free (page);
+	}
+      return 0;
+    }
+  else if (merge_pages)
     return 0;
   else
     return (pl_closepl_r (plotter));
 }
 
-
-/* read a single byte from input stream, return as unsigned char (0..255) */
-unsigned char
-read_byte_as_unsigned_char (FILE *input, bool *badstatus)
+/* Append to the copy of a page being made the data in the input buffer
+   that precedes `offset', i.e. all data that hasn't yet been copied.  If
+   more has already been copied, the copy is shortened. */
+void
+capture_input (plot_input *input, long offset)
 {
-  int newint;
-
-  if (*badstatus == true)
-    return 0;
+  size_t len, start;
 
-  newint = getc (input);
-  /* have an unsigned char cast to an int, in range 0..255 */
-  if (newint == EOF)
+  if (offset <= input->capture_offset)
     {
-      *badstatus = true;
-      return 0;
+      len = (size_t)(input->capture_offset - offset);
+      input->capture_len = (len < input->capture_len 
+			    ? input->capture_len - len : 0);
     }
   else
-    return (unsigned char)newint;
+    {
+      start = (size_t)(input->capture_offset - input->buffer_offset);
+      len = (size_t)(offset - input->capture_offset);
+      if (input->capture_len + len + 1 > input->capture_size)
+	/* leave room for a null terminator */
+	{
+	  input->capture_size = 2 * (input->capture_len + len) + 1;
+	  input->capture = 
+	    (unsigned char *)xrealloc (input->capture, input->capture_size);
+	}
+      memcpy (input->capture + input->capture_len, 
+	      input->buffer + start, len);
+      input->capture_len += len;
+    }
+  input->capture_offset = offset;
 }
 
-/* read a single byte from input stream, return as unsigned int (0..255) */
-unsigned int
-read_byte_as_unsigned_int (FILE *input, bool *badstatus)
+
+/* Check the name of the output file (see -o option).  Return value is the
+   number of page number conversions it contains (0 or 1), or -1 if it
+   contains any other printf-style conversion.  A page number conversion
+   is `%d', optionally with a flag `0' or `-' and a width of at most two
+   digits, e.g. `%04d'; `%%' stands for a percent sign. */
+int
+count_page_conversions (const char *template)
 {
-  int newint;
-
-  if (*badstatus == true)
-    return 0;
+  const char *s;
+  int count = 0, digits;
 
-  newint = getc (input);
-  /* have an unsigned char cast to an int, in range 0..255 */
-  if (newint == EOF)
+  for (s = template; *s; s++)
     {
-      *badstatus = true;
-      return 0;
+      if (*s != '%')
+	continue;
+      s++;
+      if (*s == '%')
+	continue;
+      if (*s == '0' || *s == '-')
+	s++;
+      for (digits = 0; *s >= '0' && *s <= '9'; s++)
+	digits++;
+      if (*s != 'd' || digits > 2)
+	return -1;
+      count++;
     }
-  else
-    return (unsigned int)newint;
+
+  return (count > 1 ? -1 : count);
 }
 
-/* read an integer from input stream (can be in ascii format, system binary
-   format for integers or short integers, or perhaps in crufty old 2-byte
-   format) */
-int
-read_true_int (FILE *input, bool *badstatus)
+/* Return the name of the checkpoint file of a followed input file (see
+   --follow option), in storage obtained from xmalloc().  It's named after
+   the output file, or if the output file name is a template, after the
+   template with its page number conversion removed (and `%%' replaced by
+   a percent sign), so that e.g. `page%03d.svg' yields `page.svg.follow'.
+   If that leaves no file name, or there's no output file, it's named
+   after the input file. */
+char *
+checkpoint_name (void)
 {
-  int x, zi, returnval;
-  short zs;
-  unsigned int u;
-
-  if (*badstatus == true)
-    return 0;
+  const char *s, *owner = output_file;
+  char *name, *t;
 
-  switch (input_format)
+  if (output_file == NULL)
+    owner = followed_file;
+  else if (count_page_conversions (output_file) > 0)
     {
-    case GNU_PORTABLE:
-    case GNU_OLD_PORTABLE:
-      returnval = fscanf (input, " %d", &x);
-      if (returnval != 1)
+      name = (char *)xmalloc (strlen (output_file) 
+			      + strlen (CHECKPOINT_SUFFIX) + 1);
+      for (s = output_file, t = name; *s; s++)
 	{
-	  x = 0;
-	  *badstatus = true;
+	  if (*s != '%')
+	    {
+	      *t++ = *s;
+	      continue;
+	    }
+	  s++;
+	  if (*s == '%')
+	    {
+	      *t++ = '%';
+	      continue;
+	    }
+	  while (*s != 'd')	/* skip flag and width */
+	    s++;
 	}
-      break;
-    case GNU_BINARY:		/* system format for integers */
-    default:
-      returnval = fread (&zi, sizeof(zi), 1, input);
-      if (returnval == 1)
-	x = zi;
-      else
+      if (t > name && t[-1] != '/')
 	{
-	  x = 0;
-	  *badstatus = true;
+	  strcpy (t, CHECKPOINT_SUFFIX);
+	  return name;
 	}
-      break;
-    case GNU_OLD_BINARY:	/* system format for short integers */
-      returnval = fread (&zs, sizeof(zs), 1, input);
-      if (returnval == 1)
-	x = (int)zs;
-      else
+      free (name);
+      owner = followed_file;
+    }
+
+  name = (char *)xmalloc (strlen (owner) + strlen (CHECKPOINT_SUFFIX) + 1);
+  sprintf (name, "%s%s", owner, CHECKPOINT_SUFFIX);
+  return name;
+}
+
+/* Set up the renderer of pages that are split off from the input, and
+   start its threads (if more than one is requested, and they're
+   supported).  Each page will be rendered on a Plotter of its own, of the
+   given type. */
+void
+start_renderer (const char *output_format, plPlotterParams *plotter_params)
+{
+  renderer = (page_renderer *)xmalloc (sizeof (page_renderer));
+  renderer->output_format = output_format;
+  renderer->plotter_params = plotter_params;
+  renderer->output_template = output_file;
+  renderer->failed = false;
+  renderer->newest_only = false;
+  renderer->newest = (plot_page *)NULL;
+#ifdef PAGE_THREADS
+  renderer->num_threads = 0;
+  renderer->threads = (pthread_t *)NULL;
+  renderer->head = renderer->tail = (plot_page *)NULL;
+  renderer->queue_len = 0;
+  renderer->done = false;
+  if (num_threads > 1)
+    {
+      int i;
+
+      pthread_mutex_init (&renderer->lock, NULL);
+      pthread_cond_init (&renderer->nonempty, NULL);
+      pthread_cond_init (&renderer->nonfull, NULL);
+      renderer->threads = 
+	(pthread_t *)xmalloc (num_threads * sizeof (pthread_t));
+      for (i = 0; i < num_threads; i++)
 	{
-	  x = 0;
-	  *badstatus = true;
+	  if (pthread_create (&renderer->threads[i], NULL, 
+			      render_pages, NULL) != 0)
+	    break;		/* make do with fewer threads */
+	  renderer->num_threads++;
 	}
-      break;
-    case PLOT5_HIGH:		/* two-byte format, high byte first */
-      u = ((read_byte_as_unsigned_int (input, badstatus)) << 8);
-      u |= read_byte_as_unsigned_int (input, badstatus);
-      if (u > 0x7fff)
-	x = - (int)(0x10000 - u);
-      else
-	x = (int)u;
-      break;
-    case PLOT5_LOW:		/* two-byte format, low byte first */
-      u = read_byte_as_unsigned_int (input, badstatus);
-      u |= (read_byte_as_unsigned_int (input, badstatus) << 8);
-      if (u > 0x7fff)
-	x = - (int)(0x10000 - u);
+    }
+#endif
+}
+
+/* Pass a page split off from the input to the renderer, which takes
+   ownership of it.  If there are no threads, it's rendered immediately;
+   otherwise it's queued, after waiting until the queue isn't full. */
+void
+submit_page (plot_page *page)
+{
+  if (renderer->newest_only)
+    /* render it when the end of the input is reached, unless a newer page
+       replaces it first */
+    {
+      if (renderer->newest)
+	{
+	  free (renderer->newest->data);
+	  free (renderer->newest);
+	}
+      renderer->newest = page;
+      return;
+    }
+#ifdef PAGE_THREADS
+  if (renderer->num_threads > 0)
+    {
+      pthread_mutex_lock (&renderer->lock);
+      while (renderer->queue_len >= 
+	     PAGES_QUEUED_PER_THREAD * renderer->num_threads)
+	pthread_cond_wait (&renderer->nonfull, &renderer->lock);
+      if (renderer->tail)
+	renderer->tail->next = page;
       else
-	x = (int)u;
-      break;
+	renderer->head = page;
+      renderer->tail = page;
+      renderer->queue_len++;
+      pthread_cond_signal (&renderer->nonempty);
+      pthread_mutex_unlock (&renderer->lock);
+      return;
     }
+#endif
+  if (render_page (page) == false)
+    renderer->failed = true;
+}
 
-  return x;
+/* Wait until all pages passed to the renderer have been rendered. */
+void
+finish_renderer (void)
+{
+  render_newest_page ();
+#ifdef PAGE_THREADS
+  if (renderer->num_threads > 0)
+    {
+      int i;
+
+      pthread_mutex_lock (&renderer->lock);
+      renderer->done = true;
+      pthread_cond_broadcast (&renderer->nonempty);
+      pthread_mutex_unlock (&renderer->lock);
+      for (i = 0; i < renderer->num_threads; i++)
+	pthread_join (renderer->threads[i], NULL);
+      pthread_mutex_destroy (&renderer->lock);
+      pthread_cond_destroy (&renderer->nonempty);
+      pthread_cond_destroy (&renderer->nonfull);
+    }
+  if (renderer->threads)
+    free (renderer->threads);
+#endif
 }
-  
-/* a relaxed version of the preceding routine: if a portable
-   (human-readable) format is used, a floating point number may substitute
-   for the integer */
-double
-read_int (FILE *input, bool *badstatus)
+
+/* If only the newest page is to be rendered, render it (if it hasn't been
+   already). */
+void
+render_newest_page (void)
 {
-  int x, zi, returnval;
-  short zs;
-  unsigned int u;
+  plot_page *page = renderer->newest;
 
-  if (*badstatus == true)
-    return 0.0;
+  if (page == NULL)
+    return;
+  renderer->newest = (plot_page *)NULL;
+  if (render_page (page) == false)
+    renderer->failed = true;
+}
 
-  switch (input_format)
-    {
-    case GNU_PORTABLE:
-    case GNU_OLD_PORTABLE:
-      {
-	double r;
+#ifdef PAGE_THREADS
+/* Body of each of the renderer's threads: render queued pages until there
+   are no more. */
+void *
+render_pages (void *arg)
+{
+  plot_page *page;
 
-	returnval = fscanf (input, " %lf", &r);
-	if (returnval != 1)
-	  {
-	    *badstatus = true;
-	    r = 0.0;
-	  }
-	return r;
+  for ( ; ; )
+    {
+      pthread_mutex_lock (&renderer->lock);
+      while (renderer->head == NULL && renderer->done == false)
+	pthread_cond_wait (&renderer->nonempty, &renderer->lock);
+      page = renderer->head;
+      if (page)
+	{
+	  renderer->head = page->next;
+	  if (renderer->head == NULL)
+	    renderer->tail = (plot_page *)NULL;
+	  renderer->queue_len--;
+	  pthread_cond_signal (&renderer->nonfull);
+	}
+      pthread_mutex_unlock (&renderer->lock);
+
+      if (page == NULL)		/* queue is empty, and will remain so */
+	break;
+      if (render_page (page) == false)
+	{
+	  pthread_mutex_lock (&renderer->lock);
+	  renderer->failed = true;
+	  pthread_mutex_unlock (&renderer->lock);
+	}
+    }
+
+  return NULL;
+}
+#endif
+
+/* Render a page split off from the input on a Plotter of its own, writing
+   the output to the file whose name is given by the output file template.
+   If only the newest page is rendered, the file is replaced, by renaming a
+   temporary file, so that it's never seen incomplete.  The page, including
+   its data, is freed.  Return value indicates whether that was
+   successful. */
+bool
+render_page (plot_page *page)
+{
+  plPlotter *plotter;
+  plot_input input;
+  FILE *out_stream;
+  char *name, *file_name;
+  int number = page->number;
+  bool success = true;
+
+  name = (char *)xmalloc (strlen (renderer->output_template) 
+			  + MAX_PAGE_NUMBER_LEN);
+  sprintf (name, renderer->output_template, page->number);
+  if (renderer->newest_only)
+    {
+      file_name = (char *)xmalloc (strlen (name) + 5);
+      sprintf (file_name, "%s.tmp", name);
+    }
+  else
+    file_name = name;
+  if ((out_stream = fopen (file_name, "w")) == NULL)
+    {
+      fprintf (stderr, "%s: %s: %s\n", progname, file_name, strerror (errno));
+      success = false;
+    }
+  else if (copier && page->format == copier->format)
+    /* copy page, with a copier of its own */
+    {
+      page_copier dest = *copier;
+
+      dest.stream = out_stream;
+      dest.offset = 0;
+      dest.num_pages = 0;
+      dest.page_offsets = (long *)NULL;
+      dest.page_offsets_len = 0;
+      success = (copy_page (&dest, page) && finish_copier (&dest));
+      if (fclose (out_stream) < 0)
+	{
+	  fprintf (stderr, "%s: %s: %s\n", progname, file_name, strerror (errno));
+	  success = false;
+	}
+    }
+  else
+    {
+      if ((plotter = pl_newpl_r (renderer->output_format, NULL, out_stream,
+				 stderr, renderer->plotter_params)) == NULL)
+	{
+	  fprintf (stderr, "%s: error: the plot device could not be created\n", 
+		   progname);
+	  success = false;
+	}
+      else
+	{
+	  /* any parse error was reported when the page was split off, and
+	     the page ends just before it */
+	  init_memory_input (&input, page->data, page->len, page->format);
+	  parse_plot (plotter, &input, &number);
+	  if (pl_deletepl_r (plotter) < 0)
+	    {
+	      fprintf (stderr, "%s: error: the plot device could not be deleted\n", 
+		       progname);
+	      success = false;
+	    }
+	}
+      if (fclose (out_stream) < 0)
+	{
+	  fprintf (stderr, "%s: %s: %s\n", progname, file_name, strerror (errno));
+	  success = false;
+	}
+    }
+  if (file_name != name)
+    {
+      if (success && rename (file_name, name) < 0)
+	{
+	  fprintf (stderr, "%s: %s: %s\n", progname, name, strerror (errno));
+	  success = false;
+	}
+      free (file_name);
+    }
+  free (name);
+  free (page->data);
+  free (page);
+
+  return success;
+}
+
+/* Decide whether pages can be copied to the output rather than replayed:
+   the output must be a metafile, and the drawing on each page mustn't be
+   altered, e.g. by an option such as -s, or by output compression (see
+   OUTPUT_COMPRESSION parameter).  Since the MetaPlotter merely removes
+   redundant instructions from pages, a copy yields the same drawing. */
+bool
+can_copy_pages (const char *output_format)
+{
+  const char *s;
+
+  if (strcmp (output_format, "meta") != 0 || merge_pages
+      || output_params_given || bg_color || pen_color || font_name
+      || font_size >= 0.0 || line_width >= 0.0)
+    return false;
+  if ((s = getenv ("META_OPTIMIZE")) && strcasecmp (s, "yes") == 0)
+    return false;
+  if ((s = getenv ("OUTPUT_COMPRESSION")) && strncasecmp (s, "gzip", 4) == 0)
+    return false;
+  return true;
+}
+
+/* Set up the copier of pages to the output metafile, determining its
+   format as a MetaPlotter would.  Its output stream is set later, unless
+   pages are split off (then each page is copied to a file of its own). */
+void
+start_copier (void)
+{
+  const char *s;
+
+  if (portable_output == false
+      && (s = getenv ("META_PORTABLE")) && strcasecmp (s, "yes") == 0)
+    portable_output = true;
+  if (compact_output == false
+      && (s = getenv ("META_COMPACT")) && strcasecmp (s, "yes") == 0)
+    compact_output = true;
+
+  copier = (page_copier *)xmalloc (sizeof (page_copier));
+  copier->format = (portable_output ? GNU_PORTABLE 
+		    : compact_output ? GNU_COMPACT : GNU_BINARY);
+  copier->page_index = ((s = getenv ("META_PAGE_INDEX")) 
+			&& strcasecmp (s, "yes") == 0);
+  /* pages in other formats are re-encoded by a MetaPlotter, and the
+     copier writes the page index itself */
+  copier->plotter_params = pl_newplparams ();
+  if (portable_output)
+    pl_setplparam (copier->plotter_params, "META_PORTABLE", (void *)"yes");
+  else if (compact_output)
+    pl_setplparam (copier->plotter_params, "META_COMPACT", (void *)"yes");
+  pl_setplparam (copier->plotter_params, "META_PAGE_INDEX", (void *)"no");
+  copier->stream = (FILE *)NULL;
+  copier->offset = 0;
+  copier->num_pages = 0;
+  copier->page_offsets = (long *)NULL;
+  copier->page_offsets_len = 0;
+  copier->failed = false;
+}
+
+/* Write data to the copier's output stream.  Return value indicates
+   whether that was successful. */
+bool
+write_copy (page_copier *dest, const unsigned char *data, size_t len)
+{
+  if (len > 0 && fwrite (data, 1, len, dest->stream) != len)
+    {
+      fprintf (stderr, "%s: error: the output could not be written: %s\n",
+	       progname, strerror (errno));
+      return false;
+    }
+  dest->offset += (long)len;
+  return true;
+}
+
+/* Append a page split off from the input to the copier's output stream,
+   preceded by the metafile header if it's the first page.  If the page is
+   in the output's metafile format, it's copied verbatim and a CLOSEPL is
+   appended; otherwise it's re-encoded by replaying it on a MetaPlotter.
+   The page isn't freed.  Return value indicates whether that was
+   successful. */
+bool
+copy_page (page_copier *dest, plot_page *page)
+{
+  char header[16];
+  long page_offset;
+  size_t header_len;
+  bool success = true;
+
+  sprintf (header, "%cPLOT %c\n", (int)O_COMMENT,
+	   dest->format == GNU_PORTABLE ? '2' 
+	   : dest->format == GNU_COMPACT ? '3' : '1');
+  header_len = strlen (header);
+  if (dest->num_pages == 0
+      && write_copy (dest, (unsigned char *)header, header_len) == false)
+    return false;
+  page_offset = dest->offset;
+
+  if (page->format == dest->format)
+    {
+      static const unsigned char closepl[2] = { (unsigned char)O_CLOSEPL, '\n' };
+
+      /* the page begins with an OPENPL, and can be decoded by itself
+	 (in compact format, its first coordinates are relative to (0,0)) */
+      success = (write_copy (dest, page->data, page->len)
+		 && write_copy (dest, closepl, 
+				dest->format == GNU_PORTABLE ? 2 : 1));
+    }
+  else
+    {
+      plPlotter *plotter;
+      plot_input input;
+      FILE *tmp_stream;
+      int number = page->number;
+
+      if ((tmp_stream = tmpfile ()) == NULL)
+	{
+	  fprintf (stderr, "%s: error: a temporary file could not be created: %s\n",
+		   progname, strerror (errno));
+	  return false;
+	}
+      if ((plotter = pl_newpl_r ("meta", NULL, tmp_stream, stderr,
+				 dest->plotter_params)) == NULL)
+	{
+	  fprintf (stderr, "%s: error: the plot device could not be created\n", 
+		   progname);
+	  fclose (tmp_stream);
+	  return false;
+	}
+      init_memory_input (&input, page->data, page->len, page->format);
+      parse_plot (plotter, &input, &number);
+      if (pl_deletepl_r (plotter) < 0)
+	{
+	  fprintf (stderr, "%s: error: the plot device could not be deleted\n", 
+		   progname);
+	  success = false;
+	}
+      else
+	/* append MetaPlotter's output, excluding its header */
+	{
+	  unsigned char buf[INPUT_BUFFER_LEN];
+	  size_t len;
+
+	  if (fseek (tmp_stream, (long)header_len, SEEK_SET) < 0)
+	    success = false;
+	  while (success
+		 && (len = fread (buf, 1, sizeof (buf), tmp_stream)) > 0)
+	    success = write_copy (dest, buf, len);
+	}
+      fclose (tmp_stream);
+    }
+  if (success == false)
+    return false;
+
+  /* record offset of page, for the page index (if any) */
+  if (dest->num_pages == dest->page_offsets_len)
+    {
+      dest->page_offsets_len = 
+	(dest->page_offsets_len == 0 ? 16 : 2 * dest->page_offsets_len);
+      dest->page_offsets = 
+	(long *)xrealloc (dest->page_offsets, 
+			  dest->page_offsets_len * sizeof (long));
+    }
+  dest->page_offsets[dest->num_pages++] = page_offset;
+
+  return true;
+}
+
+/* Finish the copier's output: append the page index, if requested, in the
+   form written by a MetaPlotter (see libplot/m_emit.c), and flush the
+   output stream.  Return value indicates whether that was successful, and
+   whether all pages were successfully copied. */
+bool
+finish_copier (page_copier *dest)
+{
+  char buf[MAX_PAGE_INDEX_LINE_LEN];
+  long index_offset = dest->offset;
+  bool success = (dest->failed == false);
+  int i;
+
+  if (dest->page_index && dest->num_pages > 0)
+    {
+      for (i = 0; success && i < dest->num_pages; i++)
+	{
+	  sprintf (buf, "%cPAGE %d %ld\n", 
+		   (int)O_COMMENT, i + 1, dest->page_offsets[i]);
+	  success = write_copy (dest, (unsigned char *)buf, strlen (buf));
+	}
+      sprintf (buf, "%cPAGE_INDEX %d %ld\n", 
+	       (int)O_COMMENT, dest->num_pages, index_offset);
+      success = (success 
+		 && write_copy (dest, (unsigned char *)buf, strlen (buf)));
+    }
+  if (fflush (dest->stream) < 0)
+    {
+      fprintf (stderr, "%s: error: the output could not be written: %s\n",
+	       progname, strerror (errno));
+      success = false;
+    }
+  if (dest->page_offsets)
+    free (dest->page_offsets);
+  dest->page_offsets = (long *)NULL;
+
+  return success;
+}
+
+/* initialize an input buffer for a stream */
+void
+init_input (plot_input *input, FILE *stream)
+{
+  input->stream = stream;
+  input->stream_done = false;
+  input->read_error = false;
+  input->eof = false;
+  input->buffer = (unsigned char *)xmalloc (INPUT_BUFFER_LEN + 1);
+  input->start = input->end = 0;
+  input->buffer[0] = '\0';
+#ifdef HAVE_UNISTD_H
+  input->base = (long)lseek (fileno (stream), (off_t)0, SEEK_CUR);
+#else
+  input->base = ftell (stream);
+#endif
+  input->buffer_offset = 0;
+  input->instruction_offset = 0;
+  input->coordinates_left = 0;
+  input->coordinate_is_y = false;
+  input->prev_x = input->prev_y = 0;
+  input->capturing = false;
+  input->capture = (unsigned char *)NULL;
+  input->capture_len = input->capture_size = 0;
+  input->have_page_index = false;
+  input->num_pages = 0;
+  input->page_offsets = (long *)NULL;
+  input->index_offset = 0;
+  input->follow = false;
+  input->checkpoint = (char *)NULL;
+  input->resume_offset = input->saved_offset = -1L;
+  input->resume_page = 0;
+  input->watch_fd = -1;
+}
+
+/* initialize an input buffer for data (a page split off from the input)
+   that's already in memory, null-terminated; it's owned by the caller */
+void
+init_memory_input (plot_input *input, unsigned char *data, size_t len, plot_format format)
+{
+  input->stream = (FILE *)NULL;
+  input->format = format;
+  input->stream_done = true;
+  input->read_error = false;
+  input->eof = false;
+  input->buffer = data;
+  input->start = 0;
+  input->end = len;
+  input->base = -1L;		/* not seekable */
+  input->buffer_offset = 0;
+  input->instruction_offset = 0;
+  input->coordinates_left = 0;
+  input->coordinate_is_y = false;
+  input->prev_x = input->prev_y = 0;
+  input->capturing = false;
+  input->capture = (unsigned char *)NULL;
+  input->capture_len = input->capture_size = 0;
+  input->have_page_index = false;
+  input->num_pages = 0;
+  input->page_offsets = (long *)NULL;
+  input->index_offset = 0;
+  input->follow = false;
+  input->checkpoint = (char *)NULL;
+  input->resume_offset = input->saved_offset = -1L;
+  input->resume_page = 0;
+  input->watch_fd = -1;
+}
+
+/* Move to a position in the input stream, discarding any buffered data.
+   Return value indicates whether that was possible. */
+bool
+seek_input (plot_input *input, long position)
+{
+#ifdef HAVE_UNISTD_H
+  if (lseek (fileno (input->stream), (off_t)position, SEEK_SET) < 0)
+    return false;
+#else
+  if (fseek (input->stream, position, SEEK_SET) < 0)
+    return false;
+#endif
+  input->stream_done = false;
+  input->read_error = false;
+  input->eof = false;
+  input->start = input->end = 0;
+  input->buffer[0] = '\0';
+  input->buffer_offset = position - input->base;
+
+  return true;
+}
+
+/* Return the offset of the unread data in the input buffer, in bytes from
+   the beginning of the input; -1 if the stream isn't seekable. */
+long
+input_offset (plot_input *input)
+{
+  if (input->base < 0)
+    return -1L;
+
+  return input->buffer_offset + (long)input->start;
+}
+
+/* Look for an index of pages at the end of the input (it is appended to a
+   metafile by libplot if the META_PAGE_INDEX parameter is "yes"), and if
+   there's a valid one, read it.  That's possible only if the input stream
+   is seekable.  Afterwards, the input is at its beginning again. */
+void
+load_page_index (plot_input *input)
+{
+  long length;
+  
+  if (input->base < 0)		/* not seekable */
+    return;
+#ifdef HAVE_UNISTD_H
+  length = (long)lseek (fileno (input->stream), (off_t)0, SEEK_END);
+#else
+  length = (fseek (input->stream, 0L, SEEK_END) < 0 
+	    ? -1L : ftell (input->stream));
+#endif
+  if (length < 0)
+    return;
+
+  if (read_page_index (input, length - input->base) == false 
+      && input->page_offsets)
+    {
+      free (input->page_offsets);
+      input->page_offsets = (long *)NULL;
+    }
+  seek_input (input, input->base);
+}
+
+/* Read the index of pages, if any, at the end of the input (see
+   load_page_index()).  It consists of lines
+
+     #PAGE 1 <offset of page 1>
+     ...
+     #PAGE <n> <offset of page n>
+     #PAGE_INDEX <n> <offset of first #PAGE line>
+
+   Offsets are measured from the beginning of the input, and `length' is
+   the length of the input.  Return value indicates whether a valid index
+   was found.  To be accepted, the index
+   must end exactly where the last line begins; so e.g. if several
+   metafiles are concatenated, the index of the last one isn't used. */
+bool
+read_page_index (plot_input *input, long length)
+{
+  char *line, *newline;
+  int num_pages, page, n;
+  long index_offset, trailer_offset, offset, page_offset;
+  size_t len, i;
+
+  /* read the last line */
+  len = (length < MAX_PAGE_INDEX_LINE_LEN 
+	 ? (size_t)length : MAX_PAGE_INDEX_LINE_LEN);
+  if (len < 2 || seek_input (input, input->base + length - (long)len) == false)
+    return false;
+  fill_input (input, len);
+  if (input->end != len || input->buffer[len - 1] != '\n')
+    return false;
+  for (i = len - 1; i > 0 && input->buffer[i - 1] != '\n'; i--)
+    ;
+  if (i == 0)			/* didn't find beginning of line */
+    return false;
+  line = (char *)input->buffer + i;
+  trailer_offset = length - (long)len + (long)i;
+  if (sscanf (line, "#PAGE_INDEX %d %ld", &num_pages, &index_offset) != 2
+      || num_pages < 0 || index_offset < 0 || index_offset > trailer_offset
+      || num_pages > trailer_offset - index_offset)
+    return false;
+
+  /* read the page offsets, which must be increasing */
+  if (seek_input (input, input->base + index_offset) == false)
+    return false;
+  input->num_pages = num_pages;
+  input->page_offsets = (long *)xmalloc ((num_pages + 1) * sizeof(long));
+  offset = index_offset;
+  for (page = 1; page <= num_pages; page++)
+    {
+      fill_input (input, MAX_PAGE_INDEX_LINE_LEN);
+      line = (char *)input->buffer + input->start;
+      newline = (char *)memchr (line, '\n', input->end - input->start);
+      if (newline == NULL
+	  || sscanf (line, "#PAGE %d %ld", &n, &page_offset) != 2
+	  || n != page || page_offset >= index_offset
+	  || page_offset < (page > 1 ? input->page_offsets[page - 2] + 1 : 0))
+	return false;
+      input->page_offsets[page - 1] = page_offset;
+      offset += (long)(newline + 1 - line);
+      input->start += (size_t)(newline + 1 - line);
+    }
+  if (offset != trailer_offset)
+    return false;
+
+  input->index_offset = index_offset;
+  input->have_page_index = true;
+  return true;
+}
+
+/* Use the page index, when the OPENPL instruction beginning a page that
+   isn't to be displayed has just been read, to go directly to the next
+   page that is, or to the index itself (i.e., the end of the metafile) if
+   there are no more.  `*page' is the number of the current page, which is
+   updated, and `first_page' is the number of the first page in the input.
+   Return value indicates whether that was possible; if it wasn't, the
+   index is found to be wrong and isn't used further. */
+bool
+skip_to_requested_page (plot_input *input, int *page, int first_page)
+{
+  int current = *page - first_page; /* position of current page in index */
+  int next_page;
+  long offset, next_offset;
+
+  /* the index should agree on where the current page begins */
+  offset = input_offset (input);
+  if (current < 0 || current >= input->num_pages
+      || offset - 1 != input->page_offsets[current])
+    {
+      input->have_page_index = false;
+      return false;
+    }
+  
+  if (*page < first_requested_page 
+      && first_requested_page - first_page < input->num_pages)
+    {
+      next_page = first_requested_page;
+      next_offset = input->page_offsets[next_page - first_page];
+    }
+  else
+    {
+      next_page = first_page + input->num_pages;
+      next_offset = input->index_offset;
+    }
+  
+  if (seek_input (input, input->base + next_offset) == false)
+    {
+      input->have_page_index = false;
+      return false;
+    }
+  /* check that we've arrived at an OPENPL, or at the index */
+  if (fill_input (input, 1) == false
+      || (int)input->buffer[input->start] 
+      != (next_page < first_page + input->num_pages 
+	  ? (int)O_OPENPL : (int)O_COMMENT))
+    {
+      seek_input (input, input->base + offset);
+      input->have_page_index = false;
+      return false;
+    }
+
+  *page = next_page;
+  return true;
+}
+
+/* Prepare to follow the input file as it grows (see --follow option): at
+   the end of the input, wait for more rather than stopping.  The
+   checkpoint file belongs to the output (if there's an output file), since
+   it records which pages the output already contains; if an earlier run
+   saved it, resume after the last page that run completed.  `*page' is
+   the number of the next page, and is updated.  The input file is watched
+   with inotify if possible, so that waiting needn't involve polling; the
+   watch is set up before the data already in the file are read, so that
+   no later modification is missed. */
+void
+start_following (plot_input *input, int *page)
+{
+  input->checkpoint = checkpoint_name ();
+  resume_input (input, page);
+  input->saved_offset = input->resume_offset;
+  input->follow = true;
+#ifdef HAVE_SYS_INOTIFY_H
+  if ((input->watch_fd = inotify_init ()) >= 0
+      && inotify_add_watch (input->watch_fd, followed_file, IN_MODIFY) < 0)
+    {
+      close (input->watch_fd);
+      input->watch_fd = -1;
+    }
+#endif
+}
+
+/* If the checkpoint file was saved by an earlier run that followed the
+   input file (see save_checkpoint()), go to the position it records, just
+   after the last page that was completed, so that only later pages are
+   read.  `*page' is set to the number of the next page.  The position is
+   used only if the input is long enough, and a CLOSEPL precedes it, as it
+   should; otherwise the input is read from its beginning.  Return value
+   indicates whether the position was used. */
+bool
+resume_input (plot_input *input, int *page)
+{
+  FILE *checkpoint_stream;
+  int format, next_page, n;
+  long offset, length;
+
+  if ((checkpoint_stream = fopen (input->checkpoint, "r")) == NULL)
+    return false;
+  n = fscanf (checkpoint_stream, "%d %ld %d", &format, &offset, &next_page);
+  fclose (checkpoint_stream);
+  if (n != 3 || format < 1 || format > 3 || offset < 1 || next_page < 1
+      || input->base < 0)
+    return false;
+
+  /* the input mustn't end before the position; if it does, it's not the
+     file that was followed */
+#ifdef HAVE_UNISTD_H
+  length = (long)lseek (fileno (input->stream), (off_t)0, SEEK_END);
+#else
+  length = (fseek (input->stream, 0L, SEEK_END) < 0 
+	    ? -1L : ftell (input->stream));
+#endif
+  if (length < input->base + offset
+      || seek_input (input, input->base + offset - 1) == false
+      || fill_input (input, 1) == false
+      || input->buffer[input->start] != (unsigned char)O_CLOSEPL)
+    {
+      fprintf (stderr, "%s: the checkpoint file `%s' doesn't match the input file, which is read from the beginning\n",
+	       progname, input->checkpoint);
+      seek_input (input, input->base);
+      return false;
+    }
+
+  input->start++;		/* skip CLOSEPL */
+  input->format = (format == 1 ? GNU_BINARY 
+		   : format == 2 ? GNU_PORTABLE : GNU_COMPACT);
+  input->resume_offset = offset;
+  input->resume_page = next_page;
+  *page = next_page;
+  return true;
+}
+
+/* Save the position in the followed input file just after the last page
+   that was completed (and the number of the next page, and the format of
+   the input), so that a later run can resume there (see resume_input()).
+   If the checkpoint file can't be written, following continues without
+   it. */
+void
+save_checkpoint (plot_input *input)
+{
+  FILE *checkpoint_stream;
+
+  if ((checkpoint_stream = fopen (input->checkpoint, "w")) != NULL)
+    {
+      fprintf (checkpoint_stream, "%d %ld %d\n", 
+	       input->format == GNU_BINARY ? 1 
+	       : input->format == GNU_PORTABLE ? 2 : 3,
+	       input->resume_offset, input->resume_page);
+      if (fclose (checkpoint_stream) == 0)
+	{
+	  input->saved_offset = input->resume_offset;
+	  return;
+	}
+    }
+  fprintf (stderr, "%s: %s: %s\n", progname, input->checkpoint, 
+	   strerror (errno));
+  free (input->checkpoint);
+  input->checkpoint = (char *)NULL;
+}
+
+/* At the end of the followed input file, first finish all that was
+   deferred until then: render the newest page, if only it is rendered,
+   flush the output, and save the checkpoint.  Then wait until the file
+   grows.  Return value indicates whether it did; if it was truncated
+   instead, it can no longer be followed. */
+bool
+wait_for_input (plot_input *input)
+{
+  long length = input->base + input->buffer_offset + (long)input->end;
+#ifdef HAVE_SYS_STAT_H
+  struct stat status;
+#endif
+
+  if (renderer)
+    render_newest_page ();
+  if (copier && copier->stream)
+    fflush (copier->stream);
+  if (input->checkpoint && input->resume_offset != input->saved_offset)
+    save_checkpoint (input);
+
+  for ( ; ; )
+    {
+#ifdef HAVE_SYS_STAT_H
+      if (fstat (fileno (input->stream), &status) < 0)
+	return false;
+      if ((long)status.st_size < length)
+	{
+	  fprintf (stderr, "%s: the input file `%s' was truncated, so it can't be followed further\n",
+		   progname, followed_file);
+	  return false;
+	}
+      if ((long)status.st_size > length)
+	return true;
+#endif
+#ifdef HAVE_SYS_INOTIFY_H
+      if (input->watch_fd >= 0)
+	/* wait for the file to be modified (perhaps it already was) */
+	{
+	  char events[4096];
+
+	  if (read (input->watch_fd, events, sizeof (events)) < 0
+	      && errno != EINTR)
+	    return false;
+	  continue;
+	}
+#endif
+#ifdef HAVE_UNISTD_H
+      sleep (FOLLOW_POLL_INTERVAL);
+#endif
+#ifndef HAVE_SYS_STAT_H
+      return true;		/* just try reading again */
+#endif
+    }
+}
+
+/* Ensure that at least `len' bytes of unread data (len <= INPUT_BUFFER_LEN)
+   are in the input buffer, by reading from the stream if necessary.
+   Return value indicates whether that was possible. */
+bool
+fill_input (plot_input *input, size_t len)
+{
+  size_t available = input->end - input->start, count;
+
+  if (available >= len)
+    return true;
+
+  /* move unread data to front of buffer */
+  if (input->start > 0)
+    {
+      if (input->capturing)	/* copy data that will be discarded */
+	capture_input (input, input->buffer_offset + (long)input->start);
+      input->buffer_offset += (long)input->start;
+      memmove (input->buffer, input->buffer + input->start, available);
+      input->start = 0;
+      input->end = available;
+    }
+
+  while (input->end < len && input->stream_done == false)
+    {
+#ifdef HAVE_UNISTD_H
+      /* read() returns what's available, so if the stream is a pipe, we
+	 won't wait for more input than we need */
+      ssize_t n;
+
+      n = read (fileno (input->stream), input->buffer + input->end, 
+		INPUT_BUFFER_LEN - input->end);
+      if (n < 0 && errno == EINTR)
+	continue;
+      if (n < 0)
+	input->read_error = true;
+      count = (n > 0 ? (size_t)n : 0);
+#else
+      count = fread (input->buffer + input->end, 1, 
+		     INPUT_BUFFER_LEN - input->end, input->stream);
+      if (count == 0 && ferror (input->stream))
+	input->read_error = true;
+#endif
+      if (count == 0)
+	{
+	  if (input->follow && input->read_error == false
+	      && wait_for_input (input))
+	    {
+#ifndef HAVE_UNISTD_H
+	      clearerr (input->stream);	/* forget end of file */
+#endif
+	      continue;
+	    }
+	  input->stream_done = true;
+	}
+      input->end += count;
+    }
+  /* null-terminate, so that numbers can be converted in place */
+  input->buffer[input->end] = '\0';
+
+  return (input->end >= len ? true : false);
+}
+
+/* read the op code of the next instruction from the input buffer; return
+   EOF if there are no more */
+int
+read_instruction (plot_input *input)
+{
+  int instruction;
+
+  input->instruction_offset = input->buffer_offset + (long)input->start;
+  if (input->start == input->end && fill_input (input, 1) == false)
+    return EOF;
+
+  instruction = (int)(input->buffer[input->start++]);
+  if (input->format == GNU_COMPACT)
+    /* prepare to decode coordinates (if any) */
+    {
+      input->coordinates_left = num_coordinates (instruction);
+      input->coordinate_is_y = false;
+      if (instruction == (int)O_OPENPL)
+	/* first coordinates on a page are relative to (0,0) */
+	input->prev_x = input->prev_y = 0;
+    }
+
+  return instruction;
+}
+
+/* Record that a read from the input buffer failed.  It failed because of
+   end of input, unless there was a read error. */
+void
+input_failed (plot_input *input, bool *badstatus)
+{
+  *badstatus = true;
+  if (input->read_error == false)
+    input->eof = true;
+}
+
+/* read a single byte from input stream, return as unsigned char (0..255) */
+unsigned char
+read_byte_as_unsigned_char (plot_input *input, bool *badstatus)
+{
+  if (*badstatus == true)
+    return 0;
+
+  if (input->start == input->end && fill_input (input, 1) == false)
+    {
+      input_failed (input, badstatus);
+      return 0;
+    }
+  else
+    return input->buffer[input->start++];
+}
+
+/* read a single byte from input stream, return as unsigned int (0..255) */
+unsigned int
+read_byte_as_unsigned_int (plot_input *input, bool *badstatus)
+{
+  return (unsigned int)read_byte_as_unsigned_char (input, badstatus);
+}
+
+/* read a `len'-byte object, in system binary format, from input stream */
+bool
+read_binary (plot_input *input, void *ptr, size_t len, bool *badstatus)
+{
+  if (fill_input (input, len) == false)
+    {
+      input_failed (input, badstatus);
+      return false;
+    }
+  memcpy (ptr, input->buffer + input->start, len);
+  input->start += len;
+
+  return true;
+}
+
+/* Return the length of the longest initial segment of a string that is,
+   or is the beginning of, a number acceptable to the fscanf() conversion
+   `conversion' (see below).  That is how much fscanf() would read. */
+size_t
+number_prefix_length (const char *s, int conversion)
+{
+  static const char * const words[2] = { "infinity", "nan" };
+  const char *p = s;
+  bool digits = false;
+  int i, k;
+
+  if (*p == '+' || *p == '-')
+    p++;
+  if (conversion != 'd')
+    for (i = 0; i < 2; i++)
+      {
+	for (k = 0; words[i][k] && tolower ((int)p[k]) == words[i][k]; k++)
+	  ;
+	if (k > 0)
+	  return (size_t)(p + k - s);
       }
+  while (isdigit ((int)*p))
+    {
+      p++;
+      digits = true;
+    }
+  if (conversion != 'd')
+    {
+      if (*p == '.')
+	for (p++; isdigit ((int)*p); p++)
+	  digits = true;
+      if (digits && (*p == 'e' || *p == 'E'))
+	{
+	  p++;
+	  if (*p == '+' || *p == '-')
+	    p++;
+	  while (isdigit ((int)*p))
+	    p++;
+	}
+    }
+
+  return (size_t)(p - s);
+}
+
+/* Read a number in human-readable format from input stream, skipping
+   leading whitespace, as fscanf() would.  `conversion' is 'd', 'f', or
+   'l', as in the fscanf() conversions " %d", " %f", and " %lf". */
+double
+read_ascii_number (plot_input *input, int conversion, bool *badstatus)
+{
+  char *number, *end;
+  double r;
+  size_t len;
+
+  /* skip whitespace */
+  for ( ; ; )
+    {
+      if (input->start == input->end && fill_input (input, 1) == false)
+	{
+	  input_failed (input, badstatus);
+	  return 0.0;
+	}
+      if (!isspace ((int)(input->buffer[input->start])))
+	break;
+      input->start++;
+    }
+
+  /* convert in place; unread data is null-terminated (see fill_input).
+     The number must be in the buffer in its entirety, but since it's
+     ended by the newline that ends its instruction, if not sooner, there
+     may be no need to read further (and no need to wait for more input,
+     if the input is being followed). */
+  while (input->end - input->start < MAX_NUMBER_LEN
+	 && memchr (input->buffer + input->start, '\n', 
+		    input->end - input->start) == NULL
+	 && fill_input (input, input->end - input->start + 1))
+    ;
+  number = (char *)(input->buffer + input->start);
+  switch (conversion)
+    {
+    case 'd':
+    default:
+      r = (double)(int)strtol (number, &end, 10);
+      break;
+    case 'f':
+      r = (double)strtof (number, &end);
+      break;
+    case 'l':
+      r = strtod (number, &end);
+      break;
+    }
+
+  /* like fscanf(), consume all that could begin a number */
+  len = number_prefix_length (number, conversion);
+  if ((size_t)(end - number) > len)
+    len = (size_t)(end - number);
+  input->start += len;
+
+  if (end == number)
+    /* failure; due to end of input if that cut the number short */
+    {
+      if (input->start == input->end && input->stream_done)
+	input_failed (input, badstatus);
+      else
+	*badstatus = true;
+      return 0.0;
+    }
+
+  return r;
+}
+
+/* read an integer from input stream (can be in ascii format, system binary
+   format for integers or short integers, or perhaps in crufty old 2-byte
+   format) */
+int
+read_true_int (plot_input *input, bool *badstatus)
+{
+  int x, zi;
+  short zs;
+  unsigned int u;
+
+  if (*badstatus == true)
+    return 0;
+
+  switch (input->format)
+    {
+    case GNU_PORTABLE:
+    case GNU_OLD_PORTABLE:
+      x = (int)read_ascii_number (input, 'd', badstatus);
+      break;
+    case GNU_COMPACT:		/* machine-independent zigzag integer */
+      u = read_zigzag (input, badstatus);
+      if (u & 0x80000000U)
+	x = - (int)((~u & 0x7fffffffU)) - 1;
+      else
+	x = (int)u;
+      break;
     case GNU_BINARY:		/* system format for integers */
     default:
-      returnval = fread (&zi, sizeof(zi), 1, input);
-      if (returnval == 1)
-	x = (int)zi;
+      if (read_binary (input, &zi, sizeof(zi), badstatus))
+	x = zi;
       else
-	{
-	  x = 0;
-	  *badstatus = true;
-	}
+	x = 0;
       break;
     case GNU_OLD_BINARY:	/* system format for short integers */
-      returnval = fread (&zs, sizeof(zs), 1, input);
-      if (returnval == 1)
+      if (read_binary (input, &zs, sizeof(zs), badstatus))
 	x = (int)zs;
       else
-	{
-	  x = 0;
-	  *badstatus = true;
-	}
+	x = 0;
       break;
     case PLOT5_HIGH:		/* two-byte format, high byte first */
       u = ((read_byte_as_unsigned_int (input, badstatus)) << 8);
@@ -1745,41 +3458,63 @@ read_int (FILE *input, bool *badstatus)
       break;
     }
 
-  return (double)x;
+  return x;
+}
+  
+/* a relaxed version of the preceding routine: if a portable
+   (human-readable) format is used, a floating point number may substitute
+   for the integer */
+double
+read_int (plot_input *input, bool *badstatus)
+{
+  if (*badstatus == true)
+    return 0.0;
+
+  switch (input->format)
+    {
+    case GNU_PORTABLE:
+    case GNU_OLD_PORTABLE:
+      return read_ascii_number (input, 'l', badstatus);
+    default:
+      return (double)read_true_int (input, badstatus);
+    }
 }
   
 /* read a floating point quantity from input stream (may be in ascii format
    or system single-precision format) */
 double
-read_float (FILE *input, bool *badstatus)
+read_float (plot_input *input, bool *badstatus)
 {
   float f;
-  int returnval;
   
   if (*badstatus == true)
     return 0;
 
-  switch (input_format)
+  switch (input->format)
     {
     case GNU_PORTABLE:
     case GNU_OLD_PORTABLE:
       /* human-readable format */
-      returnval = fscanf (input, " %f", &f);
+      f = (float)read_ascii_number (input, 'f', badstatus);
+      break;
+    case GNU_COMPACT:
+      /* machine-independent format */
+      f = read_compact_float (input, badstatus);
       break;
     case GNU_BINARY:
     case GNU_OLD_BINARY:
     default:
       /* system single-precision format */
-      returnval = fread (&f, sizeof(f), 1, input);
+      read_binary (input, &f, sizeof(f), badstatus);
       break;
     case PLOT5_HIGH:
     case PLOT5_LOW:
       /* plot(5) didn't support floats */
-      returnval = 0;
+      *badstatus = true;
       break;
     }
 
-  if (returnval != 1 || f != f)
+  if (*badstatus || f != f)
     /* failure, or NaN */
     {
       *badstatus = true;
@@ -1789,15 +3524,111 @@ read_float (FILE *input, bool *badstatus)
     return (double)f;
 }
 
+/* Read an integer in the zigzag format of GNU_COMPACT metafiles (see
+   libplot/m_emit.c) from input stream.  It's returned as the bit pattern
+   of a 32-bit two's complement integer. */
+unsigned int
+read_zigzag (plot_input *input, bool *badstatus)
+{
+  unsigned int z = 0, byte;
+  int shift;
+
+  for (shift = 0; ; shift += 7)
+    {
+      byte = read_byte_as_unsigned_int (input, badstatus);
+      if (*badstatus)
+	return 0;
+      if (shift == 28 && byte > 0x0f)	/* too long */
+	{
+	  *badstatus = true;
+	  return 0;
+	}
+      z |= (byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0)
+	break;
+    }
+
+  return ((z >> 1) ^ ((z & 1) ? 0xffffffffU : 0)) & 0xffffffffU;
+}
+
+/* Read a floating point number in GNU_COMPACT format from input stream:
+   either a coordinate, encoded relative to the previous x or y coordinate,
+   or an IEEE single precision number, least significant byte first. */
+float
+read_compact_float (plot_input *input, bool *badstatus)
+{
+  unsigned int bits, key, *prev;
+  float f;
+  int i;
+
+  if (input->coordinates_left > 0)
+    {
+      prev = (input->coordinate_is_y ? &input->prev_y : &input->prev_x);
+      key = (*prev + read_zigzag (input, badstatus)) & 0xffffffffU;
+      *prev = key;
+      input->coordinate_is_y = !input->coordinate_is_y;
+      input->coordinates_left--;
+      /* invert the order-preserving map of bit patterns to keys */
+      if (key & 0x80000000U)
+	bits = (~key & 0x7fffffffU) | 0x80000000U;
+      else
+	bits = key;
+    }
+  else
+    {
+      bits = 0;
+      for (i = 0; i < 4; i++)
+	bits |= read_byte_as_unsigned_int (input, badstatus) << (8 * i);
+    }
+  memcpy (&f, &bits, sizeof(float));
+
+  return f;
+}
+
+/* Return the number of leading floating point arguments of an instruction
+   in GNU_COMPACT format that are coordinates, i.e. alternating x and y
+   coordinates of points (see libplot/m_emit.c).  An FPOLYLINE instruction
+   has any number. */
+int
+num_coordinates (int instruction)
+{
+  switch (instruction)
+    {
+    case (int)O_FCIRCLE:
+    case (int)O_FCONT:
+    case (int)O_FELLIPSE:
+    case (int)O_FMARKER:
+    case (int)O_FMOVE:
+    case (int)O_FPOINT:
+      return 2;
+    case (int)O_FBOX:
+    case (int)O_FLINE:
+    case (int)O_FSPACE:
+      return 4;
+    case (int)O_FARC:
+    case (int)O_FBEZIER2:
+    case (int)O_FELLARC:
+    case (int)O_FSPACE2:
+      return 6;
+    case (int)O_FBEZIER3:
+      return 8;
+    case (int)O_FPOLYLINE:
+      return INT_MAX;
+    default:
+      return 0;
+    }
+}
+
 /* Read a newline-terminated string from input stream.  As returned, the
    string, with \0 replacing \n, is allocated on the heap and may be
    freed. */
 char *
-read_string (FILE *input, bool *badstatus)
+read_string (plot_input *input, bool *badstatus)
 {
   int length = 0, buffer_length = 16; /* initial length */
   char *buffer;
-  char c;
+  unsigned char *newline;
+  size_t count;
 
   if (*badstatus == true)
     return 0;
@@ -1805,15 +3636,29 @@ read_string (FILE *input, bool *badstatus)
   buffer = (char *)xmalloc (buffer_length * sizeof(char));
   for ( ; ; )
     {
-      if (length >= buffer_length)
+      if (input->start == input->end && fill_input (input, 1) == false)
+	{
+	  input_failed (input, badstatus);
+	  break;
+	}
+      /* copy up to newline, or all unread data */
+      newline = (unsigned char *)memchr (input->buffer + input->start, '\n',
+					 input->end - input->start);
+      count = (newline ? (size_t)(newline - input->buffer) : input->end)
+	- input->start;
+      while (length + (int)count >= buffer_length)
 	{
 	  buffer_length *= 2;
 	  buffer = (char *)xrealloc (buffer, (unsigned int)(buffer_length));
 	}
-      c = (char)read_byte_as_unsigned_char (input, badstatus);
-      if ((*badstatus == true) || (c == '\n'))
-	break;
-      buffer [length++] = c;
+      memcpy (buffer + length, input->buffer + input->start, count);
+      length += (int)count;
+      input->start += count;
+      if (newline)
+	{
+	  input->start++;	/* skip newline */
+	  break;
+	}
     }
 
   if (*badstatus)
@@ -1828,3 +3673,179 @@ read_string (FILE *input, bool *badstatus)
     }
 }
 
+/* Return the layout of the arguments of an instruction in GNU_BINARY
+   format, as a string of characters: `c' for a byte, `i' for an integer,
+   `f' for a floating point number, and `s' for a newline-terminated
+   string.  NULL is returned for instructions that skip_instructions()
+   should leave to parse_plot(). */
+const char *
+binary_arg_layout (int instruction)
+{
+  switch (instruction)
+    {
+    case (int)O_CLOSEPATH:
+    case (int)O_ENDPATH:
+    case (int)O_ENDSUBPATH:
+    case (int)O_ERASE:
+    case (int)O_RESTORESTATE:
+    case (int)O_SAVESTATE:
+      return "";
+    case (int)O_CAPMOD:
+    case (int)O_COMMENT:
+    case (int)O_FILLMOD:
+    case (int)O_FONTNAME:
+    case (int)O_JOINMOD:
+    case (int)O_LABEL:
+    case (int)O_LINEMOD:
+      return "s";
+    case (int)O_ALABEL:
+      return "ccs";
+    case (int)O_FILLTYPE:
+    case (int)O_FONTSIZE:
+    case (int)O_LINEWIDTH:
+    case (int)O_ORIENTATION:
+    case (int)O_PENTYPE:
+    case (int)O_TEXTANGLE:
+      return "i";
+    case (int)O_CONT:
+    case (int)O_CONTREL:
+    case (int)O_MOVE:
+    case (int)O_MOVEREL:
+    case (int)O_POINT:
+    case (int)O_POINTREL:
+      return "ii";
+    case (int)O_BGCOLOR:
+    case (int)O_CIRCLE:
+    case (int)O_CIRCLEREL:
+    case (int)O_COLOR:
+    case (int)O_FILLCOLOR:
+    case (int)O_PENCOLOR:
+      return "iii";
+    case (int)O_BOX:
+    case (int)O_BOXREL:
+    case (int)O_LINE:
+    case (int)O_LINEREL:
+    case (int)O_MARKER:
+    case (int)O_MARKERREL:
+    case (int)O_SPACE:
+      return "iiii";
+    case (int)O_ELLIPSE:
+    case (int)O_ELLIPSEREL:
+      return "iiiii";
+    case (int)O_ARC:
+    case (int)O_ARCREL:
+    case (int)O_BEZIER2:
+    case (int)O_BEZIER2REL:
+    case (int)O_ELLARC:
+    case (int)O_ELLARCREL:
+    case (int)O_SPACE2:
+      return "iiiiii";
+    case (int)O_BEZIER3:
+    case (int)O_BEZIER3REL:
+      return "iiiiiiii";
+    case (int)O_FFONTSIZE:
+    case (int)O_FLINEWIDTH:
+    case (int)O_FMITERLIMIT:
+    case (int)O_FROTATE:
+    case (int)O_FTEXTANGLE:
+      return "f";
+    case (int)O_FCONT:
+    case (int)O_FCONTREL:
+    case (int)O_FMOVE:
+    case (int)O_FMOVEREL:
+    case (int)O_FPOINT:
+    case (int)O_FPOINTREL:
+    case (int)O_FSCALE:
+    case (int)O_FTRANSLATE:
+      return "ff";
+    case (int)O_FCIRCLE:
+    case (int)O_FCIRCLEREL:
+      return "fff";
+    case (int)O_FBOX:
+    case (int)O_FBOXREL:
+    case (int)O_FLINE:
+    case (int)O_FLINEREL:
+    case (int)O_FSPACE:
+      return "ffff";
+    case (int)O_FMARKER:
+    case (int)O_FMARKERREL:
+      return "ffif";
+    case (int)O_FELLIPSE:
+    case (int)O_FELLIPSEREL:
+      return "fffff";
+    case (int)O_FARC:
+    case (int)O_FARCREL:
+    case (int)O_FBEZIER2:
+    case (int)O_FBEZIER2REL:
+    case (int)O_FCONCAT:
+    case (int)O_FELLARC:
+    case (int)O_FELLARCREL:
+    case (int)O_FSETMATRIX:
+    case (int)O_FSPACE2:
+      return "ffffff";
+    case (int)O_FBEZIER3:
+    case (int)O_FBEZIER3REL:
+      return "ffffffff";
+    default:			/* OPENPL, CLOSEPL, dash arrays, etc. */
+      return NULL;
+    }
+}
+
+/* Skip over instructions in a GNU_BINARY page that isn't being displayed,
+   without decoding their arguments.  This stops at the first instruction
+   that parse_plot() should look at: an OPENPL or CLOSEPL, an instruction
+   with a variable number of arguments, one with a NaN argument, one that
+   extends past the end of the input or past the input buffer, or an
+   unrecognized one.  So errors are reported just as if nothing had been
+   skipped. */
+void
+skip_instructions (plot_input *input)
+{
+  const char *layout, *t;
+  float f;
+  size_t len, pos;
+  unsigned char *newline;
+
+  for ( ; ; )
+    {
+      if (input->start == input->end && fill_input (input, 1) == false)
+	return;
+      layout = binary_arg_layout ((int)input->buffer[input->start]);
+      if (layout == NULL)
+	return;
+
+      /* get op code and all fixed-length arguments into buffer */
+      len = 1;
+      for (t = layout; *t; t++)
+	len += (*t == 'i' ? sizeof(int) : *t == 'f' ? sizeof(float) 
+		: *t == 'c' ? 1 : 0);
+      if (fill_input (input, len) == false)
+	return;
+
+      pos = input->start + 1;
+      for (t = layout; *t; t++)
+	switch (*t)
+	  {
+	  case 'c':
+	    pos++;
+	    break;
+	  case 'i':
+	    pos += sizeof(int);
+	    break;
+	  case 'f':
+	    memcpy (&f, input->buffer + pos, sizeof(float));
+	    if (f != f)		/* NaN, an error */
+	      return;
+	    pos += sizeof(float);
+	    break;
+	  case 's':
+	    newline = (unsigned char *)memchr (input->buffer + pos, '\n',
+					       input->end - pos);
+	    if (newline == NULL)
+	      return;
+	    pos = (size_t)(newline - input->buffer) + 1;
+	    break;
+	  }
+      input->start = pos;
+    }
+}
@@ -101,6 +101,17 @@
 #include "libcommon.h"
 #include "getopt.h"
 
+/* Datasets may be splined on several threads (see --threads).  Their
+   output is buffered in memory streams. */
+#ifdef HAVE_PTHREAD_H
+#ifdef HAVE_PTHREAD_CREATE
+#ifdef HAVE_OPEN_MEMSTREAM
+#include <pthread.h>
+#define SPLINE_THREADS
+#endif
+#endif
+#endif
+
 /* states for cubic Bessel DFA; occupancy of data point queue */
 enum { STATE_ZERO, STATE_ONE, STATE_TWO, STATE_THREE };
 
@@ -119,6 +130,9 @@ enum { AUTO_NONE, AUTO_INCREMENT, AUTO_BY_DISTANCE };
    x/sinh(x) and x/tanh(x) by |x|exp(-|x|). */
 #define TRIG_ARG_MAX 50.0
 
+/* Maximum number of datasets read but not yet written, per thread. */
+#define DATASETS_QUEUED_PER_THREAD 4
+
 /* options */
 
 #define	ARG_NONE	0
@@ -145,6 +159,7 @@ struct option long_options[] =
   {"input-type",	ARG_REQUIRED,	NULL, 'I'},
   {"output-type",	ARG_REQUIRED,	NULL, 'O'},
   /* Long options with no equivalent short option alias */
+  {"threads",		ARG_REQUIRED,	NULL, 'j' << 8},
   {"version",		ARG_NONE,	NULL, 'V' << 8},
   {"help",		ARG_NONE,	NULL, 'h' << 8},
   {NULL, 		0, 		0,     0}
@@ -163,6 +178,77 @@ data_type;
 data_type input_type = T_ASCII;
 data_type output_type = T_ASCII;
 
+/* scratch storage for fit(), kept from one dataset to the next, and
+   enlarged when a dataset needs more.  A dataset of the size of the last
+   one therefore needs no allocation. */
+
+struct scratch
+{
+  double *buf;
+  int size;			/* number of doubles in buf[] */
+};
+
+/* a dataset read from the input, to be splined */
+typedef struct
+{
+  int used, len;		/* used+1 points, in arrays of size len */
+  double *t, **y, **z;		/* abscissa, ordinate, 2nd derivative arrays */
+  bool separator;		/* output a separator after it? */
+} dataset;
+
+/* the options for splining a dataset, i.e., the arguments of do_spline()
+   other than the dataset */
+typedef struct
+{
+  int ydimension;
+  double tension;
+  bool periodic;
+  bool spec_boundary_condition;
+  double boundary_condition;
+  int precision;
+  double first_t, last_t, spacing_t;
+  int no_of_intervals;
+  bool spec_first_t, spec_last_t, spec_spacing_t;
+  bool spec_no_of_intervals;
+  bool suppress_abscissa;
+} spline_options;
+
+#ifdef SPLINE_THREADS
+/* a slot in the ring of datasets being splined on the pool's threads */
+typedef struct
+{
+  dataset *ds;			/* the dataset, if any */
+  bool done;			/* has it been splined? */
+  bool failed;			/* ... without success? */
+  FILE *out, *err;		/* memory streams for output, diagnostics */
+  char *out_buf, *err_buf;	/* their buffers */
+  size_t out_len, err_len;	/* number of bytes written to them */
+} dataset_slot;
+#endif
+
+/* the pool that splines datasets and writes their output (see
+   submit_dataset()) */
+typedef struct
+{
+  spline_options options;	/* options for every dataset */
+  struct scratch scratch;	/* storage for fit(), on the main thread */
+  bool failed;			/* some dataset couldn't be splined? */
+#ifdef SPLINE_THREADS
+  int num_threads;		/* number of threads in pool */
+  pthread_t *threads;		/* the threads */
+  pthread_mutex_t lock;		/* protects the members below */
+  pthread_cond_t changed;	/* signalled when a slot is filled or done */
+  dataset_slot *slots;		/* ring of slots */
+  int num_slots;		/* number of slots */
+  long submitted;		/* number of datasets put in slots */
+  long taken;			/* ... taken by threads */
+  long written;			/* ... whose output has been written */
+  bool done;			/* no more datasets will be submitted */
+#endif
+} spline_pool;
+
+spline_pool *pool = NULL;	/* the pool, while splining */
+
 const char *progname = "spline"; /* name of this program */
 const char *written = "Written by Robert S. Maier and Rich Murphey.";
 const char *copyright = "Copyright (C) 2009 Free Software Foundation, Inc.";
@@ -171,14 +257,26 @@ const char *usage_appendage = " [FILE]...\n\
 With no FILE, or when FILE is -, read standard input.\n";
 
 /* forward references */
+struct spline_cursor;
+FILE * open_memory_stream (char **bufp, size_t *sizep);
+bool do_spline (int used, int len, double **t, int ydimension, double **y, double **z, double tension, bool periodic, bool spec_boundary_condition, double boundary_condition, int precision, double first_t, double last_t, double spacing_t, int no_of_intervals, bool spec_first_t, bool spec_last_t, bool spec_spacing_t, bool spec_no_of_intervals, bool suppress_abscissa, struct scratch *scratch, FILE *out, FILE *err);
 bool do_bessel (FILE *input, int ydimension, int auto_abscissa, double auto_t, double auto_delta, double first_t, double last_t, double spacing_t, int precision, bool suppress_abscissa);
+bool finish_splining (void);
+bool fit (int n, double *t, double **y, double **z, int ydimension, double k, double tension, bool periodic, struct scratch *scratch, FILE *err);
 bool is_monotonic (int n, double *t);
 bool read_data (FILE *input, int *len, int *used, int auto_abscissa, double auto_t, double auto_delta, double **t, int ydimension, double **y, double **z);
 bool read_float (FILE *input, double *dptr);
 bool skip_whitespace (FILE *stream);
-bool write_point (double t, double *y, int ydimension, int precision, bool suppress_abscissa);
-double interpolate (int n, double *t, double *y, double *z, double x, double tension, bool periodic);
+bool spline_dataset (dataset *ds, struct scratch *scratch, FILE *out, FILE *err);
+bool submit_dataset (dataset *ds);
+bool write_buffer (const char *buf, size_t len, FILE *stream);
+bool write_point (FILE *stream, double t, double *y, int ydimension, int precision, bool suppress_abscissa);
+bool write_splined_datasets (long until);
+dataset * new_dataset (int ydimension);
+int locate_point (struct spline_cursor *sc, double *xp);
+struct spline_cursor * new_spline_cursor (int n, double *t, double **y, double **z, int ydimension, double tension, bool periodic);
 double quotient_sin_func (double x, double y);
+double * scratch_buffer (struct scratch *scratch, int size);
 double quotient_sinh_func (double x, double y);
 double sin_func (double x);
 double sinh_func (double x);
@@ -186,12 +284,17 @@ double tan_func (double x);
 double tanh_func (double x);
 int read_point (FILE *input, double *t, double *y, int ydimension, bool *first_point, int auto_abscissa, double *auto_t, double auto_delta, double *stored);
 void do_bessel_range (double abscissa0, double abscissa1, double *value0, double *value1, double *slope0, double *slope1, double first_t, double last_t, double spacing_t, int ydimension, int precision, bool endit, bool suppress_abscissa);
-void do_spline (int used, int len, double **t, int ydimension, double **y, double **z, double tension, bool periodic, bool spec_boundary_condition, double boundary_condition, int precision, double first_t, double last_t, double spacing_t, int no_of_intervals, bool spec_first_t, bool spec_last_t, bool spec_spacing_t, bool spec_no_of_intervals, bool suppress_abscissa);
-void fit (int n, double *t, double *y, double *z, double k, double tension, bool periodic);
+void free_dataset (dataset *ds, int ydimension);
+void free_spline_cursor (struct spline_cursor *sc);
+void interpolate_block (struct spline_cursor *sc, int i, int count, const double *x, double *values);
+void interval_coefficients (struct spline_cursor *sc, int i);
 void maybe_emit_oob_warning (void);
 void non_monotonic_error (void);
-void output_dataset_separator (void);
+void output_dataset_separator (FILE *stream);
 void set_format_type (char *s, data_type *typep);
+void start_splining (const spline_options *options, int num_threads);
+void * spline_datasets (void *arg);
+void write_block (FILE *stream, struct spline_cursor *sc, int i, int count, const double *x, const double *xm, double *values, int precision, bool suppress_abscissa);
 
 
 int
@@ -220,6 +323,7 @@ main (int argc, char *argv[])
   int no_of_intervals = 100;	/* no. of intervals to divide abs. range */
   int precision = 6;		/* default no. of significant digits printed */
   int ydimension = 1;		/* dimension of each point's ordinate */
+  int num_threads = 1;		/* no. of threads splining datasets */
 
   /* used in argument parsing */
   double local_first_t, local_last_t, local_spacing_t;
@@ -255,6 +359,24 @@ main (int argc, char *argv[])
 	case 'h' << 8:		/* Help */
 	  show_usage = true;
 	  break;
+	case 'j' << 8:		/* Number of threads, ARG REQUIRED */
+	  {
+	    char *end;
+	    long local_num_threads;
+
+	    local_num_threads = strtol (optarg, &end, 10);
+	    if (end == optarg || *end != '\0' || local_num_threads < 1
+		|| local_num_threads > INT_MAX)
+	      {
+		fprintf (stderr,
+			 "%s: error: the number of threads `%s' is bad (it should be a positive integer)\n",
+			 progname, optarg);
+		errcnt++;
+	      }
+	    else
+	      num_threads = (int)local_num_threads;
+	  }
+	  break;
 
 	  /*--------------options with a single argument--------*/
 
@@ -486,7 +608,7 @@ main (int argc, char *argv[])
 
 		  /* output a separator between successive datasets */
 		  if (dataset_follows || (optind + 1 != argc))
-		    output_dataset_separator();
+		    output_dataset_separator (stdout);
 		  
 		} while (dataset_follows);
 
@@ -514,7 +636,7 @@ main (int argc, char *argv[])
 	    
 	    /* output a separator between successive datasets */
 	    if (dataset_follows)
-	      output_dataset_separator();
+	      output_dataset_separator (stdout);
 	  }
 	while (dataset_follows);	/* keep going if no EOF yet */
     }
@@ -522,8 +644,25 @@ main (int argc, char *argv[])
   else
     /* not acting as filter, so use spline interpolation (w/ tension) */
     {
-      double *t, **y, **z;	/* ordinate, abscissa, 2nd derivative arrays */
-      int i, len, used;
+      dataset *ds;
+      spline_options options;
+
+      options.ydimension = ydimension;
+      options.tension = tension;
+      options.periodic = periodic;
+      options.spec_boundary_condition = spec_boundary_condition;
+      options.boundary_condition = boundary_condition;
+      options.precision = precision;
+      options.first_t = first_t;
+      options.last_t = last_t;
+      options.spacing_t = spacing_t;
+      options.no_of_intervals = no_of_intervals;
+      options.spec_first_t = spec_first_t;
+      options.spec_last_t = spec_last_t;
+      options.spec_spacing_t = spec_spacing_t;
+      options.spec_no_of_intervals = spec_no_of_intervals;
+      options.suppress_abscissa = suppress_abscissa;
+      start_splining (&options, num_threads);
 
       if (optind < argc)	/* files spec'd on command line */
 	{
@@ -542,6 +681,7 @@ main (int argc, char *argv[])
 		  data_file = fopen (argv[optind], "r");
 		  if (data_file == NULL)
 		    {
+		      finish_splining ();
 		      fprintf (stderr, "%s: error: the file `%s' could not be opened\n",
 			       progname, argv[optind]);
 		      return EXIT_FAILURE;
@@ -551,40 +691,22 @@ main (int argc, char *argv[])
 	      /* loop through datasets in file (may be more than one) */
 	      do
 		{
-		  len = 16;	/* initial value of storage length */
-		  used = -1;	/* initial value of array size, minus 1 */
-	      
-		  t = (double *)xmalloc (sizeof(double) * len);
-		  y = (double **)xmalloc (sizeof(double *) * ydimension);
-		  z = (double **)xmalloc (sizeof(double *) * ydimension);
-		  for (i = 0; i < ydimension; i++)
-		    {
-		      y[i] = (double *)xmalloc (sizeof(double) * len);
-		      z[i] = (double *)xmalloc (sizeof(double) * len);
-		    }
-		  
-		  dataset_follows = read_data (data_file, &len, &used, 
+		  ds = new_dataset (ydimension);
+		  dataset_follows = read_data (data_file, &ds->len, &ds->used,
 					       auto_abscissa, t_start, delta_t,
-					       &t, ydimension, y, z);
+					       &ds->t, ydimension, ds->y, ds->z);
 		  /* read_data() may reallocate t,y[*],z[*], and update
 		     len, used; on exit, used + 1 is number of data points */
 		  
-		  /* spline the dataset and output interpolating points */
-		  do_spline (used, len, 
-			     &t, ydimension, y, z, tension, periodic,
-			     spec_boundary_condition, boundary_condition, 
-			     precision,
-			     first_t, last_t, spacing_t, no_of_intervals,
-			     spec_first_t, spec_last_t, spec_spacing_t, 
-			     spec_no_of_intervals, suppress_abscissa);
-
 		  /* output a separator between successive datasets */
-		  if (dataset_follows || (optind + 1 != argc))
-		    output_dataset_separator();
-		  
-		  free (z);
-		  free (y);
-		  free (t);
+		  ds->separator = (dataset_follows || (optind + 1 != argc));
+
+		  /* spline the dataset and output interpolating points */
+		  if (!submit_dataset (ds))
+		    {
+		      finish_splining ();
+		      return EXIT_FAILURE;
+		    }
 		}
 	      while (dataset_follows);	/* keep going if no EOF yet */
 	      
@@ -593,6 +715,7 @@ main (int argc, char *argv[])
 		{
 		  if (fclose (data_file) < 0)
 		    {
+		      finish_splining ();
 		      fprintf (stderr, 
 			       "%s: error: the input file `%s' could not be closed\n",
 			       progname, argv[optind]);
@@ -605,47 +728,27 @@ main (int argc, char *argv[])
 	/* loop through datasets read from stdin (may be more than one) */
 	do
 	  {
-	    len = 16;		/* initial value for array size */
-	    used = -1;	/* initial number of stored points, minus 1 */
-	    
-	    t = (double *)xmalloc (sizeof(double) * len);
-	    y = (double **)xmalloc (sizeof(double *) * ydimension);
-	    z = (double **)xmalloc (sizeof(double *) * ydimension);
-	    for (i = 0; i < ydimension; i++)
-	      {
-		y[i] = (double *)xmalloc (sizeof(double) * len);
-		z[i] = (double *)xmalloc (sizeof(double) * len);
-	      }
-	    
-	    dataset_follows = read_data (stdin, &len, &used, 
+	    ds = new_dataset (ydimension);
+	    dataset_follows = read_data (stdin, &ds->len, &ds->used, 
 				     auto_abscissa, t_start, delta_t, 
-				     &t, ydimension, y, z);
+				     &ds->t, ydimension, ds->y, ds->z);
 	    /* read_data() may reallocate t,y[*],z[*], and update len,
 	       used; on exit, used + 1 is number of data points */
 	    
-	    /* spline the dataset and output interpolating points */
-	    do_spline (used, len, 
-		       &t, ydimension, y, z, tension, periodic,
-		       spec_boundary_condition, boundary_condition, precision,
-		       first_t, last_t, spacing_t, no_of_intervals,
-		       spec_first_t, spec_last_t, spec_spacing_t, 
-		       spec_no_of_intervals, suppress_abscissa);
-	    
 	    /* output a separator between successive datasets */
-	    if (dataset_follows)
-	      output_dataset_separator();
-	    
-	    for (i = 0; i < ydimension; i++)
+	    ds->separator = dataset_follows;
+
+	    /* spline the dataset and output interpolating points */
+	    if (!submit_dataset (ds))
 	      {
-		free (z[i]);
-		free (y[i]);
+		finish_splining ();
+		return EXIT_FAILURE;
 	      }
-	    free (z);
-	    free (y);
-	    free (t);
 	  }
 	while (dataset_follows);	/* keep going if no EOF yet */
       
+      if (!finish_splining ())
+	return EXIT_FAILURE;
     }
 
   return EXIT_SUCCESS;
@@ -684,8 +787,25 @@ set_format_type (char *s, data_type *typep)
 }
 
 
-/* fit() computes the array z[] of second derivatives at the knots, i.e.,
-   internal data points.  The abscissa array t[] and the ordinate array y[]
+/* scratch_buffer() returns scratch storage for at least size doubles,
+   from the storage kept in *scratch (see above), enlarging it if need be.
+   Its contents are not preserved from one call to the next. */
+double *
+scratch_buffer (struct scratch *scratch, int size)
+{
+  if (size > scratch->size)
+    {
+      free (scratch->buf);
+      scratch->buf = (double *)xmalloc (sizeof(double) * size);
+      scratch->size = size;
+    }
+  return scratch->buf;
+}
+
+
+/* fit() computes the arrays z[j][] of second derivatives at the knots,
+   i.e., internal data points, for each component j = 0..ydimension-1 of
+   the ordinate.  The abscissa array t[] and the ordinate arrays y[j][]
    are specified.  On entry, have n+1 >= 2 points in the t, y, z arrays,
    numbered 0..n.  The knots are numbered 1..n-1 as in Kincaid and Cheney.
    In the periodic case, the final knot, i.e., (t[n-1],y[n-1]), has the
@@ -700,41 +820,50 @@ set_format_type (char *s, data_type *typep)
    the vector u[], and the vector on the right-hand side is v[].  That is,
    the equation is of the form Ay'' = v, where a_(ii) = u[i], and a_(i,i+1)
    = alpha[i].  Here i=1..n-1 indexes the set of knots.  The matrix
-   equation is solved by back-substitution for y''[], i.e., for z[]. */
+   equation is solved by back-substitution for y''[], i.e., for z[].
 
-/* ARGS: k = coeff in bdy condition y''_1 = k y''_0, etc. */
-void
-fit (int n, double *t, double *y, double *z, double k, double tension,
-     bool periodic)
+   The matrix depends only on t[] and the tension, so it is reduced once,
+   and the right-hand sides of all the components are carried along
+   together.  b[], v[] and vv[] hold ydimension values for each i, so
+   that the loops over the components run over adjacent elements. */
+
+/* ARGS: k = coeff in bdy condition y''_1 = k y''_0, etc.
+   	 scratch = where to find storage for the arrays below
+	 err = stream for diagnostics
+   Return value is false if the problem is singular. */
+bool
+fit (int n, double *t, double **y, double **z, int ydimension, double k, 
+     double tension, bool periodic, struct scratch *scratch, FILE *err)
 {
   double *h, *b, *u, *v, *alpha, *beta;
   double *uu = NULL, *vv = NULL, *s = NULL;
-  int i;
+  int i, j, d = ydimension;
 
   if (n == 1)			/* exactly 2 points, use straight line */
     {
-      z[0] = z[1] = 0.0;
-      return;
+      for (j = 0; j < ydimension; j++)
+	z[j][0] = z[j][1] = 0.0;
+      return true;
     }
 
-  h = (double *)xmalloc (sizeof(double) * n);
-  b = (double *)xmalloc (sizeof(double) * n);
-  u = (double *)xmalloc (sizeof(double) * n);
-  v = (double *)xmalloc (sizeof(double) * n);
-  alpha = (double *)xmalloc (sizeof(double) * n);
-  beta = (double *)xmalloc (sizeof(double) * n);
-
+  h = scratch_buffer (scratch, (periodic ? 6 + 3 * d : 4 + 2 * d) * n);
+  u = h + n;
+  alpha = u + n;
+  beta = alpha + n;
+  b = beta + n;
+  v = b + d * n;
   if (periodic)
     {
-      s = (double *)xmalloc (sizeof(double) * n); 
-      uu = (double *)xmalloc (sizeof(double) * n); 
-      vv = (double *)xmalloc (sizeof(double) * n); 
+      s = v + d * n;
+      uu = s + n;
+      vv = uu + n;
     }
 
   for (i = 0; i <= n - 1 ; ++i)
     {
       h[i] = t[i + 1] - t[i];
-      b[i] = 6.0 * (y[i + 1] - y[i]) / h[i]; /* for computing RHS */
+      for (j = 0; j < d; j++)	/* for computing RHS */
+	b[i * d + j] = 6.0 * (y[j][i + 1] - y[j][i]) / h[i];
     }
 
   if (tension < 0.0)		/* must rule out sin(tension * h[i]) = 0 */
@@ -742,8 +871,8 @@ fit (int n, double *t, double *y, double *z, double k, double tension,
       for (i = 0; i <= n - 1 ; ++i)
 	if (sin (tension * h[i]) == 0.0)
 	  {
-	    fprintf (stderr, "%s: error: the specified negative tension value is singular\n", progname);
-	    exit (EXIT_FAILURE);
+	    fprintf (err, "%s: error: the specified negative tension value is singular\n", progname);
+	    return false;
 	  }
     }
   if (tension == 0.0)
@@ -821,21 +950,23 @@ fit (int n, double *t, double *y, double *z, double k, double tension,
   else
     u[1] = beta[0] + beta[1] + k * alpha[0];
 
-  v[1] = b[1] - b[0];
+  for (j = 0; j < d; j++)
+    v[d + j] = b[d + j] - b[j];
   
   if (u[1] == 0.0)
     {
-      fprintf (stderr, 
+      fprintf (err, 
 	       "%s: error: as posed, the problem of computing a spline is singular\n",
 	       progname);
-      exit (EXIT_FAILURE);
+      return false;
     }
 
   if (periodic)
     {
       s[1] = alpha[0];
       uu[1] = 0.0;
-      vv[1] = 0.0;
+      for (j = 0; j < d; j++)
+	vv[d + j] = 0.0;
     }
 
   for (i = 2; i <= n - 1 ; ++i)
@@ -846,164 +977,373 @@ fit (int n, double *t, double *y, double *z, double k, double tension,
 
       if (u[i] == 0.0)
 	{
-	  fprintf (stderr, 
+	  fprintf (err, 
 		   "%s: error: as posed, the problem of computing a spline is singular\n",
 		   progname);
-	  exit (EXIT_FAILURE);
+	  return false;
 	}
 
 
-      v[i] = b[i] - b[i - 1] - alpha[i - 1] * v[i - 1] / u[i - 1];
+      for (j = 0; j < d; j++)
+	v[i * d + j] = (b[i * d + j] - b[(i - 1) * d + j] 
+			- alpha[i - 1] * v[(i - 1) * d + j] / u[i - 1]);
 
       if (periodic)
 	{
 	  s[i] = - s[i-1] * alpha[i-1] / u[i-1];
 	  uu[i] = uu[i-1] - s[i-1] * s[i-1] / u[i-1];
-	  vv[i] = vv[i-1] - v[i-1] * s[i-1] / u[i-1];
+	  for (j = 0; j < d; j++)
+	    vv[i * d + j] = (vv[(i - 1) * d + j] 
+			     - v[(i - 1) * d + j] * s[i-1] / u[i-1]);
 	}
     }
       
-  if (!periodic)
+  for (j = 0; j < d; j++)
     {
-      /* fill in 2nd derivative array */
-      z[n] = 0.0;
-      for (i = n - 1; i >= 1; --i)
-	z[i] = (v[i] - alpha[i] * z[i + 1]) / u[i];
-      z[0] = 0.0;
-      
-      /* modify to include boundary condition */
-      z[0] = k * z[1];
-      z[n] = k * z[n - 1];
-    }
-  else		/* periodic */
-    {
-      z[n-1] = (v[n-1] + vv[n-1]) / (u[n-1] + uu[n-1] + 2 * s[n-1]);
-      for (i = n - 2; i >= 1; --i)
-	z[i] = ((v[i] - alpha[i] * z[i + 1]) - s[i] * z[n-1]) / u[i];
+      double *zj = z[j];
 
-      z[0] = z[n-1];
-      z[n] = z[1];
+      if (!periodic)
+	{
+	  /* fill in 2nd derivative array */
+	  zj[n] = 0.0;
+	  for (i = n - 1; i >= 1; --i)
+	    zj[i] = (v[i * d + j] - alpha[i] * zj[i + 1]) / u[i];
+	  zj[0] = 0.0;
+      
+	  /* modify to include boundary condition */
+	  zj[0] = k * zj[1];
+	  zj[n] = k * zj[n - 1];
+	}
+      else		/* periodic */
+	{
+	  zj[n-1] = ((v[(n - 1) * d + j] + vv[(n - 1) * d + j]) 
+		     / (u[n-1] + uu[n-1] + 2 * s[n-1]));
+	  for (i = n - 2; i >= 1; --i)
+	    zj[i] = ((v[i * d + j] - alpha[i] * zj[i + 1]) 
+		     - s[i] * zj[n-1]) / u[i];
+
+	  zj[0] = zj[n-1];
+	  zj[n] = zj[1];
+	}
     }
 
-  if (periodic)
-    {
-      free (vv);
-      free (uu);
-      free (s);
-    }
-  free (beta);
-  free (alpha);
-  free (v);
-  free (u);
-  free (b);
-  free (h);
+  return true;
 }
 
 
-/* interpolate() computes an approximate ordinate value for a given
-   abscissa value, given an array of data points (stored in t[] and y[],
-   containing abscissa and ordinate values respectively), and z[], the
-   array of 2nd derivatives at the knots (i.e. internal data points).
-   
-   On entry, have n+1 >= 2 points in the t, y, z arrays, numbered 0..n.
-   The number of knots (i.e. internal data points) is n-1; they are
-   numbered 1..n-1 as in Kincaid and Cheney.  In the periodic case, the
-   final knot, i.e., (t[n-1],y[n-1]), has the property that y[n-1]=y[0];
-   also, y[n]=y[1].  The number of data points supplied by the user was n+1
-   in the non-periodic case, and n in the periodic case.  When this
-   function is called, n>=1 in the non-periodic case, and n>=2 in the
-   periodic case. */
+/* The fitted spline is evaluated by moving a cursor along the requested
+   abscissa values, which are usually monotonic, rather than by searching
+   for each one's interval afresh.  The quantities that depend only on the
+   interval (its width, the hyperbolic or trigonometric functions of
+   tension times its width, and the coefficients for each component of y)
+   are computed when the cursor enters it, and the functions of the
+   abscissa value that do not depend on the component are computed once
+   for all components.  Points in the same interval are evaluated in
+   blocks, in loops over the points that the compiler can vectorize.
+   Every value is computed by the same floating-point operations, in the
+   same order, as when each point was evaluated on its own, so the output
+   is unchanged. */
+
+/* the formula used on an interval, depending on tension * h */
+enum { EVAL_CUBIC, EVAL_SINH_SMALL, EVAL_SINH_LARGE, EVAL_SINH,
+       EVAL_SIN_SMALL, EVAL_SIN };
+
+/* ARGS: n, t, y, z, tension, periodic are as for new_spline_cursor()
+	 i = interval [t[i],t[i+1]] that the last abscissa value fell in
+	 coeff_i = interval that the fields below are for, or -1 */
+struct spline_cursor
+{
+  int n;
+  double *t, **y, **z;
+  int ydimension;
+  double tension;
+  bool periodic, is_ascending;
+  int i, coeff_i;
+  int method;			/* EVAL_CUBIC etc. */
+  double h, th;			/* width of interval, and tension * h */
+  double aux;			/* 6h, sign/tension^2, or tension^2 sinh(th) */
+  double sth;			/* sign * tension * h */
+  double *c0, *c1, *c2, *c3;	/* coefficients, for each component */
+};
 
-double
-interpolate (int n, double *t, double *y, double *z, double x, 
-	     double tension, bool periodic)
+/* maximum number of points evaluated together */
+#define BLOCK_POINTS 64
+
+/* new_spline_cursor() starts a cursor on the spline through the n+1 >= 2
+   points in t[] and in each y[j][], whose 2nd derivatives fit() has put
+   in z[j][] (j = 0..ydimension-1).  n, and the periodic pseudo-points,
+   are as for fit(). */
+struct spline_cursor *
+new_spline_cursor (int n, double *t, double **y, double **z, int ydimension,
+		   double tension, bool periodic)
+{
+  struct spline_cursor *sc;
+
+  sc = (struct spline_cursor *)xmalloc (sizeof (struct spline_cursor));
+  sc->n = n;
+  sc->t = t;
+  sc->y = y;
+  sc->z = z;
+  sc->ydimension = ydimension;
+  sc->tension = tension;
+  sc->periodic = periodic;
+  sc->is_ascending = (t[n-1] < t[n]);
+  sc->i = 0;
+  sc->coeff_i = -1;
+  sc->c0 = (double *)xmalloc (sizeof(double) * 4 * ydimension);
+  sc->c1 = sc->c0 + ydimension;
+  sc->c2 = sc->c1 + ydimension;
+  sc->c3 = sc->c2 + ydimension;
+  return sc;
+}
+
+void
+free_spline_cursor (struct spline_cursor *sc)
+{
+  free (sc->c0);		/* and the other coefficients */
+  free (sc);
+}
+
+/* locate_point() maps an abscissa value *xp into the period if the spline
+   is periodic, moves the cursor to the interval containing it, and returns
+   the interval.  That is the one a binary search would find: the last i in
+   0..n-1 such that t[i] is at or before x, or 0. */
+int
+locate_point (struct spline_cursor *sc, double *xp)
 {
-  double diff, updiff, reldiff, relupdiff, h;
-  double value;
-  int is_ascending = (t[n-1] < t[n]);
-  int i = 0, k;
+  double *t = sc->t, x = *xp;
+  int n = sc->n, i = sc->i;
 
   /* in periodic case, map x to t[0] <= x < t[n] */
-  if (periodic && (x - t[0]) * (x - t[n]) > 0.0)
+  if (sc->periodic && (x - t[0]) * (x - t[n]) > 0.0)
     x -= ((int)(floor( (x - t[0]) / (t[n] - t[0]) )) * (t[n] - t[0]));
 
-  /* do binary search to find interval */
-  for (k = n - i; k > 1;)
+  if (sc->is_ascending)
     {
-      if (is_ascending ? x >= t[i + (k>>1)] : x <= t[i + (k>>1)])
-	{
-	  i = i + (k>>1);
-	  k = k - (k>>1);
-	}
-      else
-	k = k>>1;
+      while (i < n - 1 && x >= t[i + 1])
+	i++;
+      while (i > 0 && !(x >= t[i]))
+	i--;
     }
+  else
+    {
+      while (i < n - 1 && x <= t[i + 1])
+	i++;
+      while (i > 0 && !(x <= t[i]))
+	i--;
+    }
+  *xp = x;
+  sc->i = i;
+  return i;
+}
 
-  /* at this point, x is between t[i] and t[i+1] */
-  h = t[i + 1] - t[i];
-  diff = x - t[i];
-  updiff = t[i+1] - x;
-  reldiff = diff / h;
-  relupdiff = updiff / h;
+/* interval_coefficients() computes the quantities for the interval
+   [t[i],t[i+1]] that do not depend on the abscissa value. */
+void
+interval_coefficients (struct spline_cursor *sc, int i)
+{
+  double tension = sc->tension, h;
+  double *t = sc->t;
+  int j;
 
+  h = sc->h = t[i + 1] - t[i];
+  sc->th = tension * h;
   if (tension == 0.0)
-  /* evaluate cubic polynomial in nested form */
-    value =  y[i] 
-      + diff
-	* ((y[i + 1] - y[i]) / h - h * (z[i + 1] + z[i] * 2.0) / 6.0
-	   + diff * (0.5 * z[i] + diff * (z[i + 1] - z[i]) / (6.0 * h)));
-  
+    sc->method = EVAL_CUBIC;
   else if (tension > 0.0)
-    /* `positive' (really real) tension, use sinh's */
     {
       if (fabs(tension * h) < TRIG_ARG_MIN)
-	/* hand-compute (6/y^2)(sinh(xy)/sinh(y) - x) to improve accuracy;
-	   here `x' means reldiff or relupdiff and `y' means tension*h */
-	value = (y[i] * relupdiff + y[i+1] * reldiff
-		 + ((z[i] * h * h / 6.0) 
-		    * quotient_sinh_func (relupdiff, tension * h))
-		 + ((z[i+1] * h * h / 6.0) 
-		    * quotient_sinh_func (reldiff, tension * h)));
+	sc->method = EVAL_SINH_SMALL;
       else if (fabs(tension * h) > TRIG_ARG_MAX)
-	/* approximate 1/sinh(y) by 2 sgn(y) exp(-|y|) */
-	{
-	  int sign = (h < 0.0 ? -1 : 1);
-
-	  value = (((z[i] * (exp (tension * updiff - sign * tension * h) 
-			     + exp (-tension * updiff - sign * tension * h))
-		     + z[i + 1] * (exp (tension * diff - sign * tension * h) 
-				   + exp (-tension * diff - sign * tension*h)))
-		    * (sign / (tension * tension)))
-		   + (y[i] - z[i] / (tension * tension)) * (updiff / h)
-		   + (y[i + 1] - z[i + 1] / (tension * tension)) * (diff / h));
-	}
+	sc->method = EVAL_SINH_LARGE;
       else
-	value = (((z[i] * sinh (tension * updiff) 
-		   + z[i + 1] * sinh (tension * diff))
-		  / (tension * tension * sinh (tension * h)))
-		 + (y[i] - z[i] / (tension * tension)) * (updiff / h)
-		 + (y[i + 1] - z[i + 1] / (tension * tension)) * (diff / h));
+	sc->method = EVAL_SINH;
     }
   else
-    /* `negative' (really imaginary) tension, use sin's */
+    sc->method = (fabs(tension * h) < TRIG_ARG_MIN 
+		  ? EVAL_SIN_SMALL : EVAL_SIN);
+
+  switch (sc->method)
     {
-      if (fabs(tension * h) < TRIG_ARG_MIN)
-	/* hand-compute (6/y^2)(sin(xy)/sin(y) - x) to improve accuracy;
-	   here `x' means reldiff or relupdiff and `y' means tension*h */
-	value = (y[i] * relupdiff + y[i+1] * reldiff
-		 + ((z[i] * h * h / 6.0) 
-		    * quotient_sin_func (relupdiff, tension * h))
-		 + ((z[i+1] * h * h / 6.0) 
-		    * quotient_sin_func (reldiff, tension * h)));
-      else
-	value = (((z[i] * sin (tension * updiff) 
-		   + z[i + 1] * sin (tension * diff))
-		  / (tension * tension * sin (tension * h)))
-		 + (y[i] - z[i] / (tension * tension)) * (updiff / h)
-		 + (y[i + 1] - z[i + 1] / (tension * tension)) * (diff / h));
+    case EVAL_CUBIC:
+      sc->aux = 6.0 * h;
+      break;
+    case EVAL_SINH_LARGE:
+      {
+	int sign = (h < 0.0 ? -1 : 1);
+
+	sc->aux = sign / (tension * tension);
+	sc->sth = sign * tension * h;
+      }
+      break;
+    case EVAL_SINH:
+      sc->aux = tension * tension * sinh (tension * h);
+      break;
+    case EVAL_SIN:
+      sc->aux = tension * tension * sin (tension * h);
+      break;
+    default:
+      break;
     }
-  
-  return value;
+
+  for (j = 0; j < sc->ydimension; j++)
+    {
+      double *y = sc->y[j], *z = sc->z[j];
+
+      switch (sc->method)
+	{
+	case EVAL_CUBIC:
+	  sc->c0[j] = y[i];
+	  sc->c1[j] = (y[i + 1] - y[i]) / h - h * (z[i + 1] + z[i] * 2.0) / 6.0;
+	  sc->c2[j] = 0.5 * z[i];
+	  sc->c3[j] = z[i + 1] - z[i];
+	  break;
+	case EVAL_SINH_SMALL:
+	case EVAL_SIN_SMALL:
+	  sc->c0[j] = y[i];
+	  sc->c1[j] = y[i + 1];
+	  sc->c2[j] = z[i] * h * h / 6.0;
+	  sc->c3[j] = z[i + 1] * h * h / 6.0;
+	  break;
+	default:
+	  sc->c0[j] = z[i];
+	  sc->c1[j] = z[i + 1];
+	  sc->c2[j] = y[i] - z[i] / (tension * tension);
+	  sc->c3[j] = y[i + 1] - z[i + 1] / (tension * tension);
+	  break;
+	}
+    }
+  sc->coeff_i = i;
+}
+
+/* interpolate_block() computes approximate ordinate values for count <=
+   BLOCK_POINTS abscissa values x[], which locate_point() has mapped and
+   found to lie in interval i, and puts them in values[], ydimension to a
+   point. */
+void
+interpolate_block (struct spline_cursor *sc, int i, int count, 
+		   const double *x, double *values)
+{
+  double diff[BLOCK_POINTS], updiff[BLOCK_POINTS];
+  double reldiff[BLOCK_POINTS], relupdiff[BLOCK_POINTS];
+  double f0[BLOCK_POINTS], f1[BLOCK_POINTS]; /* functions of the point */
+  double value[BLOCK_POINTS];
+  double tension = sc->tension, h, th, aux, sth;
+  double *t = sc->t;
+  int ydimension = sc->ydimension;
+  int j, k;
+
+  if (sc->coeff_i != i)
+    interval_coefficients (sc, i);
+  h = sc->h;
+  th = sc->th;
+  aux = sc->aux;
+  sth = sc->sth;
+
+  for (k = 0; k < count; k++)
+    {
+      diff[k] = x[k] - t[i];
+      updiff[k] = t[i+1] - x[k];
+      reldiff[k] = diff[k] / h;
+      relupdiff[k] = updiff[k] / h;
+    }
+
+  switch (sc->method)
+    {
+    case EVAL_SINH_SMALL:
+      /* hand-compute (6/y^2)(sinh(xy)/sinh(y) - x) to improve accuracy;
+	 here `x' means reldiff or relupdiff and `y' means tension*h */
+      for (k = 0; k < count; k++)
+	{
+	  f0[k] = quotient_sinh_func (relupdiff[k], th);
+	  f1[k] = quotient_sinh_func (reldiff[k], th);
+	}
+      break;
+    case EVAL_SIN_SMALL:
+      for (k = 0; k < count; k++)
+	{
+	  f0[k] = quotient_sin_func (relupdiff[k], th);
+	  f1[k] = quotient_sin_func (reldiff[k], th);
+	}
+      break;
+    case EVAL_SINH_LARGE:
+      /* approximate 1/sinh(y) by 2 sgn(y) exp(-|y|) */
+      for (k = 0; k < count; k++)
+	{
+	  f0[k] = (exp (tension * updiff[k] - sth) 
+		   + exp (-tension * updiff[k] - sth));
+	  f1[k] = (exp (tension * diff[k] - sth) 
+		   + exp (-tension * diff[k] - sth));
+	}
+      break;
+    case EVAL_SINH:
+      for (k = 0; k < count; k++)
+	{
+	  f0[k] = sinh (tension * updiff[k]);
+	  f1[k] = sinh (tension * diff[k]);
+	}
+      break;
+    case EVAL_SIN:
+      for (k = 0; k < count; k++)
+	{
+	  f0[k] = sin (tension * updiff[k]);
+	  f1[k] = sin (tension * diff[k]);
+	}
+      break;
+    default:
+      break;
+    }
+
+  for (j = 0; j < ydimension; j++)
+    {
+      double c0 = sc->c0[j], c1 = sc->c1[j], c2 = sc->c2[j], c3 = sc->c3[j];
+
+      switch (sc->method)
+	{
+	case EVAL_CUBIC:
+	  /* evaluate cubic polynomial in nested form */
+	  for (k = 0; k < count; k++)
+	    value[k] = c0 + diff[k] 
+	      * (c1 + diff[k] * (c2 + diff[k] * c3 / aux));
+	  break;
+	case EVAL_SINH_SMALL:
+	case EVAL_SIN_SMALL:
+	  for (k = 0; k < count; k++)
+	    value[k] = (c0 * relupdiff[k] + c1 * reldiff[k]
+			+ c2 * f0[k] + c3 * f1[k]);
+	  break;
+	case EVAL_SINH_LARGE:
+	  for (k = 0; k < count; k++)
+	    value[k] = ((c0 * f0[k] + c1 * f1[k]) * aux
+			+ c2 * (updiff[k] / h) + c3 * (diff[k] / h));
+	  break;
+	default:		/* EVAL_SINH, EVAL_SIN */
+	  for (k = 0; k < count; k++)
+	    value[k] = ((c0 * f0[k] + c1 * f1[k]) / aux
+			+ c2 * (updiff[k] / h) + c3 * (diff[k] / h));
+	  break;
+	}
+      for (k = 0; k < count; k++)
+	values[k * ydimension + j] = value[k];
+    }
+}
+
+
+/* write_block() evaluates a block of requested points by
+   interpolate_block(), and writes them to a stream in order.  x[] are the
+   points as requested, and xm[] the same points as mapped by
+   locate_point(). */
+void
+write_block (FILE *stream, struct spline_cursor *sc, int i, int count, 
+	     const double *x, const double *xm, double *values, 
+	     int precision, bool suppress_abscissa)
+{
+  int k, ydimension = sc->ydimension;
+
+  interpolate_block (sc, i, count, xm, values);
+  for (k = 0; k < count; k++)
+    write_point (stream, x[k], values + k * ydimension, ydimension, 
+		 precision, suppress_abscissa);
 }
 
 
@@ -1075,11 +1415,11 @@ read_float (FILE *input, double *dptr)
     }
 }
 
-/* Emit a pair of doubles, in specified output representation.  Inform user
-   if any of the emitted values was out-of-bounds for single-precision or
-   integer format. */
+/* Emit a pair of doubles to a stream, in specified output representation.
+   Inform user if any of the emitted values was out-of-bounds for
+   single-precision or integer format. */
 bool 
-write_point (double t, double *y, int ydimension, int precision, bool suppress_abscissa)
+write_point (FILE *stream, double t, double *y, int ydimension, int precision, bool suppress_abscissa)
 {
   int i, num_written = 0;
   float ft, fy;
@@ -1090,10 +1430,10 @@ write_point (double t, double *y, int ydimension, int precision, bool suppress_a
     case T_ASCII:
     default:
       if (suppress_abscissa == false)
-	num_written += printf ("%.*g ", precision, t);
+	num_written += fprintf (stream, "%.*g ", precision, t);
       for (i = 0; i < ydimension - 1; i++)
-	num_written += printf ("%.*g ", precision, y[i]);
-      num_written += printf ("%.*g\n", precision, y[ydimension - 1]);
+	num_written += fprintf (stream, "%.*g ", precision, y[i]);
+      num_written += fprintf (stream, "%.*g\n", precision, y[ydimension - 1]);
       break;
     case T_SINGLE:
       if (suppress_abscissa == false)
@@ -1105,7 +1445,7 @@ write_point (double t, double *y, int ydimension, int precision, bool suppress_a
 	      if (ft == FLT_MAX)
 		ft *= 0.99999;	/* kludge */
 	    }
-	  num_written += fwrite ((void *) &ft, sizeof (ft), 1, stdout);
+	  num_written += fwrite ((void *) &ft, sizeof (ft), 1, stream);
 	}
       for (i = 0; i < ydimension; i++)
 	{
@@ -1116,14 +1456,14 @@ write_point (double t, double *y, int ydimension, int precision, bool suppress_a
 	      if (fy == FLT_MAX)
 		fy *= 0.99999;	/* kludge */
 	    }
-	  num_written += fwrite ((void *) &fy, sizeof (fy), 1, stdout);
+	  num_written += fwrite ((void *) &fy, sizeof (fy), 1, stream);
 	}
       break;
     case T_DOUBLE:
       if (suppress_abscissa == false)
-	num_written += fwrite ((void *) &t, sizeof (t), 1, stdout);
+	num_written += fwrite ((void *) &t, sizeof (t), 1, stream);
       for (i = 0; i < ydimension; i++)
-	num_written += fwrite ((void *) &(y[i]), sizeof (double), 1, stdout);
+	num_written += fwrite ((void *) &(y[i]), sizeof (double), 1, stream);
       break;
     case T_INTEGER:
       if (suppress_abscissa == false)
@@ -1135,7 +1475,7 @@ write_point (double t, double *y, int ydimension, int precision, bool suppress_a
 	      if (it == INT_MAX)
 		it--;
 	    }
-	  num_written += fwrite ((void *) &it, sizeof (it), 1, stdout);
+	  num_written += fwrite ((void *) &it, sizeof (it), 1, stream);
 	}
       for (i = 0; i < ydimension; i++)
 	{
@@ -1146,7 +1486,7 @@ write_point (double t, double *y, int ydimension, int precision, bool suppress_a
 	      if (iy == INT_MAX)
 		iy--;
 	    }
-	  num_written += fwrite ((void *) &iy, sizeof (iy), 1, stdout);
+	  num_written += fwrite ((void *) &iy, sizeof (iy), 1, stream);
 	}
       break;
     }
@@ -1347,7 +1687,7 @@ read_data (FILE *input, int *len, int *used, int auto_abscissa,
 /* do_spline() is the main routine for piecewise cubic spline
    interpolation, supporting both periodicity and a user-specified boundary
    condition parameter.  Nonzero tension may be specified, in which case
-   the interpolate() routine, which this calls, will use not cubic
+   the interpolate_block() routine, which this calls, will use not cubic
    polynomials but rather expressions involving hyperbolic sines.
 
    t[] and y[] are the arrays in which the abscissa and ordinate values of
@@ -1366,43 +1706,56 @@ read_data (FILE *input, int *len, int *used, int auto_abscissa,
 /* ARGS: used = indicator that used+1 elements stored in (*t)[] etc.
    	 len = length of each array
 	 y,z are ptrs-to-ptrs because we may need to realloc
-	 k = coeff in bdy condition y''_1 = k y''_0, etc. */
-void
+	 k = coeff in bdy condition y''_1 = k y''_0, etc.
+	 scratch = scratch storage for fit(), reused across datasets
+	 out, err = streams for output and diagnostics
+   Return value is false if the spline could not be constructed. */
+bool
 do_spline (int used, int len, double **t, int ydimension, double **y, double **z, 
 	   double tension, bool periodic, bool spec_boundary_condition,
 	   double k, int precision, double first_t, double last_t, 
 	   double spacing_t, int no_of_intervals, bool spec_first_t, 
 	   bool spec_last_t, bool spec_spacing_t, 
-	   bool spec_no_of_intervals, bool suppress_abscissa)
+	   bool spec_no_of_intervals, bool suppress_abscissa, 
+	   struct scratch *scratch, FILE *out, FILE *err)
 {
   int range_count = 0;		/* number of req'd datapoints out of range */
   int lastval = 0;		/* last req'd point = 1st/last data point? */
   int i;
+  struct spline_cursor *sc;
+  double x_block[BLOCK_POINTS];	/* req'd points awaiting evaluation */
+  double xm_block[BLOCK_POINTS]; /* ... mapped into the period if any */
+  double *values;
+  int count = 0, block_i = 0;	/* how many, and their interval */
 
   if (used + 1 == 0)		/* zero data points in array */
     /* don't output anything (i.e. effectively output a null dataset) */
-    return;
+    return true;
 
   if (used+1 == 1)		/* a single data point in array */
     {
-      fprintf (stderr, 
+      fprintf (err, 
 	       "%s: a spline cannot be constructed from a single data point\n", 
 	       progname);
       /* don't output anything (i.e. effectively output a null dataset) */
-      return;
+      return true;
     }
 
   if (!periodic && used+1 <= 2)
     {
       if (spec_boundary_condition)
-	fprintf (stderr, 
+	fprintf (err, 
 		 "%s: the specified boundary condition is ignored, as there are only 2 data points\n", 
 		 progname);
       k = 0.0;
     }
 
   if (!is_monotonic (used, *t))
-    non_monotonic_error();	/* self-explanatory */
+    {
+      fprintf (err, "%s: error: the abscissa values are not monotonic\n",
+	       progname);
+      return false;
+    }
 
   if (periodic)
     {
@@ -1415,7 +1768,7 @@ do_spline (int used, int len, double **t, int ydimension, double **y, double **z
 	  y[i][used] = y[i][0];
 	}
       if (print_warning == true)
-	fprintf (stderr, "%s: the final y value is set equal to the initial value, to ensure periodicity\n", 
+	fprintf (err, "%s: the final y value is set equal to the initial value, to ensure periodicity\n", 
 		 progname); 
 
       /* add pseudo-point at end (to accord with periodicity) */
@@ -1435,9 +1788,9 @@ do_spline (int used, int len, double **t, int ydimension, double **y, double **z
     }
 
   /* compute z[], array of 2nd derivatives at each knot */
-  for (i = 0; i < ydimension; i++)
-    fit (used + (periodic ? 1 : 0), /* include pseudo-point if any */
-	 *t, y[i], z[i], k, tension, periodic);
+  if (!fit (used + (periodic ? 1 : 0), /* include pseudo-point if any */
+	    *t, y, z, ydimension, k, tension, periodic, scratch, err))
+    return false;
 
   if (!spec_first_t) 
     first_t = (*t)[0];
@@ -1454,12 +1807,12 @@ do_spline (int used, int len, double **t, int ydimension, double **y, double **z
     {
       if ((last_t - first_t) * spacing_t < 0.0)
 	{
-	  fprintf (stderr, "%s: the requested spacing is of the wrong sign, so it has been corrected\n",
+	  fprintf (err, "%s: the requested spacing is of the wrong sign, so it has been corrected\n",
 		   progname);
 	  spacing_t = -spacing_t;
 	}
       if (spec_no_of_intervals)
-	fprintf (stderr, "%s: the requested number of intervals is disregarded\n",
+	fprintf (err, "%s: the requested number of intervals is disregarded\n",
 		 progname);
       no_of_intervals = (int)(fabs((last_t - first_t) / spacing_t) + FUZZ);
     }
@@ -1469,6 +1822,8 @@ do_spline (int used, int len, double **t, int ydimension, double **y, double **z
   else if (last_t == (*t)[used])
     lastval = 2;
 
+  sc = new_spline_cursor (used, *t, y, z, ydimension, tension, periodic);
+  values = (double *)xmalloc (sizeof(double) * BLOCK_POINTS * ydimension);
   for (i = 0; i <= no_of_intervals; ++i)
     {
       double x;
@@ -1486,36 +1841,393 @@ do_spline (int used, int len, double **t, int ydimension, double **y, double **z
 
       if (periodic || (x - (*t)[0]) * (x - (*t)[used]) <= 0)
 	{
-	  int j;
-	  double *yy;
+	  double xm = x;
+	  int interval = locate_point (sc, &xm);
 
-	  yy = (double *)xmalloc (sizeof(double) * ydimension); 
-	  for (j = 0; j < ydimension; j++)
-	    yy[j] = interpolate (used, *t, y[j], z[j], x, 
-				 tension, periodic);
-	  write_point (x, yy, ydimension, precision, suppress_abscissa);
-	  free (yy);
+	  /* evaluate a block at a time, a block being a run of consecutive
+	     requested points in the same interval */
+	  if (count > 0 && (interval != block_i || count == BLOCK_POINTS))
+	    {
+	      write_block (out, sc, block_i, count, x_block, xm_block, values,
+			   precision, suppress_abscissa);
+	      count = 0;
+	    }
+	  block_i = interval;
+	  x_block[count] = x;
+	  xm_block[count] = xm;
+	  count++;
 	}
       else
 	range_count++;
     }
+  if (count > 0)
+    write_block (out, sc, block_i, count, x_block, xm_block, values,
+		 precision, suppress_abscissa);
+  free (values);
+  free_spline_cursor (sc);
 
   switch (range_count)
     {
     case 0:
       break;
     case 1:
-      fprintf (stderr, 
+      fprintf (err, 
 	       "%s: one requested point could not be computed (as it was out of the data range)\n", 
 	       progname);
       break;
     default:
-      fprintf (stderr, 
+      fprintf (err, 
 	       "%s: %d requested points could not be computed (as they were out of the data range)\n", 
 	       progname, range_count);
       break;
     }
+
+  return true;
+}
+
+
+/* Datasets are passed, as they're read, to a pool that splines them and
+   writes their output.  It splines each one on the current thread as soon
+   as it's submitted, or if several threads are requested (see --threads),
+   hands it to a thread of the pool.  In the latter case, the datasets
+   being splined are kept in a ring of slots, in the order they were read.
+   Each slot has memory streams of its own, to which the thread splining
+   the dataset in it writes the output and the diagnostics.  The main
+   thread copies their buffers to stdout and stderr, in order, before
+   reusing the slot, so that the output is the same as if there were no
+   threads. */
+
+/* new_dataset() returns a dataset with room for a few points, into which
+   read_data() may read one. */
+dataset *
+new_dataset (int ydimension)
+{
+  dataset *ds;
+  int i;
+
+  ds = (dataset *)xmalloc (sizeof (dataset));
+  ds->len = 16;			/* initial value of storage length */
+  ds->used = -1;		/* initial value of array size, minus 1 */
+  ds->t = (double *)xmalloc (sizeof(double) * ds->len);
+  ds->y = (double **)xmalloc (sizeof(double *) * ydimension);
+  ds->z = (double **)xmalloc (sizeof(double *) * ydimension);
+  for (i = 0; i < ydimension; i++)
+    {
+      ds->y[i] = (double *)xmalloc (sizeof(double) * ds->len);
+      ds->z[i] = (double *)xmalloc (sizeof(double) * ds->len);
+    }
+  ds->separator = false;
+  return ds;
+}
+
+void
+free_dataset (dataset *ds, int ydimension)
+{
+  int i;
+
+  for (i = 0; i < ydimension; i++)
+    {
+      free (ds->z[i]);
+      free (ds->y[i]);
+    }
+  free (ds->z);
+  free (ds->y);
+  free (ds->t);
+  free (ds);
+}
+
+/* spline_dataset() splines a dataset, writing the interpolating points,
+   and the separator that follows them if any, to out, and diagnostics to
+   err.  Return value is false if the spline could not be constructed. */
+bool
+spline_dataset (dataset *ds, struct scratch *scratch, FILE *out, FILE *err)
+{
+  const spline_options *o = &pool->options;
+
+  if (!do_spline (ds->used, ds->len, &ds->t, o->ydimension, ds->y, ds->z, 
+		  o->tension, o->periodic, o->spec_boundary_condition, 
+		  o->boundary_condition, o->precision, 
+		  o->first_t, o->last_t, o->spacing_t, o->no_of_intervals,
+		  o->spec_first_t, o->spec_last_t, o->spec_spacing_t, 
+		  o->spec_no_of_intervals, o->suppress_abscissa, 
+		  scratch, out, err))
+    return false;
+
+  /* output a separator between successive datasets */
+  if (ds->separator)
+    output_dataset_separator (out);
+  return true;
+}
+
+/* Set up the pool that splines datasets with the given options, and
+   start its threads (if more than one is requested, and they're
+   supported). */
+void
+start_splining (const spline_options *options, int num_threads)
+{
+  pool = (spline_pool *)xmalloc (sizeof (spline_pool));
+  pool->options = *options;
+  pool->scratch.buf = NULL;
+  pool->scratch.size = 0;
+  pool->failed = false;
+#ifdef SPLINE_THREADS
+  pool->num_threads = 0;
+  pool->threads = (pthread_t *)NULL;
+  pool->slots = (dataset_slot *)NULL;
+  pool->submitted = pool->taken = pool->written = 0;
+  pool->done = false;
+  if (num_threads > 1)
+    {
+      int i;
+
+      pthread_mutex_init (&pool->lock, NULL);
+      pthread_cond_init (&pool->changed, NULL);
+      pool->num_slots = DATASETS_QUEUED_PER_THREAD * num_threads;
+      pool->slots = 
+	(dataset_slot *)xmalloc (pool->num_slots * sizeof (dataset_slot));
+      for (i = 0; i < pool->num_slots; i++)
+	{
+	  pool->slots[i].ds = (dataset *)NULL;
+	  pool->slots[i].out = pool->slots[i].err = (FILE *)NULL;
+	}
+      pool->threads = (pthread_t *)xmalloc (num_threads * sizeof (pthread_t));
+      for (i = 0; i < num_threads; i++)
+	{
+	  if (pthread_create (&pool->threads[i], NULL, 
+			      spline_datasets, NULL) != 0)
+	    break;		/* make do with fewer threads */
+	  pool->num_threads++;
+	}
+    }
+#else
+  (void)num_threads;
+#endif
+}
+
+/* Pass a dataset to the pool, which takes ownership of it.  If there are
+   no threads, it's splined immediately; otherwise it's put in the next
+   slot, after the output of the datasets that are done has been written
+   and, if need be, after waiting until the slot is free.  Return value is
+   false if this dataset or an earlier one could not be splined, in which
+   case nothing more should be submitted. */
+bool
+submit_dataset (dataset *ds)
+{
+#ifdef SPLINE_THREADS
+  if (pool->num_threads > 0)
+    {
+      dataset_slot *slot;
+
+      if (!write_splined_datasets (pool->submitted - pool->num_slots + 1))
+	{
+	  free_dataset (ds, pool->options.ydimension);
+	  return false;
+	}
+      slot = &pool->slots[pool->submitted % pool->num_slots];
+      if (slot->out == NULL)
+	{
+	  slot->out = open_memory_stream (&slot->out_buf, &slot->out_len);
+	  slot->err = open_memory_stream (&slot->err_buf, &slot->err_len);
+	}
+      slot->ds = ds;
+      slot->done = false;
+
+      pthread_mutex_lock (&pool->lock);
+      pool->submitted++;
+      pthread_cond_broadcast (&pool->changed);
+      pthread_mutex_unlock (&pool->lock);
+      return true;
+    }
+#endif
+  if (!spline_dataset (ds, &pool->scratch, stdout, stderr))
+    pool->failed = true;
+  free_dataset (ds, pool->options.ydimension);
+  return !pool->failed;
+}
+
+/* Wait until all datasets passed to the pool have been splined, and their
+   output written, and shut the pool down.  If a dataset couldn't be
+   splined, the output of the ones after it is discarded.  Return value is
+   false in that case, or if the output could not be written. */
+bool
+finish_splining (void)
+{
+  bool success = !pool->failed;
+
+#ifdef SPLINE_THREADS
+  if (pool->num_threads > 0)
+    {
+      int i;
+
+      if (success)
+	success = write_splined_datasets (pool->submitted);
+      pthread_mutex_lock (&pool->lock);
+      pool->done = true;
+      pthread_cond_broadcast (&pool->changed);
+      pthread_mutex_unlock (&pool->lock);
+      for (i = 0; i < pool->num_threads; i++)
+	pthread_join (pool->threads[i], NULL);
+      for (i = 0; i < pool->num_slots; i++)
+	{
+	  if (pool->slots[i].ds)
+	    free_dataset (pool->slots[i].ds, pool->options.ydimension);
+	  if (pool->slots[i].out)
+	    {
+	      fclose (pool->slots[i].out);
+	      fclose (pool->slots[i].err);
+	      free (pool->slots[i].out_buf);
+	      free (pool->slots[i].err_buf);
+	    }
+	}
+      pthread_mutex_destroy (&pool->lock);
+      pthread_cond_destroy (&pool->changed);
+    }
+  if (pool->slots)
+    free (pool->slots);
+  if (pool->threads)
+    free (pool->threads);
+#endif
+  if (fflush (stdout) < 0)
+    {
+      fprintf (stderr, "%s: error: the output could not be written: %s\n",
+	       progname, strerror (errno));
+      success = false;
+    }
+  free (pool->scratch.buf);
+  free (pool);
+  pool = (spline_pool *)NULL;
+  return success;
+}
+
+#ifdef SPLINE_THREADS
+/* Body of each thread of the pool: spline the datasets in the slots, in
+   turn, until there are no more, or one of them couldn't be splined. */
+void *
+spline_datasets (void *arg)
+{
+  struct scratch scratch;	/* storage for fit(), for this thread */
+  dataset_slot *slot;
+  bool success;
+
+  scratch.buf = NULL;
+  scratch.size = 0;
+  for (;;)
+    {
+      pthread_mutex_lock (&pool->lock);
+      while (pool->taken == pool->submitted && !pool->done && !pool->failed)
+	pthread_cond_wait (&pool->changed, &pool->lock);
+      if (pool->taken == pool->submitted || pool->failed)
+	{
+	  pthread_mutex_unlock (&pool->lock);
+	  break;
+	}
+      slot = &pool->slots[pool->taken++ % pool->num_slots];
+      pthread_mutex_unlock (&pool->lock);
+
+      rewind (slot->out);
+      rewind (slot->err);
+      success = spline_dataset (slot->ds, &scratch, slot->out, slot->err);
+      /* update the buffers and their lengths */
+      if (fflush (slot->out) < 0 || fflush (slot->err) < 0)
+	{
+	  fprintf (stderr, "%s: error: the output could not be buffered: %s\n",
+		   progname, strerror (errno));
+	  exit (EXIT_FAILURE);
+	}
+
+      pthread_mutex_lock (&pool->lock);
+      slot->failed = !success;
+      slot->done = true;
+      pthread_cond_broadcast (&pool->changed);
+      pthread_mutex_unlock (&pool->lock);
+    }
+  free (scratch.buf);
+  return arg;
+}
+
+/* Write the output and diagnostics of splined datasets, in order: of all
+   those numbered below `until' (counting from 0), waiting for them if
+   need be, and then of any more that are done.  Each slot written is
+   freed.  Return value is false if one of them couldn't be splined, or
+   its output couldn't be written, in which case none after it is
+   written. */
+bool
+write_splined_datasets (long until)
+{
+  dataset_slot *slot;
+  bool failed;
+
+  for (;;)
+    {
+      pthread_mutex_lock (&pool->lock);
+      if (pool->written == pool->submitted)
+	{
+	  pthread_mutex_unlock (&pool->lock);
+	  return true;
+	}
+      slot = &pool->slots[pool->written % pool->num_slots];
+      if (pool->written >= until && !slot->done)
+	{
+	  pthread_mutex_unlock (&pool->lock);
+	  return true;
+	}
+      while (!slot->done)
+	pthread_cond_wait (&pool->changed, &pool->lock);
+      failed = slot->failed;
+      pthread_mutex_unlock (&pool->lock);
+
+      if (!write_buffer (slot->out_buf, slot->out_len, stdout))
+	failed = true;
+      fwrite (slot->err_buf, 1, slot->err_len, stderr);
+      free_dataset (slot->ds, pool->options.ydimension);
+      slot->ds = (dataset *)NULL;
+
+      pthread_mutex_lock (&pool->lock);
+      if (failed)
+	{
+	  pool->failed = true;	/* stop the threads */
+	  pthread_cond_broadcast (&pool->changed);
+	}
+      else
+	pool->written++;
+      pthread_mutex_unlock (&pool->lock);
+      if (failed)
+	return false;
+    }
+}
+
+/* Open a memory stream, which is written to a growable buffer.  The
+   buffer, and the number of bytes written to it, are stored in *bufp and
+   *sizep when the stream is flushed. */
+FILE *
+open_memory_stream (char **bufp, size_t *sizep)
+{
+  FILE *fp;
+
+  fp = open_memstream (bufp, sizep);
+  if (fp == NULL)
+    {
+      fprintf (stderr, "%s: error: the output could not be buffered: %s\n",
+	       progname, strerror (errno));
+      exit (EXIT_FAILURE);
+    }
+  return fp;
+}
+
+/* Write the bytes in a buffer to a stream.  Return value is false, after
+   an error message, if they could not all be written. */
+bool
+write_buffer (const char *buf, size_t len, FILE *stream)
+{
+  if (len > 0 && fwrite (buf, 1, len, stream) != len)
+    {
+      fprintf (stderr, "%s: error: the output could not be written: %s\n",
+	       progname, strerror (errno));
+      return false;
+    }
+  return true;
 }
+#endif /* SPLINE_THREADS */
 
 
 /* do_bessel() is the main routine for doing real-time cubic Bessel
@@ -1760,7 +2472,7 @@ do_bessel_range (double abscissa0, double abscissa1, double *value0,
 				 - updiff * updiff / h))));
 	    }
 	  
-	  success = write_point (t, y, 
+	  success = write_point (stdout, t, y, 
 				 ydimension, precision, suppress_abscissa);
 	  if (!success)
 	    {
@@ -1781,7 +2493,7 @@ do_bessel_range (double abscissa0, double abscissa1, double *value0,
    this is a DBL_MAX, etc. */
 
 void
-output_dataset_separator (void)
+output_dataset_separator (FILE *stream)
 {
   double ddummy;
   float fdummy;
@@ -1791,19 +2503,19 @@ output_dataset_separator (void)
     {
     case T_ASCII:
     default:
-      printf ("\n");
+      putc ('\n', stream);
       break;
     case T_DOUBLE:
       ddummy = DBL_MAX;
-      fwrite ((void *) &ddummy, sizeof(ddummy), 1, stdout);
+      fwrite ((void *) &ddummy, sizeof(ddummy), 1, stream);
       break;
     case T_SINGLE:
       fdummy = FLT_MAX;
-      fwrite ((void *) &fdummy, sizeof(fdummy), 1, stdout);
+      fwrite ((void *) &fdummy, sizeof(fdummy), 1, stream);
       break;
     case T_INTEGER:
       idummy = INT_MAX;
-      fwrite ((void *) &idummy, sizeof(idummy), 1, stdout);
+      fwrite ((void *) &idummy, sizeof(idummy), 1, stream);
       break;
     }
 }
@@ -1840,12 +2552,19 @@ void
 maybe_emit_oob_warning (void)
 {
   static bool warning_written = false;
+#ifdef SPLINE_THREADS
+  static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
 
+  pthread_mutex_lock (&lock);
+#endif
   if (!warning_written)
     {
       fprintf (stderr, "%s: one or more out-of-bounds output values are approximated\n", progname);
       warning_written = true;
     }
+#ifdef SPLINE_THREADS
+  pthread_mutex_unlock (&lock);
+#endif
 }
 
 
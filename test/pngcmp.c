@@ -0,0 +1,179 @@
+/* This file is part of the GNU plotutils package.  Copyright (C) 2008,
+   Free Software Foundation, Inc.
+
+   The GNU plotutils package is free software.  You may redistribute it
+   and/or modify it under the terms of the GNU General Public License as
+   published by the Free Software foundation; either version 2, or (at your
+   option) any later version.
+
+   The GNU plotutils package is distributed in the hope that it will be
+   useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with the GNU plotutils package; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin St., Fifth Floor,
+   Boston, MA 02110-1301, USA. */
+
+/* This program compares the pixels of a PNG file with those of a binary
+   PPM (P6) file, for the png.test validation test.  It prints the color
+   type and bit depth of the PNG file, e.g. "palette 4", and exits with
+   status 0 if the two images have the same size and pixels, and 1
+   otherwise. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <png.h>
+
+static unsigned char *read_png (const char *name, int *width, int *height);
+static unsigned char *read_ppm (const char *name, int *width, int *height);
+static int read_header_value (FILE *fp);
+
+int
+main (int argc, char **argv)
+{
+  unsigned char *png, *ppm;
+  int png_width, png_height, ppm_width, ppm_height;
+
+  if (argc != 3)
+    {
+      fprintf (stderr, "usage: pngcmp FILE.png FILE.ppm\n");
+      return 1;
+    }
+  png = read_png (argv[1], &png_width, &png_height);
+  ppm = read_ppm (argv[2], &ppm_width, &ppm_height);
+  if (png == NULL || ppm == NULL)
+    return 1;
+  if (png_width != ppm_width || png_height != ppm_height)
+    {
+      fprintf (stderr, "pngcmp: the images are %dx%d and %dx%d\n",
+	       png_width, png_height, ppm_width, ppm_height);
+      return 1;
+    }
+  if (memcmp (png, ppm, 3 * (size_t)png_width * png_height) != 0)
+    {
+      fprintf (stderr, "pngcmp: the pixels differ\n");
+      return 1;
+    }
+  return 0;
+}
+
+/* read a PNG file, print its color type and bit depth, and return its
+   pixels as 8-bit RGB triples */
+static unsigned char *
+read_png (const char *name, int *width, int *height)
+{
+  FILE *fp;
+  png_struct *png_ptr;
+  png_info *info_ptr;
+  png_byte **rows;
+  unsigned char *pixels;
+  int color_type, i;
+
+  if ((fp = fopen (name, "rb")) == NULL)
+    {
+      fprintf (stderr, "pngcmp: %s could not be opened\n", name);
+      return NULL;
+    }
+  png_ptr = png_create_read_struct (PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+  info_ptr = png_create_info_struct (png_ptr);
+  if (setjmp (png_jmpbuf (png_ptr)))
+    {
+      fprintf (stderr, "pngcmp: %s could not be read\n", name);
+      return NULL;
+    }
+  png_init_io (png_ptr, fp);
+  png_read_info (png_ptr, info_ptr);
+
+  color_type = png_get_color_type (png_ptr, info_ptr);
+  printf ("%s %d\n",
+	  (color_type == PNG_COLOR_TYPE_PALETTE ? "palette"
+	   : color_type == PNG_COLOR_TYPE_GRAY ? "gray"
+	   : color_type == PNG_COLOR_TYPE_RGB ? "rgb" : "other"),
+	  png_get_bit_depth (png_ptr, info_ptr));
+
+  /* convert every pixel to 8-bit RGB */
+  png_set_expand (png_ptr);
+  png_set_strip_16 (png_ptr);
+  png_set_strip_alpha (png_ptr);
+  png_set_gray_to_rgb (png_ptr);
+  png_set_interlace_handling (png_ptr);
+  png_read_update_info (png_ptr, info_ptr);
+
+  *width = png_get_image_width (png_ptr, info_ptr);
+  *height = png_get_image_height (png_ptr, info_ptr);
+  pixels = (unsigned char *)malloc (3 * (size_t)*width * *height);
+  rows = (png_byte **)malloc (*height * sizeof (png_byte *));
+  for (i = 0; i < *height; i++)
+    rows[i] = pixels + 3 * (size_t)*width * i;
+  png_read_image (png_ptr, rows);
+  png_read_end (png_ptr, NULL);
+  png_destroy_read_struct (&png_ptr, &info_ptr, NULL);
+  free (rows);
+  fclose (fp);
+  return pixels;
+}
+
+/* read a binary PPM file, and return its pixels */
+static unsigned char *
+read_ppm (const char *name, int *width, int *height)
+{
+  FILE *fp;
+  unsigned char *pixels;
+  size_t len;
+
+  if ((fp = fopen (name, "rb")) == NULL)
+    {
+      fprintf (stderr, "pngcmp: %s could not be opened\n", name);
+      return NULL;
+    }
+  if (getc (fp) != 'P' || getc (fp) != '6')
+    {
+      fprintf (stderr, "pngcmp: %s is not a binary PPM file\n", name);
+      return NULL;
+    }
+  *width = read_header_value (fp);
+  *height = read_header_value (fp);
+  if (*width <= 0 || *height <= 0 || read_header_value (fp) != 255)
+    {
+      fprintf (stderr, "pngcmp: %s has a bad header\n", name);
+      return NULL;
+    }
+  len = 3 * (size_t)*width * *height;
+  pixels = (unsigned char *)malloc (len);
+  if (fread (pixels, 1, len, fp) != len)
+    {
+      fprintf (stderr, "pngcmp: %s is truncated\n", name);
+      return NULL;
+    }
+  fclose (fp);
+  return pixels;
+}
+
+/* read a decimal value from a PPM header, skipping whitespace and
+   comments before it, and the whitespace character after it */
+static int
+read_header_value (FILE *fp)
+{
+  int c, value = 0;
+
+  for (;;)
+    {
+      c = getc (fp);
+      if (c == '#')
+	while (c != '\n' && c != EOF)
+	  c = getc (fp);
+      else if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+	break;
+    }
+  if (c < '0' || c > '9')
+    return -1;
+  while (c >= '0' && c <= '9')
+    {
+      value = 10 * value + (c - '0');
+      c = getc (fp);
+    }
+  return value;
+}
@@ -0,0 +1,137 @@
+/* This file is part of the GNU plotutils package.  Copyright (C) 2008,
+   Free Software Foundation, Inc.
+
+   The GNU plotutils package is free software.  You may redistribute it
+   and/or modify it under the terms of the GNU General Public License as
+   published by the Free Software foundation; either version 2, or (at your
+   option) any later version.
+
+   The GNU plotutils package is distributed in the hope that it will be
+   useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with the GNU plotutils package; see the file COPYING.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin St., Fifth Floor,
+   Boston, MA 02110-1301, USA. */
+
+/* This program exercises libplot's getraster() and copyraster() methods,
+   for the raster.test validation test.  It draws a few pages with PNM,
+   GIF and Metafile Plotters, and prints what it retrieves: whether a
+   raster is available, its dimensions, and a few of its pixels. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <plot.h>
+
+#define SIZE 20			/* width and height of bitmaps, in pixels */
+
+static void show (const char *what, plPlotter *plotter);
+static void show_pixels (const unsigned char *pixels, int stride);
+static void fill_box (plPlotter *plotter, const char *color, double x0, double x1);
+
+int
+main (void)
+{
+  plPlotterParams *params;
+  plPlotter *plotter;
+  const char *types[] = { "pnm", "gif" };
+  const unsigned char *pixels;
+  unsigned char buf[SIZE * (3 * SIZE + 5)];
+  int i, status;
+
+  params = pl_newplparams ();
+  pl_setplparam (params, "BITMAPSIZE", (void *)"20x20");
+  pl_setplparam (params, "BG_COLOR", (void *)"white");
+
+  for (i = 0; i < 2; i++)
+    {
+      printf ("%s Plotter\n", types[i]);
+      plotter = pl_newpl_r (types[i], NULL, NULL, stderr, params);
+      show ("before openpl", plotter);
+
+      /* first page: red on the left, and later blue on the right */
+      pl_openpl_r (plotter);
+      pl_fspace_r (plotter, 0.0, 0.0, (double)SIZE, (double)SIZE);
+      fill_box (plotter, "red", 0.0, 10.0);
+      show ("page 1, red drawn", plotter);
+      pl_getraster_r (plotter, &pixels, NULL, NULL, NULL, NULL);
+      fill_box (plotter, "blue", 10.0, 20.0);
+      printf ("  earlier snapshot, after blue drawn:");
+      show_pixels (pixels, 3 * SIZE);
+      show ("page 1, blue drawn", plotter);
+      pl_closepl_r (plotter);
+      show ("page 1 closed", plotter);
+
+      /* copy it with padded rows, and with rows that are too short */
+      status = pl_copyraster_r (plotter, buf, 3 * SIZE + 5);
+      printf ("  copyraster, padded rows: %d:", status);
+      show_pixels (buf, 3 * SIZE + 5);
+      printf ("  copyraster, short rows: %d\n",
+	      pl_copyraster_r (plotter, buf, 3 * SIZE - 1));
+
+      /* second page, which is never asked for until it's closed */
+      pl_openpl_r (plotter);
+      pl_fspace_r (plotter, 0.0, 0.0, (double)SIZE, (double)SIZE);
+      fill_box (plotter, "green", 0.0, 20.0);
+      pl_closepl_r (plotter);
+      show ("page 2 closed", plotter);
+
+      /* third page, left open when the Plotter is deleted */
+      pl_openpl_r (plotter);
+      fill_box (plotter, "black", 0.0, 20.0);
+      pl_deletepl_r (plotter);
+    }
+
+  /* a Plotter that doesn't draw into a bitmap has no raster */
+  printf ("meta Plotter\n");
+  plotter = pl_newpl_r ("meta", NULL, NULL, stderr, params);
+  pl_openpl_r (plotter);
+  show ("page 1", plotter);
+  pl_closepl_r (plotter);
+  show ("page 1 closed", plotter);
+  pl_deletepl_r (plotter);
+
+  pl_deleteplparams (params);
+  return 0;
+}
+
+/* print the return value of getraster(), and what it returns */
+static void
+show (const char *what, plPlotter *plotter)
+{
+  const unsigned char *pixels;
+  int width, height, stride, format, status;
+
+  status = pl_getraster_r (plotter, &pixels, &width, &height, &stride, &format);
+  printf ("  %s: %d", what, status);
+  if (status < 0)
+    {
+      printf ("\n");
+      return;
+    }
+  printf (", %dx%d, stride %d, format %d:", width, height, stride, format);
+  show_pixels (pixels, stride);
+}
+
+/* print the pixels at the middle of the left and right halves */
+static void
+show_pixels (const unsigned char *pixels, int stride)
+{
+  const unsigned char *left, *right;
+
+  left = pixels + (SIZE / 2) * stride + 3 * (SIZE / 4);
+  right = pixels + (SIZE / 2) * stride + 3 * (3 * SIZE / 4);
+  printf (" %02x%02x%02x %02x%02x%02x\n",
+	  left[0], left[1], left[2], right[0], right[1], right[2]);
+}
+
+/* fill a full-height box in the specified color */
+static void
+fill_box (plPlotter *plotter, const char *color, double x0, double x1)
+{
+  pl_filltype_r (plotter, 1);
+  pl_colorname_r (plotter, color);
+  pl_fbox_r (plotter, x0, 0.0, x1, (double)SIZE);
+}